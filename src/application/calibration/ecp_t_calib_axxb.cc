@@ -5,763 +5,116 @@ namespace ecp {
 namespace common {
 namespace task {
 
-// KONSTRUKTORY
-calib_axxb::calib_axxb(lib::configurator &_config) : calibration(_config)
-{
-	fdf.n = dimension = 6;  // number of function components
-	fdf.f = &objective_function;
-	fdf.df = &objective_function_df;
-	fdf.fdf = &objective_function_fdf;
-}
-
-void calib_axxb::main_task_algorithm(void)
-{
-	calibration::main_task_algorithm();
-}
+namespace {
 
 /*!
  * Objective function for eih calibration
  * v = [x, y, z, alfa, beta, gamma]
- * params contains matrices K, M and vectors k, m
- * A * X = X * B
+ * A * X = X * B, for consecutive measurements 1, 2:
+ * c * tr([K1 * X * M1 - K2 * X * M2]^T * [K1 * X * M1 - K2 * X * M2]) +
+ * + |K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)|^2
  */
-double calib_axxb::objective_function(const gsl_vector *v, void *params)
+class axxb_problem : public hand_eye_problem <6>
 {
-	int i;
-
-	// temporary variable
-	double wynik = 0.0;
-
-	// temporary matrix for calculations
-	gsl_matrix *temp_matrix;
-	temp_matrix = gsl_matrix_calloc(3, 3);
-	// second temporary matrix for calculations
-	gsl_matrix *temp_matrix2;
-	temp_matrix2 = gsl_matrix_calloc(3, 3);
-	// third temporary matrix for calculations
-	gsl_matrix *temp_matrix3;
-	temp_matrix3 = gsl_matrix_calloc(3, 3);
-
-	// vector to store angles and transform them to rotation matrix
-	gsl_vector *angles;
-	angles = gsl_vector_calloc (3);
-
-	// temporary vector for calculations
-	gsl_vector *temp_vector;
-	temp_vector = gsl_vector_calloc (3);
-	// second temporary vector for calculations
-	gsl_vector *temp_vector2;
-	temp_vector2 = gsl_vector_calloc (3);
-	// third temporary vector for calculations
-	gsl_vector *temp_vector3;
-	temp_vector3 = gsl_vector_calloc (3);
-
-	// translation from robot base to gripper frame
-	gsl_vector *k;
-	k = gsl_vector_calloc (3);
-
-	// translation from robot base to gripper frame
-	gsl_vector *k2;
-	k2 = gsl_vector_calloc (3);
-
-	// translation from chessboard frame to camera frame
-	gsl_vector *m;
-	m = gsl_vector_calloc (3);
-
-	// translation from chessboard frame to camera frame
-	gsl_vector *m2;
-	m2 = gsl_vector_calloc (3);
-
-	// translation from gripper frame to camera frame
-	gsl_vector *x;
-	x = gsl_vector_calloc (3);
-
-	// rotation from gripper frame to camera frame
-	gsl_matrix *X;
-	X = gsl_matrix_calloc(3, 3);
-
-	// rotation from robot base to gripper frame
-	gsl_matrix *K2;
-	K2 = gsl_matrix_calloc(3, 3);
-
-	// rotation from robot base to gripper frame
-	gsl_matrix *K;
-	K = gsl_matrix_calloc(3, 3);
-
-	// rotation from chessboard frame to camera frame
-	gsl_matrix *M2;
-	M2 = gsl_matrix_calloc(3, 3);
-
-	// rotation from chessboard frame to camera frame
-	gsl_matrix *M;
-	M = gsl_matrix_calloc(3, 3);
-
-	objective_function_parameters *p = (objective_function_parameters *)params;
-
-	// initialize x, X from vector v
-	for(i = 0; i < 6; ++i)
+public:
+	axxb_problem(const std::vector <hand_eye_measurement> & measurements, double magical_c) :
+		data(measurements), sqrt_c(sqrt(magical_c))
 	{
-		if(i < 3)
-		{
-			// x, y, z
-			gsl_vector_set(x, i, gsl_vector_get(v,i));
-		}
-		else if (i < 6)
-		{
-			// fi, teta, psi
-			gsl_vector_set(angles, i-3, gsl_vector_get(v,i));
+		// change transformation from object to camera -> camera to object
+		for (std::size_t i = 0; i < data.size(); ++i) {
+			data[i].m = -data[i].m;
 		}
 	}
 
-	// calculate matrix X from angles fi, teta, psi
-	angles_to_rotation_matrix(angles, X);
-
-	for(i = 0; i < p->number_of_measures - 1; ++i)
+	int terms() const
 	{
-		// K = K1
-		extract_matrix(p->K, K, i);
-
-		// k = k1
-		extract_vector(p->k, k, i);
-
-		// K2 = K2
-		extract_matrix(p->K, K2, i + 1);
-
-		// k2 = k2
-		extract_vector(p->k, k2, i + 1);
-
-		// M = M1
-		extract_matrix(p->M, M, i);
-
-		// m = m1
-		extract_vector(p->m, m, i);
-
-		// M2 = M2
-		extract_matrix(p->M, M2, i + 1);
-
-		// m2 = m2
-		extract_vector(p->m, m2, i + 1);
-
-		// change transformation from object to camera -> camera to object
-//		gsl_matrix_transpose(M);
-//		matrix_vector_multiply(M, m);
-		gsl_vector_scale(m, -1.0);
-//		gsl_matrix_transpose(M2);
-//		matrix_vector_multiply(M2, m2);
-		gsl_vector_scale(m2, -1.0);
-
-		// temp_matrix = K1
-		gsl_matrix_memcpy (temp_matrix, K);
-
-		// temp_matrix = K1 * X
-		matrix_matrix_multiply(temp_matrix, X);
-
-		// temp_matrix = K1 * X * M1
-		matrix_matrix_multiply(temp_matrix, M);
-
-		// temp_matrix2 = K2
-		gsl_matrix_memcpy (temp_matrix2, K2);
-
-		// temp_matrix2 = K2 * X
-		matrix_matrix_multiply(temp_matrix2, X);
-
-		// temp_matrix2 = K2 * X * M2
-		matrix_matrix_multiply(temp_matrix2, M2);
-
-		// temp_matrix = K1 * X * M1 - K2 * X * M2
-		gsl_matrix_sub(temp_matrix, temp_matrix2);
-
-		//temp_matrix3 = K1 * X * M1 - K2 * X * M2
-		gsl_matrix_memcpy (temp_matrix3, temp_matrix);
-
-		//temp_matrix = [K1 * X * M1 - K2 * X * M2]^T
-		gsl_matrix_transpose(temp_matrix);
-
-		// temp_matrix = [K1 * X * M1 - K2 * X * M2]^T * [K1 * X * M1 - K2 * X * M2]
-		matrix_matrix_multiply(temp_matrix, temp_matrix3);
-
-		// wynik += c * tr([K1 * X * M1 - K2 * X * M2]^T * [K1 * X * M1 - K2 * X * M2])
-		wynik += p->magical_c * calculate_matrix_trace(temp_matrix);
-
-		// temp_vector = x
-		gsl_vector_memcpy(temp_vector, x);
-
-		// temp_vector2 = m1
-		gsl_vector_memcpy(temp_vector2, m);
-
-		// temp_vector2 = X * m1
-		matrix_vector_multiply(X, temp_vector2);
-
-		// temp_vector2 = K1 * X * m1
-		matrix_vector_multiply(K, temp_vector2);
-
-		// temp_vector = K1 * x
-		matrix_vector_multiply(K, temp_vector);
-
-		// temp_vector2 = K1 * X * m1 + K1 * x
-		gsl_vector_add(temp_vector2, temp_vector);
-
-		// temp_vector2 = K1 * X * m1 + K1 * x + k1
-		gsl_vector_add(temp_vector2, k);
-
-		// temp_vector3 = K1 * X * m1 + K1 * x + k1
-		gsl_vector_memcpy(temp_vector3, temp_vector2);
-
-		// temp_vector = x
-		gsl_vector_memcpy(temp_vector, x);
-
-		// temp_vector2 = m2
-		gsl_vector_memcpy(temp_vector2, m2);
-
-		// temp_vector2 = X * m2
-		matrix_vector_multiply(X, temp_vector2);
-
-		// temp_vector2 = K2 * X * m2
-		matrix_vector_multiply(K2, temp_vector2);
-
-		// temp_vector = K2 * x
-		matrix_vector_multiply(K2, temp_vector);
-
-		// temp_vector2 = K2 * X * m2 + K2 * x
-		gsl_vector_add(temp_vector2, temp_vector);
-
-		// temp_vector2 = K2 * X * m2 + K2 * x + k2
-		gsl_vector_add(temp_vector2, k2);
-
-		// temp_vector3 = K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)
-		gsl_vector_sub(temp_vector3, temp_vector2);
-
-		wynik += transposed_vector_multiply(temp_vector3, temp_vector3);
+		return (data.size() > 1) ? (int) data.size() - 1 : 0;
 	}
 
-	// free allocated memory
-	gsl_matrix_free(temp_matrix);
-	gsl_matrix_free(temp_matrix2);
-	gsl_matrix_free(temp_matrix3);
-	gsl_vector_free(angles);
-	gsl_vector_free(m);
-	gsl_vector_free(m2);
-	gsl_vector_free(k);
-	gsl_vector_free(k2);
-	gsl_vector_free(x);
-	gsl_vector_free(temp_vector);
-	gsl_vector_free(temp_vector2);
-	gsl_vector_free(temp_vector3);
-	gsl_matrix_free(K);
-	gsl_matrix_free(M);
-	gsl_matrix_free(K2);
-	gsl_matrix_free(M2);
-	gsl_matrix_free(X);
-	return wynik;
-}
-
-/*!
- * Calculate derivative of the objective function
- */
-void calib_axxb::objective_function_df(const gsl_vector *v, void *params, gsl_vector *df)
-{
-	int i;
-
-	// value of derivative dx, dy, dz
-	gsl_vector_set(df, 0, 0.0);
-	gsl_vector_set(df, 1, 0.0);
-	gsl_vector_set(df, 2, 0.0);
-	// value of derivative dfi, dteta and dpsi
-	gsl_vector_set(df, 3, 0.0);
-	gsl_vector_set(df, 4, 0.0);
-	gsl_vector_set(df, 5, 0.0);
-
-	// temporary variable
-	double wynik = 0.0;
-
-	// temporary matrix for calculations
-	gsl_matrix *temp_matrix;
-	temp_matrix = gsl_matrix_calloc(3, 3);
-	// second temporary matrix for calculations
-	gsl_matrix *temp_matrix2;
-	temp_matrix2 = gsl_matrix_calloc(3, 3);
-	// third temporary matrix for calculations
-	gsl_matrix *temp_matrix3;
-	temp_matrix3 = gsl_matrix_calloc(3, 3);
-
-	// vector to store angles and transform them to rotation matrix
-	gsl_vector *angles;
-	angles = gsl_vector_calloc (3);
-
-	// temporary vector for calculations
-	gsl_vector *temp_vector;
-	temp_vector = gsl_vector_calloc (3);
-	// second temporary vector for calculations
-	gsl_vector *temp_vector2;
-	temp_vector2 = gsl_vector_calloc (3);
-	// third temporary vector for calculations
-	gsl_vector *temp_vector3;
-	temp_vector3 = gsl_vector_calloc (3);
-
-	// translation from robot base to gripper frame
-	gsl_vector *k;
-	k = gsl_vector_calloc (3);
-
-	// translation from robot base to gripper frame
-	gsl_vector *k2;
-	k2 = gsl_vector_calloc (3);
-
-	// translation from chessboard frame to camera frame
-	gsl_vector *m;
-	m = gsl_vector_calloc (3);
-
-	// translation from chessboard frame to camera frame
-	gsl_vector *m2;
-	m2 = gsl_vector_calloc (3);
-
-	// translation from gripper frame to camera frame
-	gsl_vector *x;
-	x = gsl_vector_calloc (3);
-
-	// rotation from gripper frame to camera frame
-	gsl_matrix *X;
-	X = gsl_matrix_calloc(3, 3);
-
-	gsl_matrix *dX_dfi;
-	dX_dfi = gsl_matrix_calloc(3, 3);
-
-	gsl_matrix *dX_dteta;
-	dX_dteta = gsl_matrix_calloc(3, 3);
-
-	gsl_matrix *dX_dpsi;
-	dX_dpsi = gsl_matrix_calloc(3, 3);
-
-	// rotation from robot base to gripper frame
-	gsl_matrix *K2;
-	K2 = gsl_matrix_calloc(3, 3);
-
-	// rotation from robot base to gripper frame
-	gsl_matrix *K;
-	K = gsl_matrix_calloc(3, 3);
-
-	// rotation from chessboard frame to camera frame
-	gsl_matrix *M2;
-	M2 = gsl_matrix_calloc(3, 3);
-
-	// rotation from chessboard frame to camera frame
-	gsl_matrix *M;
-	M = gsl_matrix_calloc(3, 3);
-
-	objective_function_parameters *p = (objective_function_parameters *)params;
-
-	// initialize x, X from vector v
-	for(i = 0; i < 6; ++i)
+	void set_parameters(const parameters_t & v)
 	{
-		if(i < 3)
-		{
-			// x, y, z
-			gsl_vector_set(x, i, gsl_vector_get(v,i));
-		}
-		else if (i < 6)
-		{
-			// fi, teta, psi
-			gsl_vector_set(angles, i-3, gsl_vector_get(v,i));
-		}
+		x << v(0), v(1), v(2);
+		X.set(v(3), v(4), v(5));
 	}
 
-	// calculate matrix X from angles fi, teta, psi
-	angles_to_rotation_matrix(angles, X);
-
-	// calculate derivative of matrix X - dX/dfi
-	angles_to_rotation_matrix_dalfa(angles, dX_dfi);
-
-	// calculate derivative of matrix X - dX/dteta
-	angles_to_rotation_matrix_dbeta(angles, dX_dteta);
-
-	// calculate derivative of matrix X - dX/dpsi
-	angles_to_rotation_matrix_dgamma(angles, dX_dpsi);
-
-	for(i = 0; i < p->number_of_measures - 1; ++i)
+	void term(int i, hand_eye_residual & r, jacobian_t & J) const
 	{
-		// K = K1
-		extract_matrix(p->K, K, i);
-
-		// k = k1
-		extract_vector(p->k, k, i);
-
-		// K2 = K2
-		extract_matrix(p->K, K2, i + 1);
-
-		// k2 = k2
-		extract_vector(p->k, k2, i + 1);
-
-		// M = M1
-		extract_matrix(p->M, M, i);
-
-		// m = m1
-		extract_vector(p->m, m, i);
-
-		// M2 = M2
-		extract_matrix(p->M, M2, i + 1);
-
-		// m2 = m2
-		extract_vector(p->m, m2, i + 1);
-
-		// change transformation from object to camera -> camera to object
-//		gsl_matrix_transpose(M);
-//		matrix_vector_multiply(M, m);
-		gsl_vector_scale(m, -1.0);
-//		gsl_matrix_transpose(M2);
-//		matrix_vector_multiply(M2, m2);
-		gsl_vector_scale(m2, -1.0);
-
-		// temp_matrix = K1
-		gsl_matrix_memcpy (temp_matrix, K);
-
-		// temp_matrix = K1 * X
-		matrix_matrix_multiply(temp_matrix, X);
-
-		// temp_matrix = K1 * X * M1
-		matrix_matrix_multiply(temp_matrix, M);
-
-		// temp_matrix2 = K2
-		gsl_matrix_memcpy (temp_matrix2, K2);
-
-		// temp_matrix2 = K2 * X
-		matrix_matrix_multiply(temp_matrix2, X);
-
-		// temp_matrix2 = K2 * X * M2
-		matrix_matrix_multiply(temp_matrix2, M2);
-
-		// temp_matrix = K1 * X * M1 - K2 * X * M2
-		gsl_matrix_sub(temp_matrix, temp_matrix2);
-
-		//temp_matrix3 = K1 * X * M1 - K2 * X * M2
-		gsl_matrix_memcpy (temp_matrix3, temp_matrix);
-
-		// temp_vector = x
-		gsl_vector_memcpy(temp_vector, x);
-
-		// temp_vector2 = m1
-		gsl_vector_memcpy(temp_vector2, m);
-
-		// temp_vector2 = X * m1
-		matrix_vector_multiply(X, temp_vector2);
-
-		// temp_vector2 = K1 * X * m1
-		matrix_vector_multiply(K, temp_vector2);
-
-		// temp_vector = K1 * x
-		matrix_vector_multiply(K, temp_vector);
-
-		// temp_vector2 = K1 * X * m1 + K1 * x
-		gsl_vector_add(temp_vector2, temp_vector);
-
-		// temp_vector2 = K1 * X * m1 + K1 * x + k1
-		gsl_vector_add(temp_vector2, k);
-
-		// temp_vector3 = K1 * X * m1 + K1 * x + k1
-		gsl_vector_memcpy(temp_vector3, temp_vector2);
-
-		// temp_vector = x
-		gsl_vector_memcpy(temp_vector, x);
-
-		// temp_vector2 = m2
-		gsl_vector_memcpy(temp_vector2, m2);
-
-		// temp_vector2 = X * m2
-		matrix_vector_multiply(X, temp_vector2);
-
-		// temp_vector2 = K2 * X * m2
-		matrix_vector_multiply(K2, temp_vector2);
-
-		// temp_vector = K2 * x
-		matrix_vector_multiply(K2, temp_vector);
-
-		// temp_vector2 = K2 * X * m2 + K2 * x
-		gsl_vector_add(temp_vector2, temp_vector);
-
-		// temp_vector2 = K2 * X * m2 + K2 * x + k2
-		gsl_vector_add(temp_vector2, k2);
-
-		// temp_vector3 = K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)
-		gsl_vector_sub(temp_vector3, temp_vector2);
-
-		// temp_matrix = K1
-		gsl_matrix_memcpy (temp_matrix, K);
-
-		// temp_matrix = K1 - K2
-		gsl_matrix_sub(temp_matrix, K2);
-
-		// temp_vector = [0 0 0]^T
-		gsl_vector_set_zero(temp_vector);
-
-		// temp_vector = [1 0 0]^T
-		gsl_vector_set(temp_vector, 0, 1.0);
-
-		// temp_vector = (K1 - K2) * [1 0 0]^T
-		matrix_vector_multiply(temp_matrix, temp_vector);
-
-		// get previous value of dx
-		wynik = gsl_vector_get(df, 0);
-		// wynik += 2 * [K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)]^T *
-		// *[(K1 - K2) * [1 0 0]^T]
-		wynik += 2.0 * transposed_vector_multiply(temp_vector, temp_vector3);
-		// update value of dy
-		gsl_vector_set(df, 0, wynik);
-
-		// temp_vector = [0 0 0]^T
-		gsl_vector_set_zero(temp_vector);
-
-		// temp_vector = [0 1 0]^T
-		gsl_vector_set(temp_vector, 1, 1.0);
-
-		// temp_vector = (K1 - K2) * [0 1 0]^T
-		matrix_vector_multiply(temp_matrix, temp_vector);
-
-		// get previous value of dy
-		wynik = gsl_vector_get(df, 1);
-		// wynik += 2 * [K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)]^T *
-		// *[(K1 - K2) * [0 1 0]^T]
-		wynik += 2.0 * transposed_vector_multiply(temp_vector, temp_vector3);
-		// update value of dy
-		gsl_vector_set(df, 1, wynik);
-
-		// temp_vector = [0 0 0]^T
-		gsl_vector_set_zero(temp_vector);
-
-		// temp_vector = [0 0 1]^T
-		gsl_vector_set(temp_vector, 2, 1.0);
-
-		// temp_vector = (K1 - K2) * [0 0 1]^T
-		matrix_vector_multiply(temp_matrix, temp_vector);
-
-		// get previous value of dz
-		wynik = gsl_vector_get(df, 2);
-		// wynik += 2 * [K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)]^T *
-		// *[(K1 - K2) * [0 0 1]^T]
-		wynik += 2.0 * transposed_vector_multiply(temp_vector, temp_vector3);
-		// update value of dy
-		gsl_vector_set(df, 2, wynik);
-
-		// dfi
-
-		// temp_matrix = K1
-		gsl_matrix_memcpy (temp_matrix, K);
-
-		// temp_matrix = K1 * dX/dfi
-		matrix_matrix_multiply(temp_matrix, dX_dfi);
-
-		// temp_matrix = K1 * dX/dfi * M1
-		matrix_matrix_multiply(temp_matrix, M);
-
-		// temp_matrix2 = K2
-		gsl_matrix_memcpy (temp_matrix2, K2);
-
-		// temp_matrix2 = K2 * dX/dfi
-		matrix_matrix_multiply(temp_matrix2, dX_dfi);
-
-		// temp_matrix2 = K2 * dX/dfi* M2
-		matrix_matrix_multiply(temp_matrix2, M2);
-
-		// temp_matrix = K1 * dX/dfi * M1 - K2 * dX/dfi * M2
-		gsl_matrix_sub(temp_matrix, temp_matrix2);
-
-		// temp_matrix2 = K1 * dX/dfi * M1 - K2 * dX/dfi * M2
-		gsl_matrix_memcpy (temp_matrix2, temp_matrix);
-
-		// temp_matrix2 = [K1 * dX/dfi * M1 - K2 * dX/dfi * M2]^T
-		gsl_matrix_transpose(temp_matrix2);
-
-		// temp_matrix2 = [K1 * dX/dfi * M1 - K2 * dX/dfi * M2]^T * (K1 * X * M1 - K2 * X * M2)
-		matrix_matrix_multiply(temp_matrix2, temp_matrix3);
-
-		// get previous value of dfi
-		wynik = gsl_vector_get(df, 3);
-		// wynik += 2.0 * c * tr[(K1 * dX/dfi * M1 - K2 * dX/dfi * M2)^T * (K1 * X * M1 - K2 * X * M2)]
-		wynik += 2.0 * (p->magical_c) * calculate_matrix_trace(temp_matrix2);
-
-		// temp_vector = m1
-		gsl_vector_memcpy(temp_vector, m);
-
-		// temp_vector = dX/dfi * m1
-		matrix_vector_multiply(dX_dfi, temp_vector);
-
-		// temp_vector = K1 * dX/dfi * m1
-		matrix_vector_multiply(K, temp_vector);
+		const hand_eye_measurement & one = data[i];
+		const hand_eye_measurement & two = data[i + 1];
 
-		// temp_vector2 = m2
-		gsl_vector_memcpy(temp_vector2, m2);
+		// K1 * X * M1 - K2 * X * M2
+		set_rotation_residual(r, one.K * X.R * one.M - two.K * X.R * two.M, sqrt_c);
 
-		// temp_vector2 = dX/dfi * m2
-		matrix_vector_multiply(dX_dfi, temp_vector2);
-
-		// temp_vector2 = K2 * dX/dfi * m2
-		matrix_vector_multiply(K2, temp_vector2);
-
-		// temp_vector = K1 * dX/dfi * m1 - K2 * dX/dfi * m2
-		gsl_vector_sub(temp_vector, temp_vector2);
-
-		// wynik += 2.0 * [K1 * dX/dfi * m1 - K2 * dX/dfi * m2]^T * [K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)]
-		wynik += 2.0 * transposed_vector_multiply(temp_vector, temp_vector3);
-
-		// update value of dfi
-		gsl_vector_set(df, 3, wynik);
-
-		// dteta
-
-		// temp_matrix = K1
-		gsl_matrix_memcpy (temp_matrix, K);
-
-		// temp_matrix = K1 * dX/dteta
-		matrix_matrix_multiply(temp_matrix, dX_dteta);
-
-		// temp_matrix = K1 * dX/dteta * M1
-		matrix_matrix_multiply(temp_matrix, M);
-
-		// temp_matrix2 = K2
-		gsl_matrix_memcpy (temp_matrix2, K2);
-
-		// temp_matrix2 = K2 * dX/dteta
-		matrix_matrix_multiply(temp_matrix2, dX_dteta);
-
-		// temp_matrix2 = K2 * dX/dteta* M2
-		matrix_matrix_multiply(temp_matrix2, M2);
-
-		// temp_matrix = K1 * dX/dteta * M1 - K2 * dX/dteta * M2
-		gsl_matrix_sub(temp_matrix, temp_matrix2);
-
-		// temp_matrix2 = K1 * dX/dteta * M1 - K2 * dX/dteta * M2
-		gsl_matrix_memcpy (temp_matrix2, temp_matrix);
-
-		// temp_matrix2 = [K1 * dX/dteta * M1 - K2 * dX/dteta * M2]^T
-		gsl_matrix_transpose(temp_matrix2);
-
-		// temp_matrix2 = [K1 * dX/dteta * M1 - K2 * dX/dteta * M2]^T * (K1 * X * M1 - K2 * X * M2)
-		matrix_matrix_multiply(temp_matrix2, temp_matrix3);
-
-		// get previous value of dteta
-		wynik = gsl_vector_get(df, 4);
-		// wynik += 2.0 * c * tr[(K1 * dX/dteta * M1 - K2 * dX/dteta * M2)^T * (K1 * X * M1 - K2 * X * M2)]
-		wynik += 2.0 * (p->magical_c) * calculate_matrix_trace(temp_matrix2);
-
-		// temp_vector = m1
-		gsl_vector_memcpy(temp_vector, m);
-
-		// temp_vector = dX/dteta * m1
-		matrix_vector_multiply(dX_dteta, temp_vector);
-
-		// temp_vector = K1 * dX/dteta * m1
-		matrix_vector_multiply(K, temp_vector);
-
-		// temp_vector2 = m2
-		gsl_vector_memcpy(temp_vector2, m2);
-
-		// temp_vector2 = dX/dteta * m2
-		matrix_vector_multiply(dX_dteta, temp_vector2);
-
-		// temp_vector2 = K2 * dX/dteta * m2
-		matrix_vector_multiply(K2, temp_vector2);
-
-		// temp_vector = K1 * dX/dteta * m1 - K2 * dX/dteta * m2
-		gsl_vector_sub(temp_vector, temp_vector2);
-
-		// wynik += 2.0 * [K1 * dX/dteta * m1 - K2 * dX/dteta * m2]^T * [K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)]
-		wynik += 2.0 * transposed_vector_multiply(temp_vector, temp_vector3);
-
-		// update value of dteta
-		gsl_vector_set(df, 4, wynik);
-
-		// dpsi
-
-		// temp_matrix = K1
-		gsl_matrix_memcpy (temp_matrix, K);
-
-		// temp_matrix = K1 * dX/dpsi
-		matrix_matrix_multiply(temp_matrix, dX_dpsi);
-
-		// temp_matrix = K1 * dX/dpsi * M1
-		matrix_matrix_multiply(temp_matrix, M);
-
-		// temp_matrix2 = K2
-		gsl_matrix_memcpy (temp_matrix2, K2);
-
-		// temp_matrix2 = K2 * dX/dpsi
-		matrix_matrix_multiply(temp_matrix2, dX_dpsi);
-
-		// temp_matrix2 = K2 * dX/dpsi* M2
-		matrix_matrix_multiply(temp_matrix2, M2);
-
-		// temp_matrix = K1 * dX/dpsi * M1 - K2 * dX/dpsi * M2
-		gsl_matrix_sub(temp_matrix, temp_matrix2);
+		// K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)
+		const Eigen::Vector3d t = one.K * (X.R * one.m + x) + one.k - two.K * (X.R * two.m + x) - two.k;
+		for (int j = 0; j < 3; ++j) {
+			r(9 + j) = t(j);
+		}
 
-		// temp_matrix2 = K1 * dX/dpsi * M1 - K2 * dX/dpsi * M2
-		gsl_matrix_memcpy (temp_matrix2, temp_matrix);
+		// d/dx, d/dy, d/dz: (K1 - K2) * e_j
+		const Eigen::Matrix3d dK = one.K - two.K;
+		for (int col = 0; col < 3; ++col) {
+			for (int row = 0; row < 9; ++row) {
+				J(row, col) = 0.0;
+			}
+			for (int j = 0; j < 3; ++j) {
+				J(9 + j, col) = dK(j, col);
+			}
+		}
 
-		// temp_matrix2 = [K1 * dX/dpsi * M1 - K2 * dX/dpsi * M2]^T
-		gsl_matrix_transpose(temp_matrix2);
+		// d/dalfa, d/dbeta, d/dgamma
+		for (int a = 0; a < 3; ++a) {
+			const Eigen::Matrix3d & dX = X.dR[a];
+			set_rotation_jacobian <6> (J, 3 + a, one.K * dX * one.M - two.K * dX * two.M, sqrt_c);
+			const Eigen::Vector3d dt = one.K * (dX * one.m) - two.K * (dX * two.m);
+			for (int j = 0; j < 3; ++j) {
+				J(9 + j, 3 + a) = dt(j);
+			}
+		}
+	}
 
-		// temp_matrix2 = [K1 * dX/dpsi * M1 - K2 * dX/dpsi * M2]^T * (K1 * X * M1 - K2 * X * M2)
-		matrix_matrix_multiply(temp_matrix2, temp_matrix3);
+private:
+	std::vector <hand_eye_measurement> data;
 
-		// get previous value of dpsi
-		wynik = gsl_vector_get(df, 5);
-		// wynik += 2.0 * c * tr[(K1 * dX/dpsi * M1 - K2 * dX/dpsi * M2)^T * (K1 * X * M1 - K2 * X * M2)]
-		wynik += 2.0 * (p->magical_c) * calculate_matrix_trace(temp_matrix2);
+	const double sqrt_c;
 
-		// temp_vector = m1
-		gsl_vector_memcpy(temp_vector, m);
+	// translation from gripper frame to camera frame
+	Eigen::Vector3d x;
 
-		// temp_vector = dX/dpsi * m1
-		matrix_vector_multiply(dX_dpsi, temp_vector);
+	// rotation from gripper frame to camera frame
+	rotation_with_derivatives X;
+};
 
-		// temp_vector = K1 * dX/dpsi * m1
-		matrix_vector_multiply(K, temp_vector);
+} // namespace
 
-		// temp_vector2 = m2
-		gsl_vector_memcpy(temp_vector2, m2);
+// KONSTRUKTORY
+calib_axxb::calib_axxb(lib::configurator &_config) : calibration(_config)
+{
+	dimension = 6;
+}
 
-		// temp_vector2 = dX/dpsi * m2
-		matrix_vector_multiply(dX_dpsi, temp_vector2);
+void calib_axxb::main_task_algorithm(void)
+{
+	calibration::main_task_algorithm();
+}
 
-		// temp_vector2 = K2 * dX/dpsi * m2
-		matrix_vector_multiply(K2, temp_vector2);
+int calib_axxb::solve(std::vector <double> & solution, double & value)
+{
+	axxb_problem problem(measurements, ofp.magical_c);
+	lm_solver <6> solver(problem, solver_threads);
 
-		// temp_vector = K1 * dX/dpsi * m1 - K2 * dX/dpsi * m2
-		gsl_vector_sub(temp_vector, temp_vector2);
+	axxb_problem::parameters_t v;
+	for (int i = 0; i < 6; ++i) {
+		v(i) = solution[i];
+	}
 
-		// wynik += 2.0 * [K1 * dX/dpsi * m1 - K2 * dX/dpsi * m2]^T * [K1 * X * m1 + K1 * x + k1 - (K2 * X * m2 + K2 * x + k2)]
-		wynik += 2.0 * transposed_vector_multiply(temp_vector, temp_vector3);
+	const int iterations = solver.solve(v, value);
 
-		// update value of dpsi
-		gsl_vector_set(df, 5, wynik);
+	for (int i = 0; i < 6; ++i) {
+		solution[i] = v(i);
 	}
 
-	// free allocated memory
-	gsl_matrix_free(temp_matrix);
-	gsl_matrix_free(temp_matrix2);
-	gsl_matrix_free(temp_matrix3);
-	gsl_vector_free(angles);
-	gsl_vector_free(m);
-	gsl_vector_free(m2);
-	gsl_vector_free(k);
-	gsl_vector_free(k2);
-	gsl_vector_free(x);
-	gsl_vector_free(temp_vector);
-	gsl_vector_free(temp_vector2);
-	gsl_vector_free(temp_vector3);
-	gsl_matrix_free(K);
-	gsl_matrix_free(M);
-	gsl_matrix_free(K2);
-	gsl_matrix_free(M2);
-	gsl_matrix_free(X);
-	gsl_matrix_free(dX_dfi);
-	gsl_matrix_free(dX_dteta);
-	gsl_matrix_free(dX_dpsi);
-}
-
-/*!
- * Calculate objective function and her derivative together.
- */
-void calib_axxb::objective_function_fdf(const gsl_vector *v, void *params, double *f, gsl_vector *df)
-{
-	*f = objective_function(v, params);
-	objective_function_df(v, params, df);
+	return iterations;
 }
 
 //task_base* return_created_ecp_task (lib::configurator &_config)
@@ -15,9 +15,7 @@ class calib_axzb: public common::task::calibration  {
 
 		void main_task_algorithm(void);
 
-		static double objective_function (const gsl_vector *v, void *params);
-		static void objective_function_df(const gsl_vector *v, void *params, gsl_vector *df);
-		static void objective_function_fdf(const gsl_vector *v, void *params, double *f, gsl_vector *df);
+		int solve(std::vector <double> & solution, double & value);
 };
 
 } // namespace task
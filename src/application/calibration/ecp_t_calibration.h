@@ -1,14 +1,17 @@
 #if !defined(_ECP_T_CALIBRATION_H)
 #define _ECP_T_CALIBRATION_H
 
+#include <vector>
+
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
-#include <gsl/gsl_multimin.h>
 
 #include "base/lib/com_buf.h"
 #include "base/lib/configurator.h"
 #include "base/ecp/ecp_task.h"
 
+#include "hand_eye_solver.h"
+
 namespace mrrocpp {
 namespace ecp {
 namespace common {
@@ -16,8 +19,6 @@ namespace task {
 
 class calibration: public common::task::task  {
 	protected:
-		gsl_multimin_function_fdf fdf;
-
 		struct objective_function_parameters
 		{
 			// rotation matrix (from robot base to tool frame) - received from MRROC
@@ -36,25 +37,22 @@ class calibration: public common::task::task  {
 
 		int dimension;
 
+		// measurements copied from ofp to fixed-size matrices before solving
+		std::vector <hand_eye_measurement> measurements;
+
+		// number of threads evaluating the objective function (solver_threads, all processors by default)
+		int solver_threads;
+
 		// KONSTRUKTORY
 		calibration(lib::configurator &_config);
 
 		// methods for ECP template to redefine in concrete classes
 		void main_task_algorithm(void);
 
-	public:
-		static bool matrix_matrix_multiply(gsl_matrix * matrix1, const gsl_matrix * matrix2);
-		static double transposed_vector_multiply(const gsl_vector * transposed, const gsl_vector * vector);
-		static bool matrix_vector_multiply(const gsl_matrix * matrix, gsl_vector * vector);
-		static bool rotation_matrix_to_angles(const gsl_matrix * rotation, gsl_vector * angles); // angles = [alfa, beta, gamma]
-		static bool angles_to_rotation_matrix(const gsl_vector * angles, gsl_matrix * rotation); // angles = [alfa, beta, gamma]
-		static bool angles_to_rotation_matrix_dalfa(const gsl_vector * angles, gsl_matrix * rotation); // angles = [alfa, beta, gamma]
-		static bool angles_to_rotation_matrix_dbeta(const gsl_vector * angles, gsl_matrix * rotation); // angles = [alfa, beta, gamma]
-		static bool angles_to_rotation_matrix_dgamma(const gsl_vector * angles, gsl_matrix * rotation); // angles = [alfa, beta, gamma]
-		static double calculate_matrix_trace(const gsl_matrix * matrix);
-		static bool extract_vector(const gsl_vector * source, gsl_vector * destination, int position);
-		static bool extract_matrix(const gsl_matrix * source, gsl_matrix * destination, int position);
-		static bool transposed_vector_matrix_multiply( gsl_vector * vector, const gsl_matrix * matrix);
+		// minimise the objective function of the concrete problem over the measurements
+		// solution - starting point replaced by the result, value - value of the objective function
+		// returns number of iterations
+		virtual int solve(std::vector <double> & solution, double & value) = 0;
 };
 
 } // namespace task
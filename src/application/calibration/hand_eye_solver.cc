@@ -0,0 +1,120 @@
+/*!
+ * @file hand_eye_solver.cc
+ * @brief Levenberg-Marquardt solver of the hand-eye calibration problems.
+ */
+
+#include <cmath>
+
+#include "hand_eye_solver.h"
+
+namespace mrrocpp {
+namespace ecp {
+namespace common {
+namespace task {
+
+void rotation_with_derivatives::set(double alfa, double beta, double gamma)
+{
+	const double ca = cos(alfa), sa = sin(alfa);
+	const double cb = cos(beta), sb = sin(beta);
+	const double cg = cos(gamma), sg = sin(gamma);
+
+	// obroty elementarne i ich pochodne
+	Eigen::Matrix3d Rx, Ry, Rz, dRx, dRy, dRz;
+
+	Rx << 1, 0, 0, 0, ca, -sa, 0, sa, ca;
+	Ry << cb, 0, sb, 0, 1, 0, -sb, 0, cb;
+	Rz << cg, -sg, 0, sg, cg, 0, 0, 0, 1;
+
+	dRx << 0, 0, 0, 0, -sa, -ca, 0, ca, -sa;
+	dRy << -sb, 0, cb, 0, 0, 0, -cb, 0, -sb;
+	dRz << -sg, -cg, 0, cg, -sg, 0, 0, 0, 0;
+
+	const Eigen::Matrix3d RyRz = Ry * Rz;
+
+	R = Rx * RyRz;
+	dR[0] = dRx * RyRz;
+	dR[1] = Rx * dRy * Rz;
+	dR[2] = Rx * Ry * dRz;
+}
+
+term_pool::term_pool(int _workers) :
+	workers((_workers > 0) ? _workers : 1), job(NULL), terms(0), generation(0), pending(0), quit(false)
+{
+	// watek wywolujacy run() jest pracownikiem 0
+	for (int w = 1; w < workers; ++w) {
+		threads.create_thread(boost::bind(&term_pool::worker_loop, this, w));
+	}
+}
+
+term_pool::~term_pool()
+{
+	{
+		boost::mutex::scoped_lock lock(mtx);
+		quit = true;
+	}
+	start_cond.notify_all();
+	threads.join_all();
+}
+
+int term_pool::size() const
+{
+	return workers;
+}
+
+void term_pool::run(const job_t & _job, int _terms)
+{
+	{
+		boost::mutex::scoped_lock lock(mtx);
+		job = &_job;
+		terms = _terms;
+		pending = workers - 1;
+		++generation;
+	}
+	start_cond.notify_all();
+
+	run_part(0);
+
+	boost::mutex::scoped_lock lock(mtx);
+	while (pending > 0) {
+		done_cond.wait(lock);
+	}
+	job = NULL;
+}
+
+void term_pool::run_part(int worker)
+{
+	const int begin = (int) ((long long) terms * worker / workers);
+	const int end = (int) ((long long) terms * (worker + 1) / workers);
+
+	(*job)(worker, begin, end);
+}
+
+void term_pool::worker_loop(int worker)
+{
+	unsigned int done_generation = 0;
+
+	for (;;) {
+		{
+			boost::mutex::scoped_lock lock(mtx);
+			while (!quit && generation == done_generation) {
+				start_cond.wait(lock);
+			}
+			if (quit) {
+				return;
+			}
+			done_generation = generation;
+		}
+
+		run_part(worker);
+
+		boost::mutex::scoped_lock lock(mtx);
+		if (--pending == 0) {
+			done_cond.notify_one();
+		}
+	}
+}
+
+} // namespace task
+} // namespace common
+} // namespace ecp
+} // namespace mrrocpp
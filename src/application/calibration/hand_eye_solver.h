@@ -0,0 +1,339 @@
+/*!
+ * @file hand_eye_solver.h
+ * @brief Levenberg-Marquardt solver of the hand-eye calibration problems.
+ *
+ * The objective function is a sum of squared residuals of the measurements.
+ * The residuals and their analytic jacobians are evaluated on fixed-size
+ * matrices in workspaces allocated once, divided among a pool of threads.
+ */
+
+#if !defined(_HAND_EYE_SOLVER_H)
+#define _HAND_EYE_SOLVER_H
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/utility.hpp>
+#include <boost/function.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <Eigen/Core>
+
+namespace mrrocpp {
+namespace ecp {
+namespace common {
+namespace task {
+
+//! Single measurement of the calibration
+struct hand_eye_measurement
+{
+	//! rotation matrix (from robot base to tool frame)
+	Eigen::Matrix3d K;
+	//! translation vector (from robot base to tool frame)
+	Eigen::Vector3d k;
+	//! rotation matrix (from chessboard base to camera frame)
+	Eigen::Matrix3d M;
+	//! translation vector (from chessboard base to camera frame)
+	Eigen::Vector3d m;
+};
+
+//! Residuals of a single term of the objective function:
+//! 9 elements of the rotation matrix difference (scaled by sqrt(c)) and 3 of the translation difference
+typedef Eigen::Matrix <double, 12, 1> hand_eye_residual;
+
+//! Rotation matrix from angles [alfa, beta, gamma], R = Rx(alfa) * Ry(beta) * Rz(gamma), with its derivatives
+struct rotation_with_derivatives
+{
+	//! rotation matrix
+	Eigen::Matrix3d R;
+	//! derivatives dR/dalfa, dR/dbeta, dR/dgamma
+	Eigen::Matrix3d dR[3];
+
+	void set(double alfa, double beta, double gamma);
+};
+
+//! Store the rotation matrix difference, row by row and scaled, as the residuals 0-8
+inline void set_rotation_residual(hand_eye_residual & r, const Eigen::Matrix3d & E, double scale)
+{
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r(3 * i + j) = scale * E(i, j);
+		}
+	}
+}
+
+//! Store the derivative of the rotation matrix difference, row by row and scaled, in the rows 0-8 of a jacobian column
+template <int DIM>
+inline void set_rotation_jacobian(Eigen::Matrix <double, 12, DIM> & J, int column, const Eigen::Matrix3d & dE, double scale)
+{
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			J(3 * i + j, column) = scale * dE(i, j);
+		}
+	}
+}
+
+//! Pool of threads evaluating the terms of the objective function
+class term_pool : boost::noncopyable
+{
+public:
+	//! Evaluation of the terms [begin, end) with the workspace of a given worker
+	typedef boost::function <void(int worker, int begin, int end)> job_t;
+
+	//! @param workers number of workers, including the calling thread
+	term_pool(int workers);
+
+	~term_pool();
+
+	//! Number of workers, including the calling thread
+	int size() const;
+
+	//! Evaluate terms [0, terms) divided among the workers; returns when all of them are done
+	void run(const job_t & job, int terms);
+
+private:
+	const int workers;
+
+	boost::thread_group threads;
+	boost::mutex mtx;
+	boost::condition_variable start_cond, done_cond;
+
+	//! current job, valid during run()
+	const job_t * job;
+	//! number of terms of the current job
+	int terms;
+	//! number of the job, wakes the workers up
+	unsigned int generation;
+	//! number of workers still evaluating the current job
+	int pending;
+	//! set to finish the workers
+	bool quit;
+
+	void worker_loop(int worker);
+
+	//! Evaluate the part of the current job assigned to the worker
+	void run_part(int worker);
+};
+
+//! Calibration problem with DIM parameters
+template <int DIM>
+class hand_eye_problem
+{
+public:
+	typedef Eigen::Matrix <double, DIM, 1> parameters_t;
+	typedef Eigen::Matrix <double, 12, DIM> jacobian_t;
+
+	virtual ~hand_eye_problem()
+	{
+	}
+
+	//! Number of terms of the objective function
+	virtual int terms() const = 0;
+
+	//! Compute data shared by all the terms (e.g. rotation matrices) for the given parameters
+	virtual void set_parameters(const parameters_t & v) = 0;
+
+	//! Residuals of the i-th term and their jacobian; called concurrently for different terms
+	virtual void term(int i, hand_eye_residual & r, jacobian_t & J) const = 0;
+};
+
+//! Levenberg-Marquardt minimisation of the sum of squared residuals of a hand_eye_problem
+template <int DIM>
+class lm_solver : boost::noncopyable
+{
+public:
+	typedef typename hand_eye_problem <DIM>::parameters_t parameters_t;
+	typedef typename hand_eye_problem <DIM>::jacobian_t jacobian_t;
+	typedef Eigen::Matrix <double, DIM, DIM> normal_matrix_t;
+
+	//! @param _problem problem to solve
+	//! @param threads number of threads evaluating the terms
+	lm_solver(hand_eye_problem <DIM> & _problem, int threads) :
+		problem(_problem), pool(threads), workspaces(new workspace[threads]),
+		job(boost::bind(&lm_solver::accumulate, this, _1, _2, _3))
+	{
+	}
+
+	//! Minimise the objective function
+	//! @param v starting point, replaced by the solution
+	//! @param value value of the objective function at the solution
+	//! @param max_iterations limit of the iterations
+	//! @return number of iterations
+	int solve(parameters_t & v, double & value, int max_iterations = 1000)
+	{
+		normal_matrix_t A, A_new;
+		parameters_t g, g_new, dx, v_new;
+		double cost, cost_new;
+
+		evaluate(v, A, g, cost);
+
+		double lambda = 1e-3 * A.diagonal().maxCoeff();
+		double nu = 2.0;
+		int iteration = 0;
+
+		while (iteration < max_iterations) {
+			++iteration;
+
+			// gradient of the objective function is 2 * J^T r
+			double gradient_max = 0;
+			for (int i = 0; i < DIM; ++i) {
+				gradient_max = std::max(gradient_max, 2.0 * std::fabs(g(i)));
+			}
+			if (gradient_max < 1e-6) {
+				break;
+			}
+
+			// (J^T J + lambda * diag(J^T J)) dx = -J^T r
+			normal_matrix_t A_damped = A;
+			for (int i = 0; i < DIM; ++i) {
+				A_damped(i, i) += lambda * std::max(A(i, i), 1e-12);
+			}
+			if (!cholesky_solve(A_damped, -g, dx)) {
+				lambda *= nu;
+				nu *= 2.0;
+				continue;
+			}
+
+			if (dx.norm() < 1e-12 * (v.norm() + 1e-12)) {
+				break;
+			}
+
+			v_new = v + dx;
+			evaluate(v_new, A_new, g_new, cost_new);
+
+			// reduction predicted by the linear model: dx^T (lambda D dx - g)
+			double predicted = 0;
+			for (int i = 0; i < DIM; ++i) {
+				predicted += dx(i) * (lambda * std::max(A(i, i), 1e-12) * dx(i) - g(i));
+			}
+
+			if (cost_new < cost) {
+				const double rho = (predicted > 0) ? (cost - cost_new) / predicted : 1.0;
+				const bool small_change = (cost - cost_new) < 1e-15 * cost;
+				v = v_new;
+				A = A_new;
+				g = g_new;
+				cost = cost_new;
+				const double t = 2.0 * rho - 1.0;
+				lambda *= std::max(1.0 / 3.0, 1.0 - t * t * t);
+				nu = 2.0;
+				if (small_change) {
+					break;
+				}
+			} else {
+				lambda *= nu;
+				nu *= 2.0;
+			}
+		}
+
+		value = cost;
+		return iteration;
+	}
+
+	//! Value of the objective function, its gradient (J^T r, half of the gradient) and J^T J
+	void evaluate(const parameters_t & v, normal_matrix_t & A, parameters_t & g, double & cost)
+	{
+		problem.set_parameters(v);
+		pool.run(job, problem.terms());
+
+		A = workspaces[0].JtJ;
+		g = workspaces[0].Jtr;
+		cost = workspaces[0].cost;
+		for (int w = 1; w < pool.size(); ++w) {
+			A += workspaces[w].JtJ;
+			g += workspaces[w].Jtr;
+			cost += workspaces[w].cost;
+		}
+	}
+
+private:
+	//! Workspace of a single worker
+	struct workspace
+	{
+		normal_matrix_t JtJ;
+		parameters_t Jtr;
+		double cost;
+		hand_eye_residual r;
+		jacobian_t J;
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	hand_eye_problem <DIM> & problem;
+
+	term_pool pool;
+
+	boost::scoped_array <workspace> workspaces;
+
+	const term_pool::job_t job;
+
+	//! Sums of the terms [begin, end) in the workspace of the worker
+	void accumulate(int worker, int begin, int end)
+	{
+		workspace & ws = workspaces[worker];
+		ws.JtJ.setZero();
+		ws.Jtr.setZero();
+		ws.cost = 0;
+
+		for (int i = begin; i < end; ++i) {
+			problem.term(i, ws.r, ws.J);
+			ws.JtJ += ws.J.transpose() * ws.J;
+			ws.Jtr += ws.J.transpose() * ws.r;
+			ws.cost += ws.r.squaredNorm();
+		}
+	}
+
+	//! Solve A x = b for symmetric positive definite A; returns false if A is not positive definite
+	static bool cholesky_solve(normal_matrix_t A, const parameters_t & b, parameters_t & x)
+	{
+		// A = L L^T (L w dolnym trojkacie A)
+		for (int j = 0; j < DIM; ++j) {
+			double d = A(j, j);
+			for (int k = 0; k < j; ++k) {
+				d -= A(j, k) * A(j, k);
+			}
+			if (!(d > 0)) {
+				return false;
+			}
+			d = std::sqrt(d);
+			A(j, j) = d;
+			for (int i = j + 1; i < DIM; ++i) {
+				double sum = A(i, j);
+				for (int k = 0; k < j; ++k) {
+					sum -= A(i, k) * A(j, k);
+				}
+				A(i, j) = sum / d;
+			}
+		}
+
+		// L y = b
+		x = b;
+		for (int i = 0; i < DIM; ++i) {
+			for (int k = 0; k < i; ++k) {
+				x(i) -= A(i, k) * x(k);
+			}
+			x(i) /= A(i, i);
+		}
+
+		// L^T x = y
+		for (int i = DIM - 1; i >= 0; --i) {
+			for (int k = i + 1; k < DIM; ++k) {
+				x(i) -= A(k, i) * x(k);
+			}
+			x(i) /= A(i, i);
+		}
+
+		return true;
+	}
+};
+
+} // namespace task
+} // namespace common
+} // namespace ecp
+} // namespace mrrocpp
+
+#endif
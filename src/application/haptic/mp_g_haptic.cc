@@ -195,6 +195,8 @@ bool haptic::next_step_inside()
 
 	// modyfikacja dlugosci makrokroku postumenta na podstawie analizy wyprzedzenia pulse z ECP postumenta wzgledem pulsu z ECP traka
 	// sam proces korekty jest konieczny ze wzgledu na to ze przerwanie w EDP traka dochodzi co okolo 2,08 ms zamiast 2ms w postumecie i calosc sie rozjezdza.
+	// Wspolny zegar serwomechanizmow (klucz servo_clock) zsynchronizowalby oba EDP tylko na jednym wezle;
+	// w haptic.ini dzialaja one na robot1 i robot2, wiec moga sie rozjezdzac, a korekta pozostaje wylaczona.
 
 	boost::posix_time::time_duration time_interval = irp6ot->reply.getTimestamp() - irp6p->reply.getTimestamp();
 
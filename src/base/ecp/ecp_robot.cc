@@ -65,6 +65,8 @@ ecp_robot_base::ecp_robot_base(const lib::robot_name_t & _robot_name, int _numbe
 		data_ports_used(false)
 {
 	edp_section = _config.get_edp_section(robot_name);
+	pipelined_motion = !_config.exists(lib::PIPELINED_MOTION, edp_section)
+			|| _config.value <int>(lib::PIPELINED_MOTION, edp_section);
 	connect_to_edp(_config);
 }
 
@@ -80,6 +82,8 @@ ecp_robot_base::ecp_robot_base(const lib::robot_name_t & _robot_name, int _numbe
 		data_ports_used(false)
 {
 	edp_section = _ecp_object.config.get_edp_section(robot_name);
+	pipelined_motion = !_ecp_object.config.exists(lib::PIPELINED_MOTION, edp_section)
+			|| _ecp_object.config.value <int>(lib::PIPELINED_MOTION, edp_section);
 	connect_to_edp(_ecp_object.config);
 }
 
@@ -113,21 +117,12 @@ void ecp_robot_base::connect_to_edp(lib::configurator &config)
 	printf("connect_to_edp");
 	fflush(stdout);
 
-	unsigned int tmp = 0;
-
-	while ((EDP_fd = messip::port_connect(edp_net_attach_point)) == NULL)
-
-	{
-		if ((tmp++) < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-			printf(".");
-			fflush(stdout);
-		} else {
-			int e = errno; // kod bledu systemowego
-			fprintf(stderr, "Unable to locate EDP_MASTER process at channel \"%s\": %s\n", edp_net_attach_point.c_str(), strerror(e));
-			sr_ecp_msg.message(lib::SYSTEM_ERROR, e, ": Unable to locate EDP_MASTER process");
-			BOOST_THROW_EXCEPTION(exception::se_r());
-		}
+	// zarzadca messip powiadamia o utworzeniu kanalu przez EDP_MASTER
+	if ((EDP_fd = messip::port_connect_wait(edp_net_attach_point, lib::CONNECT_TIMEOUT)) == NULL) {
+		int e = errno; // kod bledu systemowego
+		fprintf(stderr, "Unable to locate EDP_MASTER process at channel \"%s\": %s\n", edp_net_attach_point.c_str(), strerror(e));
+		sr_ecp_msg.message(lib::SYSTEM_ERROR, e, ": Unable to locate EDP_MASTER process");
+		BOOST_THROW_EXCEPTION(exception::se_r());
 	}
 	printf(".done\n");
 }
@@ -132,6 +132,14 @@ public:
 	 */
 	lib::fd_client_t EDP_fd;
 
+	/**
+	 * @brief single round trip motion step flag
+	 *
+	 * if the flag is set (default) the EDP replies to SET, GET and SET_GET with the result of the instruction\n
+	 * so no separate QUERY is sent in execute_motion; it can be disabled with pipelined_motion=0 in EDP section
+	 */
+	bool pipelined_motion;
+
 	/**
 	 * @brief states if any data_port is set
 	 */
@@ -359,7 +367,17 @@ public:
 	 */
 	void execute_motion(void)
 	{
+		ecp_command.query_in_reply = pipelined_motion;
 		send();
+		ecp_command.query_in_reply = false;
+
+		// EDP has already executed the instruction and sent its result
+		if (reply_package.query_in_reply) {
+			if (reply_package.reply_type == lib::ERROR) {
+				BOOST_THROW_EXCEPTION(exception::nfe_r() << lib::exception::mrrocpp_error0(EDP_ERROR));
+			}
+			return;
+		}
 
 		if (reply_package.reply_type == lib::ERROR) {
 			query();
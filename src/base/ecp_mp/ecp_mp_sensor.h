@@ -170,17 +170,11 @@ sensor <SENSOR_IMAGE, CONFIGURE_DATA>::sensor(lib::sensor::SENSOR_t _sensor_name
 		BOOST_THROW_EXCEPTION(lib::exception::se_sensor() << lib::exception::mrrocpp_error0(CANNOT_SPAWN_VSP));
 	}
 
-	short tmp = 0;
-	// Kilka sekund  (~2) na otworzenie urzadzenia.
-	while ((sd = messip::port_connect(VSP_NAME)) == NULL) {
-		// 		cout<<tmp<<endl;
-		if ((tmp++) < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-		} else {
-			std::cerr << "ecp_mp_sensor: messip::port_connect(" << VSP_NAME << ") failed" << std::endl;
-			BOOST_THROW_EXCEPTION(lib::exception::se_sensor() << lib::exception::mrrocpp_error0(CANNOT_LOCATE_DEVICE));
-		}
-	} // end: while
+	// Oczekiwanie na utworzenie kanalu przez VSP (powiadomienie od zarzadcy messip).
+	if ((sd = messip::port_connect_wait(VSP_NAME, lib::CONNECT_TIMEOUT)) == NULL) {
+		std::cerr << "ecp_mp_sensor: messip::port_connect_wait(" << VSP_NAME << ") failed" << std::endl;
+		BOOST_THROW_EXCEPTION(lib::exception::se_sensor() << lib::exception::mrrocpp_error0(CANNOT_LOCATE_DEVICE));
+	}
 
 }
 
@@ -46,21 +46,15 @@ task::task(lib::configurator &_config) :
 {
 	const std::string ui_net_attach_point = config.get_ui_attach_point();
 
-	// kilka sekund  (~1) na otworzenie urzadzenia
-	unsigned int tmp = 0;
-
-	while ((UI_fd = messip::port_connect(ui_net_attach_point)) == NULL) {
-		if ((tmp++) < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-		} else {
-			int e = errno;
-			perror("Connect to UI failed");
-			// WARNING: sr_ecp_msg is not yet initialized!;
-			// it will be created in ecp_task/mp_task constructors
-
-			// sr_ecp_msg->message (lib::SYSTEM_ERROR, e, "Connect to UI failed");
-			BOOST_THROW_EXCEPTION(exception::se() << lib::exception::mrrocpp_error0(e));
-		}
+	// oczekiwanie na kanal UI, zarzadca messip powiadamia o jego utworzeniu
+	if ((UI_fd = messip::port_connect_wait(ui_net_attach_point, lib::CONNECT_TIMEOUT)) == NULL) {
+		int e = errno;
+		perror("Connect to UI failed");
+		// WARNING: sr_ecp_msg is not yet initialized!;
+		// it will be created in ecp_task/mp_task constructors
+
+		// sr_ecp_msg->message (lib::SYSTEM_ERROR, e, "Connect to UI failed");
+		BOOST_THROW_EXCEPTION(exception::se() << lib::exception::mrrocpp_error0(e));
 	}
 }
 
@@ -74,10 +74,8 @@ bool manip_effector::compute_servo_joints_and_frame(void)
 		lib::Xyz_Euler_Zyz_vector servo_desired_kartez_pos; // by Y polozenie we wspolrzednych xyz_euler_zyz obliczane co krok servo   XXXXX
 		local_matrix.get_xyz_euler_zyz(servo_desired_kartez_pos);
 
-		// scope-locked reader data update
+		// reader data update (servo thread)
 		{
-			boost::mutex::scoped_lock lock(rb_obj->reader_mutex);
-
 			servo_real_kartez_pos.to_table(rb_obj->step_data.real_cartesian_position);
 			servo_desired_kartez_pos.to_table(rb_obj->step_data.desired_cartesian_position);
 		}
@@ -668,6 +666,20 @@ void manip_effector::compute_frame(const lib::c_buffer &instruction)
 }
 /*--------------------------------------------------------------------------*/
 
+/*--------------------------------------------------------------------------*/
+void manip_effector::compute_otg_target(const lib::c_buffer &instruction)
+{
+	switch (instruction.set_arm_type)
+	{
+		case lib::FRAME:
+			compute_frame(instruction);
+			break;
+		default:
+			motor_driven_effector::compute_otg_target(instruction);
+	}
+}
+/*--------------------------------------------------------------------------*/
+
 /*--------------------------------------------------------------------------*/
 
 lib::Homog_matrix manip_effector::return_current_frame(TRANSLATION_ENUM translation_mode)
@@ -719,6 +731,11 @@ void manip_effector::single_thread_move_arm(const lib::c_buffer &instruction)
 // Wypenienie struktury danych transformera na podstawie parametrow polecenia
 // otrzymanego z ECP. Zlecenie transformerowi przeliczenie wspolrzednych
 
+	if (instruction.interpolation_type == lib::OTG) {
+		move_arm_otg(instruction);
+		return;
+	}
+
 	switch (instruction.set_arm_type)
 	{
 		case lib::FRAME:
@@ -756,6 +773,9 @@ void manip_effector::multi_thread_move_arm(const lib::c_buffer &instruction)
 		case lib::TCIM:
 			pose_force_torque_at_frame_move(instruction);
 
+			break;
+		case lib::OTG:
+			motor_driven_effector::multi_thread_move_arm(instruction);
 			break;
 		default:
 			break;
@@ -39,6 +39,11 @@ protected:
 	 */
 	virtual void compute_frame(const lib::c_buffer &instruction);
 
+	/*!
+	 * \brief method to compute the target of the motion generated in the servo, including the FRAME target.
+	 */
+	void compute_otg_target(const lib::c_buffer &instruction);
+
 	/*!
 	 * \brief the matrix of the end effector frame without tool for the servo buffer (pose of the WRIST).
 	 *
@@ -118,6 +118,11 @@ void motor_driven_effector::single_thread_move_arm(const lib::c_buffer &instruct
 // Wypenienie struktury danych transformera na podstawie parametrow polecenia
 // otrzymanego z ECP. Zlecenie transformerowi przeliczenie wspolrzednych
 
+	if (instruction.interpolation_type == lib::OTG) {
+		move_arm_otg(instruction);
+		return;
+	}
+
 	switch (instruction.set_arm_type)
 	{
 		case lib::MOTOR:
@@ -140,6 +145,12 @@ void motor_driven_effector::multi_thread_move_arm(const lib::c_buffer &instructi
 // Wypenienie struktury danych transformera na podstawie parametrow polecenia
 // otrzymanego z ECP. Zlecenie transformerowi przeliczenie wspolrzednych
 
+	if (instruction.interpolation_type == lib::OTG) {
+		move_arm_otg(instruction);
+		mt_tt_obj->trans_t_to_master_synchroniser.command();
+		return;
+	}
+
 	switch (instruction.set_arm_type)
 	{
 		case lib::MOTOR:
@@ -206,7 +217,8 @@ motor_driven_effector::motor_driven_effector(shell &_shell, const lib::robot_nam
 		number_of_servos(-1),
 		instruction(c_buffer_ref),
 		reply(r_buffer_ref),
-		move_arm_second_phase(false)
+		move_arm_second_phase(false),
+		reply_pending(false)
 {
 	controller_state_edp_buf.is_synchronised = false;
 	controller_state_edp_buf.is_power_on = true;
@@ -236,6 +248,22 @@ motor_driven_effector::motor_driven_effector(shell &_shell, const lib::robot_nam
 
 }
 
+void motor_driven_effector::enable_hardware_simulation()
+{
+	if (!config.exists_and_true(lib::HARDWARE_SIMULATION)) {
+		return;
+	}
+
+	// symulowane silniki obslugiwane sa jak sprzet
+	hardware_simulation = true;
+	robot_test_mode = false;
+
+	const double speed = config.exists(lib::SIMULATION_SPEED) ? config.value <double>(lib::SIMULATION_SPEED) : 1.0;
+	sim_clock = (boost::shared_ptr <lib::simulation_clock>) new lib::simulation_clock(speed);
+
+	msg->message("Hardware simulation activated");
+}
+
 motor_driven_effector::~motor_driven_effector()
 {
 }
@@ -293,10 +321,8 @@ bool motor_driven_effector::compute_servo_joints_and_frame(void)
 			get_current_kinematic_model()->mp2i_transform(servo_current_motor_pos, servo_current_joints);
 		}
 
-		// scope-locked reader data update
+		// reader data update (servo thread)
 		{
-			boost::mutex::scoped_lock lock(rb_obj->reader_mutex);
-
 			for (int j = 0; j < number_of_servos; j++) {
 				rb_obj->step_data.current_joints[j] = servo_current_joints[j];
 			}
@@ -739,12 +765,17 @@ void motor_driven_effector::compute_joints(const lib::c_buffer &instruction)
 	get_current_kinematic_model()->i2mp_transform(desired_motor_pos_new_tmp, desired_joints_tmp);
 
 	// kinematyka nie stwierdzila bledow, przepisanie wartosci
+	reader_joints_data joints_data = reader_joints_data();
+
 	for (int i = 0; i < number_of_servos; i++) {
 		desired_joints[i] = desired_joints_tmp[i];
-		rb_obj->step_data.desired_joints[i] = desired_joints[i]; //zapis struktury readera
+		joints_data.desired_joints[i] = desired_joints[i];
 		desired_motor_pos_new[i] = desired_motor_pos_new_tmp[i];
 	}
 
+	// zapis struktury readera, wlaczany do rekordu przez watek servo
+	rb_obj->desired_joints_slot.publish(joints_data);
+
 }
 
 void motor_driven_effector::move_servos()
@@ -776,6 +807,77 @@ void motor_driven_effector::move_servos()
 	sb->send_to_SERVO_GROUP();
 }
 
+void motor_driven_effector::compute_otg_target(const lib::c_buffer &instruction)
+{
+	switch (instruction.set_arm_type)
+	{
+		case lib::MOTOR:
+			compute_motors(instruction);
+			break;
+		case lib::JOINT:
+			compute_joints(instruction);
+			break;
+		default: // blad: niezdefiniowany sposb specyfikacji pozycji koncowki
+			BOOST_THROW_EXCEPTION(nfe_2() << mrrocpp_error0(INVALID_SET_END_EFFECTOR_TYPE));
+			break;
+	}
+}
+
+void motor_driven_effector::move_arm_otg(const lib::c_buffer &instruction)
+{
+	// pozycja docelowa liczona jak dla makrokroku zlozonego z jednego kroku
+	lib::c_buffer target_instruction(instruction);
+	target_instruction.motion_steps = 1;
+	target_instruction.value_in_step_no = 1;
+
+	compute_otg_target(target_instruction);
+
+	// przeliczenie ograniczen na walach silnikow: lokalne przelozenie kazdej osi w punkcie docelowym
+	double scale[lib::MAX_SERVOS_NR];
+	if (instruction.set_arm_type == lib::MOTOR) {
+		for (int i = 0; i < number_of_servos; i++) {
+			scale[i] = 1.0;
+		}
+	} else {
+		const double delta = 1e-4;
+		lib::MotorArray shifted_motors(number_of_servos);
+		lib::JointArray shifted_joints(number_of_servos);
+		for (int i = 0; i < number_of_servos; i++) {
+			double direction = 1.0;
+			for (int j = 0; j < number_of_servos; j++) {
+				shifted_joints[j] = desired_joints[j];
+			}
+			shifted_joints[i] += delta;
+			try {
+				get_current_kinematic_model()->i2mp_transform(shifted_motors, shifted_joints);
+			} catch (...) {
+				// poza zakresem ruchu - przyrost w druga strone
+				direction = -1.0;
+				shifted_joints[i] = desired_joints[i] - delta;
+				get_current_kinematic_model()->i2mp_transform(shifted_motors, shifted_joints);
+			}
+			scale[i] = fabs(direction * (shifted_motors[i] - desired_motor_pos_new[i]) / delta);
+		}
+	}
+
+	sb->servo_command.instruction_code = MOVE_OTG;
+
+	for (int i = 0; i < number_of_servos; i++) {
+		sb->servo_command.parameters.otg.start_position[i] = desired_motor_pos_old[i];
+		sb->servo_command.parameters.otg.target_position[i] = desired_motor_pos_new[i];
+		sb->servo_command.parameters.otg.target_velocity[i] = instruction.otg.target_velocity[i] * scale[i];
+		sb->servo_command.parameters.otg.max_velocity[i] = instruction.otg.max_velocity[i] * scale[i];
+		sb->servo_command.parameters.otg.max_acceleration[i] = instruction.otg.max_acceleration[i] * scale[i];
+		sb->servo_command.parameters.otg.max_jerk[i] = instruction.otg.max_jerk[i] * scale[i];
+
+		// cel ruchu staje sie stara wartoscia zadana
+		desired_motor_pos_old[i] = desired_motor_pos_new[i];
+	}
+
+	/* Wyslanie celu ruchu do procesu SERVO_GROUP, odpowiedz po pierwszym kroku ruchu */
+	sb->send_to_SERVO_GROUP();
+}
+
 void motor_driven_effector::update_servo_current_motor_pos(double motor_position_increment, size_t i)
 {
 	servo_current_motor_pos[i] += motor_position_increment;
@@ -1210,7 +1312,12 @@ void motor_driven_effector::post_synchro_loop(STATE& next_state)
 							// potwierdzenie przyjecia polecenia (dla ECP)
 							// printf("SET_GET\n");
 							reply.reply_type = lib::ACKNOWLEDGE;
-							variant_reply_to_instruction();
+							if (instruction.query_in_reply) {
+								// ECP waits for the result, reply after the execution
+								reply_pending = true;
+							} else {
+								variant_reply_to_instruction();
+							}
 							break;
 						case lib::SYNCHRO: // blad: robot jest juz zsynchronizowany
 							// okreslenie numeru bledu
@@ -1236,7 +1343,13 @@ void motor_driven_effector::post_synchro_loop(STATE& next_state)
 				case EXECUTE_INSTRUCTION:
 					// wykonanie instrukcji - wszelkie bledy powoduja zgloszenie wyjtku NonFatal_error_2 lub Fatal_error
 					interpret_instruction(instruction);
-					next_state = WAIT;
+					if (reply_pending) {
+						// the result goes with the reply, no QUERY follows
+						reply_with_result();
+						next_state = GET_INSTRUCTION;
+					} else {
+						next_state = WAIT;
+					}
 					break;
 				case WAIT:
 					if (receive_instruction() == lib::QUERY) { // instrukcja wlasciwa =>
@@ -1266,7 +1379,11 @@ void motor_driven_effector::post_synchro_loop(STATE& next_state)
 			establish_error(reply, error0, OK);
 			// printf("catch NonFatal_error_1\n");
 			// informacja dla ECP o bledzie
-			variant_reply_to_instruction();
+			if (reply_pending) {
+				reply_with_result();
+			} else {
+				variant_reply_to_instruction();
+			}
 			msg->message(lib::NON_FATAL_ERROR, error0);
 			// powrot do stanu: GET_INSTRUCTION
 			next_state = GET_INSTRUCTION;
@@ -1286,8 +1403,14 @@ void motor_driven_effector::post_synchro_loop(STATE& next_state)
 
 			establish_error(reply, error0, OK);
 			msg->message(lib::NON_FATAL_ERROR, error0);
-			// powrot do stanu: WAIT
-			next_state = WAIT;
+			if (reply_pending) {
+				// the error goes with the reply, no QUERY follows
+				reply_with_result();
+				next_state = GET_INSTRUCTION;
+			} else {
+				// powrot do stanu: WAIT
+				next_state = WAIT;
+			}
 		} // end: catch(transformer::NonFatal_error_2 nfe)
 
 		catch (exception::nfe_3 & error) {
@@ -1339,8 +1462,14 @@ void motor_driven_effector::post_synchro_loop(STATE& next_state)
 
 			establish_error(reply, error0, error1);
 			msg->message(lib::FATAL_ERROR, error0, error1);
-			// Powrot do stanu: WAIT
-			next_state = WAIT;
+			if (reply_pending) {
+				// the error goes with the reply, no QUERY follows
+				reply_with_result();
+				next_state = GET_INSTRUCTION;
+			} else {
+				// Powrot do stanu: WAIT
+				next_state = WAIT;
+			}
 		} // end: catch(transformer::Fatal_error fe)
 
 	} // end: for (;;)
@@ -1367,6 +1496,15 @@ void motor_driven_effector::variant_reply_to_instruction()
 	reply_to_instruction(reply);
 }
 
+void motor_driven_effector::reply_with_result()
+{
+	reply_pending = false;
+
+	reply.query_in_reply = true;
+	variant_reply_to_instruction();
+	reply.query_in_reply = false;
+}
+
 void motor_driven_effector::registerReaderStartedCallback(boost::function <void()> startedCallback)
 {
 	startedCallback_ = startedCallback;
@@ -16,6 +16,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "base/lib/condition_synchroniser.h"
+#include "base/lib/simulation_clock.h"
 #include "base/kinematics/kinematics_manager.h"
 #include "base/edp/in_out.h"
 #include "base/edp/edp_effector.h"
@@ -127,6 +128,21 @@ protected:
 	 */
 	void move_servos();
 
+	/*!
+	 * \brief method to compute desired_motor_position of the target of the motion generated in the servo (OTG interpolation).
+	 *
+	 * It handles MOTOR and JOINT targets; manipulators extend it with the FRAME target.
+	 */
+	virtual void compute_otg_target(const lib::c_buffer &instruction);
+
+	/*!
+	 * \brief method to command the motion generated online in the servo loop (OTG interpolation).
+	 *
+	 * The servo computes a jerk limited trajectory to the target every servo step;
+	 * a new target preempts the motion in progress.
+	 */
+	void move_arm_otg(const lib::c_buffer &instruction);
+
 	/*!
 	 * \brief motor position  currently computed in the servo
 	 *
@@ -253,6 +269,13 @@ public:
 	 */
 	boost::shared_ptr <sensor::force> vs;
 
+	/*!
+	 * \brief virtual time base of the simulated hardware
+	 *
+	 * It is created only in the hardware simulation, it is advanced by the servo thread and paces the other threads.
+	 */
+	boost::shared_ptr <lib::simulation_clock> sim_clock;
+
 	/*!
 	 * \brief class constructor
 	 *
@@ -267,6 +290,13 @@ public:
 	 */
 	virtual ~motor_driven_effector();
 
+	/*!
+	 * \brief turns the hardware simulation on, if requested in the configuration
+	 *
+	 * Called in the constructors of the effectors whose servo buffer can create the simulated hardware interface.
+	 */
+	void enable_hardware_simulation();
+
 	/*!
 	 * \brief method to set the robot model commanded by ECP
 	 *
@@ -501,6 +531,13 @@ public:
 	 */
 	virtual void variant_reply_to_instruction();
 
+	/*!
+	 * \brief method to reply to ecp with the result of the executed instruction
+	 *
+	 * It is used when the ECP asked for the result in the reply (lib::c_buffer::query_in_reply) instead of a separate QUERY
+	 */
+	void reply_with_result();
+
 	/*!
 	 * \brief Reference to base types of instruction
 	 *
@@ -518,6 +555,13 @@ public:
 	// for the force variant of move arm and transformation thread error handling
 	bool move_arm_second_phase;
 
+	/*!
+	 * \brief the ECP waits for the result of the instruction being executed
+	 *
+	 * Set when the instruction was received with query_in_reply flag, so no acknowledge has been sent yet
+	 */
+	bool reply_pending;
+
 	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
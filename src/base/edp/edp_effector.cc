@@ -23,14 +23,18 @@ effector::effector(shell &_shell, const lib::robot_name_t & l_robot_name) :
 	robot_name(l_robot_name),
 	config(_shell.config),
 	msg(_shell.msg),
-	robot_test_mode(true)
+	robot_test_mode(true),
+	hardware_simulation(false)
 {
 
 	if (config.exists(lib::ROBOT_TEST_MODE)) {
 		robot_test_mode = config.exists_and_true(lib::ROBOT_TEST_MODE);
 	}
 
-	if (robot_test_mode) {
+	if (config.exists_and_true(lib::HARDWARE_SIMULATION)) {
+		// do czasu wlaczenia symulacji przez efektor, ktory ja obsluguje, sprzet nie jest otwierany
+		robot_test_mode = true;
+	} else if (robot_test_mode) {
 		msg->message("Robot test mode activated");
 	}
 
@@ -57,8 +61,14 @@ void effector::initialize_communication()
 		throw std::runtime_error("communication error");
 	}
 
+	// symulacja zazadana w konfiguracji, ale nie wlaczona przez efektor
+	if (!hardware_simulation && config.exists_and_true(lib::HARDWARE_SIMULATION)) {
+		msg->message(lib::FATAL_ERROR, "hardware simulation not supported by this robot");
+		throw std::runtime_error("hardware simulation not supported by robot " + robot_name);
+	}
+
 	/* Ustawienie priorytetu procesu */
-	if(!robot_test_mode) {
+	if(!robot_test_mode && !hardware_simulation) {
 		lib::set_thread_priority(lib::PTHREAD_MAX_PRIORITY - 2);
 	}
 
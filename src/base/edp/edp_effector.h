@@ -181,6 +181,14 @@ public:
 	 */
 	bool robot_test_mode;
 
+	/*!
+	 * \brief Info if the hardware is replaced by the simulated motors.
+	 *
+	 * It is set only by the effectors driven by the simulated hardware interface,
+	 * then it turns the robot test mode off; other effectors reject the configuration key.
+	 */
+	bool hardware_simulation;
+
 	/*!
 	 * \brief Method to initiate communication.
 	 *
@@ -17,7 +17,7 @@ void force::operator()()
 {
 	//	sr_msg->message("operator");
 
-	if(!master.robot_test_mode) {
+	if(!master.robot_test_mode && !master.hardware_simulation) {
 		lib::set_thread_priority(lib::PTHREAD_MAX_PRIORITY - 1);
 	}
 
@@ -106,12 +106,13 @@ void force::operator()()
 				lib::Ft_vector current_force_torque(ft_tr_inv_tool_matrix * ft_tr_inv_current_frame_matrix
 						* current_force);
 
-				// scope-locked reader data update
+				// reader data update, merged into the record by the servo thread
 				{
 					if (master.rb_obj) {
-						boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
+						edp::common::reader_force_data force_data;
 
-						current_force_torque.to_table(master.rb_obj->step_data.force);
+						current_force_torque.to_table(force_data.force);
+						master.rb_obj->force_slot.publish(force_data);
 					} else {
 						std::cerr << " " << std::endl;
 					}
@@ -152,7 +153,7 @@ void force::operator()()
 
 force::force(common::manip_effector &_master) :
 		force_sensor_test_mode(true), is_reading_ready(false), //!< nie ma zadnego gotowego odczytu
-		is_right_turn_frame(true), gravity_transformation(NULL), master(_master), TERMINATE(false), is_sensor_configured(false), new_edp_command(false), cb(FORCE_BUFFER_LENGHT) //!< czujnik niezainicjowany
+		is_right_turn_frame(true), gravity_transformation(NULL), master(_master), TERMINATE(false), is_sensor_configured(false), new_edp_command(false) //!< czujnik niezainicjowany
 {
 	/*! Lokalizacja procesu wywietlania komunikatow SR */
 
@@ -177,23 +178,16 @@ force::force(common::manip_effector &_master) :
 		ft_table[i] = 0.0;
 	}
 
-	clear_cb();
+	filter.reset(create_force_filter(master.config, 1.0e9 / COMMCYCLE_TIME_NS));
+
+	clear_filter();
 
 }
 
-void force::clear_cb()
+void force::clear_filter()
 {
-
-	lib::Ft_vector zero_force;
-	for (int i = 0; i < 6; ++i) {
-		zero_force[i] = 0.0;
-	}
-	cb.clear();
-
-	for (int i = 0; i < FORCE_BUFFER_LENGHT; i++) {
-		cb.push_back(zero_force);
-	}
-
+	// filtr startuje od zerowej sily
+	filter->reset(lib::Ft_vector());
 }
 
 void force::wait_for_event()
@@ -202,6 +196,9 @@ void force::wait_for_event()
 
 		wait_for_particular_event();
 
+	} else if (master.sim_clock) {
+		// odczyty testowe w takt czasu wirtualnego symulowanego sprzetu
+		master.sim_clock->sleep(1000000);
 	} else {
 		usleep(1000);
 	}
@@ -249,24 +246,8 @@ void force::get_reading(void)
 
 				//		lib::Ft_vector force_in_base_orientation(lib::Ft_tr(current_orientation) * base_force);
 
-				//		cb.push_back(force_in_base_orientation);
-				cb.push_back(base_force);
-
-				lib::Ft_vector output_in_base;
-
-				for (int j = 0; j < 6; j++) {
-					output_in_base[j] = 0.0;
-				}
-
-				// usredniamy za FORCE_BUFFER_LENGHT pomiarow
-
-				for (int i = 0; i < FORCE_BUFFER_LENGHT; i++) {
-
-					for (int j = 0; j < 6; j++) {
-						output_in_base[j] += (cb[i][j]) / (double) FORCE_BUFFER_LENGHT;
-					}
-
-				}
+				//		lib::Ft_vector output_in_base(filter->filter(force_in_base_orientation));
+				lib::Ft_vector output_in_base(filter->filter(base_force));
 
 				//sila zwracamy w biezacej oritntacji
 
@@ -304,7 +285,7 @@ void force::configure_sensor(void)
 		configure_particular_sensor();
 	}
 
-	clear_cb();
+	clear_filter();
 
 	// polozenie kisci bez narzedzia wzgledem bazy
 	lib::Homog_matrix frame = master.return_current_frame(common::WITH_TRANSLATION); // FORCE Transformation by Slawomir Bazant
@@ -11,12 +11,13 @@
 #include <boost/utility.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/shared_ptr.hpp>
-#include <boost/circular_buffer.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <Eigen/Core>
 
 #include "base/lib/mrmath/ForceTrans.h"
 #include "base/lib/sensor_interface.h"				// klasa bazowa sensor
 #include "base/edp/edp_typedefs.h"				// klasa bazowa sensor
+#include "base/edp/force_filter.h"
 #include "base/lib/condition_synchroniser.h"
 #include "base/lib/sr/sr_vsp.h"
 
@@ -107,9 +108,10 @@ protected:
 
 	struct timespec wake_time;
 
-	static const int FORCE_BUFFER_LENGHT = 2;
+	//! filtr odczytow, wybierany w konfiguracji
+	boost::scoped_ptr <force_filter> filter;
 
-	void clear_cb();
+	void clear_filter();
 
 public:
 	void operator()();
@@ -140,7 +142,6 @@ public:
 
 	bool new_edp_command;
 
-	boost::circular_buffer <lib::Ft_vector> cb;
 	force(common::manip_effector &_master);
 
 	virtual ~force();
@@ -0,0 +1,210 @@
+// -------------------------------------------------------------------------
+//                                   force_filter.cc
+//
+// Filtry odczytow czujnika sily w EDP
+// -------------------------------------------------------------------------
+
+#include <cmath>
+#include <string>
+#include <stdexcept>
+
+#include "base/lib/configurator.h"
+#include "base/edp/force_filter.h"
+
+namespace mrrocpp {
+namespace edp {
+namespace sensor {
+
+void pass_through_filter::reset(const lib::Ft_vector & initial)
+{
+}
+
+lib::Ft_vector pass_through_filter::filter(const lib::Ft_vector & sample)
+{
+	return sample;
+}
+
+moving_average_filter::moving_average_filter(unsigned int _window) :
+	window((_window > 0) ? _window : 1), history(6 * window), oldest(0)
+{
+	reset(lib::Ft_vector());
+}
+
+void moving_average_filter::reset(const lib::Ft_vector & initial)
+{
+	for (unsigned int i = 0; i < window; ++i) {
+		Eigen::Map <axes_t> slot(&history[6 * i]);
+		slot = initial;
+	}
+	sum = initial * (double) window;
+	oldest = 0;
+}
+
+lib::Ft_vector moving_average_filter::filter(const lib::Ft_vector & sample)
+{
+	Eigen::Map <axes_t> slot(&history[6 * oldest]);
+
+	// the oldest reading leaves the window, the new one takes its place
+	sum -= slot;
+	sum += sample;
+	slot = sample;
+
+	if (++oldest == window) {
+		oldest = 0;
+	}
+
+	return lib::Ft_vector(sum * (1.0 / window));
+}
+
+butterworth_filter::butterworth_filter(unsigned int order, double cutoff, double sample_rate)
+{
+	if (cutoff <= 0.0 || cutoff >= sample_rate / 2) {
+		throw std::runtime_error("butterworth_filter: cutoff frequency out of the (0, sample_rate/2) range");
+	}
+
+	const unsigned int sections_number = (order > 1) ? (order + 1) / 2 : 1;
+	const unsigned int even_order = 2 * sections_number;
+
+	// bilinear transform with the cutoff frequency prewarping
+	const double K = tan(M_PI * cutoff / sample_rate);
+
+	for (unsigned int k = 0; k < sections_number; ++k) {
+		// quality factor of the k-th pair of the Butterworth poles
+		const double Q = 1.0 / (2.0 * cos(M_PI * (2 * k + 1) / (2.0 * even_order)));
+
+		const double norm = 1.0 / (1.0 + K / Q + K * K);
+
+		biquad * s = new biquad;
+		s->b0 = K * K * norm;
+		s->b1 = 2.0 * s->b0;
+		s->b2 = s->b0;
+		s->a1 = 2.0 * (K * K - 1.0) * norm;
+		s->a2 = (1.0 - K / Q + K * K) * norm;
+
+		sections.push_back(s);
+	}
+
+	reset(lib::Ft_vector());
+}
+
+butterworth_filter::~butterworth_filter()
+{
+	for (std::vector <biquad *>::iterator it = sections.begin(); it != sections.end(); ++it) {
+		delete *it;
+	}
+}
+
+void butterworth_filter::reset(const lib::Ft_vector & initial)
+{
+	// steady state for the constant input, the gain of each section is 1
+	for (std::vector <biquad *>::iterator it = sections.begin(); it != sections.end(); ++it) {
+		biquad & s = **it;
+		s.z1 = initial * (1.0 - s.b0);
+		s.z2 = initial * (s.b2 - s.a2);
+	}
+}
+
+lib::Ft_vector butterworth_filter::filter(const lib::Ft_vector & sample)
+{
+	axes_t x = sample;
+
+	for (std::vector <biquad *>::iterator it = sections.begin(); it != sections.end(); ++it) {
+		biquad & s = **it;
+
+		const axes_t y = s.b0 * x + s.z1;
+		s.z1 = s.b1 * x - s.a1 * y + s.z2;
+		s.z2 = s.b2 * x - s.a2 * y;
+
+		x = y;
+	}
+
+	return lib::Ft_vector(x);
+}
+
+median_filter::median_filter(unsigned int _window) :
+	window((_window > 0) ? _window : 1), history(6 * window), sorted(6 * window), oldest(0)
+{
+	reset(lib::Ft_vector());
+}
+
+void median_filter::reset(const lib::Ft_vector & initial)
+{
+	for (unsigned int i = 0; i < window; ++i) {
+		for (unsigned int j = 0; j < 6; ++j) {
+			history[6 * i + j] = initial[j];
+			sorted[window * j + i] = initial[j];
+		}
+	}
+	oldest = 0;
+}
+
+lib::Ft_vector median_filter::filter(const lib::Ft_vector & sample)
+{
+	lib::Ft_vector output;
+
+	for (unsigned int j = 0; j < 6; ++j) {
+		double * axis = &sorted[window * j];
+		const double outgoing = history[6 * oldest + j];
+		double incoming = sample[j];
+
+		// a non-finite reading would break the ordering, the newest valid one is repeated instead
+		if (!std::isfinite(incoming)) {
+			incoming = history[6 * ((oldest + window - 1) % window) + j];
+		}
+
+		history[6 * oldest + j] = incoming;
+
+		// replace the outgoing value with the incoming one and restore the order
+		unsigned int i = 0;
+		while (i + 1 < window && axis[i] != outgoing) {
+			++i;
+		}
+		while (i > 0 && axis[i - 1] > incoming) {
+			axis[i] = axis[i - 1];
+			--i;
+		}
+		while (i + 1 < window && axis[i + 1] < incoming) {
+			axis[i] = axis[i + 1];
+			++i;
+		}
+		axis[i] = incoming;
+
+		output[j] = (window % 2) ? axis[window / 2] : 0.5 * (axis[window / 2 - 1] + axis[window / 2]);
+	}
+
+	if (++oldest == window) {
+		oldest = 0;
+	}
+
+	return output;
+}
+
+force_filter * create_force_filter(const lib::configurator & config, double default_sample_rate)
+{
+	const std::string type = config.exists("force_filter") ? config.value <std::string>("force_filter") : "average";
+
+	// dotychczasowe zachowanie: srednia z dwoch ostatnich pomiarow
+	const unsigned int window =
+			config.exists("force_filter_window") ? config.value <unsigned int>("force_filter_window") : 2;
+
+	if (type == "average") {
+		return new moving_average_filter(window);
+	} else if (type == "median") {
+		return new median_filter(window);
+	} else if (type == "butterworth") {
+		const unsigned int order =
+				config.exists("force_filter_order") ? config.value <unsigned int>("force_filter_order") : 2;
+		const double sample_rate =
+				config.exists("force_filter_sample_rate") ? config.value <double>("force_filter_sample_rate") : default_sample_rate;
+
+		return new butterworth_filter(order, config.value <double>("force_filter_cutoff"), sample_rate);
+	} else if (type == "none") {
+		return new pass_through_filter;
+	}
+
+	throw std::runtime_error("unknown force_filter type: " + type);
+}
+
+} // namespace sensor
+} // namespace edp
+} // namespace mrrocpp
@@ -0,0 +1,179 @@
+// -------------------------------------------------------------------------
+//                                   force_filter.h
+//
+// Filtry odczytow czujnika sily w EDP
+// -------------------------------------------------------------------------
+
+#if !defined(_EDP_FORCE_FILTER_H)
+#define _EDP_FORCE_FILTER_H
+
+#include <vector>
+
+#include <boost/utility.hpp>
+#include <Eigen/Core>
+
+#include "base/lib/mrmath/mrmath.h"
+
+namespace mrrocpp {
+namespace lib {
+class configurator;
+}
+
+namespace edp {
+namespace sensor {
+
+/*!
+ * Streaming filter of the force/torque readings.
+ *
+ * Every call of filter() costs a constant time, independent of the history
+ * of the readings. All six axes are processed together with the Eigen vector
+ * operations.
+ */
+class force_filter : private boost::noncopyable
+{
+public:
+	//! Six axes processed together
+	typedef Eigen::Matrix <double, 6, 1> axes_t;
+
+	virtual ~force_filter()
+	{
+	}
+
+	/*!
+	 * Clear the filter history.
+	 * @param initial value assumed to be measured before, the output starts from it
+	 */
+	virtual void reset(const lib::Ft_vector & initial) = 0;
+
+	/*!
+	 * Process a single reading.
+	 * @param sample current reading
+	 * @return filtered value
+	 */
+	virtual lib::Ft_vector filter(const lib::Ft_vector & sample) = 0;
+};
+
+/*!
+ * No filtering.
+ */
+class pass_through_filter : public force_filter
+{
+public:
+	void reset(const lib::Ft_vector & initial);
+	lib::Ft_vector filter(const lib::Ft_vector & sample);
+};
+
+/*!
+ * Moving average of the last readings, computed with a running sum.
+ */
+class moving_average_filter : public force_filter
+{
+private:
+	//! Number of averaged readings
+	const unsigned int window;
+
+	//! Last readings, six values each
+	std::vector <double> history;
+
+	//! Position of the oldest reading in the history
+	unsigned int oldest;
+
+	//! Sum of the readings in the history
+	axes_t sum;
+
+public:
+	/*!
+	 * Constructor.
+	 * @param _window number of averaged readings
+	 */
+	moving_average_filter(unsigned int _window);
+
+	void reset(const lib::Ft_vector & initial);
+	lib::Ft_vector filter(const lib::Ft_vector & sample);
+
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/*!
+ * Low-pass Butterworth filter, realized as a cascade of second order sections
+ * (biquads) in the transposed direct form II.
+ */
+class butterworth_filter : public force_filter
+{
+private:
+	//! Coefficients and state of a single second order section
+	struct biquad
+	{
+		double b0, b1, b2, a1, a2;
+		axes_t z1, z2;
+
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
+	//! Sections of the cascade
+	std::vector <biquad *> sections;
+
+public:
+	/*!
+	 * Constructor.
+	 * @param order order of the filter, rounded up to an even number
+	 * @param cutoff cutoff frequency [Hz]
+	 * @param sample_rate frequency of the readings [Hz]
+	 */
+	butterworth_filter(unsigned int order, double cutoff, double sample_rate);
+
+	~butterworth_filter();
+
+	void reset(const lib::Ft_vector & initial);
+	lib::Ft_vector filter(const lib::Ft_vector & sample);
+};
+
+/*!
+ * Median of the last readings, rejects single spikes.
+ * Non-finite readings are replaced with the previous reading.
+ */
+class median_filter : public force_filter
+{
+private:
+	//! Number of readings the median is taken from
+	const unsigned int window;
+
+	//! Last readings in the order of arrival, six values each
+	std::vector <double> history;
+
+	//! Last readings of each axis in the ascending order, window values per axis
+	std::vector <double> sorted;
+
+	//! Position of the oldest reading in the history
+	unsigned int oldest;
+
+public:
+	/*!
+	 * Constructor.
+	 * @param _window number of readings the median is taken from
+	 */
+	median_filter(unsigned int _window);
+
+	void reset(const lib::Ft_vector & initial);
+	lib::Ft_vector filter(const lib::Ft_vector & sample);
+};
+
+/*!
+ * Create the filter selected in the configuration of the EDP.
+ *
+ * force_filter = average (default) | butterworth | median | none
+ * force_filter_window = number of readings for average and median (default 2)
+ * force_filter_order = order of the butterworth filter (default 2)
+ * force_filter_cutoff = cutoff frequency of the butterworth filter [Hz]
+ * force_filter_sample_rate = frequency of the readings [Hz]
+ *
+ * @param config configuration of the EDP
+ * @param default_sample_rate frequency of the readings of the sensor [Hz]
+ */
+force_filter * create_force_filter(const lib::configurator & config, double default_sample_rate);
+
+} // namespace sensor
+} // namespace edp
+} // namespace mrrocpp
+
+#endif
@@ -29,7 +29,7 @@ manip_trans_t::manip_trans_t(motor_driven_effector& _master) :
 
 void manip_trans_t::operator()()
 {
-	if(!master.robot_test_mode) {
+	if(!master.robot_test_mode && !master.hardware_simulation) {
 		lib::set_thread_priority(lib::PTHREAD_MAX_PRIORITY);
 	}
 
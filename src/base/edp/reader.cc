@@ -10,6 +10,7 @@
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <csignal>
 #include <cerrno>
 #include <sys/wait.h>
@@ -24,6 +25,7 @@
 #include <ctime>
 
 #include <boost/scoped_array.hpp>
+#include <boost/scoped_ptr.hpp>
 
 #include "base/lib/typedefs.h"
 #include "base/lib/impconst.h"
@@ -31,37 +33,67 @@
 #include "base/lib/mis_fun.h"
 #include "base/edp/edp_e_motor_driven.h"
 #include "base/edp/reader.h"
+#include "base/edp/reader_stream.h"
 
 namespace mrrocpp {
 namespace edp {
 namespace common {
 
-reader_config::reader_config() :
-	step(false), measure_time(false), servo_mode(false)
+//! okres odpytywania bufora pomiarow przez reader [ms]
+static const int READER_POLL_PERIOD_MS = 10;
+
+//! okres oczekiwania symulacji na miejsce w buforze pomiarow [us]
+static const int READER_SIMULATION_WAIT_US = 100;
+
+reader_ring::reader_ring() :
+	head(0), tail(0)
+{
+}
+
+bool reader_ring::push(const reader_data & data)
 {
-	for (std::size_t i = 0; i < lib::MAX_SERVOS_NR; ++i) {
-		desired_inc[i] = false;
-		current_inc[i] = false;
-		pwm[i] = false;
-		uchyb[i] = false;
-		abs_pos[i] = false;
-		current_joints[i] = false;
-                desired_joints[i] = false;
+	const uint32_t h = head;
+	const uint32_t next = (h + 1) & (SIZE - 1);
+
+	if (next == tail) {
+		return false;
 	}
 
-	for (int i = 0; i < 6; ++i) {
-		force[i] = false;
-		desired_force[i] = false;
-		filtered_force[i] = false;
-		desired_cartesian_position[i] = false;
-		real_cartesian_position[i] = false;
-		real_cartesian_vel[i] = false;
-		real_cartesian_acc[i] = false;
+	buf[h] = data;
+
+	// rekord musi byc kompletny zanim konsument zobaczy nowy head
+	__sync_synchronize();
+	head = next;
+
+	return true;
+}
+
+bool reader_ring::pop(reader_data & data)
+{
+	const uint32_t t = tail;
+
+	if (t == head) {
+		return false;
 	}
+
+	__sync_synchronize();
+	data = buf[t];
+
+	// zwolnienie miejsca dopiero po skopiowaniu rekordu
+	__sync_synchronize();
+	tail = (t + 1) & (SIZE - 1);
+
+	return true;
+}
+
+void reader_ring::flush()
+{
+	__sync_synchronize();
+	tail = head;
 }
 
 reader_buffer::reader_buffer(motor_driven_effector &_master) :
-	new_data(false), master(_master), write_csv(true)
+	master(_master), measuring(false), write_csv(true), write_stream(false)
 {
 	thread_id = boost::thread(boost::bind(&reader_buffer::operator(), this));
 }
@@ -73,6 +105,32 @@ reader_buffer::~reader_buffer()
 	//thread_id.join(); // join it
 }
 
+void reader_buffer::publish_step()
+{
+	reader_force_data force_data;
+
+	// jesli watek sily akurat zapisuje, zostaje poprzednia wartosc
+	if (force_slot.read(force_data)) {
+		std::memcpy(step_data.force, force_data.force, sizeof(step_data.force));
+	}
+
+	reader_joints_data joints_data;
+
+	if (desired_joints_slot.read(joints_data)) {
+		std::memcpy(step_data.desired_joints, joints_data.desired_joints, sizeof(step_data.desired_joints));
+	}
+
+	// przepelnienie oznacza utrate probki, wykrywana przez reader po numerze kroku
+	if (ring.push(step_data) || !master.sim_clock) {
+		return;
+	}
+
+	// symulacja szybsza niz czas rzeczywisty czeka na reader, aby zapis byl kompletny
+	while (measuring && !ring.push(step_data)) {
+		usleep(READER_SIMULATION_WAIT_US);
+	}
+}
+
 void reader_buffer::operator()()
 {
 	uint64_t nr_of_samples; // maksymalna liczba pomiarow
@@ -82,10 +140,7 @@ void reader_buffer::operator()()
 	bool ui_trigger = false; // specjalny puls z UI
 
 	int file_counter = 0;
-	time_t time_of_day;
-	char file_name[50];
-	char file_date[40];
-	char config_file_with_dir[80];
+	std::string config_file_with_dir;
 
 	// czytanie konfiguracji
 	std::string reader_meassures_dir;
@@ -103,6 +158,9 @@ void reader_buffer::operator()()
 	else
 		nr_of_samples = 1000;
 
+	// zapis strumieniowy do pliku binarnego w trakcie pomiarow zamiast bufora w pamieci
+	write_stream = master.config.check_config("reader_stream");
+
 	reader_cnf.step = 1;
 	reader_cnf.servo_mode = master.config.check_config("servo_tryb");
 	reader_cnf.measure_time = master.config.check_config("measure_time");
@@ -160,13 +218,19 @@ void reader_buffer::operator()()
 	}
 
 	// ustawienie priorytetu watku
-	if(!master.robot_test_mode) {
+	if(!master.robot_test_mode && !master.hardware_simulation) {
 		lib::set_thread_priority(lib::PTHREAD_MIN_PRIORITY);
 	}
 
 	// NOTE: reader buffer has to be allocated on heap (using "new" operator) due to huge size
 	// boost::scoped_array takes care of deallocating in case of exception
-	boost::circular_buffer <reader_data> reader_buf(nr_of_samples);
+	boost::circular_buffer <reader_data> reader_buf(write_stream ? 0 : nr_of_samples);
+
+	// bufor bloku zapisu strumieniowego rowniez na stercie
+	boost::scoped_ptr <reader_stream> stream;
+	if (write_stream) {
+		stream.reset(new reader_stream);
+	}
 
 	//	fprintf(stderr, "reader buffer size %lluKB\n", nr_of_samples*sizeof(reader_data)/1024);
 
@@ -186,7 +250,7 @@ void reader_buffer::operator()()
 	for (;;) {
 		// TODO: why, Leo? Why?
 		// ustawienie priorytetu watku
-		if(!master.robot_test_mode) {
+		if(!master.robot_test_mode && !master.hardware_simulation) {
 			lib::set_thread_priority(lib::PTHREAD_MIN_PRIORITY);
 		}
 
@@ -209,44 +273,64 @@ void reader_buffer::operator()()
 
 		master.msg->message("measures started");
 
+		if (write_stream) {
+			prepare_file_name(config_file_with_dir, reader_meassures_dir, robot_filename, ++file_counter, "bin");
+
+			if (!stream->open(config_file_with_dir, reader_cnf, master.number_of_servos)) {
+				std::cerr << "Cannot open file: " << config_file_with_dir << '\n';
+				master.msg->message("cannot open destination file");
+			}
+		}
+
 		// TODO: why, Leo? Why?
-		if(!master.robot_test_mode) {
+		// zapis strumieniowy blokuje na write(), wiec pozostaje przy najnizszym priorytecie;
+		// od watku servo oddziela go bufor ring, a utracone probki sa zliczane
+		if(!master.robot_test_mode && !master.hardware_simulation && !write_stream) {
 			lib::set_thread_priority(lib::PTHREAD_MAX_PRIORITY);
 		}
 
+		// odrzucenie probek zgromadzonych przed startem pomiarow
+		ring.flush();
+		measuring = true;
+
+		bool first_sample = true;
+		unsigned long last_step = 0;
+		uint64_t lost_samples = 0;
+
+		reader_data data;
+
 		// dopoki nie przyjdzie puls stopu
 		do {
-			//	master.msg->message("measure 1");
-			new_data = false;
-			// sekcja krytyczna odczytu danych pomiarowych dla biezacego kroku
-			{
-				boost::mutex::scoped_lock lock(reader_mutex);
-
-				while (!new_data) {
-					// czekamy na opuszcenie semafora przez watek EDP_SERVO (co mikrokrok)
-					cond.wait(lock);
+			// przepisanie danych zgromadzonych przez watek EDP_SERVO do bufora lokalnego reader
+			while (ring.pop(data)) {
+				if (!first_sample && data.step != last_step + 1) {
+					lost_samples += data.step - last_step - 1;
 				}
+				first_sample = false;
+				last_step = data.step;
 
-				step_data.ui_trigger = ui_trigger;
+				data.ui_trigger = ui_trigger;
+				ui_trigger = false;
 
-				// przepisanie danych dla biezacego kroku do bufora lokalnego reader
-				reader_buf.push_back(step_data);
+				if (write_stream) {
+					stream->append(data);
+				} else {
+					reader_buf.push_back(data);
+				}
 			}
 
-			//	master.msg->message("measure 2");
-
-			// warunkowy odbior pulsu (o ile przyszedl)
+			// odbior pulsu sterujacego, jednoczesnie okres odpytywania bufora
 			stop = false;
-			ui_trigger = false;
 
 			int32_t type, subtype;
-			int rcvid = messip::port_receive_pulse(my_attach, type, subtype, 0);
+			int rcvid = messip::port_receive_pulse(my_attach, type, subtype, READER_POLL_PERIOD_MS);
 
 			//std::cerr << "pulse received: " << rcvid << " " << type << " " << subtype << std::endl;
 
 			if (rcvid == MESSIP_MSG_NOREPLY) {
 				if (type == READER_STOP) {
 					stop = true;
+					measuring = false;
 					master.onReaderStopped();
 				} else if (type == READER_TRIGGER) {
 					ui_trigger = true;
@@ -255,24 +339,35 @@ void reader_buffer::operator()()
 
 		} while (!stop); // dopoki nie przyjdzie puls stopu
 
-		if(!master.robot_test_mode) {
+		if(!master.robot_test_mode && !master.hardware_simulation) {
 			lib::set_thread_priority(lib::PTHREAD_MIN_PRIORITY);// Najnizszy priorytet podczas proby zapisu do pliku
 		}
 		master.msg->message("measures stopped");
 
-		// przygotowanie nazwy pliku do ktorego beda zapisane pomiary
-		time_of_day = time(NULL);
-		strftime(file_date, 40, "%Y-%m-%d_%H-%M-%S", localtime(&time_of_day));
+		if (lost_samples) {
+			std::stringstream ss;
+			ss << "reader lost " << lost_samples << " samples";
+			master.msg->message(ss.str());
+		}
 
-		sprintf(file_name, "/%s_%s_pomiar-%d.csv", file_date, robot_filename.c_str(), ++file_counter);
-		strcpy(config_file_with_dir, reader_meassures_dir.c_str());
+		if (write_stream) {
+			if (stream->is_open()) {
+				if (!stream->close()) {
+					master.msg->message("file writing failed");
+				} else {
+					master.msg->message("file writing is finished");
+				}
+			}
+			continue;
+		}
 
-		strcat(config_file_with_dir, file_name);
+		// przygotowanie nazwy pliku do ktorego beda zapisane pomiary
+		prepare_file_name(config_file_with_dir, reader_meassures_dir, robot_filename, ++file_counter, "csv");
 
-		std::ofstream outfile(config_file_with_dir, std::ios::out);
+		std::ofstream outfile(config_file_with_dir.c_str(), std::ios::out);
 		if (!outfile.good()) // jesli plik nie instnieje
 		{
-			std::cerr << "Cannot open file: " << file_name << '\n';
+			std::cerr << "Cannot open file: " << config_file_with_dir << '\n';
 			perror("because of");
 			master.msg->message("cannot open destination file");
 			// TODO: throw
@@ -309,6 +404,18 @@ void reader_buffer::operator()()
 	} // end: for (;;)
 }
 
+void reader_buffer::prepare_file_name(std::string & file_with_dir, const std::string & dir, const std::string & robot_filename, int file_counter, const char * extension)
+{
+	time_t time_of_day = time(NULL);
+	char file_date[40];
+	strftime(file_date, 40, "%Y-%m-%d_%H-%M-%S", localtime(&time_of_day));
+
+	std::stringstream ss;
+	ss << dir << "/" << file_date << "_" << robot_filename << "_pomiar-" << file_counter << "." << extension;
+
+	file_with_dir = ss.str();
+}
+
 void reader_buffer::write_header_old_format(std::ofstream& outfile)
 {
 	// does nothing
@@ -394,140 +501,12 @@ void reader_buffer::write_data_old_format(std::ofstream& outfile, const reader_d
 
 void reader_buffer::write_header_csv(std::ofstream& outfile)
 {
-	outfile << "step;";
-	if (reader_cnf.measure_time)
-		outfile << "measure_time_sec;measure_time_nsec;";
-	if (reader_cnf.servo_mode)
-		outfile << "servo_mode;";
-	for (int j = 0; j < master.number_of_servos; j++) {
-		if (reader_cnf.desired_inc[j])
-			outfile << "desired_inc[" << j << "];";
-		if (reader_cnf.current_inc[j])
-			outfile << "current_inc[" << j << "];";
-		if (reader_cnf.measured_current[j])
-			outfile << "measured_current[" << j << "];";
-//		if (reader_cnf.pwm[j])
-//			outfile << "pwm[" << j << "];";
-		if (reader_cnf.uchyb[j])
-			outfile << "uchyb[" << j << "];";
-		if (reader_cnf.abs_pos[j])
-			outfile << "abs_pos[" << j << "];";
-	}
-
-	for (int j = 0; j < master.number_of_servos; j++) {
-		if (reader_cnf.current_joints[j])
-			outfile << "current_joints[" << j << "];";
-	}
-
-        for (int j = 0; j < master.number_of_servos; j++) {
-                if (reader_cnf.desired_joints[j])
-                        outfile << "desired_joints[" << j << "];";
-        }
-
-        for (int j = 0; j < master.number_of_servos; j++) {
-                if (reader_cnf.pwm[j])
-                        outfile << "pwm[" << j << "];";
-        }
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.force[j])
-			outfile << "force[" << j << "];";
-		if (reader_cnf.desired_force[j])
-			outfile << "desired_force[" << j << "];";
-		if (reader_cnf.filtered_force[j])
-			outfile << "filtered_force[" << j << "];";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.desired_cartesian_position[j])
-			outfile << "desired_cartesian_position[" << j << "];";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.real_cartesian_position[j])
-			outfile << "real_cartesian_position[" << j << "];";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.real_cartesian_vel[j])
-			outfile << "real_cartesian_vel[" << j << "];";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.real_cartesian_acc[j])
-			outfile << "real_cartesian_acc[" << j << "];";
-	}
-
-	outfile << "ui_trigger\n";
+	write_reader_header_csv(outfile, reader_cnf, master.number_of_servos);
 }
 
 void reader_buffer::write_data_csv(std::ofstream& outfile, const reader_data & data)
 {
-	outfile << data.step << ";";
-	if (reader_cnf.measure_time)
-		outfile << data.measure_time.tv_sec << ";" << data.measure_time.tv_nsec << ";";
-	if (reader_cnf.servo_mode)
-		outfile << (data.servo_mode ? "1" : "0") << ";";
-	for (int j = 0; j < master.number_of_servos; j++) {
-		if (reader_cnf.desired_inc[j])
-			outfile << data.desired_inc[j] << ";";
-		if (reader_cnf.current_inc[j])
-			outfile << data.current_inc[j] << ";";
-		if (reader_cnf.measured_current[j])
-			outfile << data.measured_current[j] << ";";
-                //if (reader_cnf.pwm[j])
-                //	outfile << data.pwm[j] << ";";
-		if (reader_cnf.uchyb[j])
-			outfile << data.uchyb[j] << ";";
-		if (reader_cnf.abs_pos[j])
-			outfile << data.abs_pos[j] << ";";
-	}
-
-	for (int j = 0; j < master.number_of_servos; j++) {
-		if (reader_cnf.current_joints[j])
-			outfile << data.current_joints[j] << ";";
-	}
-
-        for (int j = 0; j < master.number_of_servos; j++) {
-                if (reader_cnf.desired_joints[j])
-                        outfile << data.desired_joints[j] << ";";
-        }
-
-        for (int j = 0; j < master.number_of_servos; j++) {
-            if (reader_cnf.pwm[j])
-                    outfile << data.pwm[j] << ";";
-        }
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.force[j])
-			outfile << data.force[j] << ";";
-		if (reader_cnf.desired_force[j])
-			outfile << data.desired_force[j] << ";";
-		if (reader_cnf.filtered_force[j])
-			outfile << data.filtered_force[j] << ";";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.desired_cartesian_position[j])
-			outfile << data.desired_cartesian_position[j] << ";";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.real_cartesian_position[j])
-			outfile << data.real_cartesian_position[j] << ";";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.real_cartesian_vel[j])
-			outfile << data.real_cartesian_vel[j] << ";";
-	}
-
-	for (int j = 0; j < 6; j++) {
-		if (reader_cnf.real_cartesian_acc[j])
-			outfile << data.real_cartesian_acc[j] << ";";
-	}
-
-	outfile << data.ui_trigger << '\n';
+	write_reader_data_csv(outfile, reader_cnf, master.number_of_servos, data);
 }
 
 } // namespace common
@@ -8,8 +8,6 @@
 #include <stdint.h>
 
 #include <boost/utility.hpp>
-#include <boost/thread/mutex.hpp>
-#include <boost/thread/condition_variable.hpp>
 
 #include <ctime>
 
@@ -83,23 +81,109 @@ struct reader_data
 	bool ui_trigger; // by Y: false - nie wystapil w biezacym kroku, true - wystapil
 };
 
-/**************************** reader_buffer *****************************/
+//! Force sample published by the force thread
+struct reader_force_data
+{
+	double force[6];
+};
 
-class reader_buffer : public boost::noncopyable
+//! Desired joints published by the thread computing the commands
+struct reader_joints_data
+{
+	double desired_joints[lib::MAX_SERVOS_NR];
+};
+
+//! Wait-free publish area (seqlock) for data written by a single thread other than the servo
+template <typename T>
+class reader_publish_slot : public boost::noncopyable
+{
+public:
+	reader_publish_slot() :
+		sequence(0)
+	{
+	}
+
+	//! producer side, never blocks
+	void publish(const T & value)
+	{
+		const uint32_t seq = sequence;
+		sequence = seq + 1;
+		__sync_synchronize();
+		data = value;
+		__sync_synchronize();
+		sequence = seq + 2;
+	}
+
+	//! consumer side; returns false if the producer kept the slot busy
+	bool read(T & value) const
+	{
+		for (int i = 0; i < 4; ++i) {
+			const uint32_t seq = sequence;
+			if (seq & 1) {
+				continue;
+			}
+			__sync_synchronize();
+			value = data;
+			__sync_synchronize();
+			if (sequence == seq) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	volatile uint32_t sequence;
+	T data;
+};
+
+//! Wait-free single-producer/single-consumer ring of measurement records
+class reader_ring : public boost::noncopyable
 {
 public:
-	boost::mutex reader_mutex;
+	//! ring capacity (power of 2), about 1s of servo steps
+	static const uint32_t SIZE = 512;
+
+	reader_ring();
 
-	boost::condition_variable cond;
+	//! servo thread side; returns false (and the sample is lost) if the ring is full
+	bool push(const reader_data & data);
 
-	bool new_data;
+	//! reader thread side; returns false if the ring is empty
+	bool pop(reader_data & data);
 
+	//! reader thread side; drop all pending records
+	void flush();
+
+private:
+	reader_data buf[SIZE];
+
+	volatile uint32_t head;
+	volatile uint32_t tail;
+};
+
+/**************************** reader_buffer *****************************/
+
+class reader_buffer : public boost::noncopyable
+{
+public:
 	//! main thread loop
 	void operator()();
 
-        reader_data step_data; // dane pomiarowe dla biezacego mikrokroku
+	//! dane pomiarowe dla biezacego mikrokroku, zapisywane wylacznie przez watek servo
+	reader_data step_data;
 	reader_config reader_cnf; //   Struktura z informacja, ktore elementy struktury reader_data maja byc zapisane do pliku
 
+	//! sila zapisywana przez watek sily
+	reader_publish_slot <reader_force_data> force_slot;
+
+	//! polozenie zadane zapisywane przez watek przeliczajacy polecenia ruchu
+	reader_publish_slot <reader_joints_data> desired_joints_slot;
+
+	//! called by the servo thread at the end of each step; never blocks,
+	//! except for the hardware simulation, which waits for space in the ring during the measurements
+	void publish_step();
+
 	reader_buffer(motor_driven_effector &_master);
 	~reader_buffer();
 private:
@@ -107,8 +191,18 @@ private:
 
 	boost::thread thread_id;
 
+	reader_ring ring;
+
+	//! pomiary w toku, ustawiane przez watek reader
+	volatile bool measuring;
+
 	bool write_csv;
 
+	//! zapis strumieniowy w trakcie pomiarow (opcja reader_stream)
+	bool write_stream;
+
+	void prepare_file_name(std::string & file_with_dir, const std::string & dir, const std::string & robot_filename, int file_counter, const char * extension);
+
 	void write_header_old_format(std::ofstream& outfile);
 	void write_data_old_format(std::ofstream& outfile, const reader_data & data);
 
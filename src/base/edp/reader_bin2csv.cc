@@ -0,0 +1,76 @@
+/*!
+ * @file reader_bin2csv.cc
+ * @brief Conversion of the EDP reader binary stream to the CSV format
+ *
+ * Usage: reader_bin2csv input.bin [output.csv]
+ *
+ * @ingroup edp
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+
+#include "base/edp/reader_stream.h"
+
+using namespace mrrocpp::edp::common;
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " input.bin [output.csv]" << std::endl;
+		return 1;
+	}
+
+	std::ifstream infile(argv[1], std::ios::in | std::ios::binary);
+	if (!infile.good()) {
+		std::cerr << "Cannot open file: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	reader_stream_header header;
+
+	if (!infile.read((char *) &header, sizeof(header))) {
+		std::cerr << "File too short: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	if (std::memcmp(header.magic, READER_STREAM_MAGIC, sizeof(header.magic)) != 0) {
+		std::cerr << "Not a reader stream file: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	// uklad rekordow musi byc zgodny z uzywanym przez ten program
+	if (header.version != READER_STREAM_VERSION || header.header_size != sizeof(reader_stream_header)
+			|| header.record_size != sizeof(reader_data) || header.max_servos_nr != mrrocpp::lib::MAX_SERVOS_NR
+			|| header.number_of_servos > mrrocpp::lib::MAX_SERVOS_NR) {
+		std::cerr << "Incompatible reader stream format in: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::ofstream outfile;
+	if (argc > 2) {
+		outfile.open(argv[2], std::ios::out);
+		if (!outfile.good()) {
+			std::cerr << "Cannot open file: " << argv[2] << std::endl;
+			return 1;
+		}
+	}
+
+	std::ostream & out = (argc > 2) ? outfile : std::cout;
+
+	write_reader_header_csv(out, header.config, header.number_of_servos);
+
+	reader_data data;
+	while (infile.read((char *) &data, sizeof(data))) {
+		write_reader_data_csv(out, header.config, header.number_of_servos, data);
+	}
+
+	// niepelny rekord na koncu pliku oznacza przerwany zapis
+	if (infile.gcount() != 0) {
+		std::cerr << "Truncated record at the end of: " << argv[1] << std::endl;
+	}
+
+	return 0;
+}
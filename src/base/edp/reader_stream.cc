@@ -0,0 +1,286 @@
+//
+// Binarny zapis strumieniowy pomiarow reader'a i konwersja do CSV
+//
+
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "base/edp/reader_stream.h"
+
+namespace mrrocpp {
+namespace edp {
+namespace common {
+
+reader_config::reader_config() :
+	step(false), measure_time(false), servo_mode(false)
+{
+	for (std::size_t i = 0; i < lib::MAX_SERVOS_NR; ++i) {
+		desired_inc[i] = false;
+		current_inc[i] = false;
+		pwm[i] = false;
+		uchyb[i] = false;
+		abs_pos[i] = false;
+		current_joints[i] = false;
+		desired_joints[i] = false;
+	}
+
+	for (int i = 0; i < 6; ++i) {
+		force[i] = false;
+		desired_force[i] = false;
+		filtered_force[i] = false;
+		desired_cartesian_position[i] = false;
+		real_cartesian_position[i] = false;
+		real_cartesian_vel[i] = false;
+		real_cartesian_acc[i] = false;
+	}
+}
+
+reader_stream::reader_stream() :
+	fd(-1), block_used(0)
+{
+}
+
+reader_stream::~reader_stream()
+{
+	close();
+}
+
+bool reader_stream::open(const std::string & filename, const reader_config & cnf, int number_of_servos)
+{
+	close();
+
+	if ((fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1) {
+		perror("reader_stream open()");
+		return false;
+	}
+
+	reader_stream_header header;
+	std::memset(&header, 0, sizeof(header));
+
+	std::memcpy(header.magic, READER_STREAM_MAGIC, sizeof(header.magic));
+	header.version = READER_STREAM_VERSION;
+	header.header_size = sizeof(reader_stream_header);
+	header.record_size = sizeof(reader_data);
+	header.max_servos_nr = lib::MAX_SERVOS_NR;
+	header.number_of_servos = number_of_servos;
+	header.config = cnf;
+
+	if (::write(fd, &header, sizeof(header)) != (ssize_t) sizeof(header)) {
+		perror("reader_stream write()");
+		::close(fd);
+		fd = -1;
+		return false;
+	}
+
+	block_used = 0;
+
+	return true;
+}
+
+bool reader_stream::append(const reader_data & data)
+{
+	if (fd == -1) {
+		return false;
+	}
+
+	block[block_used++] = data;
+
+	if (block_used == BLOCK_RECORDS) {
+		return flush();
+	}
+
+	return true;
+}
+
+bool reader_stream::flush()
+{
+	const char * ptr = (const char *) block;
+	std::size_t left = block_used * sizeof(reader_data);
+
+	block_used = 0;
+
+	while (left) {
+		ssize_t written = ::write(fd, ptr, left);
+		if (written == -1) {
+			if (errno == EINTR) {
+				continue;
+			}
+			perror("reader_stream write()");
+			return false;
+		}
+		ptr += written;
+		left -= written;
+	}
+
+	return true;
+}
+
+bool reader_stream::close()
+{
+	if (fd == -1) {
+		return true;
+	}
+
+	bool ret = flush();
+
+	if (::close(fd) == -1) {
+		perror("reader_stream close()");
+		ret = false;
+	}
+
+	fd = -1;
+
+	return ret;
+}
+
+bool reader_stream::is_open() const
+{
+	return (fd != -1);
+}
+
+void write_reader_header_csv(std::ostream & outfile, const reader_config & cnf, int number_of_servos)
+{
+	outfile << "step;";
+	if (cnf.measure_time)
+		outfile << "measure_time_sec;measure_time_nsec;";
+	if (cnf.servo_mode)
+		outfile << "servo_mode;";
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.desired_inc[j])
+			outfile << "desired_inc[" << j << "];";
+		if (cnf.current_inc[j])
+			outfile << "current_inc[" << j << "];";
+		if (cnf.measured_current[j])
+			outfile << "measured_current[" << j << "];";
+//		if (cnf.pwm[j])
+//			outfile << "pwm[" << j << "];";
+		if (cnf.uchyb[j])
+			outfile << "uchyb[" << j << "];";
+		if (cnf.abs_pos[j])
+			outfile << "abs_pos[" << j << "];";
+	}
+
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.current_joints[j])
+			outfile << "current_joints[" << j << "];";
+	}
+
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.desired_joints[j])
+			outfile << "desired_joints[" << j << "];";
+	}
+
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.pwm[j])
+			outfile << "pwm[" << j << "];";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.force[j])
+			outfile << "force[" << j << "];";
+		if (cnf.desired_force[j])
+			outfile << "desired_force[" << j << "];";
+		if (cnf.filtered_force[j])
+			outfile << "filtered_force[" << j << "];";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.desired_cartesian_position[j])
+			outfile << "desired_cartesian_position[" << j << "];";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.real_cartesian_position[j])
+			outfile << "real_cartesian_position[" << j << "];";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.real_cartesian_vel[j])
+			outfile << "real_cartesian_vel[" << j << "];";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.real_cartesian_acc[j])
+			outfile << "real_cartesian_acc[" << j << "];";
+	}
+
+	outfile << "ui_trigger\n";
+}
+
+void write_reader_data_csv(std::ostream & outfile, const reader_config & cnf, int number_of_servos, const reader_data & data)
+{
+	outfile << data.step << ";";
+	if (cnf.measure_time)
+		outfile << data.measure_time.tv_sec << ";" << data.measure_time.tv_nsec << ";";
+	if (cnf.servo_mode)
+		outfile << (data.servo_mode ? "1" : "0") << ";";
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.desired_inc[j])
+			outfile << data.desired_inc[j] << ";";
+		if (cnf.current_inc[j])
+			outfile << data.current_inc[j] << ";";
+		if (cnf.measured_current[j])
+			outfile << data.measured_current[j] << ";";
+		//if (cnf.pwm[j])
+		//	outfile << data.pwm[j] << ";";
+		if (cnf.uchyb[j])
+			outfile << data.uchyb[j] << ";";
+		if (cnf.abs_pos[j])
+			outfile << data.abs_pos[j] << ";";
+	}
+
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.current_joints[j])
+			outfile << data.current_joints[j] << ";";
+	}
+
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.desired_joints[j])
+			outfile << data.desired_joints[j] << ";";
+	}
+
+	for (int j = 0; j < number_of_servos; j++) {
+		if (cnf.pwm[j])
+			outfile << data.pwm[j] << ";";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.force[j])
+			outfile << data.force[j] << ";";
+		if (cnf.desired_force[j])
+			outfile << data.desired_force[j] << ";";
+		if (cnf.filtered_force[j])
+			outfile << data.filtered_force[j] << ";";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.desired_cartesian_position[j])
+			outfile << data.desired_cartesian_position[j] << ";";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.real_cartesian_position[j])
+			outfile << data.real_cartesian_position[j] << ";";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.real_cartesian_vel[j])
+			outfile << data.real_cartesian_vel[j] << ";";
+	}
+
+	for (int j = 0; j < 6; j++) {
+		if (cnf.real_cartesian_acc[j])
+			outfile << data.real_cartesian_acc[j] << ";";
+	}
+
+	outfile << data.ui_trigger << '\n';
+}
+
+} // namespace common
+} // namespace edp
+} // namespace mrrocpp
@@ -0,0 +1,91 @@
+// -------------------------------------------------------------------------
+//                                reader_stream.h
+// Binarny zapis strumieniowy pomiarow reader'a i konwersja do CSV
+// -------------------------------------------------------------------------
+
+#ifndef __READER_STREAM_H
+#define __READER_STREAM_H
+
+#include <stdint.h>
+
+#include <string>
+#include <ostream>
+
+#include <boost/utility.hpp>
+
+#include "base/edp/reader.h"
+
+namespace mrrocpp {
+namespace edp {
+namespace common {
+
+//! Identyfikator pliku z zapisem strumieniowym
+const char READER_STREAM_MAGIC[8] = { 'M', 'R', 'R', 'E', 'A', 'D', 'E', 'R' };
+
+//! Wersja formatu pliku
+const uint32_t READER_STREAM_VERSION = 1;
+
+/*!
+ * \brief Naglowek pliku z zapisem strumieniowym
+ *
+ * Za naglowkiem nastepuja rekordy reader_data w postaci binarnej o stalym rozmiarze.
+ * Rozmiary zapisane w naglowku pozwalaja wykryc plik z niezgodnej wersji programu.
+ */
+struct reader_stream_header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t header_size;
+	uint32_t record_size;
+	uint32_t max_servos_nr;
+	uint32_t number_of_servos;
+	reader_config config;
+};
+
+/*!
+ * \brief Zapis strumieniowy rekordow reader_data do pliku
+ *
+ * Rekordy sa gromadzone w bloku i zapisywane do pliku po jego zapelnieniu,
+ * wiec pamiec zajeta przez reader nie zalezy od dlugosci pomiarow.
+ */
+class reader_stream : public boost::noncopyable
+{
+public:
+	reader_stream();
+	~reader_stream();
+
+	//! utworzenie pliku i zapis naglowka
+	bool open(const std::string & filename, const reader_config & cnf, int number_of_servos);
+
+	//! dopisanie rekordu
+	bool append(const reader_data & data);
+
+	//! zapis pozostalych rekordow i zamkniecie pliku
+	bool close();
+
+	bool is_open() const;
+
+private:
+	//! liczba rekordow zapisywanych jednym wywolaniem write()
+	static const std::size_t BLOCK_RECORDS = 64;
+
+	int fd;
+
+	reader_data block[BLOCK_RECORDS];
+
+	std::size_t block_used;
+
+	bool flush();
+};
+
+//! naglowek pliku CSV
+void write_reader_header_csv(std::ostream & outfile, const reader_config & cnf, int number_of_servos);
+
+//! rekord pliku CSV
+void write_reader_data_csv(std::ostream & outfile, const reader_config & cnf, int number_of_servos, const reader_data & data);
+
+} // namespace common
+} // namespace edp
+} // namespace mrrocpp
+
+#endif
@@ -24,6 +24,11 @@
 
 #include "base/edp/edp_e_motor_driven.h"
 
+#include "ReflexxesAPI.h"
+#include "RMLPositionFlags.h"
+#include "RMLPositionInputParameters.h"
+#include "RMLPositionOutputParameters.h"
+
 #include "base/lib/exception.h"
 using namespace mrrocpp::lib::exception;
 
@@ -191,6 +196,7 @@ void servo_buffer::send_to_SERVO_GROUP()
 		boost::lock_guard <boost::mutex> lock(servo_command_mtx);
 		servo_command_rdy = true;
 	}
+	servo_command_cond.notify_one();
 
 	{
 		boost::unique_lock <boost::mutex> lock(sg_reply_mtx);
@@ -245,6 +251,8 @@ void servo_buffer::operator()()
 	try {
 
 		load_hardware_interface();
+
+		create_otg();
 	}
 
 	catch (std::exception & e) {
@@ -253,7 +261,7 @@ void servo_buffer::operator()()
 		exit(EXIT_SUCCESS);
 	}
 
-	if (!master.robot_test_mode) {
+	if (!master.robot_test_mode && !master.hardware_simulation) {
 		lib::set_thread_priority(lib::PTHREAD_MAX_PRIORITY + 10);
 	}
 
@@ -264,26 +272,26 @@ void servo_buffer::operator()()
 	/* BEGIN SERVO_GROUP */
 
 	for (;;) {
+		wait_for_command_if_idle();
+
 		// komunikacja z transformation
 		if (!get_command()) {
-			// scoped-locked reader data update
-			{
-				boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
-				master.rb_obj->step_data.servo_mode = false; // tryb bierny
+			if (otg_active) {
+				// kontynuacja ruchu generowanego w petli serwa
+				Move_otg_step();
+				continue;
 			}
 
+			// reader data update
+			master.rb_obj->step_data.servo_mode = false; // tryb bierny
+
 			/* Nie otrzymano nowego polecenia */
 			/* Krok bierny - zerowy przyrost polozenia */
 			// Wykonanie pojedynczego kroku ruchu
 			Move_passive();
 		} else {
 			// nowe polecenie
-			{
-				boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
-				master.rb_obj->step_data.servo_mode = true; // tryb czynny
-			}
+			master.rb_obj->step_data.servo_mode = true; // tryb czynny
 
 			switch (command_type())
 			{
@@ -293,6 +301,9 @@ void servo_buffer::operator()()
 				case MOVE:
 					Move(); // realizacja makrokroku ruchu
 					break;
+				case MOVE_OTG:
+					Move_otg(); // nowy cel ruchu generowanego w petli serwa
+					break;
 				case READ:
 					Read(); // Odczyt polozen
 					break;
@@ -348,10 +359,34 @@ SERVO_COMMAND servo_buffer::command_type() const
 }
 
 servo_buffer::servo_buffer(motor_driven_effector &_master) :
-		servo_command_rdy(false), sg_reply_rdy(false), step_number_in_macrostep(0), thread_started(), master(_master)
+		servo_command_rdy(false), sg_reply_rdy(false), step_number_in_macrostep(0), otg_api(NULL), otg_input(NULL),
+		otg_candidate(NULL), otg_output(NULL), otg_flags(NULL), otg_active(false), thread_started(), master(_master)
 {
+	// roboty bez synchronizacji (np. conveyor) nie ustawiaja krokow synchronizacji
+	for (std::size_t j = 0; j < lib::MAX_SERVOS_NR; j++) {
+		synchro_step_coarse[j] = 0.0;
+		synchro_step_fine[j] = 0.0;
+	}
+}
 
+/*-----------------------------------------------------------------------*/
+void servo_buffer::wait_for_command_if_idle(void)
+{
+	if (!master.sim_clock || master.sim_clock->get_speed() != 0) {
+		return;
+	}
+
+	// ruch w toku albo zalegla odpowiedz wymagaja kolejnych krokow
+	if (otg_active || send_after_last_step) {
+		return;
+	}
+
+	boost::unique_lock <boost::mutex> lock(servo_command_mtx);
+	while (!servo_command_rdy) {
+		servo_command_cond.wait(lock);
+	}
 }
+/*-----------------------------------------------------------------------*/
 
 /*-----------------------------------------------------------------------*/
 bool servo_buffer::get_command(void)
@@ -387,6 +422,8 @@ bool servo_buffer::get_command(void)
 				return true; // wyjscie bez kontaktu z EDP_MASTER
 			case MOVE:
 				return true; // wyjscie bez kontaktu z EDP_MASTER
+			case MOVE_OTG:
+				return true; // wyjscie bez kontaktu z EDP_MASTER
 			case READ:
 				return true; // wyjscie bez kontaktu z EDP_MASTER
 			case SERVO_ALGORITHM_AND_PARAMETERS:
@@ -418,11 +455,12 @@ uint8_t servo_buffer::Move_1_step(void)
 	// odczyt poprzedniego polozenia
 	master.step_counter++;
 
-	// scoped-locked reader data update
+	// reader data update, the reader thread is waited for only in the hardware simulation
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
-		if (clock_gettime(CLOCK_REALTIME, &master.rb_obj->step_data.measure_time) == -1) {
+		if (master.sim_clock) {
+			// czas wirtualny, powtarzalny miedzy przebiegami
+			master.sim_clock->now(master.rb_obj->step_data.measure_time);
+		} else if (clock_gettime(CLOCK_REALTIME, &master.rb_obj->step_data.measure_time) == -1) {
 			perror("clock_gettime()");
 
 			/*
@@ -436,8 +474,7 @@ uint8_t servo_buffer::Move_1_step(void)
 
 		master.rb_obj->step_data.step = master.step_counter;
 
-		master.rb_obj->new_data = true;
-		master.rb_obj->cond.notify_one();
+		master.rb_obj->publish_step();
 	}
 
 	if (reply_status_tmp.error0 || reply_status_tmp.error1) {
@@ -510,6 +547,15 @@ void servo_buffer::Move(void)
 	else
 		send_after_last_step = false;
 
+	if (otg_active) {
+		// przerwanie ruchu generowanego w petli serwa - makrokrok od biezacej pozycji zadanej
+		otg_active = false;
+		for (int k = 0; k < master.number_of_servos; k++) {
+			command.parameters.move.macro_step[k] = command.parameters.move.abs_position[k]
+					- otg_input->CurrentPositionVector->VecData[k];
+		}
+	}
+
 	for (int k = 0; k < master.number_of_servos; k++) {
 		new_increment[k] = command.parameters.move.macro_step[k] / command.parameters.move.number_of_steps;
 		regulator_ptr[k]->new_desired_velocity_error = true;
@@ -575,6 +621,116 @@ void servo_buffer::Move(void)
 }
 /*-----------------------------------------------------------------------*/
 
+/*-----------------------------------------------------------------------*/
+void servo_buffer::create_otg(void)
+{
+	// obiekty generatora sa tworzone raz, przed wejsciem w petle serwa
+	otg_api = new ReflexxesAPI(master.number_of_servos, lib::EDP_STEP);
+	otg_input = new RMLPositionInputParameters(master.number_of_servos);
+	otg_candidate = new RMLPositionInputParameters(master.number_of_servos);
+	otg_output = new RMLPositionOutputParameters(master.number_of_servos);
+	otg_flags = new RMLPositionFlags;
+
+	otg_flags->SynchronizationBehavior = RMLPositionFlags::PHASE_SYNCHRONIZATION_IF_POSSIBLE;
+}
+/*-----------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------*/
+void servo_buffer::Move_otg(void)
+{
+	// nowy cel jest sprawdzany na kopii, biezacy ruch trwa az do jego akceptacji
+	if (otg_active) {
+		// w trakcie ruchu nowy cel przejmuje biezacy stan generatora (ciaglosc predkosci i przyspieszenia)
+		*otg_candidate = *otg_input;
+	} else {
+		// ruch od spoczynku w biezacej pozycji zadanej
+		for (int k = 0; k < master.number_of_servos; k++) {
+			otg_candidate->CurrentPositionVector->VecData[k] = command.parameters.otg.start_position[k];
+			otg_candidate->CurrentVelocityVector->VecData[k] = 0.0;
+			otg_candidate->CurrentAccelerationVector->VecData[k] = 0.0;
+		}
+	}
+
+	for (int k = 0; k < master.number_of_servos; k++) {
+		otg_candidate->TargetPositionVector->VecData[k] = command.parameters.otg.target_position[k];
+		otg_candidate->TargetVelocityVector->VecData[k] = command.parameters.otg.target_velocity[k];
+		otg_candidate->MaxVelocityVector->VecData[k] = command.parameters.otg.max_velocity[k];
+		otg_candidate->MaxAccelerationVector->VecData[k] = command.parameters.otg.max_acceleration[k];
+		otg_candidate->MaxJerkVector->VecData[k] = command.parameters.otg.max_jerk[k];
+		otg_candidate->SelectionVector->VecData[k] = true;
+	}
+
+	if (!otg_candidate->CheckForValidity()) {
+		// nie mozna zrealizowac ruchu - trwajacy ruch do poprzedniego celu nie jest przerywany
+		reply_status.error0 = SERVO_ERROR_IN_PHASE_1;
+		clear_reply_status_tmp();
+		reply_to_EDP_MASTER();
+		return;
+	}
+
+	*otg_input = *otg_candidate;
+
+	for (int k = 0; k < master.number_of_servos; k++) {
+		regulator_ptr[k]->new_desired_velocity_error = true;
+	}
+
+	otg_active = true;
+	send_after_last_step = false;
+
+	// pierwszy krok ruchu, po nim odpowiedz dla EDP_MASTER
+	Move_otg_step();
+
+	reply_to_EDP_MASTER();
+}
+/*-----------------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------------*/
+void servo_buffer::Move_otg_step(void)
+{
+	master.rb_obj->step_data.servo_mode = true; // tryb czynny
+
+	const int result = otg_api->RMLPosition(*otg_input, otg_output, *otg_flags);
+
+	if (result < 0 && result != ReflexxesAPI::RML_ERROR_NO_PHASE_SYNCHRONIZATION) {
+		// blad generatora - zatrzymanie w biezacej pozycji zadanej
+		reply_status.error0 |= SERVO_ERROR_IN_PHASE_2;
+		otg_active = false;
+		// zglaszany od razu, a nie dopiero w odpowiedzi na kolejne polecenie
+		master.msg->message(lib::NON_FATAL_ERROR, reply_status.error0, reply_status.error1);
+		Move_passive();
+		return;
+	}
+
+	for (int k = 0; k < master.number_of_servos; k++) {
+		const double new_position = otg_output->NewPositionVector->VecData[k];
+
+		regulator_ptr[k]->insert_new_step(new_position - otg_input->CurrentPositionVector->VecData[k]);
+		regulator_ptr[k]->previous_abs_position = new_position;
+		if (master.robot_test_mode) {
+			master.update_servo_current_motor_pos_abs(new_position, k);
+		}
+	}
+
+	// wyjscie generatora jest stanem poczatkowym kolejnego kroku
+	*otg_input->CurrentPositionVector = *otg_output->NewPositionVector;
+	*otg_input->CurrentVelocityVector = *otg_output->NewVelocityVector;
+	*otg_input->CurrentAccelerationVector = *otg_output->NewAccelerationVector;
+
+	if (Move_a_step() != NO_ERROR_DETECTED) {
+		reply_status.error0 = reply_status_tmp.error0 | SERVO_ERROR_IN_PHASE_2;
+		reply_status.error1 = reply_status_tmp.error1;
+		clear_reply_status_tmp();
+		otg_active = false; // przerwac ruch, bo byl blad
+		master.msg->message(lib::NON_FATAL_ERROR, reply_status.error0, reply_status.error1);
+		return;
+	}
+
+	if (result == ReflexxesAPI::RML_FINAL_STATE_REACHED) {
+		otg_active = false;
+	}
+}
+/*-----------------------------------------------------------------------*/
+
 /*-----------------------------------------------------------------------*/
 void servo_buffer::reply_to_EDP_MASTER(void)
 {
@@ -625,6 +781,12 @@ servo_buffer::~servo_buffer(void)
 
 	delete hi;
 
+	delete otg_flags;
+	delete otg_output;
+	delete otg_candidate;
+	delete otg_input;
+	delete otg_api;
+
 	delete thread_id;
 }
 /*-----------------------------------------------------------------------*/
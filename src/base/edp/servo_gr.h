@@ -18,6 +18,11 @@
 #include "base/lib/condition_synchroniser.h"
 #include "base/edp/edp_typedefs.h"
 
+class ReflexxesAPI;
+class RMLPositionInputParameters;
+class RMLPositionOutputParameters;
+class RMLPositionFlags;
+
 namespace mrrocpp {
 namespace edp {
 namespace common {
@@ -44,7 +49,7 @@ const int SYNCHRO_FINAL_STOP_STEP_NUMBER = 25; // liczba krokow zatrzymania podc
 //------------------------------------------------------------------------------
 enum SERVO_COMMAND
 {
-	MOVE, READ, SYNCHRONISE, SERVO_ALGORITHM_AND_PARAMETERS
+	MOVE, READ, SYNCHRONISE, SERVO_ALGORITHM_AND_PARAMETERS, MOVE_OTG
 };
 
 //------------------------------------------------------------------------------
@@ -74,6 +79,22 @@ struct edp_master_command
 		} move;
 		//------------------------------------------------------
 		struct
+		{
+			/*! Desired position at the moment of the command, used if no motion is in progress. */
+			double start_position[lib::MAX_SERVOS_NR];
+			/*! Target position of the motor shafts. */
+			double target_position[lib::MAX_SERVOS_NR];
+			/*! Velocity at the target position. */
+			double target_velocity[lib::MAX_SERVOS_NR];
+			/*! Velocity limits. */
+			double max_velocity[lib::MAX_SERVOS_NR];
+			/*! Acceleration limits. */
+			double max_acceleration[lib::MAX_SERVOS_NR];
+			/*! Jerk limits. */
+			double max_jerk[lib::MAX_SERVOS_NR];
+		} otg;
+		//------------------------------------------------------
+		struct
 		{
 			/*! Servo algorithm numbers. */
 			uint8_t servo_algorithm_no[lib::MAX_SERVOS_NR];
@@ -147,6 +168,7 @@ protected:
 
 	bool servo_command_rdy;
 	boost::mutex servo_command_mtx;
+	boost::condition servo_command_cond;
 
 	bool sg_reply_rdy;
 	boost::mutex sg_reply_mtx;
@@ -159,6 +181,23 @@ protected:
 	// obliczenie statystyk pradu
 	void compute_current_measurement_statistics();
 
+	//! generator trajektorii Reflexxes, liczony co krok serwa
+	ReflexxesAPI *otg_api;
+	RMLPositionInputParameters *otg_input;
+	//! nowy cel sprawdzany przed podmiana parametrow trwajacego ruchu
+	RMLPositionInputParameters *otg_candidate;
+	RMLPositionOutputParameters *otg_output;
+	RMLPositionFlags *otg_flags;
+
+	//! czy trwa ruch generowany w petli serwa
+	bool otg_active;
+
+	//! utworzenie obiektow generatora trajektorii
+	void create_otg(void);
+
+	//! krok ruchu generowanego w petli serwa
+	void Move_otg_step(void);
+
 public:
 	lib::condition_synchroniser thread_started;
 
@@ -195,12 +234,19 @@ public:
 	//! odczytanie polecenia z EDP_MASTER o ile zostalo przyslane
 	bool get_command(void);
 
+	//! symulacja bez ograniczenia predkosci: bezczynna petla serwa czeka na polecenie,
+	//! wiec czas wirtualny zalezy tylko od polecen, a nie od szeregowania watkow
+	void wait_for_command_if_idle(void);
+
 	//! stanie w miejscu
 	void Move_passive(void);
 
 	//! wykonac makrokrok ruchu
 	void Move(void);
 
+	//! nowy cel ruchu generowanego w petli serwa, przerywa biezacy ruch
+	void Move_otg(void);
+
 	//! odczytac aktualne polozenie
 	void Read(void);
 
@@ -49,6 +49,42 @@ void kinematic_model::inverse_kinematics_transform(lib::JointArray & local_desir
 
 }
 
+void kinematic_model::inverse_kinematics_transform_batch(joint_batch_t & desired_joints_, const lib::JointArray & current_joints_, const frame_batch_t & desired_frames_)
+{
+	const int n_joints = current_joints_.size();
+
+	desired_joints_.resize(desired_frames_.rows(), n_joints);
+
+	lib::Homog_matrix frame;
+	lib::JointArray joints(n_joints);
+	lib::JointArray joints_old = current_joints_;
+
+	for (int i = 0; i < desired_frames_.rows(); ++i) {
+		get_batch_frame(desired_frames_, i, frame);
+		inverse_kinematics_transform(joints, joints_old, frame);
+		desired_joints_.row(i) = joints.transpose();
+		// Solution for the current frame is the starting point for the next one.
+		joints_old = joints;
+	}
+}
+
+void kinematic_model::set_batch_frame(frame_batch_t & frames_, int i_, const lib::Homog_matrix & frame_)
+{
+	for (int r = 0; r < 3; ++r) {
+		for (int c = 0; c < 4; ++c) {
+			frames_(i_, 4 * r + c) = frame_(r, c);
+		}
+	}
+}
+
+void kinematic_model::get_batch_frame(const frame_batch_t & frames_, int i_, lib::Homog_matrix & frame_)
+{
+	for (int r = 0; r < 3; ++r) {
+		for (int c = 0; c < 4; ++c) {
+			frame_(r, c) = frames_(i_, 4 * r + c);
+		}
+	}
+}
 
 } // namespace common
 } // namespace kinematic
@@ -38,6 +38,36 @@ namespace common {
  */
 class kinematic_model
 {
+public:
+	/**
+	 * @brief Batch of homogeneous frames in the structure-of-arrays layout.
+	 *
+	 * Row i describes the i-th frame, column (4*r + c) holds the (r,c) element of the 3x4 part of all frames.
+	 * As the storage is column-major, every element of all frames is stored contiguously.
+	 */
+	typedef Eigen::Matrix <double, Eigen::Dynamic, 12> frame_batch_t;
+
+	/**
+	 * @brief Batch of joint values - row i holds the joints computed for the i-th frame.
+	 */
+	typedef Eigen::Matrix <double, Eigen::Dynamic, Eigen::Dynamic> joint_batch_t;
+
+	/**
+	 * @brief Stores a frame in the batch.
+	 * @param[out] frames_ Batch of frames.
+	 * @param[in] i_ Index of the frame in the batch.
+	 * @param[in] frame_ Frame to be stored.
+	 */
+	static void set_batch_frame(frame_batch_t & frames_, int i_, const lib::Homog_matrix & frame_);
+
+	/**
+	 * @brief Retrieves a frame from the batch.
+	 * @param[in] frames_ Batch of frames.
+	 * @param[in] i_ Index of the frame in the batch.
+	 * @param[out] frame_ Retrieved frame.
+	 */
+	static void get_batch_frame(const frame_batch_t & frames_, int i_, lib::Homog_matrix & frame_);
+
 protected:
 	//! Name of given kinematics.
 	std::string label;
@@ -125,6 +155,20 @@ public:
 	virtual void
 	inverse_kinematics_transform(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const lib::Homog_matrix & local_desired_end_effector_frame);
 
+	/**
+	 * @brief Solves inverse kinematics for a sequence of frames.
+	 *
+	 * Solution for every frame is computed with the solution for the previous frame treated as current joints,
+	 * exactly as in a loop of inverse_kinematics_transform() calls, which is the default implementation.
+	 * Models reimplement it to share computations between the frames.
+	 *
+	 * @param[out] desired_joints_ Computed joint values, resized to (number of frames) x (number of joints).
+	 * @param[in] current_joints_ Current (in fact previous) internal values, used for the first frame.
+	 * @param[in] desired_frames_ Given end-effector frames.
+	 */
+	virtual void
+	inverse_kinematics_transform_batch(joint_batch_t & desired_joints_, const lib::JointArray & current_joints_, const frame_batch_t & desired_frames_);
+
 	/**
 	 * @brief Sets kinematics description.
 	 * @param _label Kinematics description to be set.
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <exception>
+#include <algorithm>
 
 #include <boost/foreach.hpp>
 #include <boost/serialization/string.hpp>
@@ -15,7 +16,7 @@ namespace lib {
 namespace agent {
 
 Agent::Agent(const std::string & _name) :
-	AgentBase(_name)
+	AgentBase(_name), ready_buffer_overwritten(false)
 {
 	channel = messip_channel_create(NULL, getName().c_str(), MESSIP_NOTIMEOUT, 0);
 
@@ -39,6 +40,11 @@ void Agent::registerBuffer(InputBufferBase & buf)
 	if (!result.second) {
 		throw std::logic_error(buf.getName() + ": error registering duplicate buffer");;
 	}
+
+	if (!buffer_ids.insert(buffer_ids_t::value_type(buf.getId(), &buf)).second) {
+		buffers.erase(result.first);
+		throw std::logic_error(buf.getName() + ": buffer identifier collides with another buffer");
+	}
 }
 
 void Agent::unregisterBuffer(InputBufferBase & buf)
@@ -46,6 +52,10 @@ void Agent::unregisterBuffer(InputBufferBase & buf)
 	if (buffers.erase(buf.getName()) != 1) {
 		throw std::logic_error(buf.getName() + ": error unregistering nonexistent buffer");
 	}
+
+	buffer_ids.erase(buf.getId());
+
+	ready_buffers.erase(std::remove(ready_buffers.begin(), ready_buffers.end(), &buf), ready_buffers.end());
 }
 
 void Agent::listBuffers() const
@@ -58,13 +68,10 @@ void Agent::listBuffers() const
 	}
 }
 
-int Agent::ReceiveMessage(void * msg, std::size_t msglen, bool block)
+int Agent::ReceiveMessage(void * msg, std::size_t msglen, bool block, int32_t & type, int32_t & subtype)
 {
 	// receive loop
 	while (true) {
-		// additional message type/subtype information
-		int32_t type, subtype;
-
 		int ret = messip_receive(channel, &type, &subtype, msg, msglen, block ? MESSIP_NOTIMEOUT : 0);
 
 		if (ret == -1) {
@@ -82,26 +89,27 @@ int Agent::ReceiveMessage(void * msg, std::size_t msglen, bool block)
 
 bool Agent::ReceiveSingleMessage(bool block)
 {
-	// create object for real-time usage in the loop
-	// TODO: this should be private clas member to avoid memory allocation in real-time
-	std::string msg_buffer_name;
-
-	// allocate memory for the string object
-	// TODO: this size should be #defined for the whole library
-	msg_buffer_name.reserve(100);
+	// the message is received directly into the archive buffer
+	xdr_iarchive <> ia;
 
-	// buffer for the message to receive
-	char msg[16384];
+	// additional message type/subtype information
+	int32_t type, subtype;
 
-	int msglen = ReceiveMessage(msg, sizeof(msg), block);
+	int msglen = ReceiveMessage(ia.get_buffer(), ia.get_buffer_size(), block, type, subtype);
 
 	if(msglen >= 0) {
-		// initialize the archive with the data received
-		xdr_iarchive <sizeof(msg)> ia(msg, msglen);
+		ia.set_data_size(msglen);
 
-		ia >> msg_buffer_name;
+		if (type == MSG_BUFFER_ID) {
+			Store((uint32_t) subtype, ia);
+		} else {
+			// messages from writers, which address buffers by name
+			std::string msg_buffer_name;
 
-		Store(msg_buffer_name, ia);
+			ia >> msg_buffer_name;
+
+			Store(msg_buffer_name, ia);
+		}
 
 		return true;
 	}
@@ -109,6 +117,35 @@ bool Agent::ReceiveSingleMessage(bool block)
 	return false;
 }
 
+std::size_t Agent::ReceivePendingMessages(bool block)
+{
+	ready_buffer_overwritten = false;
+
+	if (!ReceiveSingleMessage(block)) {
+		return 0;
+	}
+
+	// drain the channel without blocking, the caller evaluates the buffers once per batch;
+	// stop when a ready buffer receives again, the remaining messages wait for the next batch
+	std::size_t received = 1;
+	while (!ready_buffer_overwritten && ReceiveSingleMessage(false)) {
+		++received;
+	}
+
+	return received;
+}
+
+void Agent::takeReadyBuffers(ready_buffers_t & ready)
+{
+	BOOST_FOREACH(InputBufferBase * buf, ready_buffers)
+	{
+		buf->ready = false;
+	}
+
+	ready.swap(ready_buffers);
+	ready_buffers.clear();
+}
+
 } // namespace agent
 } // namespace lib
 } // namespace mrrocpp
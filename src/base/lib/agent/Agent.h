@@ -2,6 +2,8 @@
 #define __AGENT_H
 
 #include <string>
+#include <iostream>
+#include <vector>
 
 #include <boost/unordered_map.hpp>
 
@@ -33,6 +35,29 @@ public:
 	//! @return true if a message has been received
 	bool ReceiveSingleMessage(bool block);
 
+	//! Receive all the pending messages in a single batch
+	//! @note the batch ends at a message for a buffer which is already on the ready list,
+	//! so the caller evaluates it before the channel is drained any further
+	//! @param block true for blocking until the first message
+	//! @return number of received messages
+	std::size_t ReceivePendingMessages(bool block);
+
+	//! Datatype of the list of ready buffers
+	typedef std::vector <InputBufferBase *> ready_buffers_t;
+
+	//! Take the buffers which received data since the previous call
+	//! @param ready buffers in order of the first arrival, each listed once
+	void takeReadyBuffers(ready_buffers_t & ready);
+
+	//! Message types
+	enum
+	{
+		//! buffer name is encoded in front of the data
+		MSG_BUFFER_NAME = 0,
+		//! buffer identifier is in the message subtype
+		MSG_BUFFER_ID = 1
+	};
+
 protected:
 	//! Datatype of buffers container
 	typedef boost::unordered_map <std::string, InputBufferBase *> buffers_t;
@@ -43,6 +68,12 @@ protected:
 	//! Buffer container
 	buffers_t buffers;
 
+	//! Datatype of buffers container indexed with identifiers
+	typedef boost::unordered_map <uint32_t, InputBufferBase *> buffer_ids_t;
+
+	//! Buffer container indexed with identifiers
+	buffer_ids_t buffer_ids;
+
 	//! List buffers of the agent
 	void listBuffers() const;
 
@@ -50,6 +81,23 @@ private:
 	//! server channel id
 	messip_channel_t * channel;
 
+	//! Buffers which received data since the last takeReadyBuffers()
+	ready_buffers_t ready_buffers;
+
+	//! A buffer already on the ready list received data again
+	bool ready_buffer_overwritten;
+
+	//! Add the buffer to the ready list
+	void markReady(InputBufferBase & buf)
+	{
+		if (!buf.ready) {
+			buf.ready = true;
+			ready_buffers.push_back(&buf);
+		} else {
+			ready_buffer_overwritten = true;
+		}
+	}
+
 	//! Store data from archive into a buffer
 	template <std::size_t size>
 	void Store(const std::string & buffer_name, xdr_iarchive <size> & ia)
@@ -65,14 +113,29 @@ private:
 		buffers_t::iterator result = buffers.find(buffer_name);
 		if (result != buffers.end()) {
 			result->second->Store(ia);
+			markReady(*result->second);
 		} else {
 			// TODO: exception?
 			std::cerr << "Message received for unknown buffer '" << buffer_name << "'" << std::endl;
 		}
 	}
 
+	//! Store data from archive into a buffer
+	template <std::size_t size>
+	void Store(uint32_t buffer_id, xdr_iarchive <size> & ia)
+	{
+		buffer_ids_t::iterator result = buffer_ids.find(buffer_id);
+		if (result != buffer_ids.end()) {
+			result->second->Store(ia);
+			markReady(*result->second);
+		} else {
+			// TODO: exception?
+			std::cerr << "Message received for unknown buffer id " << buffer_id << std::endl;
+		}
+	}
+
 	//! Receive single message
-	int ReceiveMessage(void * msg, std::size_t msglen, bool block);
+	int ReceiveMessage(void * msg, std::size_t msglen, bool block, int32_t & type, int32_t & subtype);
 
 	//! Give access to buffer registration
 	friend class InputBufferBase;
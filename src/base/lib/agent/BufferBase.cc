@@ -14,7 +14,7 @@ namespace lib {
 namespace agent {
 
 BufferBase::BufferBase(const std::string & _name)
-	: name(_name)
+	: name(_name), id(nameToId(_name))
 {
 }
 
@@ -23,6 +23,24 @@ const std::string & BufferBase::getName() const
 	return this->name;
 }
 
+uint32_t BufferBase::getId() const
+{
+	return this->id;
+}
+
+uint32_t BufferBase::nameToId(const std::string & _name)
+{
+	// FNV-1a
+	uint32_t h = 2166136261u;
+
+	for (std::string::const_iterator it = _name.begin(); it != _name.end(); ++it) {
+		h ^= (unsigned char) *it;
+		h *= 16777619u;
+	}
+
+	return h;
+}
+
 } // namespace agent
 } // namespace lib
 } // namespace mrrocpp
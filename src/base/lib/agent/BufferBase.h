@@ -10,6 +10,8 @@
 
 #include <string>
 
+#include <stdint.h>
+
 #include <boost/utility.hpp>
 
 namespace mrrocpp {
@@ -23,12 +25,25 @@ class BufferBase : private boost::noncopyable {
 	//! name of the data buffer
 	const std::string name;
 
+	//! identifier of the data buffer, derived from the name
+	const uint32_t id;
+
 public:
 	//! Constructor
 	BufferBase(const std::string & _name);
 
 	//! get name of the buffer
 	const std::string & getName() const;
+
+	//! get identifier of the buffer, used in messages instead of the name
+	uint32_t getId() const;
+
+	/**
+	 * Intern the buffer name into an integer identifier
+	 * @param _name name of the buffer
+	 * @return identifier, the same on both sides of the connection
+	 */
+	static uint32_t nameToId(const std::string & _name);
 };
 
 } // namespace agent
@@ -13,7 +13,7 @@ namespace lib {
 namespace agent {
 
 InputBufferBase::InputBufferBase(Agent & _owner, const std::string & _name)
-	: BufferBase(_name), owner(_owner)
+	: BufferBase(_name), owner(_owner), ready(false)
 {
 	owner.registerBuffer(*this);
 }
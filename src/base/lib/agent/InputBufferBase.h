@@ -30,6 +30,9 @@ class InputBufferBase : public BufferBase {
 	//! Owner of the buffer
 	Agent & owner;
 
+	//! Data stored since the owner collected the ready buffers
+	bool ready;
+
 protected:
 	//! store new data
 	virtual void Store(xdr_iarchive<> & ia) = 0;
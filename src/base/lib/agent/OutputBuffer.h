@@ -37,10 +37,9 @@ public:
 	//! Set the contents of the remote buffer
 	void Send(const T & data) {
 		xdr_oarchive<> oa;
-		oa << this->getName();
 		oa << data;
 
-		owner.Send(oa);
+		owner.Send(this->getId(), oa);
 	}
 };
 
@@ -10,9 +10,8 @@
 #include <cstdio>
 #include <unistd.h>
 
-#include <boost/thread/thread.hpp>
-
 #include "RemoteAgent.h"
+#include "Agent.h"
 
 #include "../messip/messip.h"
 // TODO: rewrite with messip dataport wrapper
@@ -27,10 +26,14 @@ namespace mrrocpp {
 namespace lib {
 namespace agent {
 
-void RemoteAgent::Send(const xdr_oarchive <> & oa)
+void RemoteAgent::Send(uint32_t id, const xdr_oarchive <> & oa)
 {
-	// do a non-blocking send
-	int ret = messip_send(channel, 0, 0, oa.get_buffer(), oa.getArchiveSize(), NULL, NULL, -1, MESSIP_NOTIMEOUT);
+	if (!channel) {
+		Connect();
+	}
+
+	// do a non-blocking send, buffer identifier goes in the message header
+	int ret = messip_send(channel, Agent::MSG_BUFFER_ID, (int32_t) id, oa.get_buffer(), oa.getArchiveSize(), NULL, NULL, -1, MESSIP_NOTIMEOUT);
 
 	if (ret != 0) {
 		throw std::logic_error("Could not send to remote agent");
@@ -39,24 +42,20 @@ void RemoteAgent::Send(const xdr_oarchive <> & oa)
 
 void RemoteAgent::Ping()
 {
+	if (!channel) {
+		Connect();
+	}
+
 	if(messip::port_ping(channel) != 0)
 		throw std::runtime_error("Pinging remote agent failed");
 }
 
-RemoteAgent::RemoteAgent(const std::string & _name) :
-		AgentBase(_name)
+void RemoteAgent::Connect()
 {
-	// nawiazanie komunikacji z ECP
-	unsigned int tmp = 0;
-	// kilka sekund  (~1) na otworzenie urzadzenia
-
-	while ((channel = messip::port_connect(_name)) == NULL) {
-		if ((tmp++) < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-		} else {
-			fprintf(stderr, "Connect to failed at channel '%s'\n", _name.c_str());
-			throw std::runtime_error("Connect to remote agent failed");
-		}
+	// nawiazanie komunikacji, zarzadca messip powiadamia o utworzeniu kanalu
+	if ((channel = messip::port_connect_wait(getName(), lib::CONNECT_TIMEOUT)) == NULL) {
+		fprintf(stderr, "Connect to failed at channel '%s'\n", getName().c_str());
+		throw std::runtime_error("Connect to remote agent failed");
 	}
 
 //	// Verify if channel is ready to transmit data
@@ -65,9 +64,17 @@ RemoteAgent::RemoteAgent(const std::string & _name) :
 //	}
 }
 
+RemoteAgent::RemoteAgent(const std::string & _name, bool deferred) :
+		AgentBase(_name), channel(NULL)
+{
+	if (!deferred) {
+		Connect();
+	}
+}
+
 RemoteAgent::~RemoteAgent()
 {
-	if (messip::port_disconnect(channel, MESSIP_NOTIMEOUT) != 0) {
+	if (channel && messip::port_disconnect(channel, MESSIP_NOTIMEOUT) != 0) {
 		// TODO: check for results
 	}
 }
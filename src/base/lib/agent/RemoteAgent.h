@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include <stdint.h>
+
 #include "AgentBase.h"
 
 #include "../messip/messip_dataport.h"
@@ -16,8 +18,13 @@ namespace agent {
  */
 class RemoteAgent : public AgentBase {
 public:
-	//! Connect to remote agent
-	RemoteAgent(const std::string & _name);
+	/**
+	 * Connect to remote agent
+	 * @param _name name of the remote agent
+	 * @param deferred wait for the remote agent on the first communication, not in the constructor;
+	 * this lets to spawn a number of agents and then to wait for all of them concurrently
+	 */
+	RemoteAgent(const std::string & _name, bool deferred = false);
 
 	//! Check connection with ping message
 	void Ping();
@@ -29,13 +36,16 @@ private:
 	//! remote server channel id
 	messip_channel_t * channel;
 
+	//! Wait until the remote agent creates its channel and connect to it
+	void Connect();
+
 	/**
 	 * Set the data of given buffer
-	 * @param name buffer name
-	 * @param the data
+	 * @param id buffer identifier
+	 * @param oa the data
 	 * @todo this should not be public method but friending with template OutputBuffer is tricky
 	 */
-	void Send(const xdr_oarchive<> & oa);
+	void Send(uint32_t id, const xdr_oarchive<> & oa);
 
 	template <class T> friend class OutputBuffer;
 };
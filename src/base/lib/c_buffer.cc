@@ -5,6 +5,7 @@ namespace lib {
 
 c_buffer::c_buffer (void) :
   instruction_type(SYNCHRO),
+  query_in_reply(false),
   set_type(0),
   get_type(0),
   get_robot_model_type(TOOL_FRAME),
@@ -302,8 +302,9 @@ enum MOTION_TYPE
 enum INTERPOLATION_TYPE
 {
 	MIM, //! motor interpolated motion
-	TCIM
-//! task coordinates interpolated motion
+	TCIM, //! task coordinates interpolated motion
+	OTG
+//! online trajectory generation in the servo loop
 };
 
 //------------------------------------------------------------------------------
@@ -480,11 +481,48 @@ private:
 	}
 } c_buffer_arm_t;
 
+//------------------------------------------------------------------------------
+/*!
+ *  Parameters of the online trajectory generation (interpolation_type == OTG).
+ *  Values are expressed in the coordinates of the target (set_arm_type);
+ *  in case of FRAME in the joint coordinates.
+ */
+typedef struct c_buffer_otg
+{
+	/*! Velocity at the target position. */
+	double target_velocity[lib::MAX_SERVOS_NR];
+	/*! Velocity limits. */
+	double max_velocity[lib::MAX_SERVOS_NR];
+	/*! Acceleration limits. */
+	double max_acceleration[lib::MAX_SERVOS_NR];
+	/*! Jerk limits. */
+	double max_jerk[lib::MAX_SERVOS_NR];
+
+private:
+	//! Give access to boost::serialization framework
+	friend class boost::serialization::access;
+
+	//! Serialization of the data structure
+	template <class Archive>
+	void serialize(Archive & ar, const unsigned int version)
+	{
+		ar & target_velocity;
+		ar & max_velocity;
+		ar & max_acceleration;
+		ar & max_jerk;
+	}
+} c_buffer_otg_t;
+
 //------------------------------------------------------------------------------
 struct c_buffer
 {
 	/*! Type of the instruction. */
 	INSTRUCTION_TYPE instruction_type;
+	/*!
+	 *  Reply to SET, GET or SET_GET only after the instruction is executed,
+	 *  so the reply carries the result and no separate QUERY is sent.
+	 */
+	bool query_in_reply;
 	/*! Type of the SET instruction. */
 	uint8_t set_type;
 	/*! Type of the GET instruction. */
@@ -531,6 +569,8 @@ struct c_buffer
 	uint16_t value_in_step_no;
 	c_buffer_robot_model_t robot_model;
 	c_buffer_arm_t arm;
+	/*! Trajectory limits, sent only with the OTG interpolation. */
+	c_buffer_otg_t otg;
 
 	//-----------------------------------------------------
 	//                      METHODS
@@ -582,6 +622,7 @@ private:
 	void serialize(Archive & ar, const unsigned int version)
 	{
 		ar & instruction_type;
+		ar & query_in_reply;
 		ar & set_type;
 		ar & get_type;
 		ar & get_robot_model_type;
@@ -594,6 +635,9 @@ private:
 		ar & value_in_step_no;
 		ar & robot_model;
 		ar & arm;
+		if (interpolation_type == OTG) {
+			ar & otg;
+		}
 	}
 };
 
@@ -743,6 +787,9 @@ struct r_buffer_base
 	/*! Number of the error (if it occured). */
 	edp_error error_no;
 
+	/*! The reply carries the result of the executed instruction (QUERY folded into the reply). */
+	bool query_in_reply;
+
 	//! Set default values
 	r_buffer_base();
 
@@ -756,6 +803,7 @@ private:
 	{
 		ar & reply_type;
 		ar & error_no;
+		ar & query_in_reply;
 	}
 };
 
@@ -11,10 +11,20 @@
 #define _CONFIG_TYPES_H
 
 #include <string>
+#include <stdint.h>
 #include <boost/serialization/string.hpp>
 
 #define CONFIGSRV_CHANNEL_NAME			"configsrv"
 
+//! Message type of the single value query or configuration file change
+#define CONFIGSRV_QUERY_VALUE			0
+
+//! Message type of the configuration snapshot request (message subtype is the page number)
+#define CONFIGSRV_QUERY_SNAPSHOT		1
+
+//! Approximate size of the single snapshot page in bytes
+#define CONFIGSRV_SNAPSHOT_PAGE_SIZE	8192
+
 //! Data structure for passing two property trees
 typedef struct _config_query {
 	// in request: true if the file change requested, false otherwise
@@ -30,4 +40,25 @@ void serialize(Archive & ar, config_query_t & query, const unsigned int version)
     ar & query.key;
 }
 
+//! Single page of the merged (common and task) configuration
+typedef struct _config_snapshot {
+	//! Configuration version, changed with every configuration file change
+	uint32_t version;
+	//! Total number of pages, zero if the requested page does not exist
+	uint32_t pages;
+	/**
+	 * Entries of the page, each encoded as "<key length> <value length>\n<key><value>",
+	 * where key is the full "section.key" path
+	 */
+	std::string entries;
+} config_snapshot_t;
+
+template<class Archive>
+void serialize(Archive & ar, config_snapshot_t & snapshot, const unsigned int version)
+{
+    ar & snapshot.version;
+    ar & snapshot.pages;
+    ar & snapshot.entries;
+}
+
 #endif /* _CONFIG_TYPES_H */
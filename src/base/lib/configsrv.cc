@@ -8,7 +8,9 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <map>
 
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -17,8 +19,25 @@
 
 #include "base/lib/configsrv.h"
 
+namespace {
+
+//! Collect leaves of the property tree as "path.to.key" -> value entries; already present entries are kept
+void flatten_property_tree(const boost::property_tree::ptree & pt, const std::string & prefix, std::map <std::string, std::string> & entries)
+{
+	for (boost::property_tree::ptree::const_iterator it = pt.begin(); it != pt.end(); ++it) {
+		const std::string path = prefix.empty() ? it->first : (prefix + "." + it->first);
+		if (it->second.empty()) {
+			entries.insert(std::make_pair(path, it->second.data()));
+		} else {
+			flatten_property_tree(it->second, path, entries);
+		}
+	}
+}
+
+} // namespace
+
 configsrv::configsrv(const std::string & _dir) :
-	dir(_dir)
+	dir(_dir), version(0)
 {
 	// Path to config file
 	std::string file_location, common_file_location;
@@ -59,6 +78,36 @@ void configsrv::change_ini_file(const std::string & ini_file)
 
 	// Reload configuration
 	read_property_tree_from_file(file_pt, file_location);
+
+	++version;
+}
+
+uint32_t configsrv::get_version() const
+{
+	return version;
+}
+
+void configsrv::snapshot(std::vector <std::string> & pages, std::size_t page_size) const
+{
+	// Same precedence as in value(): task file first, then common file
+	std::map <std::string, std::string> entries;
+	flatten_property_tree(file_pt, "", entries);
+	flatten_property_tree(common_file_pt, "", entries);
+
+	pages.clear();
+
+	std::ostringstream page;
+	for (std::map <std::string, std::string>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		page << it->first.size() << ' ' << it->second.size() << '\n' << it->first << it->second;
+		if (page.tellp() >= (std::streampos) page_size) {
+			pages.push_back(page.str());
+			page.str("");
+		}
+	}
+
+	if (pages.empty() || page.tellp() > 0) {
+		pages.push_back(page.str());
+	}
 }
 
 std::string configsrv::value(const std::string & pt_path) const
@@ -10,6 +10,10 @@
 #if !defined(_CONFIGSRV_H)
 #define _CONFIGSRV_H
 
+#include <string>
+#include <vector>
+#include <stdint.h>
+
 #include <boost/property_tree/ptree.hpp>
 
 class configsrv
@@ -25,6 +29,9 @@ private:
 	 */
 	void read_property_tree_from_file(boost::property_tree::ptree & pt, const std::string & file);
 
+	//! Configuration version, incremented with every configuration file change
+	uint32_t version;
+
 public:
 	//! Property trees of configuration files
 	boost::property_tree::ptree common_file_pt, file_pt;
@@ -36,6 +43,16 @@ public:
 	std::string value(const std::string & path) const;
 
 	void change_ini_file(const std::string & _ini_file);
+
+	//! Get the configuration version
+	uint32_t get_version() const;
+
+	/**
+	 * Encode the merged configuration (task file entries override the common ones)
+	 * @param pages encoded entries split into pages, each of them about page_size bytes long
+	 * @param page_size size of a single page
+	 */
+	void snapshot(std::vector <std::string> & pages, std::size_t page_size) const;
 };
 
 #endif /* _CONFIGSRV_H */
@@ -13,7 +13,9 @@
 #include <cstring>
 #include <csignal>
 #include <cstdlib>
+#include <iostream>
 #include <string>
+#include <vector>
 
 #include "base/lib/messip/messip_dataport.h"
 
@@ -40,6 +42,11 @@ main(int argc, char *argv[])
 		perror("signal()");
 	}
 
+	// Encoded configuration snapshot, rebuilt after the configuration file change
+	std::vector <std::string> snapshot_pages;
+	uint32_t snapshot_version = config.get_version();
+	config.snapshot(snapshot_pages, CONFIGSRV_SNAPSHOT_PAGE_SIZE);
+
 	try {
 		while(true) {
 			int32_t type, subtype;
@@ -53,6 +60,27 @@ main(int argc, char *argv[])
 				continue;
 			}
 
+			if (type == CONFIGSRV_QUERY_SNAPSHOT) {
+				//! Request for the page of the whole configuration
+				if (snapshot_version != config.get_version()) {
+					config.snapshot(snapshot_pages, CONFIGSRV_SNAPSHOT_PAGE_SIZE);
+					snapshot_version = config.get_version();
+				}
+
+				config_snapshot_t snapshot;
+				snapshot.version = snapshot_version;
+
+				if (subtype >= 0 && (std::size_t) subtype < snapshot_pages.size()) {
+					snapshot.pages = snapshot_pages.size();
+					snapshot.entries = snapshot_pages[subtype];
+				} else {
+					snapshot.pages = 0;
+				}
+
+				messip::port_reply(ch, rcvid, 0, snapshot);
+				continue;
+			}
+
 			config_query_t reply;
 			reply.flag = false;
 
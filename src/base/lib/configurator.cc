@@ -68,6 +68,140 @@ configurator::configurator(const std::string & _node, const std::string & _dir,
 	if ((ch = messip::port_connect(CONFIGSRV_CHANNEL_NAME)) == NULL) {
 	}
 	assert(ch);
+
+	// Fetch the whole configuration at once, later lookups are local
+	load_snapshot();
+}
+
+bool configurator::load_snapshot()
+{
+	boost::shared_ptr <snapshot_t> fresh(new snapshot_t);
+
+	config_query_t query;
+	query.flag = false;
+
+	// Retry if the configuration file was changed during the transfer
+	for (int attempt = 0; attempt < 3; ++attempt) {
+		fresh->clear();
+
+		uint32_t pages = 1;
+		uint32_t version = 0;
+		bool consistent = true;
+
+		for (uint32_t page = 0; page < pages; ++page) {
+			config_snapshot_t reply;
+
+			try {
+				boost::mutex::scoped_lock l(access_mutex);
+
+				if (messip::port_send(this->ch, CONFIGSRV_QUERY_SNAPSHOT, page, query, reply) != 0) {
+					reply.pages = 0;
+				}
+			} catch (std::exception & e) {
+				reply.pages = 0;
+			}
+
+			if (reply.pages == 0) {
+				// Configuration server without snapshot support - use remote queries
+				boost::mutex::scoped_lock l(access_mutex);
+				snapshot.reset();
+				return false;
+			}
+
+			if (page == 0) {
+				pages = reply.pages;
+				version = reply.version;
+			} else if (reply.version != version) {
+				consistent = false;
+				break;
+			}
+
+			// Decode "<key length> <value length>\n<key><value>" entries
+			const std::string & entries = reply.entries;
+			std::size_t pos = 0;
+			while (pos < entries.size()) {
+				const std::size_t eol = entries.find('\n', pos);
+				unsigned long key_length, value_length;
+				if (eol == std::string::npos || sscanf(entries.c_str() + pos, "%lu %lu", &key_length, &value_length) != 2
+						|| eol + 1 + key_length + value_length > entries.size()) {
+					std::cerr << "configurator: malformed configuration snapshot" << std::endl;
+					boost::mutex::scoped_lock l(access_mutex);
+					snapshot.reset();
+					return false;
+				}
+				pos = eol + 1;
+				(*fresh)[entries.substr(pos, key_length)] = entries.substr(pos + key_length, value_length);
+				pos += key_length + value_length;
+			}
+		}
+
+		if (consistent) {
+			boost::mutex::scoped_lock l(access_mutex);
+			snapshot = fresh;
+			return true;
+		}
+	}
+
+	boost::mutex::scoped_lock l(access_mutex);
+	snapshot.reset();
+	return false;
+}
+
+void configurator::reload()
+{
+	load_snapshot();
+}
+
+std::string configurator::config_path(const std::string & _key, const std::string & __section_name)
+{
+	// initialize property tree path
+	std::string pt_path = __section_name;
+
+	// trim leading '[' char
+	pt_path.erase(0, 1);
+	// trim trailing '[' char
+	pt_path.erase(pt_path.length() - 1, 1);
+
+	pt_path += ".";
+	pt_path += _key;
+
+	return pt_path;
+}
+
+bool configurator::lookup(const std::string & pt_path, std::string & result) const
+{
+	boost::shared_ptr <const snapshot_t> current;
+
+	{
+		boost::mutex::scoped_lock l(access_mutex);
+		current = snapshot;
+	}
+
+	if (current) {
+		snapshot_t::const_iterator it = current->find(pt_path);
+
+		if (it == current->end()) {
+			return false;
+		}
+
+		result = it->second;
+		return true;
+	}
+
+	boost::mutex::scoped_lock l(access_mutex);
+
+	config_query_t query, reply;
+
+	query.key = pt_path;
+	query.flag = false;
+
+	messip::port_send(this->ch, CONFIGSRV_QUERY_VALUE, 0, query, reply);
+
+	if (reply.flag) {
+		result = reply.key;
+	}
+
+	return reply.flag;
 }
 
 void configurator::change_config_file(const std::string & _ini_file)
@@ -80,13 +214,16 @@ void configurator::change_config_file(const std::string & _ini_file)
 	{
 		boost::mutex::scoped_lock l(access_mutex);
 
-		messip::port_send(this->ch, 0, 0, query, reply);
+		messip::port_send(this->ch, CONFIGSRV_QUERY_VALUE, 0, query, reply);
 	}
 
 	if (!reply.flag) {
 		// TODO: throw
 		std::cerr << "change_config_file to " << _ini_file << " failed" << std::endl;
 	}
+
+	// Configuration has changed - fetch it again
+	load_snapshot();
 }
 
 bool configurator::check_config(const std::string & key) const
@@ -202,24 +339,14 @@ std::string configurator::return_mrrocpp_network_path() const
 
 bool configurator::exists(const std::string & _key) const
 {
-	try {
-		value <std::string> (_key, section_name);
-	} catch (boost::property_tree::ptree_error & e) {
-		return false;
-	}
-
-	return true;
+	return exists(_key, section_name);
 }
 
 bool configurator::exists(const std::string & _key, const std::string & _section_name) const
 {
-	try {
-		value <std::string> (_key, _section_name);
-	} catch (boost::property_tree::ptree_error & e) {
-		return false;
-	}
+	std::string result;
 
-	return true;
+	return lookup(config_path(_key, _section_name), result);
 }
 
 bool configurator::exists_and_true(const char* _key, const char* __section_name) const
@@ -24,6 +24,8 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/property_tree/exceptions.hpp>
 
 #include "base/lib/messip/messip_dataport.h"
@@ -54,6 +56,37 @@ private:
 	//! Communication channel to the configuration server
 	messip_channel_t *ch;
 
+	//! Local copy of the whole configuration: "section.key" -> value
+	typedef boost::unordered_map <std::string, std::string> snapshot_t;
+
+	/**
+	 * Configuration snapshot fetched from the configuration server, never modified in place.
+	 * Empty if the server does not provide snapshots; then every lookup is a remote query.
+	 */
+	boost::shared_ptr <const snapshot_t> snapshot;
+
+	/**
+	 * Fetch the whole merged configuration from the configuration server
+	 * @return true if the snapshot was fetched
+	 */
+	bool load_snapshot();
+
+	/**
+	 * Build the configuration path from the key and the section name
+	 * @param _key configuration key
+	 * @param __section_name section name (in brackets)
+	 * @return configuration path
+	 */
+	static std::string config_path(const std::string & _key, const std::string & __section_name);
+
+	/**
+	 * Find configuration value
+	 * @param pt_path configuration path
+	 * @param result found value
+	 * @return true if the value was found
+	 */
+	bool lookup(const std::string & pt_path, std::string & result) const;
+
 public:
 
 	//! returns sr attach point
@@ -152,6 +185,12 @@ public:
 	 */
 	void change_config_file(const std::string & _ini_file);
 
+	/**
+	 * Fetch again the configuration from the configuration server,
+	 * i.e. after the configuration file was changed by another process
+	 */
+	void reload();
+
 	/**
 	 * Spawn new process
 	 * @param _section_name configuration section of the process to spawn
@@ -190,28 +229,12 @@ public:
 	template <class Type>
 	Type value(const std::string & _key, const std::string & __section_name) const
 	{
-		// initialize property tree path
-		std::string pt_path = __section_name;
-
-		// trim leading '[' char
-		pt_path.erase(0, 1);
-		// trim trailing '[' char
-		pt_path.erase(pt_path.length() - 1, 1);
-
-		pt_path += ".";
-		pt_path += _key;
-
-		boost::mutex::scoped_lock l(access_mutex);
-
-		config_query_t query, reply;
-
-		query.key = pt_path;
-		query.flag = false;
+		const std::string pt_path = config_path(_key, __section_name);
 
-		messip::port_send(this->ch, 0, 0, query, reply);
+		std::string result;
 
-		if (reply.flag) {
-			return boost::lexical_cast <Type>(reply.key);
+		if (lookup(pt_path, result)) {
+			return boost::lexical_cast <Type>(result);
 		} else {
 			throw boost::property_tree::ptree_error("remote config query failed: probably missing key \""
 					+ __section_name + "." + _key + "\" in config file. pt_path=\"" + pt_path + "\".");
@@ -27,8 +27,11 @@ namespace lib {
 const int MP_2_ECP_SERIALIZED_DATA_SIZE = 500;
 
 // Stale do komunikacji
-const unsigned int CONNECT_RETRY = 500;
-const boost::posix_time::time_duration CONNECT_DELAY = boost::posix_time::milliseconds(20);
+//! Czas oczekiwania na utworzenie kanalu przez uruchamiany proces [ms]
+const int32_t CONNECT_TIMEOUT = 10000;
+
+// Okres wysylania zakolejkowanych komunikatow do SR
+const boost::posix_time::time_duration SR_FLUSH_PERIOD = boost::posix_time::milliseconds(20);
 
 // ----------------------- PRZYDATNE STALE ---------------------------
 const std::string MP_SECTION = "[mp]";
@@ -61,6 +64,17 @@ const double TORQUE_RECIPROCAL_DAMPING = 0.1;
 const std::string ROBOT_TEST_MODE = "robot_test_mode";
 const std::string FORCE_SENSOR_TEST_MODE = "force_sensor_test_mode";
 
+// Single round trip SET/GET with the EDP (enabled unless set to 0 in the EDP section)
+const std::string PIPELINED_MOTION = "pipelined_motion";
+
+// Name of the servo clock shared by the co-located EDPs (EDP section, phase-locking disabled if absent)
+const std::string SERVO_CLOCK = "servo_clock";
+
+// Simulated motors instead of the hardware of a servo_buffer driven robot (EDP section)
+const std::string HARDWARE_SIMULATION = "hardware_simulation";
+// Multiple of the real time of the simulated hardware, 0 for the unthrottled run (EDP section, default 1)
+const std::string SIMULATION_SPEED = "simulation_speed";
+
 // Stale czasowe
 
 const int PTHREAD_MAX_PRIORITY = 10;
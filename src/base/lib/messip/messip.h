@@ -33,6 +33,14 @@
 
 #if defined(__linux__)
 //#define USE_SRRMOD	1
+
+// Shared-memory transport between peers running on the same host
+#define USE_SHMMSG	1
+
+// epoll-driven receive, not limited by FD_SETSIZE
+#if !defined(USE_SRRMOD)
+#define USE_EPOLL	1
+#endif
 #endif /* __linux__ */
 
 
@@ -46,6 +54,7 @@
 #define CHANNEL_TYPE_MESSIP		0
 #define CHANNEL_TYPE_SRRMOD		1
 #define CHANNEL_TYPE_QNXMSG		2
+#define CHANNEL_TYPE_SHMMSG		3
 
 #define MESSIP_ETC	"/etc/messip"
 #define	MESSIP_DEFAULT_PORT	9200
@@ -80,6 +89,18 @@
 #define MESSIP_TRUE		-1
 #define MESSIP_FALSE	0
 
+/*
+ * Initial number of reply slots (receive() without reply()) of a channel;
+ * the table is doubled when all of them are in use
+ */
+#define MESSIP_REPLY_SLOTS		8
+
+/*
+ * Initial number of sockets (listening + accepted) of a channel;
+ * the table is doubled when all of them are in use
+ */
+#define MESSIP_RECV_SOCKFD_SLOTS	16
+
 #define	MESSIP_MAXLEN_TASKNAME		15
 #define	MESSIP_CHANNEL_NAME_MAXLEN	47
 #define	MESSIP_QNXNODE_NAME_MAXLEN	47
@@ -105,7 +126,8 @@ typedef struct messip_channel
 	char remote_taskname[MESSIP_CHANNEL_NAME_MAXLEN + 1];
 	pthread_t remote_tid;
 	int32_t recv_sockfd_sz;
-	int recv_sockfd[FD_SETSIZE];
+	int32_t recv_sockfd_max; // Size allocated for recv_sockfd
+	int *recv_sockfd; // Listening socket followed by the accepted connections
 	int remote_port;
 	in_port_t sin_port;
 	in_addr_t sin_addr;
@@ -128,6 +150,15 @@ typedef struct messip_channel
 	int srr_name_id;
 	int srr_pid;
 #endif /* USE_SSRMOD */
+#ifdef USE_EPOLL
+	int epoll_fd; // descriptors of recv_sockfd[] and shm_doorbell
+#endif /* USE_EPOLL */
+#ifdef USE_SHMMSG
+	struct messip_shm *shm; // shared memory segment, NULL if not available
+	int shm_slot; // client slot in the segment
+	int shm_doorbell; // datagram socket for waking up the server
+	int shm_next; // slot to start the next scan from (server side)
+#endif /* USE_SHMMSG */
 #ifdef USE_QNXMSG
 	resmgr_connect_funcs_t ConnectFuncs;
 	resmgr_io_funcs_t IoFuncs;
@@ -189,6 +220,8 @@ messip_channel_t
 		*messip_channel_create(messip_cnx_t * cnx, const char *name, int msec_timeout, int32_t maxnb_msg_buffered);
 int messip_channel_delete(messip_channel_t * ch, int msec_timeout);
 messip_channel_t *messip_channel_connect(messip_cnx_t * cnx, const char *name, int msec_timeout);
+/* Block until the channel is created; 0 if it exists, -1 (errno ETIMEDOUT) on timeout */
+int messip_channel_wait(const char *mgr_ref, const char *name, int msec_timeout);
 int messip_channel_disconnect(messip_channel_t * ch, int msec_timeout);
 int messip_channel_ping(messip_channel_t * ch, int msec_timeout);
 int
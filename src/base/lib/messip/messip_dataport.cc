@@ -5,6 +5,8 @@
  *      Author: ptroja
  */
 
+#include <cstdlib>
+
 #include "base/lib/messip/messip_dataport.h"
 
 namespace messip {
@@ -61,6 +63,19 @@ port_connect(const std::string & name,
 	return messip_channel_connect(NULL, name.c_str(), msec_timeout);
 }
 
+messip_channel_t *
+port_connect_wait(const std::string & name,
+   int32_t msec_timeout)
+{
+	// the same manager as of the connexion of the process
+	if (messip_channel_wait(getenv("UI_HOST"), name.c_str(), msec_timeout) == -1) {
+		return NULL;
+	}
+
+	// the channel exists, so the manager replies at once
+	return messip_channel_connect(NULL, name.c_str(), MESSIP_NOTIMEOUT);
+}
+
 int
 port_disconnect( messip_channel_t * ch,
    int32_t msec_timeout)
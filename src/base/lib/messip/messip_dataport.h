@@ -29,17 +29,18 @@ int port_send( messip_channel_t * ch,
 	oa << send;
 
 	int32_t answer;
-	char reply_data[16384];
+
+	// reply is received directly into the archive buffer
+	xdr_iarchive<> ia;
 
 	int r = messip_send(ch, type, subtype,
 			oa.get_buffer(), oa.getArchiveSize(),
 			&answer,
-			&reply_data, sizeof(reply_data),
+			ia.get_buffer(), ia.get_buffer_size(),
 			msec_timeout);
 
 	if (r == 0) {
-		xdr_iarchive<> ia(reply_data, ch->datalenr);
-
+		ia.set_data_size(ch->datalenr);
 		ia >> reply;
 	}
 
@@ -86,13 +87,13 @@ int port_receive( messip_channel_t * ch,
    ReceiveData & data,
    int32_t msec_timeout = MESSIP_NOTIMEOUT)
 {
-	char receive_data[16384];
+	// message is received directly into the archive buffer
+	xdr_iarchive<> ia;
 
-	int r = messip_receive(ch, &type, &subtype, &receive_data, sizeof(receive_data), msec_timeout);
+	int r = messip_receive(ch, &type, &subtype, ia.get_buffer(), ia.get_buffer_size(), msec_timeout);
 
 	if ((r >= 0 || r == MESSIP_MSG_NOREPLY) && ch->datalenr > 0) {
-		xdr_iarchive<> ia(receive_data, ch->datalenr);
-
+		ia.set_data_size(ch->datalenr);
 		ia >> data;
 	}
 
@@ -138,6 +139,16 @@ messip_channel_t *
 port_connect(const std::string & name,
    int32_t msec_timeout = MESSIP_NOTIMEOUT);
 
+/**
+ * Connect to a channel, waiting for its server to create it
+ * @param name channel name
+ * @param msec_timeout limit of the wait for the channel
+ * @return channel, NULL if it has not been created in time
+ */
+messip_channel_t *
+port_connect_wait(const std::string & name,
+   int32_t msec_timeout = MESSIP_NOTIMEOUT);
+
 int
 port_disconnect( messip_channel_t * ch,
    int32_t msec_timeout = MESSIP_NOTIMEOUT);
@@ -49,6 +49,7 @@
 #include <signal.h>
 #include <assert.h>
 #include <sys/select.h>
+#include <poll.h>
 #include <netinet/tcp.h>
 #if defined(__QNX__)
 #include <sys/param.h>
@@ -62,6 +63,11 @@
 #include "messip.h"
 #include "messip_private.h"
 #include "messip_utils.h"
+#include "messip_shm.h"
+
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif /* USE_EPOLL */
 
 #ifdef USE_SRRMOD
 #include <srr.h>
@@ -249,6 +255,114 @@ messip_select( int fd,
 
 }								// messip_select
 
+/*
+	Wait until a single descriptor can be written to; poll() is used
+	as the descriptor may be above FD_SETSIZE
+	Returns 1 if ready, 0 on timeout
+*/
+static int
+messip_wait_writable( int fd,
+   int msec_timeout )
+{
+	struct pollfd pfd;
+	int status;
+
+	pfd.fd = fd;
+	pfd.events = POLLOUT;
+	pfd.revents = 0;
+	do
+	{
+		status = poll( &pfd, 1, msec_timeout );
+	} while ( (status == -1) && (errno == EINTR) );
+	assert( status != -1 );
+
+	return ( status > 0 );
+
+}								// messip_wait_writable
+
+/*
+	Absolute deadline of a timed wait, so that restarted waits do not
+	extend it
+*/
+static void
+messip_deadline_set( struct timespec * deadline,
+   int msec_timeout )
+{
+	clock_gettime( CLOCK_MONOTONIC, deadline );
+	deadline->tv_sec += msec_timeout / 1000;
+	deadline->tv_nsec += ( msec_timeout % 1000 ) * 1000000L;
+	if ( deadline->tv_nsec >= 1000000000L )
+	{
+		deadline->tv_sec++;
+		deadline->tv_nsec -= 1000000000L;
+	}
+
+}								// messip_deadline_set
+
+/*
+	Time left until the deadline [ms], rounded up; 0 if already passed
+*/
+static int
+messip_deadline_remaining( const struct timespec * deadline )
+{
+	struct timespec now;
+	long long left_ns;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	left_ns = ( long long ) ( deadline->tv_sec - now.tv_sec ) * 1000000000LL
+		+ ( deadline->tv_nsec - now.tv_nsec );
+
+	return ( left_ns > 0 ) ? ( int ) ( ( left_ns + 999999LL ) / 1000000LL ) : 0;
+
+}								// messip_deadline_remaining
+
+#ifdef USE_EPOLL
+static void
+messip_epoll_add( messip_channel_t * ch,
+   int fd )
+{
+	struct epoll_event event;
+
+	memset( &event, 0, sizeof( event ) );
+	event.events = EPOLLIN;
+	event.data.fd = fd;
+	if ( epoll_ctl( ch->epoll_fd, EPOLL_CTL_ADD, fd, &event ) == -1 )
+		fprintf( stderr, "%s %d: epoll_ctl(%d): %s\n",
+			__FILE__, __LINE__, fd, strerror( errno ) );
+
+}								// messip_epoll_add
+#endif /* USE_EPOLL */
+
+/*
+	Close a connection accepted on the channel and remove it from the list;
+	only done when a client goes away, so the linear search is fine here
+*/
+static void
+messip_recv_sockfd_close( messip_channel_t * ch,
+   int sockfd )
+{
+	int n,
+	  k;
+
+#ifdef USE_EPOLL
+	epoll_ctl( ch->epoll_fd, EPOLL_CTL_DEL, sockfd, NULL );
+#endif /* USE_EPOLL */
+	shutdown( sockfd, SHUT_RDWR );
+	close( sockfd );
+
+	for ( n = 1; n < ch->recv_sockfd_sz; n++ )
+	{
+		if ( ch->recv_sockfd[n] == sockfd )
+		{
+			for ( k = n + 1; k < ch->recv_sockfd_sz; k++ )
+				ch->recv_sockfd[k - 1] = ch->recv_sockfd[k];
+			ch->recv_sockfd_sz--;
+			break;
+		}
+	}
+
+}								// messip_recv_sockfd_close
+
 messip_cnx_t *
 messip_connect0(const char *mgr_ref,
    int msec_timeout,
@@ -442,16 +556,18 @@ messip_connect(const char *mgr_ref,
 }								// messip_connect
 
 
-int
-messip_sin( char *mgr_ref )
+/*
+	Open a plain socket to the messip manager, without MESSIP_OP_CONNECT;
+	used for the requests which need no connexion in the manager
+*/
+static int
+messip_mgr_socket( const char *mgr_ref )
 {
 	struct sockaddr_in server;
 	struct hostent *hp;
 	char hostname[64];
 	int port;
 	int status;
-	int32_t op;
-	struct iovec iovec[1];
 	int sockfd;
 	const int flag = 1;
 
@@ -507,6 +623,23 @@ messip_sin( char *mgr_ref )
 		return -1;
 	}
 
+	return sockfd;
+
+}								// messip_mgr_socket
+
+
+int
+messip_sin( char *mgr_ref )
+{
+	int status;
+	int32_t op;
+	struct iovec iovec[1];
+	int sockfd;
+
+	sockfd = messip_mgr_socket( mgr_ref );
+	if ( sockfd == -1 )
+		return -1;
+
 	/*--- Send a message to the server ---*/
 	op = htonl( MESSIP_OP_SIN );
 	iovec[0].iov_base = &op;
@@ -522,6 +655,72 @@ messip_sin( char *mgr_ref )
 
 }								// messip_sin
 
+
+int
+messip_channel_wait( const char *mgr_ref,
+   const char *name,
+   int msec_timeout )
+{
+	int status;
+	int32_t op;
+	messip_send_channel_wait_t msgsend;
+	messip_reply_channel_wait_t msgreply;
+	struct iovec iovec[2];
+	ssize_t dcount;
+	int sockfd;
+
+	/*--- A socket of its own, the manager blocks on it until the channel is created ---*/
+	sockfd = messip_mgr_socket( mgr_ref );
+	if ( sockfd == -1 )
+		return -1;
+
+	op = htonl( MESSIP_OP_CHANNEL_WAIT );
+	iovec[0].iov_base = &op;
+	iovec[0].iov_len  = sizeof( int32_t );
+	memset(&msgsend, 0, sizeof(msgsend));
+	msgsend.msec_timeout = htonl( msec_timeout );
+	strncpy( msgsend.name, name, MESSIP_CHANNEL_NAME_MAXLEN );
+	iovec[1].iov_base = &msgsend;
+	iovec[1].iov_len  = sizeof( msgsend );
+	status = messip_writev( sockfd, iovec, 2 );
+	if ( status != sizeof( int32_t ) + sizeof( messip_send_channel_wait_t ) )
+	{
+		close( sockfd );
+		return -1;
+	}
+
+	/*--- The manager replies when the channel exists or the timeout expires ---*/
+	for (;;)
+	{
+		iovec[0].iov_base = &msgreply;
+		iovec[0].iov_len  = sizeof( msgreply );
+		dcount = messip_readv( sockfd, iovec, 1 );
+		if ( ( dcount == -1 ) && ( errno == EINTR ) )
+			continue;
+		break;
+	}							// for (;;)
+
+	if ( close( sockfd ) == -1 )
+		fprintf( stderr, "Error %d while closing socket %d\n",
+			errno, sockfd );
+
+	if ( dcount != sizeof( messip_reply_channel_wait_t ) )
+	{
+		if ( dcount >= 0 )
+			errno = ECONNRESET;
+		return -1;
+	}
+
+	if ( msgreply.ok != MESSIP_OK )
+	{
+		errno = ETIMEDOUT;
+		return -1;
+	}
+
+	return 0;
+
+}								// messip_channel_wait
+
 #ifdef USE_QNXMSG
 static int
 message_handler(message_context_t *ctp, int code,
@@ -707,11 +906,13 @@ messip_channel_create0( messip_cnx_t * cnx,
 	ch->sin_port = ntohs(reply.sin_port);
 	ch->sin_addr = ntohl(reply.sin_addr);
 	//strncpy( ch->sin_addr_str, reply.sin_addr_str, sizeof(ch->sin_addr_str) );
+	ch->recv_sockfd_max = MESSIP_RECV_SOCKFD_SLOTS;
+	ch->recv_sockfd = (int *) malloc( sizeof( int ) * ch->recv_sockfd_max );
 	ch->recv_sockfd_sz = 0;
 	ch->recv_sockfd[ch->recv_sockfd_sz++] = sockfd;
 	ch->send_sockfd = -1;
 	ch->nb_replies_pending = 0;
-	ch->new_sockfd_sz = 1;
+	ch->new_sockfd_sz = MESSIP_REPLY_SLOTS;
 	ch->new_sockfd = (int *) malloc( sizeof( int ) * ch->new_sockfd_sz );
 	ch->channel_type =(int *) malloc( sizeof( int ) * ch->new_sockfd_sz );
 	ch->receive_allmsg = (void **) malloc( sizeof(void *) * ch->new_sockfd_sz );
@@ -781,6 +982,30 @@ messip_channel_create0( messip_cnx_t * cnx,
 		ch->receive_allmsg_sz[k] = 0;
 	}
 
+#ifdef USE_EPOLL
+	ch->epoll_fd = epoll_create( FD_SETSIZE );
+	if ( ch->epoll_fd == -1 )
+	{
+		perror( "epoll_create()" );
+	}
+	fcntl( ch->epoll_fd, F_SETFD, FD_CLOEXEC );
+	messip_epoll_add( ch, ch->recv_sockfd[0] );
+#endif /* USE_EPOLL */
+
+#ifdef USE_SHMMSG
+	/*--- Co-located clients will talk through the shared memory ---*/
+	if ( messip_shm_create( ch ) == -1 )
+	{
+		fprintf( stderr, "shared memory transport not available for channel \"%s\"\n", name );
+	}
+#ifdef USE_EPOLL
+	else
+	{
+		messip_epoll_add( ch, ch->shm_doorbell );
+	}
+#endif /* USE_EPOLL */
+#endif /* USE_SHMMSG */
+
 	return ch;
 }								// messip_channel_create
 
@@ -923,6 +1148,15 @@ messip_channel_delete0( messip_channel_t * ch,
 	}
 #endif /* USE_QNXMSG */
 
+#ifdef USE_SHMMSG
+	messip_shm_delete(ch);
+#endif /* USE_SHMMSG */
+
+#ifdef USE_EPOLL
+	close(ch->epoll_fd);
+#endif /* USE_EPOLL */
+
+	free(ch->recv_sockfd);
 	free(ch->new_sockfd);
 	free(ch->channel_type);
 	free(ch->receive_allmsg);
@@ -1090,6 +1324,9 @@ messip_channel_connect0( messip_cnx_t * cnx,
 		}
 
 		info->f_already_connected = 0;
+#ifdef USE_SHMMSG
+		info->shm = NULL;
+#endif /* USE_SHMMSG */
 		pthread_mutex_init(&info->send_mutex, NULL);
 		info->cnx = cnx;
 		info->mgr_sockfd = msgreply.mgr_sockfd;
@@ -1196,6 +1433,19 @@ messip_channel_connect0( messip_cnx_t * cnx,
 		nb_list_connect++;
 		strncpy( list_connect[nb_list_connect - 1].name, name , sizeof(list_connect[nb_list_connect - 1].name));
 		list_connect[nb_list_connect - 1].info = info;
+
+#ifdef USE_SHMMSG
+		/*--- Server on the same host ? Then bypass the TCP/IP stack ---*/
+		{
+			char hostname[sizeof(info->hostname)];
+
+			if ( ( gethostname( hostname, sizeof( hostname ) ) == 0 ) &&
+				 !strncmp( hostname, info->hostname, sizeof( hostname ) ) )
+			{
+				messip_shm_attach( info );
+			}
+		}
+#endif /* USE_SHMMSG */
 	}							// else
 
 	/*--- Send a fake message ---*/
@@ -1374,6 +1624,11 @@ messip_channel_disconnect0( messip_channel_t * ch,
 			// destroy access mutex
 			pthread_mutex_destroy(&ch->send_mutex);
 
+#ifdef USE_SHMMSG
+			// release the shared memory slot
+			messip_shm_detach(ch);
+#endif /* USE_SHMMSG */
+
 			// close the connection socket
 			if (ch->send_sockfd != -1) {
 				if(shutdown(ch->send_sockfd, SHUT_RDWR)) {
@@ -1519,9 +1774,6 @@ ping_reply( messip_channel_t * ch,
 	ssize_t dcount;
 	struct iovec iovec[1];
 	messip_datareply_t datareply;
-	fd_set ready;
-	struct timeval tv;
-	int status;
 
 	/*--- Message to reply back ---*/
 	datareply.pid = getpid(  );
@@ -1532,13 +1784,7 @@ ping_reply( messip_channel_t * ch,
 	/*--- Timeout to write ? ---*/
 	if ( msec_timeout != MESSIP_NOTIMEOUT )
 	{
-		FD_ZERO( &ready );
-		FD_SET( ch->new_sockfd[index], &ready );
-		tv.tv_sec = msec_timeout / 1000;
-		tv.tv_usec = ( msec_timeout % 1000 ) * 1000;
-		status = select( FD_SETSIZE, NULL, &ready, NULL, &tv );
-		assert( status != -1 );
-		if ( !FD_ISSET( ch->new_sockfd[index], &ready ) )
+		if ( !messip_wait_writable( ch->new_sockfd[index], msec_timeout ) )
 			return MESSIP_MSG_TIMEOUT;
 	}
 
@@ -1563,9 +1809,6 @@ reply_to_thread_client_send_buffered_msg( int sockfd,
 	ssize_t dcount;
 	struct iovec iovec[1];
 	messip_datareply_t datareply;
-	fd_set ready;
-	struct timeval tv;
-	int status;
 
 	/*--- Message to reply back ---*/
 	datareply.pid = getpid(  );
@@ -1576,13 +1819,7 @@ reply_to_thread_client_send_buffered_msg( int sockfd,
 	/*--- Timeout to write ? ---*/
 	if ( msec_timeout != MESSIP_NOTIMEOUT )
 	{
-		FD_ZERO( &ready );
-		FD_SET( sockfd, &ready );
-		tv.tv_sec = msec_timeout / 1000;
-		tv.tv_usec = ( msec_timeout % 1000 ) * 1000;
-		status = select( sockfd+1, NULL, &ready, NULL, &tv );	// <&>
-		assert( status != -1 );
-		if ( !FD_ISSET( sockfd, &ready ) )
+		if ( !messip_wait_writable( sockfd, msec_timeout ) )
 			return MESSIP_MSG_TIMEOUT;
 	}
 
@@ -1675,16 +1912,22 @@ messip_receive( messip_channel_t * ch,
 	int new_sockfd = -1;
 	struct sockaddr_in client_addr;
 	socklen_t client_addr_len;
+#ifndef USE_EPOLL
 	fd_set ready;
 	struct timeval tv;
+	int nothing;
+#endif /* USE_EPOLL */
+#if !defined(USE_EPOLL) || defined(USE_QNXMSG)
+	int n;
+#endif
 	int status;
 	uint32_t len;
 	int len_to_read;
-	int n,
-	  k,
-	  nothing,
+	int k,
 	  index;
 	void *rbuff = NULL;
+	int ready_fd;
+	struct timespec deadline;
 
 #ifdef MESSIP_INFORM_STATE
 	/*--- Notify the MessIP manager, for DEBUG purpose only ---*/
@@ -1694,28 +1937,39 @@ messip_receive( messip_channel_t * ch,
 
 	if ( ch->nb_replies_pending == ch->new_sockfd_sz )
 	{
+		/*--- All reply slots in use: double the tables ---*/
+		int new_sz = 2 * ch->new_sockfd_sz;
 		ch->new_sockfd = (int *)
-			realloc( ch->new_sockfd, sizeof( int ) * ( ch->new_sockfd_sz + 1 ) );
-		ch->new_sockfd[ch->new_sockfd_sz] = -1;
+			realloc( ch->new_sockfd, sizeof( int ) * new_sz );
 		ch->channel_type = (int *)
-			realloc( ch->channel_type, sizeof( int ) * ( ch->new_sockfd_sz + 1 ) );
+			realloc( ch->channel_type, sizeof( int ) * new_sz );
 		ch->receive_allmsg = (void **)
-			realloc( ch->receive_allmsg, sizeof(void*) * (ch->new_sockfd_sz + 1) );
+			realloc( ch->receive_allmsg, sizeof(void*) * new_sz );
 		ch->receive_allmsg_sz = (int *)
-			realloc( ch->receive_allmsg_sz, sizeof(int) * (ch->new_sockfd_sz + 1) );
-		ch->receive_allmsg[ch->new_sockfd_sz] = NULL;
-		index = ch->new_sockfd_sz++;
+			realloc( ch->receive_allmsg_sz, sizeof(int) * new_sz );
+		for ( k = ch->new_sockfd_sz; k < new_sz; k++ )
+		{
+			ch->new_sockfd[k] = -1;
+			ch->channel_type[k] = -1;
+			ch->receive_allmsg[k] = NULL;
+			ch->receive_allmsg_sz[k] = 0;
+		}
+		index = ch->new_sockfd_sz;
+		ch->new_sockfd_sz = new_sz;
 	}
 	else
 	{
-//		printf("for(index = 0; index < %d; index++)...", ch->new_sockfd_sz);
+		/*--- Busy slots are only those waiting for reply() ---*/
 		for ( index = 0; index < ch->new_sockfd_sz; index++ )
 			if ( ch->new_sockfd[index] == -1 )
 				break;
-//		printf("-> index = %d\n", index);
 		assert( index < ch->new_sockfd_sz );
 	}
 
+	/*--- Waits restarted below share a single deadline ---*/
+	if ( msec_timeout != MESSIP_NOTIMEOUT && msec_timeout != 1 )
+		messip_deadline_set( &deadline, msec_timeout );
+
   restart:
 
 #if USE_QNXMSG
@@ -1776,6 +2030,74 @@ messip_receive( messip_channel_t * ch,
 
 #endif /* USE_QNXMSG */
 
+#ifdef USE_SHMMSG
+	/*--- Requests from co-located clients ---*/
+	if ( ch->shm )
+	{
+		int slot = messip_shm_receive( ch, type, subtype, rec_buffer, maxlen );
+		if ( slot >= 0 )
+		{
+			ch->new_sockfd[index] = slot;
+			ch->channel_type[index] = CHANNEL_TYPE_SHMMSG;
+			ch->nb_replies_pending++;
+			return index;
+		}
+		if ( slot == MESSIP_SHM_NOMEM )
+		{
+			/*--- Request stays in the slot, errno is ENOMEM ---*/
+			*type = -1;
+			*subtype = -1;
+			return -1;
+		}
+
+		/*--- Ask the clients to ring the doorbell ---*/
+		if ( messip_shm_arm( ch ) )
+		{
+			messip_shm_disarm( ch );
+			goto restart;
+		}
+	}
+#endif /* USE_SHMMSG */
+
+	/*--- Timeout ? ---*/
+#ifdef USE_EPOLL
+	{
+		struct epoll_event event;
+		int timeout;
+
+		// the smallest possible timeout requested is a poll
+		if ( msec_timeout == MESSIP_NOTIMEOUT )
+			timeout = -1;
+		else if ( msec_timeout == 1 )
+			timeout = 0;
+		else
+			timeout = messip_deadline_remaining( &deadline );
+
+		do
+		{
+			status = epoll_wait( ch->epoll_fd, &event, 1, timeout );
+		} while ( (status == -1) && (errno == EINTR) );
+
+		ready_fd = ( status > 0 ) ? event.data.fd : -1;
+	}
+#ifdef USE_SHMMSG
+	if ( ch->shm )
+	{
+		messip_shm_disarm( ch );
+		if ( status > 0 && ready_fd == ch->shm_doorbell )
+			goto restart;
+	}
+#endif /* USE_SHMMSG */
+	if ( status == -1 )
+		return -1;
+	if ( ready_fd == -1 )
+	{
+		*type = -1;
+		*subtype = -1;
+		ch->new_sockfd[index] = -1;
+		return MESSIP_MSG_TIMEOUT;
+	}
+#else /* USE_EPOLL */
 	/*--- Timeout ? ---*/
 	do
 	{
@@ -1789,6 +2111,15 @@ messip_receive( messip_channel_t * ch,
 				maxfd = ch->recv_sockfd[n];
 		}
 
+#ifdef USE_SHMMSG
+		if ( ch->shm )
+		{
+			FD_SET( ch->shm_doorbell, &ready );
+			if ( ch->shm_doorbell > maxfd )
+				maxfd = ch->shm_doorbell;
+		}
+#endif /* USE_SHMMSG */
+
 #ifdef USE_SRRMOD
 		if (use_srrmod) {
 		FD_SET (SrrFd(), &ready);
@@ -1808,8 +2139,9 @@ messip_receive( messip_channel_t * ch,
 			}
 			else
 			{
-				tv.tv_sec  = msec_timeout/1000;
-				tv.tv_usec = (msec_timeout%1000) * 1000;
+				int remaining = messip_deadline_remaining( &deadline );
+				tv.tv_sec  = remaining/1000;
+				tv.tv_usec = (remaining%1000) * 1000;
 			}
 			status = select( maxfd+1, &ready, NULL, NULL, &tv );
 		}
@@ -1818,6 +2150,14 @@ messip_receive( messip_channel_t * ch,
 		    status = select( maxfd+1, &ready, NULL, NULL, NULL );
 		}
 	} while ( (status == -1) && (errno == EINTR) );
+#ifdef USE_SHMMSG
+	if ( ch->shm )
+	{
+		messip_shm_disarm( ch );
+		if ( status > 0 && FD_ISSET( ch->shm_doorbell, &ready ) )
+			goto restart;
+	}
+#endif /* USE_SHMMSG */
 	if ( status == -1 )
 		return -1;
 	if ( (msec_timeout != MESSIP_NOTIMEOUT) && (status == 0) )
@@ -1850,6 +2190,7 @@ messip_receive( messip_channel_t * ch,
 		if ( FD_ISSET( ch->recv_sockfd[n], &ready ) )
 		{
 			nothing = 0;
+			ready_fd = ch->recv_sockfd[n];
 			break;
 		}
 	}
@@ -1861,8 +2202,10 @@ messip_receive( messip_channel_t * ch,
 		return MESSIP_MSG_TIMEOUT;
 	}
 
+#endif /* USE_EPOLL */
+
 	/*--- Accept a new connection ---*/
-	if ( !n )
+	if ( ready_fd == ch->recv_sockfd[0] )
 	{
 //		int fff;
 //		socklen_t optlen;
@@ -1898,11 +2241,32 @@ messip_receive( messip_channel_t * ch,
 		}
 */
 #endif /* USE_QNXMSG */
+#ifndef USE_EPOLL
+		/*--- select() can not wait for descriptors above FD_SETSIZE ---*/
+		if ( new_sockfd >= FD_SETSIZE )
+		{
+			fprintf( stderr, "messip_receive: too many connections to channel \"%s\"\n", ch->name );
+			shutdown( new_sockfd, SHUT_RDWR );
+			close( new_sockfd );
+			ch->new_sockfd[index] = -1;
+			return -1;
+		}
+#endif /* USE_EPOLL */
+		if ( ch->recv_sockfd_sz == ch->recv_sockfd_max )
+		{
+			/*--- All socket slots in use: double the table ---*/
+			ch->recv_sockfd_max *= 2;
+			ch->recv_sockfd = (int *)
+				realloc( ch->recv_sockfd, sizeof( int ) * ch->recv_sockfd_max );
+		}
 		ch->recv_sockfd[ch->recv_sockfd_sz++] = new_sockfd;
+#ifdef USE_EPOLL
+		messip_epoll_add( ch, new_sockfd );
+#endif /* USE_EPOLL */
 	}
 	else
 	{
-		new_sockfd = ch->recv_sockfd[n];
+		new_sockfd = ready_fd;
 	}
 
 	/*--- Create a new channel info ---*/
@@ -1929,11 +2293,7 @@ messip_receive( messip_channel_t * ch,
 */
 #endif /* USE_QNXMSG */
 //		fprintf(stderr, "actually disconnect, dcount %d ECONNRESET %d\n", dcount, ( errno == ECONNRESET ) ? 1 : 0);
-		shutdown( new_sockfd, SHUT_RDWR );
-		close( new_sockfd );
-		for ( k = (n) ? n + 1 : ch->recv_sockfd_sz; k < ch->recv_sockfd_sz; k++ )
-			ch->recv_sockfd[k - 1] = ch->recv_sockfd[k];
-		ch->recv_sockfd_sz--;
+		messip_recv_sockfd_close( ch, new_sockfd );
 		ch->new_sockfd[index] = -1;
 //		goto restart;
 		return MESSIP_MSG_DISCONNECT;
@@ -2039,11 +2399,7 @@ messip_receive( messip_channel_t * ch,
 		}
 */
 #endif /* USE_QNXMSG */
-		shutdown( ch->recv_sockfd[n], SHUT_RDWR );
-		close( ch->recv_sockfd[n] );
-		for ( k = n + 1; k < ch->recv_sockfd_sz; k++ )
-			ch->recv_sockfd[k - 1] = ch->recv_sockfd[k];
-		ch->recv_sockfd_sz--;
+		messip_recv_sockfd_close( ch, new_sockfd );
 		goto restart;
 	}
 	if ( dcount == -1 )
@@ -2081,23 +2437,19 @@ messip_receive( messip_channel_t * ch,
 		Read more data? (if the packet if bigger than MTU)
 	*/
 	while(ch->datalenr < ch->datalen) {
-		FD_ZERO( &ready );
-		FD_SET( new_sockfd, &ready );
+		struct pollfd pfd;
+		pfd.fd = new_sockfd;
+		pfd.events = POLLIN;
 		do {
-			status = select( new_sockfd+1, &ready, NULL, NULL, NULL );
+			status = poll( &pfd, 1, -1 );
 		} while ( (status == -1) && (errno == EINTR) );
 		assert(status != -1);
-		assert(FD_ISSET(new_sockfd, &ready));
 		iovec[0].iov_base = rec_buffer + ch->datalenr;
 		iovec[0].iov_len  = len_to_read - ch->datalenr;
 		dcount = messip_readv( new_sockfd, iovec, 1 );
 		if ( ( dcount == 0 ) || ( ( dcount == -1 ) && ( errno == ECONNRESET ) ) )
 		{
-			shutdown( ch->recv_sockfd[n], SHUT_RDWR );
-			close( ch->recv_sockfd[n] );
-			for ( k = n + 1; k < ch->recv_sockfd_sz; k++ )
-				ch->recv_sockfd[k - 1] = ch->recv_sockfd[k];
-			ch->recv_sockfd_sz--;
+			messip_recv_sockfd_close( ch, new_sockfd );
 			goto restart;
 		}
 		ch->datalenr += dcount;
@@ -2225,6 +2577,13 @@ printf( " 2) %d\n", MESSIP_STATE_SEND_BLOCKED );
 	}
 #endif /* USE_QNXMSG */
 
+#ifdef USE_SHMMSG
+	if ( messip_shm_usable( ch, send_len, reply_buffer, reply_maxlen ) ) {
+		return messip_shm_send( ch, type, subtype, send_buffer, send_len,
+				answer, reply_buffer, reply_maxlen, msec_timeout );
+	}
+#endif /* USE_SHMMSG */
+
 	/*--- Timeout to write ? ---*/
 	if ( msec_timeout != MESSIP_NOTIMEOUT )
 	{
@@ -2506,10 +2865,7 @@ messip_reply( messip_channel_t * ch,
 	ssize_t dcount;
 	struct iovec iovec[2];
 	messip_datareply_t datareply;
-	fd_set ready;
-	struct timeval tv;
 	int ret;
-	int status;
 
 	if ( ( index < 0 ) || ( index > ch->nb_replies_pending ) )
 		return -1;
@@ -2531,6 +2887,11 @@ messip_reply( messip_channel_t * ch,
 			ret = MsgReply(ch->new_sockfd[index], EOK, reply_buffer, reply_len);
 			break;
 #endif /* USE_QNXMSG */
+#ifdef USE_SHMMSG
+	    case CHANNEL_TYPE_SHMMSG:
+			ret = messip_shm_reply(ch, ch->new_sockfd[index], answer, reply_buffer, reply_len);
+			break;
+#endif /* USE_SHMMSG */
 	    case CHANNEL_TYPE_MESSIP:
 			/*--- Message to reply back ---*/
 			//	logg( NULL, "messip_reply:  pthread_self=%d\n", pthread_self() );
@@ -2542,13 +2903,7 @@ messip_reply( messip_channel_t * ch,
 			/*--- Timeout to write ? ---*/
 			if ( msec_timeout != MESSIP_NOTIMEOUT )
 			{
-				FD_ZERO( &ready );
-				FD_SET( ch->new_sockfd[index], &ready );
-				tv.tv_sec = msec_timeout / 1000;
-				tv.tv_usec = ( msec_timeout % 1000 ) * 1000;
-				status = select( FD_SETSIZE, NULL, &ready, NULL, &tv );
-				assert( status != -1 );
-				if ( !FD_ISSET( ch->new_sockfd[index], &ready ) )
+				if ( !messip_wait_writable( ch->new_sockfd[index], msec_timeout ) )
 					return MESSIP_MSG_TIMEOUT;
 			}
 
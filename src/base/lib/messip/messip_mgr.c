@@ -43,6 +43,7 @@
 #include <signal.h>
 #include <fcntl.h>
 #include <assert.h>
+#include <poll.h>
 #include <netinet/tcp.h>
 
 #include "messip.h"
@@ -61,6 +62,9 @@ static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
 #define	UNLOCK \
 	pthread_mutex_unlock( &mutex )
 
+/* Signalled (under the mutex) each time a new channel is created */
+static pthread_cond_t channel_created = PTHREAD_COND_INITIALIZER;
+
 /*
  Buffered message
  */
@@ -120,7 +124,7 @@ static int nb_connexions;
 static connexion_t **connexions;
 
 /*--- List of active channels ---*/
-typedef struct /* channel_t */
+typedef struct channel /* channel_t */
 {
 	pid_t pid;
 	pthread_t tid;
@@ -146,10 +150,16 @@ typedef struct /* channel_t */
 	int nb_clients;
 	int *cnx_clients; // Dynamic Array
 
+	struct channel *hash_next; // Next channel in the same bucket of channels_hash
+
 } channel_t;
 static int nb_channels;
 static channel_t **channels; // This is an array
 
+/*--- Channels indexed by name (power of 2 buckets, chained) ---*/
+#define CHANNELS_HASH_SIZE	256
+static channel_t *channels_hash[CHANNELS_HASH_SIZE];
+
 static int f_bye; // Set to 1 when SIGINT has been applied
 
 extern char *logg_dir;
@@ -166,23 +176,75 @@ enum
 	KEY_CONNEXION_SINCE
 };
 
-static int qsort_channels(const void *c1, const void *c2)
+/* FNV-1a hash of the channel name */
+static unsigned int hash_channel_name(const char *name)
+{
+	unsigned int h = 2166136261u;
+
+	for (; *name; name++) {
+		h ^= (unsigned char) *name;
+		h *= 16777619u;
+	}
+
+	return h & (CHANNELS_HASH_SIZE - 1);
+
+} // hash_channel_name
+
+
+static channel_t *
+search_ch_by_name(const char *name)
+{
+	channel_t *ch;
+
+	for (ch = channels_hash[hash_channel_name(name)]; ch; ch = ch->hash_next) {
+		if (strcmp(ch->channel_name, name) == 0)
+			return ch;
+	}
+
+	return NULL;
+
+} // search_ch_by_name
+
+
+static void hash_insert_channel(channel_t * ch)
 {
-	const channel_t **ch1 = (const channel_t **) c1;
-	const channel_t **ch2 = (const channel_t **) c2;
+	unsigned int h = hash_channel_name(ch->channel_name);
 
-	return strcmp((*ch1)->channel_name, (*ch2)->channel_name);
+	ch->hash_next = channels_hash[h];
+	channels_hash[h] = ch;
 
-} // qsort_channels
+} // hash_insert_channel
 
 
-static int bsearch_channels(const void *c1, const void *c2)
+static void hash_remove_channel(channel_t * ch)
 {
-	const channel_t **ch2 = (const channel_t **) c2;
+	channel_t **pch;
+
+	for (pch = &channels_hash[hash_channel_name(ch->channel_name)]; *pch; pch = &(*pch)->hash_next) {
+		if (*pch == ch) {
+			*pch = ch->hash_next;
+			break;
+		}
+	}
+
+} // hash_remove_channel
+
 
-	return strcmp((const char *) c1, (*ch2)->channel_name);
+/* Wait until the socket is ready to write; unlike select() not limited by FD_SETSIZE */
+static int wait_writable(int sockfd)
+{
+	struct pollfd pfd;
+	int status;
 
-} // bsearch_channels
+	pfd.fd = sockfd;
+	pfd.events = POLLOUT;
+	do {
+		status = poll(&pfd, 1, -1);
+	} while ((status == -1) && (errno == EINTR));
+
+	return status;
+
+} // wait_writable
 
 
 static channel_t *
@@ -930,7 +992,7 @@ static int handle_client_connect(int sockfd, struct sockaddr_in *client_addr, co
 
 static int client_channel_create(int sockfd, struct sockaddr_in *client_addr, connexion_t ** cnx)
 {
-	channel_t **pch, *ch;
+	channel_t *ch;
 	struct iovec iovec[1];
 	messip_send_channel_create_t msg;
 	messip_reply_channel_create_t reply;
@@ -956,8 +1018,7 @@ static int client_channel_create(int sockfd, struct sockaddr_in *client_addr, co
 	/*--- Is there any channel with this name ? ---*/
 	memset(&reply, 0, sizeof(reply));
 	LOCK;
-	pch = (channel_t **) bsearch(msg.channel_name, channels, nb_channels, sizeof(channel_t *), bsearch_channels);
-	if (pch != NULL) {
+	if (search_ch_by_name(msg.channel_name) != NULL) {
 
 		UNLOCK;
 		reply.ok = MESSIP_NOK;
@@ -998,8 +1059,8 @@ static int client_channel_create(int sockfd, struct sockaddr_in *client_addr, co
 		strncpy(ch->sin_addr_str, inet_ntoa(client_addr->sin_addr), sizeof(ch->sin_addr_str));
 		strncpy(ch->hostname, msg.hostname, sizeof(ch->hostname));
 
-		/*--- Keep the channels sorted ---*/
-		qsort(channels, nb_channels, sizeof(channel_t *), qsort_channels);
+		hash_insert_channel(ch);
+		pthread_cond_broadcast(&channel_created);
 		reply.ok = MESSIP_OK;
 		reply.sin_port = htons(ch->sin_port);
 		reply.sin_addr = htonl(ch->sin_addr);
@@ -1049,6 +1110,7 @@ static void destroy_channel(channel_t * ch, int index)
 		assert( index != -1 );
 	} // if
 
+	hash_remove_channel(channels[index]);
 	free(channels[index]);
 
 	for (k = index + 1; k < nb_channels; k++)
@@ -1061,7 +1123,7 @@ static void destroy_channel(channel_t * ch, int index)
 
 static int client_channel_delete(int sockfd, struct sockaddr_in *client_addr)
 {
-	channel_t **pch, *ch;
+	channel_t *ch;
 	struct iovec iovec[1];
 	messip_send_channel_delete_t msg;
 	messip_reply_channel_delete_t reply;
@@ -1086,8 +1148,7 @@ static int client_channel_delete(int sockfd, struct sockaddr_in *client_addr)
 
 	/*--- Search this channel name ---*/
 	LOCK;
-	pch = (channel_t**) bsearch(msg.name, channels, nb_channels, sizeof(channel_t *), bsearch_channels);
-	ch = (pch) ? *pch : NULL;
+	ch = search_ch_by_name(msg.name);
 	UNLOCK;
 
 	/*--- Reply to the client ---*/
@@ -1120,7 +1181,7 @@ static int client_channel_delete(int sockfd, struct sockaddr_in *client_addr)
 
 static int client_channel_connect(int sockfd, struct sockaddr_in *client_addr)
 {
-	channel_t **pch, *ch;
+	channel_t *ch;
 	struct iovec iovec[1];
 	messip_send_channel_connect_t msg;
 	messip_reply_channel_connect_t reply;
@@ -1146,8 +1207,7 @@ static int client_channel_connect(int sockfd, struct sockaddr_in *client_addr)
 
 	/*--- Search this channel name ---*/
 	LOCK;
-	pch = (channel_t **) bsearch(msg.name, channels, nb_channels, sizeof(channel_t *), bsearch_channels);
-	ch = (pch) ? *pch : NULL;
+	ch = search_ch_by_name(msg.name);
 	UNLOCK;
 
 	/*--- Reply to the client ---*/
@@ -1215,9 +1275,94 @@ static int client_channel_connect(int sockfd, struct sockaddr_in *client_addr)
 } // client_channel_connect
 
 
+/* Add milliseconds to an absolute time */
+static void timespec_add_msec(struct timespec * ts, int32_t msec)
+{
+	ts->tv_sec += msec / 1000;
+	ts->tv_nsec += (long) (msec % 1000) * 1000000L;
+	if (ts->tv_nsec >= 1000000000L) {
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000L;
+	}
+
+} // timespec_add_msec
+
+
+/*
+ Block until a channel with the given name is created (or the timeout expires).
+ The request comes on a socket of its own, without MESSIP_OP_CONNECT,
+ so that the thread of the client is not blocked on the shared connexion.
+ */
+static int client_channel_wait(int sockfd, struct sockaddr_in *client_addr)
+{
+	struct iovec iovec[1];
+	messip_send_channel_wait_t msg;
+	messip_reply_channel_wait_t reply;
+	ssize_t dcount;
+	int32_t msec_timeout;
+	struct timespec deadline, wakeup;
+	struct pollfd pfd;
+	int f_last, status;
+
+	/*--- Read additional data specific to this message ---*/
+	iovec[0].iov_base = &msg;
+	iovec[0].iov_len = sizeof(msg);
+	dcount = do_readv(sockfd, iovec, 1);
+	if (dcount == -1) {
+		fprintf(stderr, "%s %d: %s\n", __FILE__, __LINE__, strerror(errno));
+		return -1;
+	}
+	if (dcount != sizeof(messip_send_channel_wait_t)) {
+		fprintf(stderr, "%s %d: read %zd of %zd: %s\n", __FILE__, __LINE__, dcount, sizeof(messip_send_channel_wait_t), strerror(errno));
+		return -1;
+	}
+	msg.name[MESSIP_CHANNEL_NAME_MAXLEN] = 0;
+	msec_timeout = ntohl(msg.msec_timeout);
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	if (msec_timeout != MESSIP_NOTIMEOUT)
+		timespec_add_msec(&deadline, msec_timeout);
+
+	pfd.fd = sockfd;
+	pfd.events = POLLIN;
+
+	/*--- Wait for the channel, once a second check if the client still waits ---*/
+	LOCK;
+	while ((search_ch_by_name(msg.name) == NULL) && !f_bye) {
+		clock_gettime(CLOCK_REALTIME, &wakeup);
+		timespec_add_msec(&wakeup, 1000);
+		f_last = 0;
+		if ((msec_timeout != MESSIP_NOTIMEOUT) && ((wakeup.tv_sec > deadline.tv_sec) || ((wakeup.tv_sec
+				== deadline.tv_sec) && (wakeup.tv_nsec >= deadline.tv_nsec)))) {
+			wakeup = deadline;
+			f_last = 1;
+		}
+		status = pthread_cond_timedwait(&channel_created, &mutex, &wakeup);
+		if (status == ETIMEDOUT) {
+			if (f_last)
+				break;
+			/* The client does not send anything more, so a readable socket has been closed */
+			if (poll(&pfd, 1, 0) > 0)
+				break;
+		}
+	} // while
+	reply.ok = (search_ch_by_name(msg.name) != NULL) ? MESSIP_OK : MESSIP_NOK;
+	UNLOCK;
+
+	logg(LOG_MESSIP_INFORMATIVE, "channel_wait: ip=%s name=%s ok=%d\n", inet_ntoa(client_addr->sin_addr), msg.name, reply.ok);
+
+	/*--- Reply to the client, which may have given up in the meantime ---*/
+	if (send(sockfd, &reply, sizeof(reply), MSG_NOSIGNAL) != sizeof(reply))
+		return -1;
+
+	return 0;
+
+} // client_channel_wait
+
+
 static int client_channel_disconnect(int sockfd, struct sockaddr_in *client_addr)
 {
-	channel_t **pch, *ch;
+	channel_t *ch;
 	struct iovec iovec[1];
 	messip_send_channel_disconnect_t msg;
 	messip_reply_channel_disconnect_t reply;
@@ -1244,8 +1389,7 @@ static int client_channel_disconnect(int sockfd, struct sockaddr_in *client_addr
 
 	/*--- Search this channel name ---*/
 	LOCK;
-	pch = (channel_t **) bsearch(msg.name, channels, nb_channels, sizeof(channel_t *), bsearch_channels);
-	ch = (pch) ? *pch : NULL;
+	ch = search_ch_by_name(msg.name);
 	UNLOCK;
 
 	/*--- Reply to the client ---*/
@@ -1303,7 +1447,6 @@ thread_client_send_buffered_msg(void *arg)
 	int status;
 	ssize_t dcount;
 	uint32_t len;
-	fd_set ready;
 	int sockfd;
 	int nb, k;
 	int do_reply;
@@ -1327,11 +1470,9 @@ thread_client_send_buffered_msg(void *arg)
 		while (nb > 0) {
 
 			/*--- Wait until ready to write ---*/
-			FD_ZERO( &ready );
-			FD_SET( sockfd, &ready );
-			status = select(FD_SETSIZE, NULL, &ready, NULL, NULL);
+			status = wait_writable(sockfd);
 			if(status < 0) {
-				perror("select()");
+				perror("poll()");
 			}
 
 			LOCK;
@@ -1613,7 +1754,6 @@ thread_client_trigger_proxy(void *arg)
 	proxy_t *proxy = (proxy_t *) arg;
 	int nb;
 	int sockfd;
-	fd_set ready;
 	uint32_t len;
 	ssize_t dcount;
 	int status;
@@ -1640,15 +1780,10 @@ thread_client_trigger_proxy(void *arg)
 			int tlen;
 
 			/*--- Wait until ready to write ---*/
-			FD_ZERO( &ready );
-			FD_SET( sockfd, &ready );
-			status = select(sockfd + 1, NULL, &ready, NULL, NULL);
+			status = wait_writable(sockfd);
 			if (status <= 0)
 				printf("OOOPSS!!! status=%d: %s\n", status, strerror(errno));
 			assert( status > 0 );
-			if (!FD_ISSET( sockfd, &ready )) {
-				printf("YYOOOPSS!!! fd=%d \n", sockfd);
-			}
 
 			LOCK;
 			nb = proxy->nb_proxies_to_trigger;
@@ -2129,6 +2264,10 @@ static int handle_client_msg(int sockfd, struct sockaddr_in *client_addr, int32_
 			client_channel_disconnect(sockfd, client_addr);
 			return 1;
 
+		case MESSIP_OP_CHANNEL_WAIT:
+			client_channel_wait(sockfd, client_addr);
+			return 0;
+
 		case MESSIP_OP_BUFFERED_SEND:
 			client_buffered_send(sockfd, client_addr);
 			return 1;
@@ -2183,7 +2322,6 @@ static int notify_server_death_client(channel_t * ch, pid_t pid, pthread_t tid,
 	struct iovec iovec[1];
 	int status;
 	ssize_t dcount;
-	fd_set ready;
 	struct sockaddr_in sockaddr;
 
 	sockfd = socket(MESSIP_SOCK_DOMAIN, MESSIP_SOCK_TYPE, MESSIP_SOCK_PROTO);
@@ -2210,11 +2348,9 @@ static int notify_server_death_client(channel_t * ch, pid_t pid, pthread_t tid,
 	}
 
 	/*--- Wait until enable to write ---*/
-	FD_ZERO( &ready );
-	FD_SET( sockfd, &ready );
-	status = select(FD_SETSIZE, NULL, &ready, NULL, NULL);
+	status = wait_writable(sockfd);
 	if(status < 0) {
-		perror("select()");
+		perror("poll()");
 	}
 
 	/*--- Send a fake message ---*/
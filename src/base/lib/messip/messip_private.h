@@ -87,6 +87,7 @@ enum
 	MESSIP_OP_CHANNEL_PING,
 	MESSIP_OP_BUFFERED_SEND,
 	MESSIP_OP_DEATH_NOTIFY,
+	MESSIP_OP_CHANNEL_WAIT,
 	
 	MESSIP_OP_SIN = 100,
 
@@ -204,6 +205,22 @@ typedef struct
 } messip_reply_channel_disconnect_t;
 
 
+// ------------------------------------
+// MESSIP_OP_CHANNEL_WAIT channel_wait
+// ------------------------------------
+
+typedef struct
+{
+	int32_t msec_timeout;					// MESSIP_NOTIMEOUT to wait forever
+	char name[MESSIP_CHANNEL_NAME_MAXLEN + 1];
+} __attribute__ ((packed)) messip_send_channel_wait_t;
+
+typedef struct
+{
+	int8_t ok;								// MESSIP_OK or MESSIP_NOK (timeout)
+} __attribute__ ((packed)) messip_reply_channel_wait_t;
+
+
 // -----------------------------------
 // MESSIP_OP_CHANNEL_PING channel_ping
 // -----------------------------------
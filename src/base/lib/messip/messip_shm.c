@@ -0,0 +1,562 @@
+/*
+ * messip_shm.c
+ *
+ * Shared-memory transport for co-located messip peers, see messip_shm.h.
+ */
+
+#include "messip.h"
+
+#ifdef USE_SHMMSG
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <linux/futex.h>
+
+#include "messip_shm.h"
+
+#define MESSIP_SHM_MAGIC	0x6d736d31	// "msm1"
+
+// Slot states; the state word is also used as a futex
+enum
+{
+	MESSIP_SHM_IDLE = 0,	// owned by the client, ready for a new request
+	MESSIP_SHM_REQUEST,		// request published, waiting for the server
+	MESSIP_SHM_SERVING,		// request taken by the server
+	MESSIP_SHM_REPLIED,		// reply published, waiting for the client
+	MESSIP_SHM_ABANDONED	// client timed out while the request was being served
+};
+
+// Period of checking if the server is still alive while waiting for a reply
+#define MESSIP_SHM_LIVENESS_MS	100
+
+typedef struct messip_shm_slot
+{
+	volatile int32_t state;
+	volatile pid_t owner;
+	pthread_t tid;
+	int32_t type;
+	int32_t subtype;
+	int32_t datalen;
+	int32_t answer;
+	int32_t replylen;
+	pid_t reply_pid;
+	pthread_t reply_tid;
+	char request[MESSIP_SHM_MSGLEN];
+	char reply[MESSIP_SHM_MSGLEN];
+} messip_shm_slot_t;
+
+struct messip_shm
+{
+	uint32_t magic;
+	volatile pid_t pid;			// server process, 0 after the channel is deleted
+	volatile int32_t waiting;	// server is (about to be) blocked in select()
+	struct sockaddr_un doorbell;
+	socklen_t doorbell_len;
+	messip_shm_slot_t slot[MESSIP_SHM_SLOTS];
+};
+
+static int
+futex_wait( volatile int32_t *addr, int32_t val, int msec_timeout )
+{
+	struct timespec ts;
+
+	ts.tv_sec = msec_timeout / 1000;
+	ts.tv_nsec = ( msec_timeout % 1000 ) * 1000000;
+
+	return syscall( SYS_futex, addr, FUTEX_WAIT, val, &ts, NULL, 0 );
+}
+
+static void
+futex_wake( volatile int32_t *addr )
+{
+	syscall( SYS_futex, addr, FUTEX_WAKE, 1, NULL, NULL, 0 );
+}
+
+static long
+elapsed_ms( const struct timespec *since )
+{
+	struct timespec now;
+
+	clock_gettime( CLOCK_MONOTONIC, &now );
+
+	return ( now.tv_sec - since->tv_sec ) * 1000 + ( now.tv_nsec - since->tv_nsec ) / 1000000;
+}
+
+static void
+shm_name( const char *channel, char *name, size_t len )
+{
+	char *p;
+
+	snprintf( name, len, "/messip.%s", channel );
+
+	// POSIX shm names can not contain slashes except the leading one
+	for ( p = name + 1; *p; p++ )
+		if ( *p == '/' )
+			*p = '_';
+}
+
+static int
+server_alive( const struct messip_shm *shm )
+{
+	pid_t pid = shm->pid;
+
+	return ( pid > 0 ) && ( ( kill( pid, 0 ) == 0 ) || ( errno != ESRCH ) );
+}
+
+int
+messip_shm_create( messip_channel_t * ch )
+{
+	char name[MESSIP_CHANNEL_NAME_MAXLEN + 16];
+	struct messip_shm *shm;
+	int fd;
+
+	ch->shm = NULL;
+	ch->shm_slot = -1;
+	ch->shm_doorbell = -1;
+	ch->shm_next = 0;
+
+	shm_name( ch->name, name, sizeof( name ) );
+
+	// Remove a segment left by a crashed server with the same channel name
+	shm_unlink( name );
+
+	// Only processes of the same user can attach and write into the slots
+	fd = shm_open( name, O_RDWR | O_CREAT | O_EXCL, 0600 );
+	if ( fd == -1 )
+	{
+		perror( "shm_open()" );
+		return -1;
+	}
+
+	if ( ftruncate( fd, sizeof( struct messip_shm ) ) == -1 )
+	{
+		perror( "ftruncate()" );
+		close( fd );
+		shm_unlink( name );
+		return -1;
+	}
+
+	shm = (struct messip_shm *) mmap( NULL, sizeof( struct messip_shm ),
+		PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	close( fd );
+	if ( shm == MAP_FAILED )
+	{
+		perror( "mmap()" );
+		shm_unlink( name );
+		return -1;
+	}
+
+	/*--- Doorbell: datagram socket in the abstract namespace ---*/
+	ch->shm_doorbell = socket( AF_UNIX, SOCK_DGRAM, 0 );
+	if ( ch->shm_doorbell == -1 )
+	{
+		perror( "socket()" );
+		munmap( shm, sizeof( struct messip_shm ) );
+		shm_unlink( name );
+		return -1;
+	}
+	fcntl( ch->shm_doorbell, F_SETFD, FD_CLOEXEC );
+	fcntl( ch->shm_doorbell, F_SETFL, O_NONBLOCK );
+
+	memset( &shm->doorbell, 0, sizeof( shm->doorbell ) );
+	shm->doorbell.sun_family = AF_UNIX;
+	snprintf( shm->doorbell.sun_path + 1, sizeof( shm->doorbell.sun_path ) - 1,
+		"messip.%d.%s", getpid(), ch->name );
+	shm->doorbell_len = offsetof( struct sockaddr_un, sun_path ) + 1
+		+ strlen( shm->doorbell.sun_path + 1 );
+
+	if ( bind( ch->shm_doorbell, ( struct sockaddr * ) &shm->doorbell, shm->doorbell_len ) == -1 )
+	{
+		perror( "bind()" );
+		close( ch->shm_doorbell );
+		ch->shm_doorbell = -1;
+		munmap( shm, sizeof( struct messip_shm ) );
+		shm_unlink( name );
+		return -1;
+	}
+
+	shm->waiting = 0;
+	shm->pid = getpid();
+	__sync_synchronize();
+	shm->magic = MESSIP_SHM_MAGIC;
+
+	ch->shm = shm;
+
+	return 0;
+}
+
+void
+messip_shm_delete( messip_channel_t * ch )
+{
+	char name[MESSIP_CHANNEL_NAME_MAXLEN + 16];
+	int k;
+
+	if ( !ch->shm )
+		return;
+
+	// Wake up clients, so they notice that the server is gone
+	ch->shm->pid = 0;
+	__sync_synchronize();
+	for ( k = 0; k < MESSIP_SHM_SLOTS; k++ )
+		futex_wake( &ch->shm->slot[k].state );
+
+	shm_name( ch->name, name, sizeof( name ) );
+	shm_unlink( name );
+	munmap( ch->shm, sizeof( struct messip_shm ) );
+	close( ch->shm_doorbell );
+
+	ch->shm = NULL;
+	ch->shm_doorbell = -1;
+}
+
+int
+messip_shm_attach( messip_channel_t * ch )
+{
+	char name[MESSIP_CHANNEL_NAME_MAXLEN + 16];
+	struct messip_shm *shm;
+	pid_t self = getpid();
+	int fd, k;
+
+	ch->shm = NULL;
+	ch->shm_slot = -1;
+	ch->shm_doorbell = -1;
+
+	shm_name( ch->name, name, sizeof( name ) );
+
+	fd = shm_open( name, O_RDWR, 0 );
+	if ( fd == -1 )
+		return -1;
+
+	shm = (struct messip_shm *) mmap( NULL, sizeof( struct messip_shm ),
+		PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	close( fd );
+	if ( shm == MAP_FAILED )
+		return -1;
+
+	// Segment has to be initialized and belong to the running server
+	if ( shm->magic != MESSIP_SHM_MAGIC || !server_alive( shm ) || shm->pid != ch->remote_pid )
+	{
+		munmap( shm, sizeof( struct messip_shm ) );
+		return -1;
+	}
+
+	/*--- Claim a free slot (or one left by a dead client) ---*/
+	for ( k = 0; k < MESSIP_SHM_SLOTS; k++ )
+	{
+		pid_t owner = shm->slot[k].owner;
+
+		if ( owner == 0 )
+		{
+			if ( __sync_bool_compare_and_swap( &shm->slot[k].owner, 0, self ) )
+				break;
+		}
+		else if ( ( kill( owner, 0 ) == -1 ) && ( errno == ESRCH ) )
+		{
+			if ( __sync_bool_compare_and_swap( &shm->slot[k].owner, owner, self ) )
+				break;
+		}
+	}
+	if ( k == MESSIP_SHM_SLOTS )
+	{
+		munmap( shm, sizeof( struct messip_shm ) );
+		return -1;
+	}
+	shm->slot[k].state = MESSIP_SHM_IDLE;
+
+	ch->shm_doorbell = socket( AF_UNIX, SOCK_DGRAM, 0 );
+	if ( ch->shm_doorbell == -1 )
+	{
+		shm->slot[k].owner = 0;
+		munmap( shm, sizeof( struct messip_shm ) );
+		return -1;
+	}
+	fcntl( ch->shm_doorbell, F_SETFD, FD_CLOEXEC );
+
+	ch->shm = shm;
+	ch->shm_slot = k;
+
+	return 0;
+}
+
+void
+messip_shm_detach( messip_channel_t * ch )
+{
+	if ( !ch->shm )
+		return;
+
+	// A request abandoned after a timeout is still owned by the server
+	if ( ch->shm->slot[ch->shm_slot].state == MESSIP_SHM_IDLE ||
+		 ch->shm->slot[ch->shm_slot].state == MESSIP_SHM_REPLIED ||
+		 !server_alive( ch->shm ) )
+	{
+		ch->shm->slot[ch->shm_slot].owner = 0;
+	}
+
+	munmap( ch->shm, sizeof( struct messip_shm ) );
+	close( ch->shm_doorbell );
+
+	ch->shm = NULL;
+	ch->shm_slot = -1;
+	ch->shm_doorbell = -1;
+}
+
+int
+messip_shm_usable( const messip_channel_t * ch,
+   int send_len,
+   const void *reply_buffer,
+   int reply_maxlen )
+{
+	return ch->shm && ( ch->shm_slot >= 0 )
+		&& ( send_len <= MESSIP_SHM_MSGLEN )
+		&& ( reply_maxlen >= 0 )			// not an asynchronous send
+		&& ( reply_maxlen <= MESSIP_SHM_MSGLEN )
+		&& !( reply_buffer && reply_maxlen == 0 );	// not a dynamically allocated reply
+}
+
+/*
+	Wait until the slot state changes from a given value,
+	with a deadline and a periodic check for the server liveness
+*/
+static int
+slot_wait( messip_channel_t * ch,
+   int32_t state,
+   const struct timespec *start,
+   int msec_timeout )
+{
+	messip_shm_slot_t *slot = &ch->shm->slot[ch->shm_slot];
+
+	while ( slot->state == state )
+	{
+		int wait_ms = MESSIP_SHM_LIVENESS_MS;
+
+		if ( msec_timeout != MESSIP_NOTIMEOUT )
+		{
+			long left = msec_timeout - elapsed_ms( start );
+			if ( left <= 0 )
+				return MESSIP_MSG_TIMEOUT;
+			if ( left < wait_ms )
+				wait_ms = left;
+		}
+
+		if ( futex_wait( &slot->state, state, wait_ms ) == -1 &&
+			 errno == ETIMEDOUT && !server_alive( ch->shm ) )
+		{
+			errno = ECONNRESET;
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int
+messip_shm_send( messip_channel_t * ch,
+   int32_t type,
+   int32_t subtype,
+   const void *send_buffer,
+   int send_len,
+   int32_t * answer,
+   void *reply_buffer,
+   int reply_maxlen,
+   int msec_timeout )
+{
+	messip_shm_slot_t *slot = &ch->shm->slot[ch->shm_slot];
+	struct timespec start;
+	int32_t state;
+	int len_to_read;
+	int ret;
+
+	clock_gettime( CLOCK_MONOTONIC, &start );
+
+	/*--- Previous request abandoned after timeout may be still served ---*/
+	while ( ( state = slot->state ) != MESSIP_SHM_IDLE )
+	{
+		if ( state == MESSIP_SHM_REPLIED )
+		{
+			slot->state = MESSIP_SHM_IDLE;
+			break;
+		}
+		if ( ( ret = slot_wait( ch, state, &start, msec_timeout ) ) != 0 )
+			return ret;
+	}
+
+	/*--- Publish the request ---*/
+	slot->tid = pthread_self();
+	slot->type = type;
+	slot->subtype = subtype;
+	slot->datalen = send_len;
+	if ( send_len > 0 )
+		memcpy( slot->request, send_buffer, send_len );
+	__sync_synchronize();
+	slot->state = MESSIP_SHM_REQUEST;
+	__sync_synchronize();
+
+	/*--- Ring the doorbell only if the server is blocked ---*/
+	if ( ch->shm->waiting )
+	{
+		const char bell = 0;
+		sendto( ch->shm_doorbell, &bell, sizeof( bell ), MSG_DONTWAIT,
+			( const struct sockaddr * ) &ch->shm->doorbell, ch->shm->doorbell_len );
+	}
+
+	/*--- Wait for the reply ---*/
+	while ( ( state = slot->state ) != MESSIP_SHM_REPLIED )
+	{
+		ret = slot_wait( ch, state, &start, msec_timeout );
+		if ( ret == MESSIP_MSG_TIMEOUT )
+		{
+			// Withdraw the request, or let the server know that nobody waits
+			if ( __sync_bool_compare_and_swap( &slot->state, MESSIP_SHM_REQUEST, MESSIP_SHM_IDLE ) ||
+				 __sync_bool_compare_and_swap( &slot->state, MESSIP_SHM_SERVING, MESSIP_SHM_ABANDONED ) )
+				return MESSIP_MSG_TIMEOUT;
+			// Reply has just arrived
+			continue;
+		}
+		if ( ret != 0 )
+			return ret;
+	}
+	__sync_synchronize();
+
+	/*--- Fetch the reply ---*/
+	len_to_read = ( slot->replylen < reply_maxlen ) ? slot->replylen : reply_maxlen;
+	if ( reply_buffer && len_to_read > 0 )
+		memcpy( reply_buffer, slot->reply, len_to_read );
+	if ( answer )
+		*answer = slot->answer;
+
+	ch->datalen = slot->replylen;
+	ch->datalenr = len_to_read;
+	ch->remote_pid = slot->reply_pid;
+	ch->remote_tid = slot->reply_tid;
+
+	slot->state = MESSIP_SHM_IDLE;
+
+	return 0;
+}
+
+int
+messip_shm_receive( messip_channel_t * ch,
+   int32_t * type,
+   int32_t * subtype,
+   void *rec_buffer,
+   int32_t maxlen )
+{
+	int n;
+
+	for ( n = 0; n < MESSIP_SHM_SLOTS; n++ )
+	{
+		const int k = ( ch->shm_next + n ) % MESSIP_SHM_SLOTS;
+		messip_shm_slot_t *slot = &ch->shm->slot[k];
+		int len_to_read;
+
+		if ( slot->state != MESSIP_SHM_REQUEST ||
+			 !__sync_bool_compare_and_swap( &slot->state, MESSIP_SHM_REQUEST, MESSIP_SHM_SERVING ) )
+			continue;
+
+		// Continue with the next client next time, so nobody starves
+		ch->shm_next = k + 1;
+
+		*type = slot->type;
+		*subtype = slot->subtype;
+		ch->remote_pid = slot->owner;
+		ch->remote_tid = slot->tid;
+		ch->datalen = slot->datalen;
+
+		/*--- Dynamic allocation asked ? ---*/
+		if ( ( rec_buffer != NULL ) && ( maxlen == 0 ) )
+		{
+			void *rbuff = malloc( slot->datalen );
+			if ( rbuff == NULL )
+			{
+				// Leave the request for the next receive
+				slot->state = MESSIP_SHM_REQUEST;
+				errno = ENOMEM;
+				return MESSIP_SHM_NOMEM;
+			}
+			memcpy( rbuff, slot->request, slot->datalen );
+			*( void ** ) rec_buffer = rbuff;
+			ch->datalenr = slot->datalen;
+		}
+		else
+		{
+			len_to_read = ( maxlen < slot->datalen ) ? maxlen : slot->datalen;
+			if ( len_to_read > 0 )
+				memcpy( rec_buffer, slot->request, len_to_read );
+			ch->datalenr = len_to_read;
+		}
+
+		return k;
+	}
+
+	return MESSIP_SHM_NONE;
+}
+
+int
+messip_shm_reply( messip_channel_t * ch,
+   int k,
+   int32_t answer,
+   const void *reply_buffer,
+   int reply_len )
+{
+	messip_shm_slot_t *slot = &ch->shm->slot[k];
+
+	slot->answer = answer;
+	slot->replylen = reply_len;
+	slot->reply_pid = getpid();
+	slot->reply_tid = pthread_self();
+	if ( reply_len > 0 )
+		memcpy( slot->reply, reply_buffer, ( reply_len < MESSIP_SHM_MSGLEN ) ? reply_len : MESSIP_SHM_MSGLEN );
+	__sync_synchronize();
+
+	if ( !__sync_bool_compare_and_swap( &slot->state, MESSIP_SHM_SERVING, MESSIP_SHM_REPLIED ) )
+	{
+		// Client has given up waiting, make the slot available again
+		slot->state = MESSIP_SHM_IDLE;
+	}
+
+	futex_wake( &slot->state );
+
+	return 0;
+}
+
+int
+messip_shm_arm( messip_channel_t * ch )
+{
+	int k;
+
+	ch->shm->waiting = 1;
+	__sync_synchronize();
+
+	// Re-check after announcing, so a request published meanwhile is not missed
+	for ( k = 0; k < MESSIP_SHM_SLOTS; k++ )
+		if ( ch->shm->slot[k].state == MESSIP_SHM_REQUEST )
+			return 1;
+
+	return 0;
+}
+
+void
+messip_shm_disarm( messip_channel_t * ch )
+{
+	char bell[64];
+
+	ch->shm->waiting = 0;
+
+	while ( recv( ch->shm_doorbell, bell, sizeof( bell ), MSG_DONTWAIT ) > 0 )
+		;
+}
+
+#endif /* USE_SHMMSG */
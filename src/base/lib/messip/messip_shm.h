@@ -0,0 +1,79 @@
+/*
+ * messip_shm.h
+ *
+ * Shared-memory transport for co-located messip peers.
+ *
+ * A channel server publishes a POSIX shared memory segment with a fixed
+ * number of client slots. A client running on the same host claims one slot
+ * at connect time and then passes its synchronous send/reply transactions
+ * through it instead of the TCP socket. Reply wake-ups use a futex word in
+ * the slot; the server is woken up with a datagram on an abstract unix socket
+ * (so it can still be multiplexed with select() over the TCP sockets), but
+ * only when it is actually blocked waiting for messages.
+ *
+ * Messages that do not fit in a slot, asynchronous sends and dynamically
+ * allocated replies fall back to the regular TCP path.
+ */
+
+#ifndef MESSIP_SHM_H_
+#define MESSIP_SHM_H_
+
+#include <stdint.h>
+
+#include "messip.h"
+
+#ifdef USE_SHMMSG
+
+//! Maximal request/reply payload carried through a shared memory slot
+#define MESSIP_SHM_MSGLEN	16384
+
+//! Number of concurrently connected co-located clients per channel
+#define MESSIP_SHM_SLOTS	16
+
+//! messip_shm_receive() result: no request pending
+#define MESSIP_SHM_NONE		-1
+
+//! messip_shm_receive() result: request left pending, receive buffer could not be allocated
+#define MESSIP_SHM_NOMEM	-2
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! Create the shared memory segment of a server channel
+int messip_shm_create(messip_channel_t * ch);
+
+//! Destroy the shared memory segment of a server channel
+void messip_shm_delete(messip_channel_t * ch);
+
+//! Attach client channel to the segment of a local server; returns -1 if not available
+int messip_shm_attach(messip_channel_t * ch);
+
+//! Release the client slot
+void messip_shm_detach(messip_channel_t * ch);
+
+//! Check if the transaction can be passed through the shared memory
+int messip_shm_usable(const messip_channel_t * ch, int send_len, const void *reply_buffer, int reply_maxlen);
+
+//! Synchronous send through the client slot
+int messip_shm_send(messip_channel_t * ch, int32_t type, int32_t subtype, const void *send_buffer, int send_len, int32_t * answer, void *reply_buffer, int reply_maxlen, int msec_timeout);
+
+//! Fetch a pending request; returns the slot number, MESSIP_SHM_NONE or MESSIP_SHM_NOMEM
+int messip_shm_receive(messip_channel_t * ch, int32_t * type, int32_t * subtype, void *rec_buffer, int32_t maxlen);
+
+//! Reply to the request received from a given slot
+int messip_shm_reply(messip_channel_t * ch, int slot, int32_t answer, const void *reply_buffer, int reply_len);
+
+//! Announce that the server is going to block; returns non-zero if requests are already pending
+int messip_shm_arm(messip_channel_t * ch);
+
+//! Announce that the server is awake again and drain the doorbell
+void messip_shm_disarm(messip_channel_t * ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* USE_SHMMSG */
+
+#endif /* MESSIP_SHM_H_ */
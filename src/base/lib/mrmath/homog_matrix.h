@@ -19,11 +19,12 @@
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/nvp.hpp>
 
+#include "base/lib/mrmath/k_vector.h"
+
 namespace mrrocpp {
 namespace lib {
 
 // forward declarations
-class K_vector;
 class Xyz_Angle_Axis_vector;
 class Xyz_Angle_Axis_Gamma_vector;
 class Xyz_Euler_Zyz_vector;
@@ -44,8 +45,11 @@ class Xyz_Rpy_vector;
 class Homog_matrix
 {
 private:
+	//! Storage type: rotation and translation rows
+	typedef Eigen::Matrix <double, 3, 4, Eigen::RowMajor> matrix_t;
+
 	//! Matrix placeholder
-	double matrix_m[3][4];
+	matrix_t matrix_m;
 
 	//! Eps for alpha representation
 	const static double ALPHA_SENSITIVITY;
@@ -247,14 +251,14 @@ public:
 	inline double& operator()(int i, int j)
 	{
 		HOMOG_MATRIX_CHECKI((0<=i)&&(i<=2)&&(0<=j)&&(j<=3));
-		return matrix_m[i][j];
+		return matrix_m(i, j);
 	}
 
 	//! Access to elements 0..3,0..2, bounds are checked when NDEBUG is not set
 	inline double operator()(int i, int j) const
 	{
 		HOMOG_MATRIX_CHECKI((0<=i)&&(i<=2)&&(0<=j)&&(j<=3));
-		return matrix_m[i][j];
+		return matrix_m(i, j);
 	}
 
 	//! Mnozenie macierzy.
@@ -288,6 +292,8 @@ public:
 	 */
 	Homog_matrix interpolate(double t, const Homog_matrix& other);
 
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
 private:
 	//! Give access to boost::serialization framework
 	friend class boost::serialization::access;
@@ -296,10 +302,65 @@ private:
 	template <class Archive>
 	void serialize(Archive & ar, const unsigned int version)
 	{
-		ar & BOOST_SERIALIZATION_NVP(matrix_m);
+		// row-major storage is archived as the former double[3][4] array
+		double (&matrix_array)[3][4] = *reinterpret_cast <double (*)[3][4]> (matrix_m.data());
+		ar & boost::serialization::make_nvp("matrix_m", matrix_array);
 	}
 };
 
+// Operacje wywolywane w kazdym kroku ruchu - rozwijane w miejscu wywolania
+
+inline Homog_matrix::Homog_matrix()
+{
+	matrix_m.setIdentity();
+}
+
+inline Homog_matrix Homog_matrix::operator*(const Homog_matrix & m) const
+{
+	// mnozenie macierzy
+	// mnozenie realizowane jest zgodnie ze wzorem 2.41 ze strony 54
+	// ksiazki: "Wprowadzenie do robotyki" John J. Craig
+
+	Homog_matrix zwracana;
+
+	// [R1 t1] * [R2 t2] = [R1*R2 R1*t2+t1]
+	zwracana.matrix_m = matrix_m.block <3, 3> (0, 0) * m.matrix_m;
+	zwracana.matrix_m.col(3) += matrix_m.col(3);
+
+	return zwracana;
+}
+
+inline void Homog_matrix::operator *=(const Homog_matrix & m)
+{
+	// mnozenie macierzy
+	this->operator=(this->operator *(m));
+}
+
+inline K_vector Homog_matrix::operator*(const K_vector & w) const
+{
+	// operator mnozenia
+	// umozliwia otrzymanie wektora w ukladzie odniesienia reprezentowanym przez macierz jednorodna
+	// argument: obiekt klasy K_vector
+
+	return K_vector(matrix_m.block <3, 3> (0, 0) * w + matrix_m.col(3));
+}
+
+inline Homog_matrix Homog_matrix::operator!() const
+{
+	// przeksztalcenie odwrotne
+	// odwrocenie macierzy zgodnie ze wzorem 2.45 ze strony 55
+	// ksiazki: "Wprowadzenie do robotyki" John J. Craig
+
+	// [R t]^-1 = [R^T -R^T*t]
+
+	Homog_matrix zwracana;
+
+	zwracana.matrix_m.block <3, 3> (0, 0) = matrix_m.block <3, 3> (0, 0).transpose();
+	zwracana.matrix_m.col(3) = -(zwracana.matrix_m.block <3, 3> (0, 0) * matrix_m.col(3));
+
+	return zwracana;
+}
+
 } // namespace lib
 } // namespace mrrocpp
 
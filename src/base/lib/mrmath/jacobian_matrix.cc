@@ -29,9 +29,7 @@ namespace lib {
 
 Jacobian_matrix::Jacobian_matrix()
 {
-	for (int i = 0; i <= 5; ++i)
-		for (int j = 0; j <= 5; ++j)
-			matrix[i][j] = 0;
+	matrix.setZero();
 }// end Jacobian_matrix::Jacobian_matrix()
 
 
@@ -41,19 +39,8 @@ Jacobian_matrix::Jacobian_matrix()
 
 void Jacobian_matrix::transpose()
 {
-	double tmp[6][6]; //Tymczasowa macierz z wynikami
-
-	for (int a = 0; a <= 5; a++) {
-		for (int b = 0; b <= 5; b++) {
-			tmp[a][b] = matrix[a][b];
-		}
-	}
-
-	for (int a = 0; a <= 5; a++) {
-		for (int b = 0; b <= 5; b++) {
-			matrix[a][b] = tmp[b][a];
-		}
-	}
+	// eval() - transpozycja przez macierz tymczasowa
+	matrix = matrix.transpose().eval();
 }
 
 /* ------------------------------------------------------------------------
@@ -62,36 +49,32 @@ void Jacobian_matrix::transpose()
 
 Xyz_Angle_Axis_vector Jacobian_matrix::operator*(const Xyz_Angle_Axis_vector & w) const
 {
-	Xyz_Angle_Axis_vector zwracany;
-
-	for (int j = 0; j < 6; j++)
-		for (int i = 0; i < 6; i++)
-			zwracany[j] += matrix[j][i] * w[i];
-
-	return zwracany;
+	return Xyz_Angle_Axis_vector(matrix * w);
 }
 
 void Jacobian_matrix::print()
 {
 	for (int i = 0; i < 6; i++)
-		printf("% 7.3f, % 7.3f, % 7.3f, % 7.3f, % 7.3f, % 7.3f\n", matrix[i][0], matrix[i][1], matrix[i][2], matrix[i][3], matrix[i][4], matrix[i][5]);
+		printf("% 7.3f, % 7.3f, % 7.3f, % 7.3f, % 7.3f, % 7.3f\n", matrix(i, 0), matrix(i, 1), matrix(i, 2), matrix(i, 3), matrix(i, 4), matrix(i, 5));
 }
 
 void Jacobian_matrix::to_table(double array[6][6]) const
 {
-	for (int i = 0; i < 6; i++)
-		for (int j = 0; j < 6; j++)
-			array[i][j] = matrix[i][j];
+	Eigen::Map <matrix_t> table(&array[0][0]);
+	table = matrix;
 }
 
 Xyz_Angle_Axis_vector Jacobian_matrix::jacobian_inverse_gauss(const Xyz_Angle_Axis_vector & dist)
 {
 	//zmienne pomocnicze w eliminacji Gaussa
 	double L, a;
-	int p[6], k, d, i, j, s, tmp;
+	int p[6], k, d, i, s, tmp;
 	const double eps = 1e-10;
 	double w[6];
 
+	//Eliminacja na kopii - jakobian pozostaje niezmieniony
+	matrix_t u(matrix);
+
 	Xyz_Angle_Axis_vector q;
 
 	//Metoda Eliminacji Gaussa - rozklad LU jakobianu
@@ -104,11 +87,11 @@ Xyz_Angle_Axis_vector Jacobian_matrix::jacobian_inverse_gauss(const Xyz_Angle_Ax
 	//V=Jq -> J=PLU -> V=PLUq
 
 	for (k = 0; k < 6; k++) {
-		a = matrix[p[k]][k]; //wybor elementu podstawowego
+		a = u(p[k], k); //wybor elementu podstawowego
 		s = k;
 		for (d = k + 1; d < 6; d++) {
-			if (fabs(a) < fabs(matrix[p[d]][k])) {
-				a = matrix[p[d]][k]; //wybierany max element kolumny
+			if (fabs(a) < fabs(u(p[d], k))) {
+				a = u(p[d], k); //wybierany max element kolumny
 				s = d;
 			}
 		}
@@ -118,27 +101,76 @@ Xyz_Angle_Axis_vector Jacobian_matrix::jacobian_inverse_gauss(const Xyz_Angle_Ax
 			p[s] = tmp;
 		}
 		for (i = k + 1; i < 6; i++) { //eliminacja Gaussa
-			if (fabs(matrix[p[i]][k]) > eps) {
-				L = matrix[p[i]][k] / a;
-				for (j = k + 1; j < 6; j++) {
-					matrix[p[i]][j] = matrix[p[i]][j] - L * matrix[p[k]][j];
-				}
+			if (fabs(u(p[i], k)) > eps) {
+				L = u(p[i], k) / a;
+				// kolumny < k sa juz wyzerowane w obu wierszach - operacja na calych wierszach
+				u.row(p[i]) -= L * u.row(p[k]);
 				w[p[i]] = w[p[i]] - L * w[p[k]];
-				matrix[p[i]][k] = 0;
+				u(p[i], k) = 0;
 			}
 		}
 	}
 
-	//Rozwiazanie ukladu r�wnan z macierza gorna trojkatna
+	//Rozwiazanie ukladu rownan z macierza gorna trojkatna
+	for (i = 5; i >= 0; i--) {
+		double sum = w[p[i]];
+		for (d = i + 1; d < 6; d++) {
+			sum -= q[d] * u(p[i], d);
+		}
+		q[i] = sum / u(p[i], i);
+	}
+
+	return q;
+}
+
+Xyz_Angle_Axis_vector Jacobian_matrix::damped_least_squares(const Xyz_Angle_Axis_vector & dist, double lambda) const
+{
+	// A = J^T J + lambda^2 I, b = J^T dist
+	Eigen::Matrix <double, 6, 6> A = matrix.transpose() * matrix;
+	Eigen::Matrix <double, 6, 1> b = matrix.transpose() * dist;
 
-	q[5] = (w[p[5]]) / matrix[p[5]][5];
-	q[4] = (w[p[4]] - (q[5] * matrix[p[4]][5])) / matrix[p[4]][4];
-	q[3] = (w[p[3]] - (q[5] * matrix[p[3]][5] + q[4] * matrix[p[3]][4])) / matrix[p[3]][3];
-	q[2] = (w[p[2]] - (q[5] * matrix[p[2]][5] + q[4] * matrix[p[2]][4] + q[3] * matrix[p[2]][3])) / matrix[p[2]][2];
-	q[1] = (w[p[1]] - (q[5] * matrix[p[1]][5] + q[4] * matrix[p[1]][4] + q[3] * matrix[p[1]][3] + q[2]
-			* matrix[p[1]][2])) / matrix[p[1]][1];
-	q[0] = (w[p[0]] - (q[5] * matrix[p[0]][5] + q[4] * matrix[p[0]][4] + q[3] * matrix[p[0]][3] + q[2]
-			* matrix[p[0]][2] + q[1] * matrix[p[0]][1])) / matrix[p[0]][0];
+	for (int i = 0; i < 6; i++) {
+		A(i, i) += lambda * lambda;
+	}
+
+	// Rozklad Cholesky'ego A = L L^T (L w dolnym trojkacie A)
+	for (int j = 0; j < 6; j++) {
+		double d = A(j, j);
+		for (int k = 0; k < j; k++) {
+			d -= A(j, k) * A(j, k);
+		}
+		if (d <= 0) {
+			// Macierz numerycznie osobliwa - brak kroku
+			return Xyz_Angle_Axis_vector(0, 0, 0, 0, 0, 0);
+		}
+		d = sqrt(d);
+		A(j, j) = d;
+		for (int i = j + 1; i < 6; i++) {
+			double sum = A(i, j);
+			for (int k = 0; k < j; k++) {
+				sum -= A(i, k) * A(j, k);
+			}
+			A(i, j) = sum / d;
+		}
+	}
+
+	// L y = b
+	for (int i = 0; i < 6; i++) {
+		for (int k = 0; k < i; k++) {
+			b(i) -= A(i, k) * b(k);
+		}
+		b(i) /= A(i, i);
+	}
+
+	// L^T q = y
+	Xyz_Angle_Axis_vector q;
+	for (int i = 5; i >= 0; i--) {
+		double sum = b(i);
+		for (int k = i + 1; k < 6; k++) {
+			sum -= A(k, i) * q[k];
+		}
+		q[i] = sum / A(i, i);
+	}
 
 	return q;
 }
@@ -166,47 +198,47 @@ void Jacobian_matrix::irp6_6dof_equations(const Xyz_Angle_Axis_vector & w)
 
 	//Wyznaczenie wzoru dla jakobianu
 
-	matrix[0][0] = 0;
-	matrix[1][0] = 0;
-	matrix[2][0] = 1;
-	matrix[3][0] = -s1 * (c4 * d5 + c3 * a3 + c2 * a2);
-	matrix[4][0] = c1 * (c4 * d5 + c3 * a3 + c2 * a2);
-	matrix[5][0] = 0;
-
-	matrix[0][1] = 0;
-	matrix[1][1] = 0;
-	matrix[2][1] = 0;
-	matrix[3][1] = -c1 * a2 * s2;
-	matrix[4][1] = -s1 * a2 * s2;
-	matrix[5][1] = -a2 * c2;
-
-	matrix[0][2] = 0;
-	matrix[1][2] = 0;
-	matrix[2][2] = 0;
-	matrix[3][2] = -c1 * a3 * s3;
-	matrix[4][2] = -s1 * a3 * s3;
-	matrix[5][2] = -a3 * c3;
-
-	matrix[0][3] = -s1;
-	matrix[1][3] = c1;
-	matrix[2][3] = 0;
-	matrix[3][3] = -c1 * s4 * d5;
-	matrix[4][3] = -s1 * s4 * d5;
-	matrix[5][3] = -d5 * c4;
-
-	matrix[0][4] = c1 * c4;
-	matrix[1][4] = s1 * c4;
-	matrix[2][4] = -s4;
-	matrix[3][4] = 0;
-	matrix[4][4] = 0;
-	matrix[5][4] = 0;
-
-	matrix[0][5] = c1 * s4 * s5 - s1 * c5;
-	matrix[1][5] = s1 * s4 * s5 + c1 * c5;
-	matrix[2][5] = c4 * s5;
-	matrix[3][5] = 0;
-	matrix[4][5] = 0;
-	matrix[5][5] = 0;
+	matrix(0, 0) = 0;
+	matrix(1, 0) = 0;
+	matrix(2, 0) = 1;
+	matrix(3, 0) = -s1 * (c4 * d5 + c3 * a3 + c2 * a2);
+	matrix(4, 0) = c1 * (c4 * d5 + c3 * a3 + c2 * a2);
+	matrix(5, 0) = 0;
+
+	matrix(0, 1) = 0;
+	matrix(1, 1) = 0;
+	matrix(2, 1) = 0;
+	matrix(3, 1) = -c1 * a2 * s2;
+	matrix(4, 1) = -s1 * a2 * s2;
+	matrix(5, 1) = -a2 * c2;
+
+	matrix(0, 2) = 0;
+	matrix(1, 2) = 0;
+	matrix(2, 2) = 0;
+	matrix(3, 2) = -c1 * a3 * s3;
+	matrix(4, 2) = -s1 * a3 * s3;
+	matrix(5, 2) = -a3 * c3;
+
+	matrix(0, 3) = -s1;
+	matrix(1, 3) = c1;
+	matrix(2, 3) = 0;
+	matrix(3, 3) = -c1 * s4 * d5;
+	matrix(4, 3) = -s1 * s4 * d5;
+	matrix(5, 3) = -d5 * c4;
+
+	matrix(0, 4) = c1 * c4;
+	matrix(1, 4) = s1 * c4;
+	matrix(2, 4) = -s4;
+	matrix(3, 4) = 0;
+	matrix(4, 4) = 0;
+	matrix(5, 4) = 0;
+
+	matrix(0, 5) = c1 * s4 * s5 - s1 * c5;
+	matrix(1, 5) = s1 * s4 * s5 + c1 * c5;
+	matrix(2, 5) = c4 * s5;
+	matrix(3, 5) = 0;
+	matrix(4, 5) = 0;
+	matrix(5, 5) = 0;
 
 }
 
@@ -260,55 +292,55 @@ void Jacobian_matrix::irp6_6dof_inverse_equations(const Xyz_Angle_Axis_vector &
 
 	//Wyznaczenie wzoru na odwrotnosc jakobianu
 
-	matrix[0][0] = 0.0;
-	matrix[0][1] = 0.0;
-	matrix[0][2] = 0.0;
-	matrix[0][3] = -s1 / (a2 * c2 + d5 * c4 + a3 * c3);
-	matrix[0][4] = c1 / (a2 * c2 + d5 * c4 + a3 * c3);
-	matrix[0][5] = 0.0;
+	matrix(0, 0) = 0.0;
+	matrix(0, 1) = 0.0;
+	matrix(0, 2) = 0.0;
+	matrix(0, 3) = -s1 / (a2 * c2 + d5 * c4 + a3 * c3);
+	matrix(0, 4) = c1 / (a2 * c2 + d5 * c4 + a3 * c3);
+	matrix(0, 5) = 0.0;
 
-	matrix[1][0] = (c1 * s3 * s4 * c5 * c4 - c1 * c3 * c5 + c1 * c3 * c5 * c4 * c4 + s3 * s1 * s5 * c4 - c3 * s4 * s1
+	matrix(1, 0) = (c1 * s3 * s4 * c5 * c4 - c1 * c3 * c5 + c1 * c3 * c5 * c4 * c4 + s3 * s1 * s5 * c4 - c3 * s4 * s1
 			* s5) * d5 / (s3 * c2 - s2 * c3) / a2 / s5;
-	matrix[1][1] = -(c1 * s3 * s5 * c4 - c1 * c3 * s4 * s5 - s1 * s3 * s4 * c5 * c4 + c3 * s1 * c5 - c3 * s1 * c5 * c4
+	matrix(1, 1) = -(c1 * s3 * s5 * c4 - c1 * c3 * s4 * s5 - s1 * s3 * s4 * c5 * c4 + c3 * s1 * c5 - c3 * s1 * c5 * c4
 			* c4) * d5 / (s3 * c2 - s2 * c3) / a2 / s5;
-	matrix[1][2] = (s3 * c4 - c3 * s4) * c4 * d5 * c5 / (s3 * c2 - s2 * c3) / a2 / s5;
-	matrix[1][3] = (c1 * c4 * d5 * c3 * s5 + c1 * c3 * c3 * a3 * s5 + c1 * c2 * a2 * c3 * s5 - c3 * s1 * c4 * d5 * s4
+	matrix(1, 2) = (s3 * c4 - c3 * s4) * c4 * d5 * c5 / (s3 * c2 - s2 * c3) / a2 / s5;
+	matrix(1, 3) = (c1 * c4 * d5 * c3 * s5 + c1 * c3 * c3 * a3 * s5 + c1 * c2 * a2 * c3 * s5 - c3 * s1 * c4 * d5 * s4
 			* c5 + s1 * s3 * c4 * c4 * d5 * c5) / (a2 * c2 + d5 * c4 + a3 * c3) / (s3 * c2 - s2 * c3) / a2 / s5;
-	matrix[1][4] = -(c1 * s3 * c4 * c4 * d5 * c5 - c1 * c3 * c4 * d5 * s4 * c5 - c2 * a2 * s1 * c3 * s5 - c4 * d5 * s1
+	matrix(1, 4) = -(c1 * s3 * c4 * c4 * d5 * c5 - c1 * c3 * c4 * d5 * s4 * c5 - c2 * a2 * s1 * c3 * s5 - c4 * d5 * s1
 			* c3 * s5 - c3 * c3 * a3 * s1 * s5) / (a2 * c2 + d5 * c4 + a3 * c3) / (s3 * c2 - s2 * c3) / a2 / s5;
-	matrix[1][5] = -s3 / a2 / (s3 * c2 - s2 * c3);
+	matrix(1, 5) = -s3 / a2 / (s3 * c2 - s2 * c3);
 
-	matrix[2][0] = (c1 * c2 * c5 - c1 * c2 * c5 * c4 * c4 - c1 * s2 * c4 * s4 * c5 + c2 * s4 * s1 * s5 - s2 * c4 * s1
+	matrix(2, 0) = (c1 * c2 * c5 - c1 * c2 * c5 * c4 * c4 - c1 * s2 * c4 * s4 * c5 + c2 * s4 * s1 * s5 - s2 * c4 * s1
 			* s5) * d5 / (s3 * c2 - s2 * c3) / a3 / s5;
-	matrix[2][1] = -(c1 * c2 * s4 * s5 - c1 * s2 * c4 * s5 - c2 * s1 * c5 + c2 * s1 * c5 * c4 * c4 + s1 * s2 * c4 * s4
+	matrix(2, 1) = -(c1 * c2 * s4 * s5 - c1 * s2 * c4 * s5 - c2 * s1 * c5 + c2 * s1 * c5 * c4 * c4 + s1 * s2 * c4 * s4
 			* c5) * d5 / (s3 * c2 - s2 * c3) / a3 / s5;
-	matrix[2][2] = (c2 * s4 - s2 * c4) * c4 * d5 * c5 / (s3 * c2 - s2 * c3) / a3 / s5;
-	matrix[2][3] = -(c1 * c4 * d5 * c2 * s5 + c1 * c3 * a3 * c2 * s5 + c1 * c2 * c2 * a2 * s5 - c2 * s1 * c4 * d5 * s4
+	matrix(2, 2) = (c2 * s4 - s2 * c4) * c4 * d5 * c5 / (s3 * c2 - s2 * c3) / a3 / s5;
+	matrix(2, 3) = -(c1 * c4 * d5 * c2 * s5 + c1 * c3 * a3 * c2 * s5 + c1 * c2 * c2 * a2 * s5 - c2 * s1 * c4 * d5 * s4
 			* c5 + s1 * s2 * c4 * c4 * d5 * c5) / (a2 * c2 + d5 * c4 + a3 * c3) / (s3 * c2 - s2 * c3) / a3 / s5;
-	matrix[2][4] = -(-c1 * s2 * c4 * c4 * d5 * c5 + c1 * c2 * s4 * d5 * c4 * c5 + s1 * c2 * c2 * a2 * s5 + c2 * s1 * s5
+	matrix(2, 4) = -(-c1 * s2 * c4 * c4 * d5 * c5 + c1 * c2 * s4 * d5 * c4 * c5 + s1 * c2 * c2 * a2 * s5 + c2 * s1 * s5
 			* c4 * d5 + s1 * c3 * a3 * c2 * s5) / (a2 * c2 + d5 * c4 + a3 * c3) / (s3 * c2 - s2 * c3) / a3 / s5;
-	matrix[2][5] = 1 / (s3 * c2 - s2 * c3) / a3 * s2;
-
-	matrix[3][0] = -(s1 * s5 + s4 * c1 * c5) / s5;
-	matrix[3][1] = (c1 * s5 - s4 * s1 * c5) / s5;
-	matrix[3][2] = -c4 * c5 / s5;
-	matrix[3][3] = -s1 * c4 * c5 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
-	matrix[3][4] = c1 * c4 * c5 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
-	matrix[3][5] = 0.0;
-
-	matrix[4][0] = c1 * c4;
-	matrix[4][1] = s1 * c4;
-	matrix[4][2] = -s4;
-	matrix[4][3] = -s4 * s1 / (a2 * c2 + d5 * c4 + a3 * c3);
-	matrix[4][4] = c1 * s4 / (a2 * c2 + d5 * c4 + a3 * c3);
-	matrix[4][5] = 0.0;
-
-	matrix[5][0] = c1 * s4 / s5;
-	matrix[5][1] = s4 * s1 / s5;
-	matrix[5][2] = c4 / s5;
-	matrix[5][3] = c4 * s1 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
-	matrix[5][4] = -c4 * c1 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
-	matrix[5][5] = 0.0;
+	matrix(2, 5) = 1 / (s3 * c2 - s2 * c3) / a3 * s2;
+
+	matrix(3, 0) = -(s1 * s5 + s4 * c1 * c5) / s5;
+	matrix(3, 1) = (c1 * s5 - s4 * s1 * c5) / s5;
+	matrix(3, 2) = -c4 * c5 / s5;
+	matrix(3, 3) = -s1 * c4 * c5 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
+	matrix(3, 4) = c1 * c4 * c5 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
+	matrix(3, 5) = 0.0;
+
+	matrix(4, 0) = c1 * c4;
+	matrix(4, 1) = s1 * c4;
+	matrix(4, 2) = -s4;
+	matrix(4, 3) = -s4 * s1 / (a2 * c2 + d5 * c4 + a3 * c3);
+	matrix(4, 4) = c1 * s4 / (a2 * c2 + d5 * c4 + a3 * c3);
+	matrix(4, 5) = 0.0;
+
+	matrix(5, 0) = c1 * s4 / s5;
+	matrix(5, 1) = s4 * s1 / s5;
+	matrix(5, 2) = c4 / s5;
+	matrix(5, 3) = c4 * s1 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
+	matrix(5, 4) = -c4 * c1 / (a2 * c2 + d5 * c4 + a3 * c3) / s5;
+	matrix(5, 5) = 0.0;
 }
 
 
@@ -9,19 +9,22 @@
 #ifndef __JACOBIAN_MATRIX_H
 #define __JACOBIAN_MATRIX_H
 
+#include <Eigen/Core>
+
 namespace mrrocpp {
 namespace lib {
 
 /**
  * Jacobian 6x6 matrix class
- *
- * @todo Rewrite with Eigen matrix
  */
 class Jacobian_matrix
 {
 private:
+	//! Storage type, row-major as the former C-style array
+	typedef Eigen::Matrix <double, 6, 6, Eigen::RowMajor> matrix_t;
+
 	//! Matrix data place-holder
-	double matrix[6][6];
+	matrix_t matrix;
 
 public:
 	/**
@@ -78,12 +81,27 @@ public:
 	 */
 	Xyz_Angle_Axis_vector jacobian_inverse_gauss(const Xyz_Angle_Axis_vector & dist);
 
+	/**
+	 * Damped least-squares (Levenberg-Marquardt) step: solves (J^T J + lambda^2 I) q = J^T dist.
+	 *
+	 * The system is symmetric positive definite for lambda > 0, so it is solved
+	 * with a fixed-size Cholesky decomposition; the result stays bounded near
+	 * singular configurations, where the Gaussian elimination breaks down.
+	 *
+	 * @param[in] dist desired displacement of the end-effector
+	 * @param[in] lambda damping factor
+	 * @return joint increment
+	 */
+	Xyz_Angle_Axis_vector damped_least_squares(const Xyz_Angle_Axis_vector & dist, double lambda) const;
+
 	/**
 	 * Overloaded matrix multiplicity operator
 	 *
 	 * @param[in] multiplicand matrix
 	 */
 	Xyz_Angle_Axis_vector operator*(const Xyz_Angle_Axis_vector & w) const;
+
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
 } // namespace lib
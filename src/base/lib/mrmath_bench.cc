@@ -0,0 +1,179 @@
+/*!
+ * @file mrmath_bench.cc
+ * @brief Micro-benchmark of the Homog_matrix and Jacobian_matrix operations.
+ *
+ * The Eigen-based operations are compared with the scalar loops
+ * on C-style arrays used before.
+ *
+ * @ingroup LIB
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "base/lib/mrmath/mrmath.h"
+
+using namespace mrrocpp::lib;
+
+namespace {
+
+//! Number of iterations of each measured operation
+const int ITERATIONS = 1000000;
+
+//! Nanoseconds per iteration since the given time
+double ns_per_iteration(const struct timespec & start, int iterations)
+{
+	struct timespec stop;
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	return ((stop.tv_sec - start.tv_sec) * 1e9 + (stop.tv_nsec - start.tv_nsec)) / iterations;
+}
+
+//! Former composition of transformations on C-style arrays
+void scalar_compose(const double a[3][4], const double b[3][4], double c[3][4])
+{
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++) {
+			for (int k = 0; k < 3; k++) {
+				if (k == 0)
+					c[j][i] = a[j][k] * b[k][i];
+				else
+					c[j][i] += a[j][k] * b[k][i];
+			}
+		}
+
+	for (int j = 0; j < 3; j++) {
+		c[j][3] = 0;
+		for (int i = 0; i < 3; i++)
+			c[j][3] += a[j][i] * b[i][3];
+		c[j][3] += a[j][3];
+	}
+}
+
+//! Former inverse of transformation on C-style arrays
+void scalar_inverse(const double a[3][4], double c[3][4])
+{
+	for (int i = 0; i < 3; i++)
+		for (int j = 0; j < 3; j++)
+			c[i][j] = a[j][i];
+
+	for (int j = 0; j < 3; j++) {
+		c[j][3] = 0;
+		for (int i = 0; i < 3; i++)
+			c[j][3] += -1 * c[j][i] * a[i][3];
+	}
+}
+
+//! Former transformation of a vector on C-style arrays
+void scalar_transform(const double a[3][4], const double v[3], double w[3])
+{
+	for (int j = 0; j < 3; j++) {
+		w[j] = a[j][3];
+		for (int i = 0; i < 3; i++)
+			w[j] += a[j][i] * v[i];
+	}
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+	const int iterations = (argc > 1) ? atoi(argv[1]) : ITERATIONS;
+	struct timespec start;
+
+	// typowa transformacja - obrot i przesuniecie
+	const Homog_matrix A(Xyz_Angle_Axis_vector(0.1, -0.2, 0.3, 0.2, 0.4, -0.3));
+	const Homog_matrix B(Xyz_Angle_Axis_vector(-0.3, 0.1, 0.5, -0.1, 0.3, 0.2));
+
+	double a[3][4], b[3][4], c[3][4];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 4; j++) {
+			a[i][j] = A(i, j);
+			b[i][j] = B(i, j);
+		}
+	}
+
+	// wynik akumulowany, aby kompilator nie usunal obliczen
+	double checksum = 0;
+
+	std::cout << "operation\t\tscalar [ns]\tEigen [ns]" << std::endl;
+
+	// skladanie przeksztalcen
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		scalar_compose(a, b, c);
+		a[0][3] = c[0][3] * 1e-9;
+	}
+	checksum += c[0][3];
+	std::cout << "Homog_matrix compose\t" << ns_per_iteration(start, iterations);
+
+	Homog_matrix C(A);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		C = C * B;
+		C(0, 3) *= 1e-9;
+	}
+	checksum += C(0, 3);
+	std::cout << "\t\t" << ns_per_iteration(start, iterations) << std::endl;
+
+	// odwracanie przeksztalcenia
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		scalar_inverse(b, c);
+		b[0][3] = c[0][3] * 1e-9;
+	}
+	checksum += c[0][3];
+	std::cout << "Homog_matrix inverse\t" << ns_per_iteration(start, iterations);
+
+	C = B;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		C = !C;
+		C(0, 3) *= 1e-9;
+	}
+	checksum += C(0, 3);
+	std::cout << "\t\t" << ns_per_iteration(start, iterations) << std::endl;
+
+	// przeksztalcenie wektora
+	double v[3] = { 0.1, 0.2, 0.3 }, w[3];
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		scalar_transform(a, v, w);
+		v[0] = w[0] * 1e-9;
+	}
+	checksum += w[0];
+	std::cout << "Homog_matrix transform\t" << ns_per_iteration(start, iterations);
+
+	K_vector kv(0.1, 0.2, 0.3);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		kv = A * kv;
+		kv[0] *= 1e-9;
+	}
+	checksum += kv[0];
+	std::cout << "\t\t" << ns_per_iteration(start, iterations) << std::endl;
+
+	// rozwiazanie ukladu rownan z jakobianem
+	Jacobian_matrix J;
+	J.irp6_6dof_equations(Xyz_Angle_Axis_vector(0.1, -1.5, 0.2, 1.6, 1.2, 0.3));
+	Xyz_Angle_Axis_vector dist(0.01, 0.02, -0.01, 0.001, 0.002, 0.003);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		dist[0] += J.jacobian_inverse_gauss(dist)[0] * 1e-9;
+	}
+	checksum += dist[0];
+	std::cout << "Jacobian gauss\t\t-\t\t" << ns_per_iteration(start, iterations) << std::endl;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int n = 0; n < iterations; n++) {
+		dist[0] += J.damped_least_squares(dist, 0.01)[0] * 1e-9;
+	}
+	checksum += dist[0];
+	std::cout << "Jacobian DLS\t\t-\t\t" << ns_per_iteration(start, iterations) << std::endl;
+
+	std::cout << "checksum " << checksum << std::endl;
+
+	return 0;
+}
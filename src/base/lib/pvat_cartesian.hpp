@@ -156,16 +156,10 @@ void linear_interpolate_motor_poses(Eigen::Matrix <double, N_POINTS, N_MOTORS> &
 	lib::Homog_matrix int_ee_frame;
 	lib::JointArray int_joints(N_MOTORS);
 	lib::MotorArray int_motors(N_MOTORS);
-	// Set last joint settings.
-	lib::JointArray int_joints_old = desired_joints_old_;
 
-	// Add current position as first one, thus there will be n+1 interpolation points.
-	// Compute inverse kinematics for desired pose. Pass previously desired joint position as current in order to receive continuous move.
-	model_->inverse_kinematics_transform(int_joints, desired_joints_old_, current_end_effector_frame_);
-	// Transform joints to motors (and check motors/joints values).
-	model_->i2mp_transform(int_motors, int_joints);
-	// Add motors to vector - first interpolation point.
-	motor_interpolations_.row(0) = int_motors.transpose();
+	// Interpolated frames - add current position as first one, thus there will be n+1 interpolation points.
+	kinematics::common::kinematic_model::frame_batch_t int_ee_frames(N_POINTS, 12);
+	kinematics::common::kinematic_model::set_batch_frame(int_ee_frames, 0, current_end_effector_frame_);
 
 	// Temporary variables containing motion time from start to current position (sum of time slices).
 	double last_summed = time_deltas_(0);
@@ -189,29 +183,37 @@ void linear_interpolate_motor_poses(Eigen::Matrix <double, N_POINTS, N_MOTORS> &
 		// Compute desired interpolation end effector frame.
 		int_ee_frame = current_end_effector_frame_ * delta_ee_frame;
 
-		// Compute inverse kinematics for desired pose. Pass previously desired joint position as current in order to receive continuous move.
-		model_->inverse_kinematics_transform(int_joints, int_joints_old, int_ee_frame);
+		// Add frame to the batch.
+		kinematics::common::kinematic_model::set_batch_frame(int_ee_frames, i + 1, int_ee_frame);
 
+#if 0
+		cout << int_ee_frame << endl;
+#endif
+
+		// Add time slice related to this segment.
+		if (i < N_POINTS - 2) {
+			last_summed += time_deltas_(i + 1);
+			total_time_factor = last_summed / motion_time_;
+		}
+	}
+
+	// Compute inverse kinematics for all interpolation poses in one pass. Pass previously desired joint position as current in order to receive continuous move.
+	kinematics::common::kinematic_model::joint_batch_t int_joints_batch;
+	model_->inverse_kinematics_transform_batch(int_joints_batch, desired_joints_old_, int_ee_frames);
+
+	for (int i = 0; i < N_POINTS; ++i) {
+		int_joints = int_joints_batch.row(i).transpose();
 
 		// Transform joints to motors (and check motors/joints values).
 		model_->i2mp_transform(int_motors, int_joints);
 
-#if 1
-		cout << int_ee_frame << endl;
+#if 0
 		cout << int_joints << endl;
 		cout << int_motors << endl;
 #endif
 
 		// Add motors to vector.
-		motor_interpolations_.row(i + 1) = int_motors.transpose();
-
-		// Set last joint settings.
-		int_joints_old = int_joints;
-		// Add time slice related to this segment.
-		if (i < N_POINTS - 2) {
-			last_summed += time_deltas_(i + 1);
-			total_time_factor = last_summed / motion_time_;
-		}
+		motor_interpolations_.row(i) = int_motors.transpose();
 	}
 
 #if 0
@@ -279,16 +281,10 @@ void cubic_polynomial_interpolate_motor_poses(Eigen::Matrix <double, N_POINTS, N
 	lib::Homog_matrix int_ee_frame;
 	lib::JointArray int_joints(N_MOTORS);
 	lib::MotorArray int_motors(N_MOTORS);
-	// Set last joint settings.
-	lib::JointArray int_joints_old = desired_joints_old_;
 
-	// Add current position as first one, thus there will be n+1 interpolation points.
-	// Compute inverse kinematics for desired pose. Pass previously desired joint position as current in order to receive continuous move.
-	model_->inverse_kinematics_transform(int_joints, desired_joints_old_, current_end_effector_frame_);
-	// Transform joints to motors (and check motors/joints values).
-	model_->i2mp_transform(int_motors, int_joints);
-	// Add motors to vector - first interpolation point.
-	motor_interpolations_.row(0) = int_motors.transpose();
+	// Interpolated frames - add current position as first one, thus there will be n+1 interpolation points.
+	kinematics::common::kinematic_model::frame_batch_t int_ee_frames(N_POINTS, 12);
+	kinematics::common::kinematic_model::set_batch_frame(int_ee_frames, 0, current_end_effector_frame_);
 
 	// Temporary variables containing motion time from start to current position (sum of time slices).
 	double last_summed = time_deltas_(0);
@@ -320,31 +316,40 @@ void cubic_polynomial_interpolate_motor_poses(Eigen::Matrix <double, N_POINTS, N
 		// Compute desired interpolation end effector frame.
 		int_ee_frame = current_end_effector_frame_ * delta_ee_frame;
 
-		// Compute inverse kinematics for desired pose. Pass previously desired joint position as current in order to receive continuous move.
-		model_->inverse_kinematics_transform(int_joints, int_joints_old, int_ee_frame);
-
-		// Transform joints to motors (and check motors/joints values).
-		model_->i2mp_transform(int_motors, int_joints);
+		// Add frame to the batch.
+		kinematics::common::kinematic_model::set_batch_frame(int_ee_frames, i + 1, int_ee_frame);
 
 #if 0
 		cout << "delta xyz aa gamma "<< delta_xyz_aa_gamma << endl;
 		cout << "delta ee frame "<< delta_ee_frame << endl;
 		cout << "interpolation ee frame "<< int_ee_frame << endl;
-		cout << int_joints << endl;
-		cout << int_motors << endl;
 #endif
 
-		// Add motors to vector.
-		motor_interpolations_.row(i + 1) = int_motors.transpose();
-
-		// Set last joint settings.
-		int_joints_old = int_joints;
 		// Add time slice related to this segment.
 		if (i < N_POINTS - 2) {
 			last_summed += time_deltas_(i + 1);
 		}
 	}
 
+	// Compute inverse kinematics for all interpolation poses in one pass. Pass previously desired joint position as current in order to receive continuous move.
+	kinematics::common::kinematic_model::joint_batch_t int_joints_batch;
+	model_->inverse_kinematics_transform_batch(int_joints_batch, desired_joints_old_, int_ee_frames);
+
+	for (int i = 0; i < N_POINTS; ++i) {
+		int_joints = int_joints_batch.row(i).transpose();
+
+		// Transform joints to motors (and check motors/joints values).
+		model_->i2mp_transform(int_motors, int_joints);
+
+#if 0
+		cout << int_joints << endl;
+		cout << int_motors << endl;
+#endif
+
+		// Add motors to vector.
+		motor_interpolations_.row(i) = int_motors.transpose();
+	}
+
 #if 0
 	// Display all motor interpolation poses.
 	for (unsigned int l = 0; l < N_POINTS; ++l) {
@@ -412,16 +417,10 @@ void cubic_polynomial_interpolate_motor_poses_in_tool_frame(Eigen::Matrix <doubl
 	lib::Homog_matrix int_ee_frame;
 	lib::JointArray int_joints(N_MOTORS);
 	lib::MotorArray int_motors(N_MOTORS);
-	// Set last joint settings.
-	lib::JointArray int_joints_old = desired_joints_old_;
 
-	// Add current position as first one, thus there will be n+1 interpolation points.
-	// Compute inverse kinematics for desired pose. Pass previously desired joint position as current in order to receive continuous move.
-	model_->inverse_kinematics_transform(int_joints, desired_joints_old_, current_tool_frame_*!tool_transformation_);
-	// Transform joints to motors (and check motors/joints values).
-	model_->i2mp_transform(int_motors, int_joints);
-	// Add motors to vector - first interpolation point.
-	motor_interpolations_.row(0) = int_motors.transpose();
+	// Interpolated frames - add current position as first one, thus there will be n+1 interpolation points.
+	kinematics::common::kinematic_model::frame_batch_t int_ee_frames(N_POINTS, 12);
+	kinematics::common::kinematic_model::set_batch_frame(int_ee_frames, 0, current_tool_frame_*!tool_transformation_);
 
 	// Temporary variables containing motion time from start to current position (sum of time slices).
 	double last_summed = time_deltas_(0);
@@ -453,31 +452,40 @@ void cubic_polynomial_interpolate_motor_poses_in_tool_frame(Eigen::Matrix <doubl
 		// Compute desired interpolation end effector frame.
 		int_ee_frame = current_tool_frame_ * delta_ee_frame *!tool_transformation_;
 
-		// Compute inverse kinematics for desired pose. Pass previously desired joint position as current in order to receive continuous move.
-		model_->inverse_kinematics_transform(int_joints, int_joints_old, int_ee_frame);
-
-		// Transform joints to motors (and check motors/joints values).
-		model_->i2mp_transform(int_motors, int_joints);
+		// Add frame to the batch.
+		kinematics::common::kinematic_model::set_batch_frame(int_ee_frames, i + 1, int_ee_frame);
 
 #if 0
 		cout << "delta xyz aa gamma "<< delta_xyz_aa_gamma << endl;
 		cout << "delta ee frame "<< delta_ee_frame << endl;
 		cout << "interpolation ee frame "<< int_ee_frame << endl;
-		cout << int_joints << endl;
-		cout << int_motors << endl;
 #endif
 
-		// Add motors to vector.
-		motor_interpolations_.row(i + 1) = int_motors.transpose();
-
-		// Set last joint settings.
-		int_joints_old = int_joints;
 		// Add time slice related to this segment.
 		if (i < N_POINTS - 2) {
 			last_summed += time_deltas_(i + 1);
 		}
 	}
 
+	// Compute inverse kinematics for all interpolation poses in one pass. Pass previously desired joint position as current in order to receive continuous move.
+	kinematics::common::kinematic_model::joint_batch_t int_joints_batch;
+	model_->inverse_kinematics_transform_batch(int_joints_batch, desired_joints_old_, int_ee_frames);
+
+	for (int i = 0; i < N_POINTS; ++i) {
+		int_joints = int_joints_batch.row(i).transpose();
+
+		// Transform joints to motors (and check motors/joints values).
+		model_->i2mp_transform(int_motors, int_joints);
+
+#if 0
+		cout << int_joints << endl;
+		cout << int_motors << endl;
+#endif
+
+		// Add motors to vector.
+		motor_interpolations_.row(i) = int_motors.transpose();
+	}
+
 #if 0
 	// Display all motor interpolation poses.
 	for (unsigned int l = 0; l < N_POINTS; ++l) {
@@ -4,7 +4,8 @@ namespace mrrocpp {
 namespace lib {
 
 r_buffer_base::r_buffer_base(void) :
-		reply_type(lib::ERROR)
+		reply_type(lib::ERROR),
+		query_in_reply(false)
 {
 }
 
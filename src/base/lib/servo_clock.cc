@@ -0,0 +1,247 @@
+/*!
+ * @file servo_clock.cc
+ * @brief Servo time base shared by the co-located EDPs.
+ *
+ * @ingroup LIB
+ */
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#include "base/lib/servo_clock.h"
+
+namespace mrrocpp {
+namespace lib {
+
+namespace {
+
+//! States of the shared segment
+enum
+{
+	SEGMENT_EMPTY = 0, SEGMENT_INITIALISING, SEGMENT_READY
+};
+
+//! How long to wait for the segment initialised by another process [ms]
+const int READY_TIMEOUT_MS = 1000;
+
+//! Check if a slot belongs to a running process
+bool is_alive(int32_t pid)
+{
+	return (pid != 0) && !((kill(pid, 0) == -1) && (errno == ESRCH));
+}
+
+} // namespace
+
+uint64_t servo_clock::now_ns()
+{
+	struct timespec now;
+	if (clock_gettime(CLOCK_MONOTONIC, &now) == -1) {
+		perror("clock_gettime()");
+		throw std::runtime_error("clock_gettime()");
+	}
+	return (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+std::string servo_clock::segment_name(const std::string & clock_name)
+{
+	return "/mrrocpp_servo_clock_" + clock_name;
+}
+
+servo_clock::servo_clock(const std::string & clock_name, const std::string & participant_name, uint64_t _period_ns) :
+	period_ns(_period_ns), segment(NULL), self(NULL), master(false)
+{
+	if (period_ns == 0) {
+		throw std::runtime_error("servo_clock: zero period");
+	}
+
+	const std::string name = segment_name(clock_name);
+
+	// tylko procesy tego samego uzytkownika moga zmieniac podstawe czasu
+	int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+	if (fd == -1) {
+		perror("shm_open()");
+		throw std::runtime_error("shm_open()");
+	}
+
+	// nowy obiekt wypelniany jest zerami, czyli SEGMENT_EMPTY
+	if (ftruncate(fd, sizeof(servo_clock_segment)) == -1) {
+		perror("ftruncate()");
+		close(fd);
+		throw std::runtime_error("ftruncate()");
+	}
+
+	void * addr = mmap(NULL, sizeof(servo_clock_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		perror("mmap()");
+		throw std::runtime_error("mmap()");
+	}
+	segment = static_cast <servo_clock_segment *> (addr);
+
+	// pierwszy proces publikuje podstawe czasu
+	if (__sync_bool_compare_and_swap(&segment->state, SEGMENT_EMPTY, SEGMENT_INITIALISING)) {
+		publish();
+	} else {
+		int waited_ms = 0;
+		while (__sync_fetch_and_add(&segment->state, 0) != SEGMENT_READY) {
+			if (++waited_ms > READY_TIMEOUT_MS) {
+				// proces inicjujacy segment zakonczyl sie w trakcie publikacji
+				publish();
+				break;
+			}
+			usleep(1000);
+		}
+	}
+
+	if (segment->period_ns != period_ns) {
+		// okres moze zmienic tylko ostatni uczestnik pozostaly z poprzedniego uruchomienia
+		bool in_use = false;
+		for (int i = 0; i < SERVO_CLOCK_MAX_PARTICIPANTS; ++i) {
+			in_use = in_use || is_alive(segment->participants[i].pid);
+		}
+		if (in_use || !__sync_bool_compare_and_swap(&segment->state, SEGMENT_READY, SEGMENT_INITIALISING)) {
+			munmap(segment, sizeof(servo_clock_segment));
+			throw std::runtime_error("servo_clock: period differs from the one of the running participants");
+		}
+		publish();
+	}
+
+	attach(participant_name);
+
+	// pierwszy takt po biezacej chwili
+	next_tick = (now_ns() - segment->epoch_ns) / period_ns + 1;
+}
+
+servo_clock::~servo_clock()
+{
+	if (self) {
+		__sync_bool_compare_and_swap(&self->pid, (int32_t) getpid(), 0);
+	}
+	munmap(segment, sizeof(servo_clock_segment));
+}
+
+void servo_clock::publish()
+{
+	segment->period_ns = period_ns;
+	segment->epoch_ns = now_ns();
+	__sync_synchronize();
+	segment->state = SEGMENT_READY;
+	master = true;
+}
+
+void servo_clock::attach(const std::string & participant_name)
+{
+	const int32_t pid = getpid();
+
+	for (int i = 0; i < SERVO_CLOCK_MAX_PARTICIPANTS && !self; ++i) {
+		servo_clock_participant & slot = segment->participants[i];
+		const int32_t owner = slot.pid;
+		if (!is_alive(owner) && __sync_bool_compare_and_swap(&slot.pid, owner, pid)) {
+			self = &slot;
+		}
+	}
+
+	if (!self) {
+		munmap(segment, sizeof(servo_clock_segment));
+		throw std::runtime_error("servo_clock: no free participant slot");
+	}
+
+	strncpy(self->name, participant_name.c_str(), sizeof(self->name) - 1);
+	self->name[sizeof(self->name) - 1] = '\0';
+	self->tick = 0;
+	self->missed_ticks = 0;
+	self->wakeups = 0;
+	self->phase_error_last = 0;
+	self->phase_error_max = 0;
+	self->phase_error_sum = 0;
+}
+
+void servo_clock::sleep()
+{
+	const uint64_t epoch = segment->epoch_ns;
+
+	// ostatni takt, ktory juz minal
+	const uint64_t passed = (now_ns() - epoch) / period_ns;
+
+	// po przekroczeniu cyklu o wiecej niz okres pominiete takty nie sa nadrabiane,
+	// tak aby nie wykonywac serii cykli bez przerwy i zachowac faze
+	if (next_tick < passed) {
+		self->missed_ticks += passed - next_tick;
+		next_tick = passed;
+	}
+
+	const uint64_t wake = epoch + next_tick * period_ns;
+
+	struct timespec wake_time;
+	wake_time.tv_sec = wake / 1000000000ULL;
+	wake_time.tv_nsec = wake % 1000000000ULL;
+
+	int err;
+	while ((err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_time, NULL)) == EINTR) {
+	}
+	if (err != 0) {
+		fprintf(stderr, "clock_nanosleep(): %s\n", strerror(err));
+	}
+
+	// blad fazy - opoznienie wybudzenia wzgledem taktu wspolnej podstawy czasu
+	const int64_t phase_error = (int64_t) (now_ns() - wake);
+
+	self->tick = next_tick;
+	self->wakeups++;
+	self->phase_error_last = phase_error;
+	self->phase_error_sum += phase_error;
+	if (phase_error > self->phase_error_max) {
+		self->phase_error_max = phase_error;
+	}
+
+	next_tick++;
+}
+
+bool servo_clock::is_master() const
+{
+	return master;
+}
+
+const servo_clock_participant & servo_clock::telemetry() const
+{
+	return *self;
+}
+
+bool servo_clock::read(const std::string & clock_name, servo_clock_segment & copy)
+{
+	int fd = shm_open(segment_name(clock_name).c_str(), O_RDONLY, 0);
+	if (fd == -1) {
+		return false;
+	}
+
+	void * addr = mmap(NULL, sizeof(servo_clock_segment), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		return false;
+	}
+
+	memcpy(&copy, addr, sizeof(servo_clock_segment));
+	munmap(addr, sizeof(servo_clock_segment));
+
+	// sloty zakonczonych procesow nie sa pokazywane
+	for (int i = 0; i < SERVO_CLOCK_MAX_PARTICIPANTS; ++i) {
+		if (!is_alive(copy.participants[i].pid)) {
+			copy.participants[i].pid = 0;
+		}
+	}
+
+	return (copy.state == SEGMENT_READY);
+}
+
+} // namespace lib
+} // namespace mrrocpp
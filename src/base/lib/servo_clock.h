@@ -0,0 +1,118 @@
+/*!
+ * @file servo_clock.h
+ * @brief Servo time base shared by the co-located EDPs.
+ *
+ * @ingroup LIB
+ */
+
+#ifndef SERVO_CLOCK_H_
+#define SERVO_CLOCK_H_
+
+#include <string>
+#include <stdint.h>
+
+#include <boost/utility.hpp>
+
+namespace mrrocpp {
+namespace lib {
+
+//! Maximal number of processes locked to a single servo clock
+const int SERVO_CLOCK_MAX_PARTICIPANTS = 8;
+
+//! Phase telemetry of a process locked to the servo clock
+struct servo_clock_participant
+{
+	//! Process identifier, 0 for a free slot
+	int32_t pid;
+	//! Name of the participant, usually the robot name
+	char name[32];
+	//! Number of the last tick of the time base
+	uint64_t tick;
+	//! Number of ticks skipped due to overruns of the cycle
+	uint64_t missed_ticks;
+	//! Number of wake-ups
+	uint64_t wakeups;
+	//! Delay of the last wake-up after its tick [ns]
+	int64_t phase_error_last;
+	//! Largest delay of a wake-up [ns]
+	int64_t phase_error_max;
+	//! Sum of the delays, for the average [ns]
+	int64_t phase_error_sum;
+};
+
+//! Layout of the shared memory segment of the servo clock
+struct servo_clock_segment
+{
+	//! Initialisation state of the segment
+	uint32_t state;
+	//! Period of the time base [ns]
+	uint64_t period_ns;
+	//! Time of the tick 0 of the time base, CLOCK_MONOTONIC [ns]
+	uint64_t epoch_ns;
+	//! Slots of the participants
+	servo_clock_participant participants[SERVO_CLOCK_MAX_PARTICIPANTS];
+};
+
+//! Periodic time base shared by the processes of a single node
+//! @note The first process attaching to the clock publishes its epoch in the shared memory;
+//! all the participants wake up at the ticks epoch + k * period of the same CLOCK_MONOTONIC,
+//! so their servo loops stay in phase instead of drifting apart.
+class servo_clock : boost::noncopyable {
+private:
+	//! Period in nanoseconds
+	const uint64_t period_ns;
+
+	//! Segment of the shared memory with the time base
+	servo_clock_segment * segment;
+
+	//! Slot of this process in the segment
+	servo_clock_participant * self;
+
+	//! Number of the tick to wait for
+	uint64_t next_tick;
+
+	//! True if this process has published the epoch
+	bool master;
+
+	//! Current value of CLOCK_MONOTONIC in nanoseconds
+	static uint64_t now_ns();
+
+	//! Name of the shared memory object for a given clock
+	static std::string segment_name(const std::string & clock_name);
+
+	//! Publish a new epoch and period; called with the segment in the initialising state
+	void publish();
+
+	//! Claim a free or stale slot for the telemetry of this process
+	void attach(const std::string & participant_name);
+
+public:
+	//! Constructor
+	//! @param clock_name name of the clock, processes using the same name are phase-locked
+	//! @param participant_name name shown in the telemetry
+	//! @param _period_ns period in nanoseconds, the same for all the participants
+	servo_clock(const std::string & clock_name, const std::string & participant_name, uint64_t _period_ns);
+
+	//! Destructor, releases the slot of the process
+	~servo_clock();
+
+	//! Wait until the next tick of the shared time base
+	void sleep();
+
+	//! Check if this process has published the epoch of the clock
+	bool is_master() const;
+
+	//! Phase telemetry of this process
+	const servo_clock_participant & telemetry() const;
+
+	//! Copy the state of a clock, e.g. for a monitoring tool
+	//! @param clock_name name of the clock
+	//! @param copy place for the state
+	//! @return false if the clock does not exist
+	static bool read(const std::string & clock_name, servo_clock_segment & copy);
+};
+
+} // namespace lib
+} // namespace mrrocpp
+
+#endif /* SERVO_CLOCK_H_ */
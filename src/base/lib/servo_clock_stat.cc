@@ -0,0 +1,59 @@
+/*!
+ * @file servo_clock_stat.cc
+ * @brief Display of the phase telemetry of the processes locked to a servo clock.
+ *
+ * Usage: servo_clock_stat <clock name> [refresh period in ms]
+ *
+ * @ingroup LIB
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include "base/lib/servo_clock.h"
+
+using namespace mrrocpp::lib;
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <clock name> [refresh period in ms]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const int refresh_ms = (argc > 2) ? atoi(argv[2]) : 0;
+
+	do {
+		servo_clock_segment clock;
+		if (!servo_clock::read(argv[1], clock)) {
+			std::cerr << "servo clock \"" << argv[1] << "\" does not exist" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << "period [us] " << clock.period_ns / 1000 << std::endl;
+		std::cout << std::setw(16) << "participant" << std::setw(8) << "pid" << std::setw(12) << "tick"
+				<< std::setw(8) << "missed" << std::setw(12) << "last [us]" << std::setw(12) << "avg [us]"
+				<< std::setw(12) << "max [us]" << std::endl;
+
+		for (int i = 0; i < SERVO_CLOCK_MAX_PARTICIPANTS; ++i) {
+			const servo_clock_participant & p = clock.participants[i];
+			if (p.pid == 0) {
+				continue;
+			}
+			std::cout << std::setw(16) << p.name << std::setw(8) << p.pid << std::setw(12) << p.tick
+					<< std::setw(8) << p.missed_ticks << std::setw(12) << p.phase_error_last / 1000
+					<< std::setw(12) << (p.wakeups ? p.phase_error_sum / (int64_t) p.wakeups / 1000 : 0)
+					<< std::setw(12) << p.phase_error_max / 1000 << std::endl;
+		}
+
+		if (refresh_ms > 0) {
+			usleep(refresh_ms * 1000);
+			std::cout << std::endl;
+		}
+	} while (refresh_ms > 0);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/*!
+ * @file simulation_clock.cc
+ * @brief Virtual time base of the simulated hardware.
+ *
+ * @ingroup LIB
+ */
+
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+
+#include "base/lib/simulation_clock.h"
+
+namespace mrrocpp {
+namespace lib {
+
+uint64_t simulation_clock::real_now_ns()
+{
+	struct timespec now;
+	if (clock_gettime(CLOCK_MONOTONIC, &now) == -1) {
+		perror("clock_gettime()");
+		throw std::runtime_error("clock_gettime()");
+	}
+	return (uint64_t) now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+simulation_clock::simulation_clock(double _speed) :
+	speed(_speed), virtual_ns(0), real_start_ns(0)
+{
+	if (speed < 0) {
+		throw std::runtime_error("simulation_clock: negative speed");
+	}
+}
+
+double simulation_clock::get_speed() const
+{
+	return speed;
+}
+
+uint64_t simulation_clock::now() const
+{
+	// odczyt 64-bitowej wartosci niepodzielny takze na maszynach 32-bitowych
+	return __sync_fetch_and_add(const_cast <volatile uint64_t *> (&virtual_ns), 0);
+}
+
+void simulation_clock::now(struct timespec & ts) const
+{
+	const uint64_t t = now();
+	ts.tv_sec = t / 1000000000ULL;
+	ts.tv_nsec = t % 1000000000ULL;
+}
+
+void simulation_clock::advance(uint64_t period_ns)
+{
+	const uint64_t t = __sync_add_and_fetch(&virtual_ns, period_ns);
+
+	// oczekujacy sprawdzaja czas pod muteksem, wiec powiadomienie nie moze sie z nimi minac
+	{
+		boost::mutex::scoped_lock lock(mtx);
+	}
+	cond.notify_all();
+
+	if (speed == 0) {
+		return;
+	}
+
+	// poczatek odliczany od pierwszego kroku serwa, a nie od utworzenia, ktore poprzedza inicjalizacje EDP
+	if (real_start_ns == 0) {
+		real_start_ns = real_now_ns();
+	}
+
+	// chwila czasu rzeczywistego odpowiadajaca czasowi wirtualnemu; po spoznieniu petla nadrabia bez czekania
+	const uint64_t wake = real_start_ns + (uint64_t) (t / speed);
+
+	struct timespec wake_time;
+	wake_time.tv_sec = wake / 1000000000ULL;
+	wake_time.tv_nsec = wake % 1000000000ULL;
+
+	int err;
+	while ((err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_time, NULL)) == EINTR) {
+	}
+	if (err != 0) {
+		fprintf(stderr, "clock_nanosleep(): %s\n", strerror(err));
+	}
+}
+
+void simulation_clock::sleep(uint64_t span_ns)
+{
+	const uint64_t wake = now() + span_ns;
+
+	boost::mutex::scoped_lock lock(mtx);
+	while (now() < wake) {
+		cond.wait(lock);
+	}
+}
+
+} // namespace lib
+} // namespace mrrocpp
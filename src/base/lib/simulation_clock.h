@@ -0,0 +1,69 @@
+/*!
+ * @file simulation_clock.h
+ * @brief Virtual time base of the simulated hardware.
+ *
+ * @ingroup LIB
+ */
+
+#ifndef SIMULATION_CLOCK_H_
+#define SIMULATION_CLOCK_H_
+
+#include <stdint.h>
+#include <time.h>
+
+#include <boost/utility.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace mrrocpp {
+namespace lib {
+
+//! Virtual time advanced by the servo loop of the simulated hardware
+//! @note The virtual time starts from zero and depends only on the number of the servo steps.
+//! In the unthrottled run the idle servo loop waits for the next command without advancing it,
+//! so the virtual time of every command does not depend on the host scheduling and the runs are repeatable.
+//! In the throttled run the servo loop follows the real time, also while idle, so the runs are not repeatable.
+class simulation_clock : boost::noncopyable {
+private:
+	//! Multiple of the real time, 0 for the unthrottled run
+	const double speed;
+
+	//! Virtual time [ns]
+	volatile uint64_t virtual_ns;
+
+	//! Value of CLOCK_MONOTONIC at the first advance() [ns], 0 before it
+	uint64_t real_start_ns;
+
+	//! Threads waiting for the virtual time
+	boost::mutex mtx;
+	boost::condition_variable cond;
+
+	//! Current value of CLOCK_MONOTONIC in nanoseconds
+	static uint64_t real_now_ns();
+
+public:
+	//! Constructor
+	//! @param _speed multiple of the real time, 0 for the unthrottled run
+	simulation_clock(double _speed);
+
+	//! Multiple of the real time, 0 for the unthrottled run
+	double get_speed() const;
+
+	//! Current virtual time [ns]
+	uint64_t now() const;
+
+	//! Current virtual time as a timespec, e.g. for the measurement records
+	void now(struct timespec & ts) const;
+
+	//! Advance the virtual time by a servo period, called by the servo loop only;
+	//! waits until the same multiple of the period passes in the real time, unless unthrottled
+	void advance(uint64_t period_ns);
+
+	//! Wait until a given span of the virtual time passes, e.g. in a sensor thread
+	void sleep(uint64_t span_ns);
+};
+
+} // namespace lib
+} // namespace mrrocpp
+
+#endif /* SIMULATION_CLOCK_H_ */
@@ -12,7 +12,12 @@
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/time.h>
 
+#include <boost/bind.hpp>
 #include <boost/thread/thread.hpp>
 
 #include "base/lib/messip/messip_dataport.h"
@@ -24,39 +29,153 @@
 namespace mrrocpp {
 namespace lib {
 
-Sender::Sender(const std::string & sr_name)
+Sender::Sender(const std::string & sr_name, process_type_t _process_type, const std::string & _process_name, sr_interpret_t _interpret) :
+	queue(new package_queue <sr_report_t, SR_QUEUE_LENGTH>),
+	process_type(_process_type), process_name(_process_name), interpret(_interpret),
+	dropped(0), terminate(false)
 {
-	unsigned int tmp = 0;
-	while ((ch = messip::port_connect(sr_name)) == NULL) {
-		if (tmp++ < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-		} else {
-			fprintf(stderr, "messip::port_connect(\"%s\") @ %s:%d: %s\n",
-					sr_name.c_str(), __FILE__, __LINE__, strerror(errno));
-			// TODO: throw
-			assert(0);
-		}
+	if(gethostname(hostname, sizeof(hostname)) == -1) {
+		perror("gethostname()");
+		hostname[0] = '\0';
+	}
+
+	if ((ch = messip::port_connect_wait(sr_name, lib::CONNECT_TIMEOUT)) == NULL) {
+		fprintf(stderr, "messip::port_connect_wait(\"%s\") @ %s:%d: %s\n",
+				sr_name.c_str(), __FILE__, __LINE__, strerror(errno));
+		// TODO: throw
+		assert(0);
 	}
 
 	assert(ch);
+
+	thread_id = boost::thread(boost::bind(&Sender::operator(), this));
 }
 
 Sender::~Sender() {
+	terminate = true;
+	thread_id.join();
+
 	if(messip::port_disconnect(ch) == -1) {
 		perror("messip::port_disconnect()");
 	}
 }
 
-void Sender::send_package(const sr_package_t& package)
+void Sender::operator()()
+{
+	// Sending to SR must not preempt the real-time threads of the process
+	struct sched_param param;
+	param.sched_priority = 0;
+	if (pthread_setschedparam(pthread_self(), SCHED_OTHER, &param)) {
+		perror("pthread_setschedparam()");
+	}
+
+	while (!terminate) {
+		boost::this_thread::sleep(lib::SR_FLUSH_PERIOD);
+		flush();
+	}
+
+	// Packages reported just before the termination
+	flush();
+}
+
+void Sender::flush()
+{
+	const unsigned int lost = __sync_fetch_and_and(&dropped, 0);
+
+	sr_batch_t batch;
+	batch.count = 0;
+
+	sr_report_t report;
+	sr_package_t package;
+	while (queue->pop(report)) {
+		format(report, package);
+
+		// Collapse consecutive identical messages
+		if (batch.count > 0) {
+			sr_package_t & last = batch.packages[batch.count - 1];
+			if (last.process_type == package.process_type && last.message_type == package.message_type
+					&& strncmp(last.process_name, package.process_name, sizeof(last.process_name)) == 0
+					&& strncmp(last.description, package.description, sizeof(last.description)) == 0) {
+				last.repeated += package.repeated;
+				continue;
+			}
+		}
+
+		if (batch.count == SR_BATCH_LENGTH) {
+			Send(batch);
+		}
+
+		batch.packages[batch.count++] = package;
+	}
+
+	if (lost) {
+		fprintf(stderr, "SR: queue full, %u message(s) lost\n", lost);
+
+		// Report the loss on behalf of the process, if its identity is known
+		if (batch.count > 0) {
+			package = batch.packages[batch.count - 1];
+			if (batch.count == SR_BATCH_LENGTH) {
+				Send(batch);
+			}
+			package.message_type = NON_FATAL_ERROR;
+			package.repeated = 1;
+			snprintf(package.description, sizeof(package.description), "SR queue full, %u message(s) lost", lost);
+			batch.packages[batch.count++] = package;
+		}
+	}
+
+	if (batch.count > 0) {
+		Send(batch);
+	}
+}
+
+void Sender::format(const sr_report_t & report, sr_package_t & package) const
+{
+	package.process_type = process_type;
+	strncpy(package.process_name, process_name.c_str(), sizeof(package.process_name));
+	strncpy(package.host_name, hostname, sizeof(package.host_name));
+
+	// time of the transfer, about SR_FLUSH_PERIOD after the report
+	struct timeval tv;
+	if(gettimeofday(&tv, NULL) == -1) {
+		perror("gettimeofday()");
+	}
+
+	package.tv.tv_sec = tv.tv_sec;
+	package.tv.tv_usec = tv.tv_usec;
+
+	package.message_type = report.message_type;
+
+	if (report.coded) {
+		interpret(package.description, report.message_type, report.error_code0, report.error_code1);
+		package.description[TEXT_LENGTH - 1] = '\0';
+		strncat(package.description, report.text, TEXT_LENGTH - 1 - strlen(package.description));
+	} else {
+		strcpy(package.description, report.text);
+	}
+
+	package.repeated = 1;
+}
+
+void Sender::Send(sr_batch_t & batch)
 {
 	// TODO: error check and throw an exception
-	int status = messip::port_send_async(ch, 0, 0, package, 0);
+	int status = messip::port_send_async(ch, 0, 0, batch, 0);
 
 	if(status == MESSIP_MSG_TIMEOUT) {
 		std::cerr << "SR: send would block, aborted" << std::endl;
 	} else if (status < 0) {
 		std::cerr << "SR: send failed" << std::endl;
 	}
+
+	batch.count = 0;
+}
+
+void Sender::send_report(const sr_report_t& report)
+{
+	if (!queue->push(report)) {
+		__sync_fetch_and_add(&dropped, 1);
+	}
 }
 
 } // namespace lib
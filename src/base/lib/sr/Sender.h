@@ -10,7 +10,15 @@
 #ifndef Sender_H_
 #define Sender_H_
 
+#include <string>
+
+#include <boost/thread/thread.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include "base/lib/com_buf.h"
+#include "base/lib/exception.h"
 #include "base/lib/messip/messip_dataport.h"
+#include "base/lib/sr/package_queue.h"
 
 namespace mrrocpp {
 namespace lib {
@@ -18,30 +26,83 @@ namespace lib {
 //! Forward declaration
 typedef struct sr_package sr_package_t;
 
-//! Base class for senders of system report messages
+//! Forward declaration
+typedef struct sr_batch sr_batch_t;
+
+//! Forward declaration
+typedef struct sr_report sr_report_t;
+
+//! Interpretation of the status codes into a text message
+typedef void (*sr_interpret_t)(char * description, error_class_t message_type, uint64_t error_code0, uint64_t error_code1);
+
+//! Number of reports waiting for the transfer to SR
+static const std::size_t SR_QUEUE_LENGTH = 128;
+
+/*!
+ * Base class for senders of system report messages.
+ *
+ * The reporting thread only puts the raw arguments of the report into a lock-free queue,
+ * so reporting from real-time threads does not involve any formatting nor communication.
+ * The queue is drained periodically by a low-priority thread, which builds
+ * the packages and sends them to SR in batches.
+ */
 class Sender
 {
 	//! Descriptor of SR communication channel
 	messip_channel_t *ch;
 
-protected:
-	//! Send default message package to the SR using underlying transport
-	//! @param[in] sr_mess package to send
-	void Send(const sr_package_t& package);
+	//! Queue of reports waiting for the transfer
+	boost::scoped_ptr <package_queue <sr_report_t, SR_QUEUE_LENGTH> > queue;
+
+	//! Reporting process type
+	const process_type_t process_type;
+
+	//! Reporting process name
+	const std::string process_name;
+
+	//! Cached hostname
+	char hostname[128];
+
+	//! Interpretation of the status codes of the reporting process
+	const sr_interpret_t interpret;
+
+	//! Number of packages lost because of the full queue
+	volatile unsigned int dropped;
+
+	//! Request to finish the sending thread
+	volatile bool terminate;
+
+	//! Sending thread
+	boost::thread thread_id;
+
+	//! Sending thread loop
+	void operator()();
+
+	//! Move all of the queued reports to SR
+	void flush();
+
+	//! Build the package from the report
+	void format(const sr_report_t & report, sr_package_t & package) const;
+
+	//! Send the batch to SR and clear it
+	void Send(sr_batch_t & batch);
 
 public:
 	/**
 	 * Constructor
 	 * @param sr_name name of the communication channel
+	 * @param _process_type reporting process type
+	 * @param _process_name reporting process name
+	 * @param _interpret interpretation of the status codes
 	 */
-	Sender(const std::string & sr_name);
+	Sender(const std::string & sr_name, process_type_t _process_type, const std::string & _process_name, sr_interpret_t _interpret);
 
-	//! Destructor
+	//! Destructor, sends the reports still waiting in the queue
 	~Sender();
 
-	//! Send package to the receiver
-	//! @param[in] package package to send
-	void send_package(const sr_package_t& package);
+	//! Send report to the receiver; never blocks
+	//! @param[in] report arguments of the report
+	void send_report(const sr_report_t& report);
 };
 
 } // namespace lib
@@ -0,0 +1,123 @@
+/*!
+ * @file package_queue.h
+ * @brief Bounded lock-free queue of system report packages.
+ *
+ * @ingroup LIB
+ */
+
+#ifndef PACKAGE_QUEUE_H_
+#define PACKAGE_QUEUE_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+
+namespace mrrocpp {
+namespace lib {
+
+/*!
+ * Bounded multiple-producer, single-consumer queue.
+ *
+ * Every cell carries a sequence number, which tells whether the cell is free
+ * for the producer of the given turn or ready for the consumer. Producers
+ * reserve a cell with a single compare-and-swap and never wait: if the queue is
+ * full, push() fails immediately and the caller decides what to do with the data.
+ *
+ * @tparam T type of the elements
+ * @tparam N capacity, has to be a power of 2
+ */
+template <typename T, std::size_t N>
+class package_queue : private boost::noncopyable
+{
+	BOOST_STATIC_ASSERT((N >= 2) && ((N & (N - 1)) == 0));
+
+private:
+	//! Single element together with its turn number
+	struct cell
+	{
+		volatile std::size_t sequence;
+		T data;
+	};
+
+	//! Storage
+	cell cells[N];
+
+	//! Position of the next push
+	volatile std::size_t enqueue_pos;
+
+	//! Position of the next pop, used only by the consumer
+	std::size_t dequeue_pos;
+
+public:
+	//! Constructor
+	package_queue() :
+		enqueue_pos(0), dequeue_pos(0)
+	{
+		for (std::size_t i = 0; i < N; ++i) {
+			cells[i].sequence = i;
+		}
+	}
+
+	/*!
+	 * Append an element; safe to call from many threads, never blocks.
+	 * @param value element to append
+	 * @return false if the queue is full
+	 */
+	bool push(const T & value)
+	{
+		cell * c;
+		std::size_t pos = enqueue_pos;
+		for (;;) {
+			c = &cells[pos & (N - 1)];
+			const std::size_t seq = c->sequence;
+			const intptr_t dif = (intptr_t) seq - (intptr_t) pos;
+			if (dif == 0) {
+				const std::size_t prev = __sync_val_compare_and_swap(&enqueue_pos, pos, pos + 1);
+				if (prev == pos) {
+					break;
+				}
+				pos = prev;
+			} else if (dif < 0) {
+				// the consumer did not free the cell yet
+				return false;
+			} else {
+				pos = enqueue_pos;
+			}
+		}
+
+		c->data = value;
+		__sync_synchronize();
+		c->sequence = pos + 1;
+
+		return true;
+	}
+
+	/*!
+	 * Remove the oldest element; may be called from a single thread only.
+	 * @param value removed element
+	 * @return false if the queue is empty
+	 */
+	bool pop(T & value)
+	{
+		cell * c = &cells[dequeue_pos & (N - 1)];
+		const std::size_t seq = c->sequence;
+		if ((intptr_t) seq - (intptr_t) (dequeue_pos + 1) < 0) {
+			return false;
+		}
+		__sync_synchronize();
+
+		value = c->data;
+		__sync_synchronize();
+		c->sequence = dequeue_pos + N;
+		++dequeue_pos;
+
+		return true;
+	}
+};
+
+} // namespace lib
+} // namespace mrrocpp
+
+#endif /* PACKAGE_QUEUE_H_ */
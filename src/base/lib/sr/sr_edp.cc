@@ -18,7 +18,7 @@ namespace mrrocpp {
 namespace lib {
 
 sr_edp::sr_edp(process_type_t process_type, const std::string & process_name, const std::string & sr_name) :
-	sr(process_type, process_name, sr_name)
+	sr(process_type, process_name, sr_name, &sr_edp::interpret)
 {
 }
 
@@ -20,7 +20,7 @@ class sr_edp : public sr
 {
 protected:
 	//! Interpret the status code into a text message.
-	virtual void interpret(char * description, error_class_t message_type, uint64_t error_code0, uint64_t error_code1);
+	static void interpret(char * description, error_class_t message_type, uint64_t error_code0, uint64_t error_code1);
 
 public:
 	/**
@@ -28,7 +28,6 @@ public:
 	 * @param process_type reporting process type
 	 * @param process_name reporting process name
 	 * @param sr_channel_name name of the SR communication channel
-	 * @param _multi_thread flag for selecting multi-threaded variant
 	 */
 	sr_edp(process_type_t process_type, const std::string & process_name, const std::string & sr_channel_name);
 
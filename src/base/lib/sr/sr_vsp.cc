@@ -14,7 +14,7 @@ namespace mrrocpp {
 namespace lib {
 
 sr_vsp::sr_vsp(process_type_t process_type, const std::string & process_name, const std::string & sr_name) :
-	sr(process_type, process_name, sr_name)
+	sr(process_type, process_name, sr_name, &sr_vsp::interpret)
 {
 }
 
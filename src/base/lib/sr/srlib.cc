@@ -7,12 +7,8 @@
  * @ingroup LIB
  */
 
-#include <cstdio>
 #include <cstring>
-#include <cstdio>
-#include <unistd.h>
 #include <stdint.h>
-#include <sys/time.h>
 
 #include "base/lib/typedefs.h"
 #include "base/lib/impconst.h"
@@ -24,30 +20,28 @@
 namespace mrrocpp {
 namespace lib {
 
-sr::sr(process_type_t _process_type, const std::string & _process_name, const std::string & sr_name)
-	: sender(sr_name), process_type(_process_type), process_name(_process_name)
+sr::sr(process_type_t _process_type, const std::string & _process_name, const std::string & sr_name, sr_interpret_t interpret)
+	: sender(sr_name, _process_type, _process_name, interpret)
 {
-	if(gethostname(hostname, sizeof(hostname)) == -1) {
-		perror("gethostname()");
-		hostname[0] = '\0';
-	}
 }
 
-void sr::send_package(sr_package_t & sr_message)
+void sr::send_report(error_class_t message_type, bool coded, uint64_t error_code0, uint64_t error_code1, const char * text, std::size_t length)
 {
-	sr_message.process_type = process_type;
-	strncpy(sr_message.process_name, process_name.c_str(), sizeof(sr_message.process_name));
-	strncpy(sr_message.host_name, hostname, sizeof(sr_message.host_name));
+	// the package is built by the sending thread, here only the arguments are copied
+	sr_report_t report;
 
-	struct timeval tv;
-	if(gettimeofday(&tv, NULL) == -1) {
-		perror("gettimeofday()");
-	}
+	report.message_type = message_type;
+	report.coded = coded;
+	report.error_code0 = error_code0;
+	report.error_code1 = error_code1;
 
-	sr_message.tv.tv_sec = tv.tv_sec;
-	sr_message.tv.tv_usec = tv.tv_usec;
+	if (length > TEXT_LENGTH - 1) {
+		length = TEXT_LENGTH - 1;
+	}
+	memcpy(report.text, text, length);
+	report.text[length] = '\0';
 
-	sender.send_package(sr_message);
+	sender.send_report(report);
 }
 
 sr::~sr()
@@ -66,45 +60,18 @@ void sr::message(error_class_t message_type, uint64_t error_code)
 
 void sr::message(error_class_t message_type, const std::string & text)
 {
-	sr_package sr_message;
-
-	sr_message.message_type = message_type;
-
-	if (text.length()) {
-		strncpy(sr_message.description, text.c_str(), TEXT_LENGTH);
-		sr_message.description[TEXT_LENGTH - 1] = '\0';
-	} else {
-		sr_message.description[0] = '\0';
-	}
-
-	return send_package(sr_message);
+	send_report(message_type, false, 0, 0, text.data(), text.length());
 }
 
 void sr::message(error_class_t message_type, uint64_t error_code, const std::string & text)
 {
-	sr_package sr_message;
-
-	sr_message.message_type = message_type;
-
-	interpret(sr_message.description, message_type, error_code);
-
-	strcat(sr_message.description, text.c_str());
-
-	return send_package(sr_message);
+	send_report(message_type, true, error_code, 0, text.data(), text.length());
 }
 
 void sr::message(error_class_t message_type, uint64_t error_code0, uint64_t error_code1)
 {
-	sr_package sr_message;
-
-	sr_message.message_type = message_type;
-
-	interpret(sr_message.description, message_type, error_code0, error_code1);
-
-	send_package(sr_message);
+	send_report(message_type, true, error_code0, error_code1, "", 0);
 }
 
-
-
 } // namespace lib
 } // namespace mrrocpp
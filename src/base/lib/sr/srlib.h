@@ -11,6 +11,7 @@
 #define __SRLIB_H
 
 #include <ctime>
+#include <cstring>
 #include <string>
 #include <stdint.h>
 
@@ -62,6 +63,9 @@ typedef struct sr_package
 
 	//! Text message
 	char description[TEXT_LENGTH];
+
+	//! Number of identical consecutive messages collapsed into this package
+	uint32_t repeated;
 } sr_package_t;
 
 template <class Archive>
@@ -74,40 +78,73 @@ void serialize(Archive & ar, sr_package_t & p, const unsigned int version)
 	ar & p.process_name;
 	ar & p.host_name;
 	ar & p.description;
+	ar & p.repeated;
+}
+
+/*!
+ * Arguments of a report, built into the package by the sending thread.
+ */
+typedef struct sr_report
+{
+	//! Message type
+	error_class_t message_type;
+
+	//! Status codes are interpreted in front of the text
+	bool coded;
+
+	//! Status codes
+	uint64_t error_code0, error_code1;
+
+	//! Text message
+	char text[TEXT_LENGTH];
+} sr_report_t;
+
+//! Maximal number of packages sent to SR in a single message
+static const unsigned int SR_BATCH_LENGTH = 8;
+
+/*!
+ * Batch of packages sent to SR in a single message.
+ */
+typedef struct sr_batch
+{
+	//! Number of valid packages
+	uint32_t count;
+
+	//! Packages, in the order of reporting
+	sr_package_t packages[SR_BATCH_LENGTH];
+} sr_batch_t;
+
+template <class Archive>
+void serialize(Archive & ar, sr_batch_t & b, const unsigned int version)
+{
+	ar & b.count;
+	if (b.count > SR_BATCH_LENGTH) {
+		b.count = SR_BATCH_LENGTH;
+	}
+	for (uint32_t i = 0; i < b.count; ++i) {
+		ar & b.packages[i];
+	}
 }
 
 //! System reporting (SR)
 class sr : public boost::noncopyable
 {
 private:
-	//! Send default message package to the SR
-	void send_package(sr_package_t & sr_message);
+	//! Queue the report arguments for the sending thread
+	void send_report(error_class_t message_type, bool coded, uint64_t error_code0, uint64_t error_code1, const char * text, std::size_t length);
 
 	//! Sender class
 	Sender sender;
 
-	//! Process type
-	const process_type_t process_type;
-
-	//! Process name
-	const std::string process_name;
-
-	//! Cached hostname
-	char hostname[128];
-
-protected:
-	//! Interpret the status code into a text message
-	virtual void interpret(char * description, error_class_t message_type, uint64_t error_code0, uint64_t error_code1 = 0) = 0;
-
 public:
 	/**
 	 * Constructor
 	 * @param process_type reporting process type
 	 * @param process_name reporting process name
 	 * @param sr_channel_name name of the SR communication channel
-	 * @param _multi_thread flag for selecting multi-threaded variant
+	 * @param interpret interpretation of the status codes, called by the sending thread
 	 */
-	sr(process_type_t _process_type, const std::string & _process_name, const std::string & sr_channel_name);
+	sr(process_type_t _process_type, const std::string & _process_name, const std::string & sr_channel_name, sr_interpret_t interpret);
 
 	/**
 	 * Destructor
@@ -142,20 +179,11 @@ public:
 	template <error_class_t ercl>
 	void message(const mrrocpp::lib::exception::error <ercl> & e_)
 	{
-		// A message that will be sent to SR.
-		sr_package sr_message;
-
-		// Set error type.
-		sr_message.message_type = e_.error_class;
-
 		// Copy error description and diagnostics to message description.
 		// Retrieve default description.
 		const char* const * pdescription = boost::get_error_info <mrrocpp::lib::exception::error_description>(e_);
 		// Check whether description is present.
-		if (pdescription != 0)
-			strcpy(sr_message.description, (*pdescription));
-		else
-			strcpy(sr_message.description, "Unidentified error");
+		const char * description = (pdescription != 0) ? (*pdescription) : "Unidentified error";
 
 		// Add diagnostic information.
 		//strcat(sr_message.description, "\n");
@@ -163,7 +191,7 @@ public:
 		// TODO: Uncomment lines when UI won't crash anymore;)
 
 		// Send message.
-		send_package(sr_message);
+		send_report(e_.error_class, false, 0, 0, description, strlen(description));
 	}
 };
 
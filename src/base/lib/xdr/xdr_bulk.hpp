@@ -0,0 +1,142 @@
+/**
+ * \file xdr_bulk.hpp
+ *
+ * \brief Bulk XDR conversion of C-style arrays of primitive types
+ *
+ * Arrays of doubles, floats and 32-bit integers are encoded in a single
+ * pass directly in the XDR memory buffer, instead of calling the libc
+ * xdr_* routine for every element. The resulting byte stream is the same
+ * as produced by xdr_double(), xdr_float(), xdr_int() and xdr_u_int().
+ * The byte swapping loops are simple enough to be vectorized by the compiler.
+ */
+
+#ifndef XDR_BULK_HPP
+#define XDR_BULK_HPP
+
+#include <cstring>
+#include <stdint.h>
+
+#include <boost/mpl/bool.hpp>
+
+#if defined(__linux__)
+#include <endian.h>
+#define XDR_BULK_ENABLED 1
+#else
+#define XDR_BULK_ENABLED 0
+#endif
+
+namespace xdr_bulk {
+
+/**
+ * Trait with the XDR representation of a type;
+ * types without specialization are converted element by element.
+ */
+template <class T>
+struct traits
+{
+    typedef boost::mpl::false_ enabled;
+};
+
+#if XDR_BULK_ENABLED
+
+template <>
+struct traits <double>
+{
+    typedef boost::mpl::true_ enabled;
+    static const std::size_t wire_size = 8;
+};
+
+template <>
+struct traits <float>
+{
+    typedef boost::mpl::true_ enabled;
+    static const std::size_t wire_size = 4;
+};
+
+template <>
+struct traits <int>
+{
+    typedef boost::mpl::true_ enabled;
+    static const std::size_t wire_size = 4;
+};
+
+template <>
+struct traits <unsigned int>
+{
+    typedef boost::mpl::true_ enabled;
+    static const std::size_t wire_size = 4;
+};
+
+//! store 8-byte elements in the big-endian (network) order
+inline void encode_64(char * dst, const void * src, std::size_t n)
+{
+    const char * s = (const char *) src;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64_t v;
+        std::memcpy(&v, s + 8 * i, 8);
+        v = htobe64(v);
+        std::memcpy(dst + 8 * i, &v, 8);
+    }
+}
+
+//! store 4-byte elements in the big-endian (network) order
+inline void encode_32(char * dst, const void * src, std::size_t n)
+{
+    const char * s = (const char *) src;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint32_t v;
+        std::memcpy(&v, s + 4 * i, 4);
+        v = htobe32(v);
+        std::memcpy(dst + 4 * i, &v, 4);
+    }
+}
+
+//! load 8-byte elements from the big-endian (network) order
+inline void decode_64(void * dst, const char * src, std::size_t n)
+{
+    char * d = (char *) dst;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64_t v;
+        std::memcpy(&v, src + 8 * i, 8);
+        v = be64toh(v);
+        std::memcpy(d + 8 * i, &v, 8);
+    }
+}
+
+//! load 4-byte elements from the big-endian (network) order
+inline void decode_32(void * dst, const char * src, std::size_t n)
+{
+    char * d = (char *) dst;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint32_t v;
+        std::memcpy(&v, src + 4 * i, 4);
+        v = be32toh(v);
+        std::memcpy(d + 4 * i, &v, 4);
+    }
+}
+
+template <class T>
+inline void encode(char * dst, const T * src, std::size_t n)
+{
+    if (traits <T>::wire_size == 8) {
+        encode_64(dst, src, n);
+    } else {
+        encode_32(dst, src, n);
+    }
+}
+
+template <class T>
+inline void decode(T * dst, const char * src, std::size_t n)
+{
+    if (traits <T>::wire_size == 8) {
+        decode_64(dst, src, n);
+    } else {
+        decode_32(dst, src, n);
+    }
+}
+
+#endif /* XDR_BULK_ENABLED */
+
+} // namespace xdr_bulk
+
+#endif // XDR_BULK_HPP
@@ -28,6 +28,8 @@
 #include <rpc/xdr.h>
 #include <stdint.h>
 
+#include "base/lib/xdr/xdr_bulk.hpp"
+
 #if BOOST_VERSION >104200
 #define BOOST_IARCHIVE_EXCEPTION input_stream_error
 #else
@@ -94,10 +96,12 @@ public:
 
     //! conversion for std::string
     xdr_iarchive &load_a_type(std::string & t,boost::mpl::true_) {
-        char b[size];
-        char * p = b;
-        if(!xdr_wrapstring(&xdrs, &p)) THROW_LOAD_EXCEPTION;
-        t = p;
+        u_int len;
+        if(!xdr_u_int(&xdrs, &len)) THROW_LOAD_EXCEPTION;
+        // characters are padded to the multiple of 4 bytes
+        const char * p = (const char *) xdr_inline(&xdrs, (len + 3) & ~3u);
+        if(!p) THROW_LOAD_EXCEPTION;
+        t.assign(p, len);
         return *this;
     }
 
@@ -256,12 +260,41 @@ public:
     template<class T, int N>
     xdr_iarchive &load_a_type(T (&t)[N],boost::mpl::false_)
     {
-        for (int i = 0; i < N; ++i) {
+        return load_array(t, N, typename xdr_bulk::traits<T>::enabled());
+    }
+
+    /**
+     * Array of elements converted one by one.
+     * @param t pointer to the first element
+     * @param n number of elements
+     * @return *this
+     */
+    template<class T>
+    xdr_iarchive &load_array(T * t, std::size_t n, boost::mpl::false_)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
             *this >> t[i];
         }
         return *this;
     }
 
+    /**
+     * Array of primitive elements decoded in bulk directly from the XDR buffer.
+     * @param t pointer to the first element
+     * @param n number of elements
+     * @return *this
+     */
+    template<class T>
+    xdr_iarchive &load_array(T * t, std::size_t n, boost::mpl::true_)
+    {
+        const char * p = (const char *) xdr_inline(&xdrs, n * xdr_bulk::traits<T>::wire_size);
+        if (p) {
+            xdr_bulk::decode(t, p, n);
+            return *this;
+        }
+        return load_array(t, n, boost::mpl::false_());
+    }
+
     /**
      * These load_override functions are required to handle the nvt<T> cases in the
      * serialization code. GCC won't compile that code without these overloads.
@@ -323,6 +356,27 @@ public:
         return buffer;
     }
 
+    /**
+     * Capacity of the buffer, which can be filled directly with get_buffer()
+     * followed by clear_buffer() instead of copying with set_buffer()
+     * @return size of the buffer
+     */
+    std::size_t get_buffer_size() const {
+        return size;
+    }
+
+    /**
+     * Limit decoding to the data placed directly with get_buffer(),
+     * so a short message throws instead of decoding stale bytes
+     * @param data_size number of valid bytes at the beginning of the buffer
+     */
+    void set_data_size(std::size_t data_size)
+    {
+        assert(data_size <= size);
+        xdr_destroy(&xdrs);
+        xdrmem_create(&xdrs, buffer, data_size, XDR_DECODE);
+    }
+
     void clear_buffer()
     {
         if( !xdr_setpos(&xdrs, 0) ){
@@ -28,6 +28,8 @@
 #include <rpc/xdr.h>
 #include <stdint.h>
 
+#include "base/lib/xdr/xdr_bulk.hpp"
+
 #if BOOST_VERSION >104200
 #define BOOST_OARCHIVE_EXCEPTION output_stream_error
 #else
@@ -256,12 +258,41 @@ public:
     template <class T, int N>
     xdr_oarchive &save_a_type(T const(&t)[N], boost::mpl::false_)
     {
-        for (int i = 0; i < N; ++i) {
+        return save_array(t, N, typename xdr_bulk::traits <T>::enabled());
+    }
+
+    /**
+     * Array of elements converted one by one.
+     * @param t pointer to the first element
+     * @param n number of elements
+     * @return *this
+     */
+    template <class T>
+    xdr_oarchive &save_array(const T * t, std::size_t n, boost::mpl::false_)
+    {
+        for (std::size_t i = 0; i < n; ++i) {
             *this << t[i];
         }
         return *this;
     }
 
+    /**
+     * Array of primitive elements encoded in bulk directly in the XDR buffer.
+     * @param t pointer to the first element
+     * @param n number of elements
+     * @return *this
+     */
+    template <class T>
+    xdr_oarchive &save_array(const T * t, std::size_t n, boost::mpl::true_)
+    {
+        char * p = (char *) xdr_inline(&xdrs, n * xdr_bulk::traits <T>::wire_size);
+        if (p) {
+            xdr_bulk::encode(p, t, n);
+            return *this;
+        }
+        return save_array(t, n, boost::mpl::false_());
+    }
+
     /**
      * Get the size of XDR representation
      * @return size of XDR representation
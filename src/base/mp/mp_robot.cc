@@ -31,19 +31,23 @@ namespace robot {
 robot::robot(const lib::robot_name_t & l_robot_name, task::task &mp_object_l, int _number_of_servos) :
 		ecp_mp::robot(l_robot_name),
 		number_of_servos(_number_of_servos),
+		mp_object(mp_object_l),
 		ECP_pid(mp_object_l.config, mp_object_l.config.get_ecp_section(robot_name)),
-		ecp(mp_object_l.config.get_ecp_section(robot_name)),
+		ecp(mp_object_l.config.get_ecp_section(robot_name), true),
 		command(ecp, "MP_COMMAND"),
 		sr_ecp_msg(*(mp_object_l.sr_ecp_msg)),
 		reply(mp_object_l, mp_object_l.config.get_ecp_section(robot_name)),
 		ecp_reply_package(reply.access),
 		communicate_with_ecp(true)
 {
+	mp_object_l.reply_owners[&reply] = this;
 }
 
 robot::~robot()
 {
 	fprintf(stderr, "robot::~robot()\n");
+
+	mp_object.reply_owners.erase(&reply);
 }
 
 void robot::send_command(lib::MP_COMMAND value)
@@ -47,6 +47,11 @@ private:
 	 */
 	const int number_of_servos;
 
+	/**
+	 * @brief task which registered the reply buffer of the robot
+	 */
+	task::task & mp_object;
+
 	/**
 	 * @brief pid of spawned ECP process
 	 */
@@ -54,6 +59,7 @@ private:
 
 public:
 	//! Remote agent proxy
+	//! @note connected on the first command, so the ECPs of all the robots of the task start concurrently
 	lib::agent::RemoteAgent ecp;
 
 private:
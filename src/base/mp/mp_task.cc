@@ -62,6 +62,8 @@ task::task(lib::configurator &_config) :
 
 task::~task()
 {
+	reply_owners.clear();
+
 	// Remove (kill) all ECP from the container
 	BOOST_FOREACH(const common::robot_pair_t & robot_node, robot_m)
 			{
@@ -149,6 +151,13 @@ void task::send_end_motion_to_ecps(int number_of_robots, lib::robot_name_t *prop
 	mp_semte_gen.Move();
 }
 
+robot::robot * task::reply_owner(const lib::agent::InputBufferBase * buffer) const
+{
+	reply_owners_t::const_iterator owner = reply_owners.find(buffer);
+
+	return (owner != reply_owners.end()) ? owner->second : NULL;
+}
+
 //
 // funkcja odbierajaca pulsy z UI lub ECP wykorzystywana w MOVE
 //
@@ -158,6 +167,9 @@ void task::send_end_motion_to_ecps(int number_of_robots, lib::robot_name_t *prop
 //     1) block for ECP message and react to UI pulses
 // otherwise
 //     2) peak for UI pulse and eventually react for in in pause/resume/stop/trigger cycle
+//
+// all the pending messages are received in a single batch; the UI pulse is handled
+// before the ECP replies, which are found in the list of ready buffers
 void task::receive_ui_or_ecp_message(generator::generator & the_generator)
 {
 	// najpierw kasujemy znacznik swiezosci buforow
@@ -170,6 +182,9 @@ void task::receive_ui_or_ecp_message(generator::generator & the_generator)
 				}
 			}
 
+	// odpowiedzi odebrane wczesniej zostaly wlasnie skasowane
+	takeReadyBuffers(ready);
+
 	enum MP_STATE_ENUM
 	{
 		MP_RUNNING, MP_PAUSED
@@ -194,7 +209,7 @@ void task::receive_ui_or_ecp_message(generator::generator & the_generator)
 			block = true;
 		}
 
-		if (ReceiveSingleMessage(block)) {
+		if (ReceivePendingMessages(block)) {
 			// UI Pulse arrived
 			if (ui_pulse.isFresh()) {
 				//	sr_ecp_msg->message(lib::NON_FATAL_ERROR, "receive_ui_or_ecp_message pulse ui_pulse.isFresh()");
@@ -231,24 +246,29 @@ void task::receive_ui_or_ecp_message(generator::generator & the_generator)
 						ecp_exit_from_while = true;
 					}
 				}
-				continue;
 			} else {
 				if (mp_state == MP_RUNNING) {
 					ui_exit_from_while = true;
 				}
 			}
 
+			// w czasie pauzy odpowiedzi ECP czekaja na liscie gotowych buforow
+			if (mp_state == MP_PAUSED || ecp_exit_from_while) {
+				continue;
+			}
+
 			if (the_generator.wait_for_ECP_message) {
 				//	sr_ecp_msg->message(lib::NON_FATAL_ERROR, "receive_ui_or_ecp_message pulse the_generator.wait_for_ECP_message");
-				BOOST_FOREACH(const common::robot_pair_t & robot_node, robot_m)
+				takeReadyBuffers(ready);
+				BOOST_FOREACH(const lib::agent::InputBufferBase * buffer, ready)
 						{
-							if (robot_node.second->reply.isFresh()) {
+							robot::robot * replied = reply_owner(buffer);
+							if (replied && replied->reply.isFresh()) {
 								//					sr_ecp_msg->message(lib::NON_FATAL_ERROR, "receive_ui_or_ecp_message pulse received");
 
-								//	 if (debug_tmp)	printf("wait_for_ECP_message r: %d, pc: %d\n", robot_node.first, robot_node.second->ui_pulse_code);
 								ecp_exit_from_while = true;
 
-								robot_node.second->ecp_errors_handler();
+								replied->ecp_errors_handler();
 
 							}
 						}
@@ -323,15 +343,18 @@ void task::wait_for_all_robots_acknowledge()
 	// Wait for ACK from all the robots
 	while (!not_confirmed.empty()) {
 		//	sr_ecp_msg->message(lib::NON_FATAL_ERROR, "wait_for_all_robots_acknowledge przed receive");
-		ReceiveSingleMessage(true);
+		ReceivePendingMessages(true);
 		//		sr_ecp_msg->message(lib::NON_FATAL_ERROR, "wait_for_all_robots_acknowledge za receive");
-		BOOST_FOREACH(const common::robot_pair_t & robot_node, not_confirmed)
-				{
-					if (robot_node.second->reply.isFresh()
-							&& robot_node.second->reply.Get().reply == lib::ECP_ACKNOWLEDGE) {
-						robot_node.second->reply.markAsUsed();
-						not_confirmed.erase(robot_node.first);
 
+		// sprawdzane sa tylko roboty, ktore odpowiedzialy
+		takeReadyBuffers(ready);
+		BOOST_FOREACH(const lib::agent::InputBufferBase * buffer, ready)
+				{
+					robot::robot * replied = reply_owner(buffer);
+					if (replied && not_confirmed.count(replied->robot_name) && replied->reply.isFresh()
+							&& replied->reply.Get().reply == lib::ECP_ACKNOWLEDGE) {
+						replied->reply.markAsUsed();
+						not_confirmed.erase(replied->robot_name);
 					}
 				}
 	}
@@ -11,6 +11,8 @@
 
 #include <ostream>
 
+#include <boost/unordered_map.hpp>
+
 #include "base/mp/mp_typedefs.h"
 #include "base/ecp_mp/ecp_mp_task.h"
 
@@ -125,6 +127,30 @@ private:
 	 */
 	void initialize_communication(void);
 
+	//! Robots register their reply buffers
+	friend class robot::robot;
+
+	//! Datatype of the map from the reply buffer to its robot
+	typedef boost::unordered_map <const lib::agent::InputBufferBase *, robot::robot *> reply_owners_t;
+
+	/**
+	 * @brief robots owning the reply buffers
+	 * used to find robots which replied without scanning robot_m
+	 */
+	reply_owners_t reply_owners;
+
+	/**
+	 * @brief buffers which received data in the last batch of messages
+	 */
+	ready_buffers_t ready;
+
+	/**
+	 * @brief robot owning the reply buffer
+	 * @param buffer buffer taken from the ready list
+	 * @return robot or NULL for other buffers
+	 */
+	robot::robot * reply_owner(const lib::agent::InputBufferBase * buffer) const;
+
 public:
 	/**
 	 * @brief communication channels descriptors
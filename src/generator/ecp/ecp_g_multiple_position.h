@@ -48,33 +48,21 @@ protected:
 	 */
 	typename std::vector <Pos>::iterator pose_vector_iterator;
 	/**
-	 * Vector of coordinates.
+	 * Interpolated coordinates (nodes x axes), the memory is reused by the consecutive trajectories.
 	 */
-	std::vector <std::vector <double> > coordinate_vector;
+	trajectory_interpolator::coordinate_buffer coordinate_vector;
 	/**
-	 * Coordinate vector iterator.
+	 * Number of the next node of coordinates to be sent.
 	 */
-	std::vector <std::vector <double> >::iterator coordinate_vector_iterator;
-	/**
-	 * Temporary iterator used mainly to iterate through a single position which is always of type vector<double>.
-	 */
-	std::vector <double>::iterator tempIter;
-        /**
-         * Vector of read currents. (used in optimization)
-         */
-        std::vector <std::vector<double> > current_vector;
-        /**
-         * Current vector iterator.
-         */
-        std::vector <std::vector <double> >::iterator current_vector_iterator;
+	std::size_t coordinate_index;
         /**
-         * Vector of read energy. (used in optimization)
+         * Read currents, one node per macrostep. (used in optimization)
          */
-        std::vector <std::vector<double> > energy_vector;
+        trajectory_interpolator::coordinate_buffer current_vector;
         /**
-         * Energy vector iterator.
+         * Read energy, one node per macrostep. (used in optimization)
          */
-        std::vector <std::vector <double> >::iterator energy_vector_iterator;
+        trajectory_interpolator::coordinate_buffer energy_vector;
 	/**
 	 * Type of the commanded motion (absolute or relative)
 	 */
@@ -247,8 +235,8 @@ protected:
 			return false;
 		}
 
-		coordinate_vector.clear();
-		coordinate_vector_iterator = coordinate_vector.begin();
+		coordinate_vector.reset(axes_num);
+		coordinate_index = 0;
 		pose_vector_iterator = pose_vector.begin();
 
 		std::size_t i; //loop counter
@@ -302,16 +290,13 @@ protected:
 	 */
 	virtual void print_coordinate_vector()
 	{
-		coordinate_vector_iterator = coordinate_vector.begin();
 		printf("coordinate_vector_size: %zd\n", coordinate_vector.size());
 		for (std::size_t i = 0; i < coordinate_vector.size(); i++) {
-			tempIter = (*coordinate_vector_iterator).begin();
+			const double * node = coordinate_vector[i];
 			printf("%zd:\t", (i + 1));
-			for (tempIter = (*coordinate_vector_iterator).begin(); tempIter != (*coordinate_vector_iterator).end();
-					tempIter++) {
-				printf(" %f\t", *tempIter);
+			for (std::size_t j = 0; j < coordinate_vector.axes_num(); j++) {
+				printf(" %f\t", node[j]);
 			}
-			coordinate_vector_iterator++;
 			printf("\n");
 		}
 		flushall();
@@ -344,6 +329,7 @@ public:
 	{
 		debug = false;
                 optimization = false;
+		coordinate_index = 0;
 		angle_axis_absolute_transformed_into_relative = false;
 		motion_type = lib::ABSOLUTE;
 		nmc = 10;
@@ -481,9 +467,15 @@ public:
 				BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(INVALID_POSE_SPECIFICATION));
 		}
 
-                current_vector.clear();
-                energy_vector.clear();
-		coordinate_vector_iterator = coordinate_vector.begin();
+                current_vector.reset(axes_num);
+                energy_vector.reset(axes_num);
+                if (optimization)
+                {
+                    // one node per macrostep - no allocation in next_step()
+                    current_vector.reserve(coordinate_vector.size());
+                    energy_vector.reserve(coordinate_vector.size());
+                }
+		coordinate_index = 0;
 		sr_ecp_msg.message("Moving...");
 		return true;
 	}
@@ -498,7 +490,7 @@ public:
 			flushall();
 		}
 
-		if (coordinate_vector_iterator == coordinate_vector.end()) {
+		if (coordinate_index == coordinate_vector.size()) {
 			sr_ecp_msg.message("Motion finished");
                         reset(); //reset the generator, set generated and calculated flags to false, flush coordinate and pose lists
                         return false;
@@ -516,45 +508,31 @@ public:
 		the_robot->communicate_with_edp = true; //turn on the communication with EDP
 		the_robot->ecp_command.instruction_type = lib::SET;
 
-		double coordinates[axes_num];
-                //std::vector<double> currents;
-                std::vector<double> currents;
-                std::vector<double> energy;
-                if (optimization)
-                {
-                    currents = std::vector<double>(axes_num);
-                    energy = std::vector<double>(axes_num);
-                }
+		const double * coordinates = coordinate_vector[coordinate_index];
 
 		switch (pose_spec)
 		{
 
 			case lib::ECP_JOINT:
 
-				tempIter = (*coordinate_vector_iterator).begin();
-				for (i = 0; i < axes_num; i++) {
-					the_robot->ecp_command.arm.pf_def.arm_coordinates[i] = *tempIter;
+				if (optimization)
+				{
+					double * currents = current_vector.append();
+					double * energy = energy_vector.append();
+					for (i = 0; i < axes_num; i++) {
+						currents[i] = sqrt(the_robot->reply_package.arm.measured_current.average_square[i]);
+						energy[i] = the_robot->reply_package.arm.measured_current.energy[i];
+					}
+				}
 
-                                        if (optimization)
-                                        {
-                                            currents[i] = sqrt(the_robot->reply_package.arm.measured_current.average_square[i]);
-                                            energy[i] = the_robot->reply_package.arm.measured_current.energy[i];
-                                        }
+				for (i = 0; i < axes_num; i++) {
+					the_robot->ecp_command.arm.pf_def.arm_coordinates[i] = coordinates[i];
 
 					if (debug) {
-                                                printf("%f\t", *tempIter);
-                                                //printf("%f\t", currents[i]);
+                                                printf("%f\t", coordinates[i]);
 					}
-					tempIter++;
-
 				}
 
-                                if (optimization)
-                                {
-                                    current_vector.push_back(currents);
-                                    energy_vector.push_back(energy);
-                                }
-
 				if (debug) {
                                         printf("\n");
 					flushall();
@@ -563,14 +541,11 @@ public:
 
 			case lib::ECP_MOTOR:
 
-				tempIter = (*coordinate_vector_iterator).begin();
 				for (i = 0; i < axes_num; i++) {
-					the_robot->ecp_command.arm.pf_def.arm_coordinates[i] = *tempIter;
+					the_robot->ecp_command.arm.pf_def.arm_coordinates[i] = coordinates[i];
 					if (debug) {
-						printf("%f\t", *tempIter);
+						printf("%f\t", coordinates[i]);
 					}
-					tempIter++;
-
 				}
 				if (debug) {
 					printf("\n");
@@ -580,18 +555,10 @@ public:
 
 			case lib::ECP_XYZ_EULER_ZYZ:
 
-				i = 0;
-
-				for (tempIter = (*coordinate_vector_iterator).begin(); tempIter != (*coordinate_vector_iterator).end();
-						tempIter++) {
-					coordinates[i] = *tempIter;
-					if (debug) {
-						printf("%f\t", *tempIter);
-					}
-					i++;
-				}
-
 				if (debug) {
+					for (i = 0; i < axes_num; i++) {
+						printf("%f\t", coordinates[i]);
+					}
 					printf("\n");
 					flushall();
 				}
@@ -602,18 +569,10 @@ public:
 
 			case lib::ECP_XYZ_ANGLE_AXIS:
 
-				i = 0;
-
-				for (tempIter = (*coordinate_vector_iterator).begin(); tempIter != (*coordinate_vector_iterator).end();
-						tempIter++) {
-					coordinates[i] = *tempIter;
-					if (debug) {
-						printf("%f\t", *tempIter);
-					}
-					i++;
-				}
-
 				if (debug) {
+					for (i = 0; i < axes_num; i++) {
+						printf("%f\t", coordinates[i]);
+					}
 					printf("\n");
 					flushall();
 				}
@@ -627,7 +586,7 @@ public:
 				BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(INVALID_POSE_SPECIFICATION));
 		} // end:switch
 
-		coordinate_vector_iterator++;
+		coordinate_index++;
 
 		return true;
 	}
@@ -724,10 +683,8 @@ public:
 			return -1;
 		}
 		if (!coordinate_vector.empty()) {
-			coordinate_vector_iterator = coordinate_vector.begin();
-
-			std::vector <double> temp1 = pose_vector.begin()->start_position;
-			std::vector <double> temp2 = (*coordinate_vector_iterator);
+			const double * temp1 = &pose_vector.begin()->start_position[0];
+			const double * temp2 = coordinate_vector[0];
 
 			std::size_t i, j; //loop counters
 
@@ -759,29 +716,27 @@ public:
 				}
 			}
 
-			coordinate_vector_iterator++;
-
 			for (i = 1; i < coordinate_vector.size(); i++) {
 
-				j = 0;
-				for (tempIter = (*coordinate_vector_iterator).begin(); tempIter != (*coordinate_vector_iterator).end();
-						tempIter++) {
+				const double * node = coordinate_vector[i];
+
+				for (j = 0; j < coordinate_vector.axes_num(); j++) {
 					if (motion_type == lib::ABSOLUTE) {
-						if (fabs((fabs(temp1[j] - temp2[j]) / mc) - (fabs(temp2[j] - *tempIter) / mc)) / mc > max_acc) {
+						if (fabs((fabs(temp1[j] - temp2[j]) / mc) - (fabs(temp2[j] - node[j]) / mc)) / mc > max_acc) {
 							sr_ecp_msg.message("Possible jerk detected!");
 							if (debug) {
 								printf("Jerk detected in coordinates: %zd\t axis: %zd\n", i + 1, j);
-								//printf("acc: %f\n", (fabs((fabs(temp1[j] - temp2[j])/mc) - (fabs(temp2[j] - *tempIter)/mc)) / mc));
+								//printf("acc: %f\n", (fabs((fabs(temp1[j] - temp2[j])/mc) - (fabs(temp2[j] - node[j])/mc)) / mc));
 								flushall();
 							}
 							return i + 1;
 						}
 					} else if (motion_type == lib::RELATIVE) {
-						if (fabs((fabs(temp2[j]) / mc) - (fabs(*tempIter) / mc)) / mc > max_acc) {
+						if (fabs((fabs(temp2[j]) / mc) - (fabs(node[j]) / mc)) / mc > max_acc) {
 							sr_ecp_msg.message("Possible jerk detected!");
 							if (debug) {
 								printf("Jerk detected in coordinates: %zd\t axis: %zd\n", i + 1, j);
-								//printf("acc: %f\n", (fabs((fabs(temp2[j])/mc) - (fabs(*tempIter)/mc)) / mc));
+								//printf("acc: %f\n", (fabs((fabs(temp2[j])/mc) - (fabs(node[j])/mc)) / mc));
 								flushall();
 							}
 							return i + 1;
@@ -791,14 +746,10 @@ public:
 						BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(ECP_ERRORS));
 						//TODO change the second argument
 					}
-
-					j++;
 				}
 
 				temp1 = temp2;
-				temp2 = *coordinate_vector_iterator;
-
-				coordinate_vector_iterator++;
+				temp2 = node;
 			}
 
 			flushall();
@@ -893,6 +844,10 @@ public:
             this->set_axes_num(6);
             from_file.seekg(pos);
 
+            if (coordinate_vector.axes_num() != (std::size_t) axes_num) {
+                    coordinate_vector.reset(axes_num);
+            }
+
             //std::vector <double> v(axes_num); //vector of read velocities
             //std::vector <double> a(axes_num); //vector of read accelerations
             std::vector <double> coordinates(axes_num); //vector of read coordinates
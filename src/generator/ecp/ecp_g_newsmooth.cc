@@ -9,6 +9,7 @@
 
 #include "base/ecp/ecp_exceptions.h"
 #include "generator/ecp/ecp_g_newsmooth.h"
+#include "generator/ecp/trajectory_file.h"
 
 namespace mrrocpp {
 namespace ecp {
@@ -469,109 +470,22 @@ bool newsmooth::load_trajectory_from_file(const char* file_name)
 
 	sr_ecp_msg.message(file_name);
 
-	char coordinate_type_desc[80]; //description of pose specification read from the file
-	char motion_type_desc[80]; //description of motion type read from the file
-	lib::ECP_POSE_SPECIFICATION ps; //pose specification read from the file
-	lib::MOTION_TYPE mt; //type of the commanded motion (relative or absolute)
-	int number_of_poses = 0; //number of poses to be read
-	int i, j; //loop counters
-
-	std::ifstream from_file(file_name); // open the file
-	if (!from_file.good()) {
-		//perror(file_name);
-		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_EXISTENT_FILE));
-		return false;
-	}
+	trajectory_file trajectory; //text or binary trajectory, throws nfe_g on error
+	trajectory.load(file_name);
 
-	if (!(from_file >> coordinate_type_desc)) {
-		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
-		return false;
-	}
-
-	//removing spaces and tabs
-	i = 0;
-	j = 0;
-	while (coordinate_type_desc[i] == ' ' || coordinate_type_desc[i] == '\t')
-		i++;
-	while (coordinate_type_desc[i] != ' ' && coordinate_type_desc[i] != '\t' && coordinate_type_desc[i] != '\n'
-			&& coordinate_type_desc[i] != '\r' && coordinate_type_desc[j] != '\0') {
-		coordinate_type_desc[j] = toupper(coordinate_type_desc[i]);
-		i++;
-		j++;
-	}
-	coordinate_type_desc[j] = '\0';
-
-	if (!strcmp(coordinate_type_desc, "MOTOR")) {
-		ps = lib::ECP_MOTOR;
-	} else if (!strcmp(coordinate_type_desc, "JOINT")) {
-		ps = lib::ECP_JOINT;
-	} else if (!strcmp(coordinate_type_desc, "XYZ_EULER_ZYZ")) {
-		ps = lib::ECP_XYZ_EULER_ZYZ;
-	} else if (!strcmp(coordinate_type_desc, "XYZ_ANGLE_AXIS")) {
-		ps = lib::ECP_XYZ_ANGLE_AXIS;
-	} else {
-		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
-		return false;
-	}
-
-	if (!(from_file >> number_of_poses)) {
-		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
-		return false;
-	}
-
-        flushall();
-	if (!(from_file >> motion_type_desc)) {
-		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
-		return false;
-	}
-
-	if (!strcmp(motion_type_desc, "ABSOLUTE")) {
-		mt = lib::ABSOLUTE;
-	} else if (!strcmp(motion_type_desc, "RELATIVE")) {
-		mt = lib::RELATIVE;
-	} else {
-		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
-		return false;
-	}
+	const lib::ECP_POSE_SPECIFICATION ps = trajectory.get_pose_spec(); //pose specification read from the file
+	const lib::MOTION_TYPE mt = trajectory.get_motion_type(); //type of the commanded motion (relative or absolute)
 
-	double tab[10];
-	int pos = from_file.tellg();
-	char line[80];
-	int dlugosc;
-	do {
-		from_file.getline(line, 80);
-		dlugosc = strlen(line);
-	} while (dlugosc < 5);
-	int num = lib::setValuesInArray(tab, line);
-	this->set_axes_num(num);
-	from_file.seekg(pos);
+	this->set_axes_num(trajectory.get_axes_num());
 
 	std::vector <double> v(axes_num); //vector of read velocities
 	std::vector <double> a(axes_num); //vector of read accelerations
 	std::vector <double> coordinates(axes_num); //vector of read coordinates
 
-	for (i = 0; i < number_of_poses; i++) {
-		for (j = 0; j < axes_num; j++) {
-			if (!(from_file >> v[j])) { //protection before the non-numerical data
-				BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
-				return false;
-			}
-		}
-		from_file.ignore(std::numeric_limits <std::streamsize>::max(), '\n');
-		for (j = 0; j < axes_num; j++) {
-			if (!(from_file >> a[j])) { //protection before the non-numerical data
-				BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
-				return false;
-			}
-		}
-		from_file.ignore(std::numeric_limits <std::streamsize>::max(), '\n');
-		for (j = 0; j < axes_num; j++) {
-			if (!(from_file >> coordinates[j])) { //protection before the non-numerical data
-				BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
-				return false;
-			}
-		}
-		from_file.ignore(std::numeric_limits <std::streamsize>::max(), '\n');
+	for (int i = 0; i < trajectory.get_poses_num(); i++) {
+		v.assign(trajectory.velocity(i), trajectory.velocity(i) + axes_num);
+		a.assign(trajectory.acceleration(i), trajectory.acceleration(i) + axes_num);
+		coordinates.assign(trajectory.coordinates(i), trajectory.coordinates(i) + axes_num);
 
 		if (ps == lib::ECP_MOTOR) {
 			load_trajectory_pose(coordinates, mt, ps, v, a, motor_max_velocity, motor_max_acceleration);
@@ -698,8 +612,8 @@ bool newsmooth::optimize_energy_cost(std::vector<double> max_current_change, std
 
     int i, j;
 
-    std::vector <double> temp1;
-    std::vector <double> temp2;
+    const double * temp1;
+    const double * temp2;
 
     double control[axes_num];
     double highest_current_change[axes_num];
@@ -728,13 +642,13 @@ bool newsmooth::optimize_energy_cost(std::vector<double> max_current_change, std
 
     pose_vector_iterator = pose_vector.begin();
 
-    current_vector_iterator = current_vector.begin();
+    std::size_t current_index = 0;
 
-    temp1 = (*current_vector_iterator);
+    temp1 = current_vector[current_index];
 
-    current_vector_iterator++;
+    current_index++;
 
-    temp2 = (*current_vector_iterator);
+    temp2 = current_vector[current_index];
 
     if (debug)
     {
@@ -830,26 +744,28 @@ bool newsmooth::optimize_energy_cost(std::vector<double> max_current_change, std
             //}
         }
 
-        current_vector_iterator++;
+        current_index++;
 
         temp1 = temp2;
 
-        temp2 = *current_vector_iterator;
+        if (current_index < current_vector.size())
+        {
+            temp2 = current_vector[current_index];
+        }
 
         current_macrostep_in_pose++;
     }
 
-    double energySum;
-
-    energy_vector_iterator = energy_vector.begin();
+    double energySum = 0.0;
 
-    for (i = 0; i < energy_vector.size() - 1; i++)
+    // the last node is skipped; an empty buffer must not wrap the bound around
+    for (std::size_t e = 0; e + 1 < energy_vector.size(); e++)
     {
+        const double * energy = energy_vector[e];
         for (j = 0; j < axes_num; j++)
         {
-            energySum += (*energy_vector_iterator)[j];
+            energySum += energy[j];
         }
-        energy_vector_iterator++;
     }
 
     energy_cost.push_back(energySum);
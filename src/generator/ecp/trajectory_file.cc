@@ -0,0 +1,269 @@
+/**
+ * @file
+ * @brief Contains definitions of the methods of trajectory_file class.
+ * @ingroup generators
+ */
+
+#include <cstring>
+#include <cctype>
+#include <fstream>
+#include <limits>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+
+#include "base/ecp/ecp_exceptions.h"
+#include "generator/ecp/trajectory_file.h"
+
+namespace mrrocpp {
+namespace ecp {
+namespace common {
+namespace generator {
+
+namespace {
+
+//! Identifier at the beginning of the binary trajectory file
+const char binary_magic[8] = { 'M', 'R', 'R', 'O', 'C', 'T', 'R', 'J' };
+
+//! Version of the binary format
+const uint32_t binary_version = 1;
+
+//! Written in the native byte order, tells whether the file was created on a compatible machine
+const uint32_t binary_byte_order = 0x01020304;
+
+//! Header of the binary trajectory file, followed by 3 * axes_num * poses_num doubles
+struct binary_header
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	int32_t pose_spec;
+	int32_t motion_type;
+	uint32_t axes_num;
+	uint32_t poses_num;
+};
+
+} // namespace
+
+trajectory_file::trajectory_file() :
+		pose_spec(lib::ECP_JOINT), motion_type(lib::ABSOLUTE), axes_num(0), poses_num(0), data(NULL), mapping(NULL), mapping_size(0)
+{
+}
+
+trajectory_file::~trajectory_file()
+{
+	unmap();
+}
+
+void trajectory_file::unmap()
+{
+	if (mapping) {
+		munmap(mapping, mapping_size);
+		mapping = NULL;
+		mapping_size = 0;
+	}
+}
+
+void trajectory_file::load(const char* file_name)
+{
+	unmap();
+	text_data.clear();
+	data = NULL;
+	axes_num = 0;
+	poses_num = 0;
+
+	int fd = open(file_name, O_RDONLY);
+	if (fd == -1) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_EXISTENT_FILE));
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == -1) {
+		close(fd);
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+	}
+
+	bool binary;
+	try {
+		binary = load_binary(fd, file_stat.st_size);
+	} catch (...) {
+		close(fd);
+		throw;
+	}
+
+	// the mapping stays valid after the descriptor is closed
+	close(fd);
+
+	if (!binary) {
+		load_text(file_name);
+	}
+}
+
+bool trajectory_file::load_binary(int fd, std::size_t size)
+{
+	binary_header header;
+
+	if (size < sizeof(header) || pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header)
+			|| memcmp(header.magic, binary_magic, sizeof(binary_magic))) {
+		return false;
+	}
+
+	if (header.version != binary_version || header.byte_order != binary_byte_order) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
+	}
+
+	switch (header.pose_spec)
+	{
+		case lib::ECP_MOTOR:
+		case lib::ECP_JOINT:
+		case lib::ECP_XYZ_EULER_ZYZ:
+		case lib::ECP_XYZ_ANGLE_AXIS:
+			break;
+		default:
+			BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
+	}
+
+	if ((header.motion_type != lib::ABSOLUTE && header.motion_type != lib::RELATIVE) || header.axes_num == 0
+			|| header.axes_num > lib::MAX_SERVOS_NR) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
+	}
+
+	if ((size - sizeof(header)) / (3 * header.axes_num * sizeof(double)) < header.poses_num) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+	}
+
+	void * addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (addr == MAP_FAILED) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+	}
+
+	// the trajectory is read sequentially, once
+	madvise(addr, size, MADV_SEQUENTIAL);
+
+	mapping = addr;
+	mapping_size = size;
+
+	pose_spec = (lib::ECP_POSE_SPECIFICATION) header.pose_spec;
+	motion_type = (lib::MOTION_TYPE) header.motion_type;
+	axes_num = header.axes_num;
+	poses_num = header.poses_num;
+	data = reinterpret_cast <const double *> (static_cast <const char *> (mapping) + sizeof(header));
+
+	return true;
+}
+
+void trajectory_file::load_text(const char* file_name)
+{
+	char coordinate_type_desc[80]; //description of pose specification read from the file
+	char motion_type_desc[80]; //description of motion type read from the file
+
+	std::ifstream from_file(file_name); // open the file
+	if (!from_file.good()) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_EXISTENT_FILE));
+	}
+
+	if (!(from_file >> coordinate_type_desc)) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+	}
+
+	for (char * c = coordinate_type_desc; *c; ++c) {
+		*c = toupper(*c);
+	}
+
+	if (!strcmp(coordinate_type_desc, "MOTOR")) {
+		pose_spec = lib::ECP_MOTOR;
+	} else if (!strcmp(coordinate_type_desc, "JOINT")) {
+		pose_spec = lib::ECP_JOINT;
+	} else if (!strcmp(coordinate_type_desc, "XYZ_EULER_ZYZ")) {
+		pose_spec = lib::ECP_XYZ_EULER_ZYZ;
+	} else if (!strcmp(coordinate_type_desc, "XYZ_ANGLE_AXIS")) {
+		pose_spec = lib::ECP_XYZ_ANGLE_AXIS;
+	} else {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
+	}
+
+	int number_of_poses;
+	if (!(from_file >> number_of_poses) || number_of_poses < 0) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+	}
+
+	if (!(from_file >> motion_type_desc)) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+	}
+
+	if (!strcmp(motion_type_desc, "ABSOLUTE")) {
+		motion_type = lib::ABSOLUTE;
+	} else if (!strcmp(motion_type_desc, "RELATIVE")) {
+		motion_type = lib::RELATIVE;
+	} else {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
+	}
+
+	// number of coordinates is taken from the first line of the data
+	std::streampos pos = from_file.tellg();
+	char line[80];
+	do {
+		if (!from_file.getline(line, 80)) {
+			BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+		}
+	} while (strlen(line) < 5);
+	axes_num = 0;
+	for (char * token = strtok(line, " \t\r"); token; token = strtok(NULL, " \t\r")) {
+		axes_num++;
+	}
+	from_file.seekg(pos);
+
+	if (axes_num <= 0 || axes_num > (int) lib::MAX_SERVOS_NR) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_TRAJECTORY_FILE));
+	}
+
+	// velocities, accelerations and coordinates, each in a separate line
+	text_data.resize(3 * axes_num * number_of_poses);
+	std::vector <double>::iterator it = text_data.begin();
+	for (int i = 0; i < 3 * number_of_poses; i++) {
+		for (int j = 0; j < axes_num; j++, ++it) {
+			if (!(from_file >> *it)) { //protection before the non-numerical data
+				BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(READ_FILE_ERROR));
+			}
+		}
+		from_file.ignore(std::numeric_limits <std::streamsize>::max(), '\n');
+	}
+
+	poses_num = number_of_poses;
+	data = text_data.empty() ? NULL : &text_data[0];
+}
+
+void trajectory_file::save_binary(const char* file_name) const
+{
+	binary_header header;
+	memcpy(header.magic, binary_magic, sizeof(binary_magic));
+	header.version = binary_version;
+	header.byte_order = binary_byte_order;
+	header.pose_spec = pose_spec;
+	header.motion_type = motion_type;
+	header.axes_num = axes_num;
+	header.poses_num = poses_num;
+
+	std::ofstream to_file(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!to_file.good()) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(NON_EXISTENT_FILE));
+	}
+
+	to_file.write(reinterpret_cast <const char *> (&header), sizeof(header));
+	if (poses_num > 0) {
+		to_file.write(reinterpret_cast <const char *> (data), 3 * axes_num * poses_num * sizeof(double));
+	}
+
+	if (!to_file.good()) {
+		BOOST_THROW_EXCEPTION(exception::nfe_g() << lib::exception::mrrocpp_error0(SAVE_FILE_ERROR));
+	}
+}
+
+} // namespace generator
+} // namespace common
+} // namespace ecp
+} // namespace mrrocpp
@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @brief Contains declarations of the methods of trajectory_file class.
+ * @ingroup generators
+ */
+
+#if !defined(_ECP_TRAJECTORY_FILE_H)
+# define _ECP_TRAJECTORY_FILE_H
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/utility.hpp>
+
+#include "base/lib/com_buf.h"
+
+namespace mrrocpp {
+namespace ecp {
+namespace common {
+namespace generator {
+
+/**
+ * @brief Trajectory file shared by the newsmooth, spline and constant_velocity generators.
+ *
+ * Two formats are read:
+ * - legacy text format: pose specification, number of poses and motion type, followed by the
+ *   velocities, accelerations and coordinates of each pose, one line each,
+ * - binary format: fixed size header followed by the packed doubles (velocities, accelerations
+ *   and coordinates of each pose) in the native byte order. The file is memory mapped and its
+ *   contents are accessed in place, without parsing.
+ *
+ * The format is recognized by the content of the file, not by its name.
+ *
+ * @ingroup generators
+ */
+class trajectory_file : private boost::noncopyable
+{
+	private:
+		/**
+		 * Pose specification of the trajectory.
+		 */
+		lib::ECP_POSE_SPECIFICATION pose_spec;
+		/**
+		 * Motion type of the trajectory.
+		 */
+		lib::MOTION_TYPE motion_type;
+		/**
+		 * Number of coordinates in a pose.
+		 */
+		int axes_num;
+		/**
+		 * Number of poses.
+		 */
+		int poses_num;
+		/**
+		 * Velocities, accelerations and coordinates of all poses, pose after pose.
+		 */
+		const double * data;
+		/**
+		 * Storage of the values parsed from the text file.
+		 */
+		std::vector <double> text_data;
+		/**
+		 * Mapped binary file.
+		 */
+		void * mapping;
+		/**
+		 * Size of the mapped binary file.
+		 */
+		std::size_t mapping_size;
+
+		/**
+		 * Releases the mapped file.
+		 */
+		void unmap();
+		/**
+		 * Loads the binary file.
+		 * @param fd descriptor of the opened file
+		 * @param size size of the file
+		 * @return false if the file is not a binary trajectory
+		 */
+		bool load_binary(int fd, std::size_t size);
+		/**
+		 * Parses the text file.
+		 * @param file_name name of the file
+		 */
+		void load_text(const char* file_name);
+
+	public:
+		/**
+		 * Constructor.
+		 */
+		trajectory_file();
+		/**
+		 * Destructor, releases the mapped file.
+		 */
+		~trajectory_file();
+		/**
+		 * Reads the trajectory from the file in any of the supported formats. Throws nfe_g on error.
+		 * @param file_name name of the file
+		 */
+		void load(const char* file_name);
+		/**
+		 * Writes the trajectory in the binary format. Throws nfe_g on error.
+		 * @param file_name name of the file
+		 */
+		void save_binary(const char* file_name) const;
+		/**
+		 * Returns pose specification of the trajectory.
+		 */
+		lib::ECP_POSE_SPECIFICATION get_pose_spec() const
+		{
+			return pose_spec;
+		}
+		/**
+		 * Returns motion type of the trajectory.
+		 */
+		lib::MOTION_TYPE get_motion_type() const
+		{
+			return motion_type;
+		}
+		/**
+		 * Returns number of coordinates in a pose.
+		 */
+		int get_axes_num() const
+		{
+			return axes_num;
+		}
+		/**
+		 * Returns number of poses.
+		 */
+		int get_poses_num() const
+		{
+			return poses_num;
+		}
+		/**
+		 * Returns velocities of the given pose.
+		 * @param pose number of the pose
+		 */
+		const double * velocity(int pose) const
+		{
+			return data + 3 * axes_num * pose;
+		}
+		/**
+		 * Returns accelerations of the given pose.
+		 * @param pose number of the pose
+		 */
+		const double * acceleration(int pose) const
+		{
+			return data + 3 * axes_num * pose + axes_num;
+		}
+		/**
+		 * Returns coordinates of the given pose.
+		 * @param pose number of the pose
+		 */
+		const double * coordinates(int pose) const
+		{
+			return data + 3 * axes_num * pose + 2 * axes_num;
+		}
+};
+
+} // namespace generator
+} // namespace common
+} // namespace ecp
+} // namespace mrrocpp
+
+#endif
@@ -45,7 +45,7 @@ public:
 	 * @param mc time of a single macrostep
 	 * @return true if the interpolation was successful
 	 */
-	bool interpolate_relative_pose(std::vector <ecp_mp::common::trajectory_pose::bang_bang_trajectory_pose>::iterator & it, std::vector <std::vector <double> > & cv, const double mc);
+	bool interpolate_relative_pose(std::vector <ecp_mp::common::trajectory_pose::bang_bang_trajectory_pose>::iterator & it, coordinate_buffer & cv, const double mc);
 	/**
 	 * Method interpolates the absolute type trajectory basing on the list of poses stored in objects of types derived from %trajectory_pose.
 	 * @param it iterator to the list of positions
@@ -53,7 +53,7 @@ public:
 	 * @param mc time of a single macrostep
 	 * @return true if the interpolation was successful
 	 */
-	bool interpolate_absolute_pose(std::vector <ecp_mp::common::trajectory_pose::bang_bang_trajectory_pose>::iterator & it, std::vector <std::vector <double> > & cv, const double mc);
+	bool interpolate_absolute_pose(std::vector <ecp_mp::common::trajectory_pose::bang_bang_trajectory_pose>::iterator & it, coordinate_buffer & cv, const double mc);
 
 private:
 	/**
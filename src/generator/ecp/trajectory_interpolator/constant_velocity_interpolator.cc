@@ -24,27 +24,27 @@ constant_velocity_interpolator::~constant_velocity_interpolator() {
 	// TODO Auto-generated destructor stub
 }
 
-bool constant_velocity_interpolator::interpolate_relative_pose(vector<ecp_mp::common::trajectory_pose::constant_velocity_trajectory_pose>::iterator & it, vector<vector<double> > & cv, const double mc) {
+bool constant_velocity_interpolator::interpolate_relative_pose(vector<ecp_mp::common::trajectory_pose::constant_velocity_trajectory_pose>::iterator & it, coordinate_buffer & cv, const double mc) {
 
-	vector<double> coordinates (it->axes_num);
+	cv.reserve(it->interpolation_node_no);
 	for (int i = 0; i < it->interpolation_node_no; i++) {
+		double * coordinates = cv.append();
 		for (int j = 0; j < it->axes_num; j++) {
 			coordinates[j] = it->k[j] * mc * it->v_r[j];
 		}
-		cv.push_back(coordinates);
 	}
 
 	return true;
 }
 
-bool constant_velocity_interpolator::interpolate_absolute_pose(vector<ecp_mp::common::trajectory_pose::constant_velocity_trajectory_pose>::iterator & it, vector<vector<double> > & cv, const double mc) {
+bool constant_velocity_interpolator::interpolate_absolute_pose(vector<ecp_mp::common::trajectory_pose::constant_velocity_trajectory_pose>::iterator & it, coordinate_buffer & cv, const double mc) {
 
-	vector<double> coordinates (it->axes_num);
+	cv.reserve(it->interpolation_node_no);
 	for (int i = 0; i < it->interpolation_node_no; i++) {
+		double * coordinates = cv.append();
 		for (int j = 0; j < it->axes_num; j++) {
 			coordinates[j] = it->start_position[j] + (it->k[j] * (i+1) * mc * it->v_r[j]);
 		}
-		cv.push_back(coordinates);
 	}
 
 	return true;
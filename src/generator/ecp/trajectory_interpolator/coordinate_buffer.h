@@ -0,0 +1,143 @@
+/**
+ * @file
+ * @brief Contains declarations and definitions of the methods of coordinate_buffer class.
+ * @ingroup generators
+ */
+
+#ifndef _COORDINATE_BUFFER_H_
+#define _COORDINATE_BUFFER_H_
+
+#include <vector>
+#include <cstddef>
+#include <cassert>
+
+namespace mrrocpp {
+namespace ecp {
+namespace common {
+namespace generator {
+namespace trajectory_interpolator {
+
+/**
+ * @brief Flat, row-major (nodes x axes) storage of the interpolated coordinates.
+ *
+ * All the nodes are kept in a single contiguous array. Clearing the buffer does not release the memory,
+ * thus after the first trajectory of a given length, interpolation and reading of the nodes do not allocate.
+ */
+class coordinate_buffer
+{
+private:
+	/**
+	 * Coordinates of all nodes, node after node.
+	 */
+	std::vector <double> data;
+	/**
+	 * Number of coordinates in a single node.
+	 */
+	std::size_t axes;
+	/**
+	 * Number of stored nodes.
+	 */
+	std::size_t nodes;
+
+public:
+	/**
+	 * Constructor.
+	 */
+	coordinate_buffer() :
+			axes(0), nodes(0)
+	{
+	}
+	/**
+	 * Removes all of the nodes and sets the number of axes. Allocated memory is kept for the next use.
+	 * @param axes_num number of coordinates in a single node
+	 */
+	void reset(std::size_t axes_num)
+	{
+		axes = axes_num;
+		nodes = 0;
+	}
+	/**
+	 * Removes all of the nodes. Allocated memory is kept for the next use.
+	 */
+	void clear()
+	{
+		nodes = 0;
+	}
+	/**
+	 * Makes sure that the given number of nodes can be appended without reallocation.
+	 * @param nodes_num number of nodes to be appended
+	 */
+	void reserve(std::size_t nodes_num)
+	{
+		if (data.size() < (nodes + nodes_num) * axes) {
+			data.resize((nodes + nodes_num) * axes);
+		}
+	}
+	/**
+	 * Appends a node. Coordinates are written in place through the returned pointer,
+	 * which remains valid until the next call of append() or reserve().
+	 * @return pointer to the coordinates of the new node
+	 */
+	double * append()
+	{
+		reserve(1);
+		return &data[axes * nodes++];
+	}
+	/**
+	 * Appends a node copied from the given vector.
+	 * @param coordinates coordinates of the node
+	 */
+	void push_back(const std::vector <double> & coordinates)
+	{
+		assert(coordinates.size() == axes);
+		double * node = append();
+		for (std::size_t i = 0; i < axes; i++) {
+			node[i] = coordinates[i];
+		}
+	}
+	/**
+	 * Returns coordinates of the given node.
+	 * @param node_num number of the node
+	 */
+	const double * operator[](std::size_t node_num) const
+	{
+		return &data[axes * node_num];
+	}
+	/**
+	 * Returns coordinates of the given node.
+	 * @param node_num number of the node
+	 */
+	double * operator[](std::size_t node_num)
+	{
+		return &data[axes * node_num];
+	}
+	/**
+	 * Returns number of the stored nodes.
+	 */
+	std::size_t size() const
+	{
+		return nodes;
+	}
+	/**
+	 * Returns true if there are no stored nodes.
+	 */
+	bool empty() const
+	{
+		return (nodes == 0);
+	}
+	/**
+	 * Returns number of coordinates in a single node.
+	 */
+	std::size_t axes_num() const
+	{
+		return axes;
+	}
+};
+
+} // namespace trajectory_interpolator
+} // namespace generator
+} // namespace common
+} // namespace ecp
+} // namespace mrrocpp
+
+#endif /* _COORDINATE_BUFFER_H_ */
@@ -25,11 +25,11 @@ spline_interpolator::~spline_interpolator()
     // TODO Auto-generated destructor stub
 }
 
-bool spline_interpolator::interpolate_relative_pose(vector<ecp_mp::common::trajectory_pose::spline_trajectory_pose>::iterator & it, vector<vector<double> > & cv, const double mc) {
+bool spline_interpolator::interpolate_relative_pose(vector<ecp_mp::common::trajectory_pose::spline_trajectory_pose>::iterator & it, coordinate_buffer & cv, const double mc) {
 
-    vector<double> coordinates (it->axes_num);
-    coordinates = it->start_position;
+    cv.reserve(it->interpolation_node_no);
     for (int i = 0; i < it->interpolation_node_no; i++) {
+            double * coordinates = cv.append();
         //printf("inter: \n");
             for (int j = 0; j < it->axes_num; j++) {
                 coordinates[j] = calculate_velocity(it, j, (i+1) * mc) * mc;
@@ -45,21 +45,19 @@ bool spline_interpolator::interpolate_relative_pose(vector<ecp_mp::common::traje
                 }*/
             }
             //printf("\n");
-            cv.push_back(coordinates);
     }
 
     return true;
 }
 
-bool spline_interpolator::interpolate_absolute_pose(vector<ecp_mp::common::trajectory_pose::spline_trajectory_pose>::iterator & it, vector<vector<double> > & cv, const double mc) {
+bool spline_interpolator::interpolate_absolute_pose(vector<ecp_mp::common::trajectory_pose::spline_trajectory_pose>::iterator & it, coordinate_buffer & cv, const double mc) {
 
-    vector<double> coordinates (it->axes_num);
-    coordinates = it->start_position;
+    cv.reserve(it->interpolation_node_no);
     for (int i = 0; i < it->interpolation_node_no; i++) {
+            double * coordinates = cv.append();
             for (int j = 0; j < it->axes_num; j++) {
                 coordinates[j] = calculate_position(it, j, (i+1) * mc);
             }
-            cv.push_back(coordinates);
     }
 
     return true;
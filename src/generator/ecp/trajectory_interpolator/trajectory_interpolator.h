@@ -13,6 +13,7 @@
 
 #include "base/lib/trajectory_pose/trajectory_pose.h"
 #include "base/lib/mrmath/mrmath.h"
+#include "generator/ecp/trajectory_interpolator/coordinate_buffer.h"
 
 namespace mrrocpp {
     namespace ecp {
@@ -50,7 +51,7 @@ namespace mrrocpp {
                          * @param mc time of a single macrostep
                          * @return true if the interpolation was successful
                          */
-                        virtual bool interpolate_relative_pose(typename std::vector<Pos>::iterator & pose_vector_iterator, std::vector<std::vector<double> > & coordinate_vector, const double mc) = 0;
+                        virtual bool interpolate_relative_pose(typename std::vector<Pos>::iterator & pose_vector_iterator, coordinate_buffer & coordinate_vector, const double mc) = 0;
                         /**
                          * Method interpolates the absolute type trajectory basing on the list of poses of stored in objects of types derived from %trajectory_pose.
                          * @param pose_vector_iterator iterator to the list of positions
@@ -58,7 +59,7 @@ namespace mrrocpp {
                          * @param mc time of a single macrostep
                          * @return true if the interpolation was successful
                          */
-                        virtual bool interpolate_absolute_pose(typename std::vector<Pos>::iterator & pose_vector_iterator, std::vector<std::vector<double> > & coordinate_vector, const double mc) = 0;
+                        virtual bool interpolate_absolute_pose(typename std::vector<Pos>::iterator & pose_vector_iterator, coordinate_buffer & coordinate_vector, const double mc) = 0;
 
                         /**
                          * Method is used to interpolate the Angle Axis absolute pose, which was previously transformed into relative pose using the velocity_profile::calculate_relative_angle_axis_vector method (coordinates vector is now a relative vector).
@@ -67,7 +68,7 @@ namespace mrrocpp {
                          * @param mc time of a single macrostep
                          * @return true if the interpolation was successful
                          */
-                        bool interpolate_angle_axis_absolute_pose_transformed_into_relative(typename std::vector <Pos>::iterator & it, std::vector <std::vector <double> > & cv, const double mc) {
+                        bool interpolate_angle_axis_absolute_pose_transformed_into_relative(typename std::vector <Pos>::iterator & it, coordinate_buffer & cv, const double mc) {
 
                             typename std::vector<double> coordinates(it->axes_num);
 
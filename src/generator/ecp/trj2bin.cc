@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @brief Converts trajectory files of the newsmooth, spline and constant_velocity generators
+ * to the binary format.
+ * @ingroup generators
+ */
+
+#include <iostream>
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include "base/ecp/ecp_exceptions.h"
+#include "generator/ecp/trajectory_file.h"
+
+using namespace mrrocpp::ecp::common::generator;
+
+int main(int argc, char *argv[])
+{
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0] << " input.trj output.trjb" << std::endl;
+		return 1;
+	}
+
+	try {
+		trajectory_file trajectory;
+		trajectory.load(argv[1]);
+		trajectory.save_binary(argv[2]);
+
+		std::cout << argv[1] << ": " << trajectory.get_poses_num() << " poses, " << trajectory.get_axes_num()
+				<< " axes" << std::endl;
+	} catch (const boost::exception & e) {
+		std::cerr << argv[1] << ": " << boost::diagnostic_information(e) << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -23,6 +23,12 @@ const int SET_LIMIT = 0x41;
 
 const int HEADER_LEN = 3;
 
+// length of a request frame, padded with the unused bytes
+const int FRAME_LEN = 21;
+
+// joints sharing a serial port (addressed with id % 2)
+const int JOINTS_PER_PORT = 2;
+
 const int LOWER_LIMIT = 0;
 const int UPPER_LIMIT = 1;
 const int CURRENT_LIMIT = 2;
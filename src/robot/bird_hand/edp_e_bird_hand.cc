@@ -135,25 +135,37 @@ void effector::move_arm(const lib::c_buffer &instruction)
 		get_current_kinematic_model()->i2mp_transform(desired_motor_pos_new_tmp_rel, desired_joints_tmp_rel);
 		dynamic_cast <kinematics::bird_hand::kinematic_model_bird_hand*>(get_current_kinematic_model())->i2mp_transform_synch(desired_motor_pos_new_tmp_abs, desired_joints_tmp_abs);
 
+		// stawy bez rozpoznanego profilu nie dostaja polecenia (code == 0)
+		joint_command cmds[lib::bird_hand::NUM_OF_SERVOS];
+		memset(cmds, 0, sizeof(cmds));
+
 		for (unsigned int i = 0; i < number_of_servos; i++) {
-			int16_t desired_torque_with_offset =
-					(int16_t) local_instruction.bird_hand.command_structure.finger[i].desired_torque + torque_offset[i];
+			joint_command & cmd = cmds[i];
+
+			cmd.t = (int16_t) local_instruction.bird_hand.command_structure.motion_steps;
+			cmd.b = (int16_t) local_instruction.bird_hand.command_structure.finger[i].reciprocal_of_damping;
+			cmd.Fd = (int16_t) local_instruction.bird_hand.command_structure.finger[i].desired_torque + torque_offset[i];
 
 			switch (local_instruction.bird_hand.command_structure.finger[i].profile_type)
 			{
 				case mrrocpp::lib::bird_hand::SIGLE_STEP_POSTION_INCREMENT:
-					device.setCMD1((uint16_t) i, (int16_t) local_instruction.bird_hand.command_structure.motion_steps, (int16_t) local_instruction.bird_hand.command_structure.finger[i].reciprocal_of_damping, desired_torque_with_offset, (int32_t) desired_motor_pos_new_tmp_rel[i]);
+					cmd.code = SET_CMD1;
+					cmd.rd = (int32_t) desired_motor_pos_new_tmp_rel[i];
 					break;
 				case mrrocpp::lib::bird_hand::MACROSTEP_POSITION_INCREMENT:
-					device.setCMD2((uint16_t) i, (int16_t) local_instruction.bird_hand.command_structure.motion_steps, (int16_t) local_instruction.bird_hand.command_structure.finger[i].reciprocal_of_damping, desired_torque_with_offset, (int32_t) desired_motor_pos_new_tmp_rel[i]);
+					cmd.code = SET_CMD2;
+					cmd.rd = (int32_t) desired_motor_pos_new_tmp_rel[i];
 					break;
 				case mrrocpp::lib::bird_hand::MACROSTEP_ABSOLUTE_POSITION:
-					device.setCMD3((uint16_t) i, (int16_t) local_instruction.bird_hand.command_structure.motion_steps, (int16_t) local_instruction.bird_hand.command_structure.finger[i].reciprocal_of_damping, desired_torque_with_offset, (int32_t) desired_motor_pos_new_tmp_abs[i]
-							+ synchro_position_motor[i]);
+					cmd.code = SET_CMD3;
+					cmd.rd = (int32_t) desired_motor_pos_new_tmp_abs[i] + synchro_position_motor[i];
 					break;
 
 			}
 		}
+
+		// ramki wszystkich stawow wysylane sa jednym zapisem na port
+		device.setCMDs(cmds, number_of_servos);
 	}
 
 	std::stringstream ss(std::stringstream::in | std::stringstream::out);
@@ -218,12 +230,16 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction)
 					local_instruction.bird_hand.command_structure.finger[i].desired_torque;
 		}
 	} else {
-		for (uint8_t i = 0; i < number_of_servos; i++) {
-			int32_t pos;
-			int16_t t, c;
-			uint8_t status;
+		joint_status statuses[lib::bird_hand::NUM_OF_SERVOS];
+
+		// zapytania o stan wysylane sa rownolegle na wszystkie porty
+		device.getStatuses(statuses, number_of_servos);
 
-			device.getStatus(i, status, pos, c, t);
+		for (uint8_t i = 0; i < number_of_servos; i++) {
+			const int32_t pos = statuses[i].position;
+			const int16_t t = statuses[i].torque;
+			const int16_t c = statuses[i].current;
+			const uint8_t status = statuses[i].status;
 
 			desired_motor_pos_new_tmp[i] = (double) pos - synchro_position_motor[i];
 			reply.bird_hand.status_reply_structure.finger[i].measured_current = c;
@@ -6,12 +6,27 @@
 #include <cstring>
 #include <iostream>
 
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <errno.h>
+#include <time.h>
+
 #define BAUD B921600
 
 namespace mrrocpp {
 namespace edp {
 namespace bird_hand {
 
+namespace {
+
+//! Identifier of the deadline timer in the epoll events; the ports are identified by their numbers
+const uint32_t DEADLINE_EVENT = PORTS_NR;
+
+//! Length of the answer to the status request
+const unsigned int STATUS_REPLY_LEN = HEADER_LEN + sizeof(struct status_);
+
+} // namespace
+
 void Bird_hand::write_read(int fd, char* b, unsigned int w_len, unsigned int r_len)
 {
 	unsigned int dlen = 0;
@@ -39,9 +54,12 @@ void Bird_hand::write_read(int fd, char* b, unsigned int w_len, unsigned int r_l
 
 }
 
-Bird_hand::Bird_hand()
+Bird_hand::Bird_hand() :
+		epoll_fd(-1), deadline_fd(-1)
 {
-
+	for (unsigned int i = 0; i < PORTS_NR; i++) {
+		fd[i] = -1;
+	}
 }
 
 Bird_hand::~Bird_hand()
@@ -79,6 +97,27 @@ void Bird_hand::connect(std::string port)
 		tcflush(fd[i], TCIFLUSH);
 		tcsetattr(fd[i], TCSANOW, &newtio);
 	}
+
+	// odpowiedzi wszystkich portow i termin ich nadejscia obslugiwane sa jednym epoll
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	deadline_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (epoll_fd < 0 || deadline_fd < 0) {
+		throw(std::runtime_error("unable to create epoll descriptors !!!"));
+	}
+
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.u32 = DEADLINE_EVENT;
+	if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, deadline_fd, &event) < 0) {
+		throw(std::runtime_error("unable to register deadline timer !!!"));
+	}
+	for (uint32_t i = 0; i < PORTS_NR; i++) {
+		event.data.u32 = i;
+		if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd[i], &event) < 0) {
+			throw(std::runtime_error("unable to register port !!!"));
+		}
+	}
 }
 
 void Bird_hand::disconnect()
@@ -87,9 +126,17 @@ void Bird_hand::disconnect()
 		if (fd[i] > 0) {
 			tcsetattr(fd[i], TCSANOW, &oldtio[i]);
 			close(fd[i]);
+			fd[i] = -1;
 		}
 	}
-
+	if (deadline_fd >= 0) {
+		close(deadline_fd);
+		deadline_fd = -1;
+	}
+	if (epoll_fd >= 0) {
+		close(epoll_fd);
+		epoll_fd = -1;
+	}
 }
 
 void Bird_hand::getStatus(uint8_t id, uint8_t &status, int32_t &position, int16_t &current, int16_t &torque)
@@ -260,6 +307,156 @@ void Bird_hand::synchronize(uint8_t id, uint16_t step)
 
 }
 
+void Bird_hand::setCMDs(const joint_command * cmd, unsigned int joints)
+{
+	char frames[JOINTS_PER_PORT * FRAME_LEN];
+
+	for (unsigned int port = 0; port * JOINTS_PER_PORT < joints; port++) {
+		unsigned int len = 0;
+
+		// ramki stawow jednego portu wysylane sa jednym wywolaniem, bez oczekiwania na pozostale porty
+		for (unsigned int id = port * JOINTS_PER_PORT; id < joints && id < (port + 1) * JOINTS_PER_PORT; id++) {
+			if (cmd[id].code == 0) {
+				continue;
+			}
+
+			char * b = frames + len;
+			memset(b, 0, FRAME_LEN);
+			b[0] = START_BYTE;
+			b[1] = id % 2;
+			b[2] = cmd[id].code;
+
+			struct cmd_ *x = (struct cmd_ *) &b[3];
+			x->t = cmd[id].t;
+			x->fd = cmd[id].Fd;
+			x->b = cmd[id].b;
+			x->rd = cmd[id].rd;
+
+			len += FRAME_LEN;
+		}
+
+		if (len > 0 && write(fd[port], frames, len) != (ssize_t) len) {
+			throw(std::runtime_error("unable to write commands !!!"));
+		}
+	}
+}
+
+void Bird_hand::request_status(uint8_t id)
+{
+	char frame[FRAME_LEN];
+	memset(frame, 0, FRAME_LEN);
+	frame[0] = START_BYTE;
+	frame[1] = id % 2;
+	frame[2] = GET_STATUS;
+
+	if (write(fd[id / JOINTS_PER_PORT], frame, FRAME_LEN) != FRAME_LEN) {
+		throw(std::runtime_error("unable to write status request !!!"));
+	}
+}
+
+void Bird_hand::getStatuses(joint_status * status, unsigned int joints)
+{
+	// joint queried on the port and the part of its answer received so far
+	unsigned int queried[PORTS_NR];
+	unsigned int received[PORTS_NR];
+	char answer[PORTS_NR][STATUS_REPLY_LEN];
+
+	const unsigned int ports = (joints + JOINTS_PER_PORT - 1) / JOINTS_PER_PORT;
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	struct itimerspec deadline;
+	memset(&deadline, 0, sizeof(deadline));
+	deadline.it_value.tv_sec = now.tv_sec + (now.tv_nsec + STATUS_DEADLINE_NS) / 1000000000L;
+	deadline.it_value.tv_nsec = (now.tv_nsec + STATUS_DEADLINE_NS) % 1000000000L;
+	timerfd_settime(deadline_fd, TFD_TIMER_ABSTIME, &deadline, NULL);
+
+	// pierwsze zapytania na wszystkich portach jednoczesnie
+	unsigned int pending = 0;
+	for (unsigned int port = 0; port < PORTS_NR; port++) {
+		received[port] = 0;
+		queried[port] = joints;
+		if (port < ports) {
+			queried[port] = port * JOINTS_PER_PORT;
+			request_status(queried[port]);
+			pending++;
+		}
+	}
+
+	while (pending > 0) {
+		struct epoll_event events[PORTS_NR + 1];
+		const int nfds = epoll_wait(epoll_fd, events, PORTS_NR + 1, -1);
+
+		if (nfds < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw(std::runtime_error("epoll_wait() failed !!!"));
+		}
+
+		for (int e = 0; e < nfds; e++) {
+			const uint32_t port = events[e].data.u32;
+
+			if (port == DEADLINE_EVENT) {
+				// niepelne odpowiedzi rozsynchronizowalyby kolejna wymiane
+				for (unsigned int p = 0; p < ports; p++) {
+					tcflush(fd[p], TCIFLUSH);
+				}
+				throw(std::runtime_error("communication timeout !!!"));
+			}
+
+			if (queried[port] >= joints) {
+				// dane spoza wymiany sa odrzucane
+				char discard[STATUS_REPLY_LEN];
+				read(fd[port], discard, sizeof(discard));
+				continue;
+			}
+
+			const ssize_t len = read(fd[port], answer[port] + received[port], STATUS_REPLY_LEN - received[port]);
+			if (len <= 0) {
+				continue;
+			}
+			received[port] += len;
+
+			if (received[port] < STATUS_REPLY_LEN) {
+				continue;
+			}
+
+			if (answer[port][0] != START_BYTE) {
+				// odpowiedz przesunieta w strumieniu, port jest synchronizowany od nowa przy kolejnej wymianie
+				for (unsigned int p = 0; p < ports; p++) {
+					tcflush(fd[p], TCIFLUSH);
+				}
+				memset(&deadline, 0, sizeof(deadline));
+				timerfd_settime(deadline_fd, 0, &deadline, NULL);
+				throw(std::runtime_error("corrupted status reply !!!"));
+			}
+
+			const struct status_* stat = (const status_*) &answer[port][3];
+			joint_status & js = status[queried[port]];
+			js.status = stat->status;
+			js.position = stat->position;
+			js.current = stat->current;
+			js.torque = stat->force;
+
+			// kolejny staw tego samego portu
+			received[port] = 0;
+			queried[port]++;
+			if (queried[port] < joints && queried[port] < (port + 1) * JOINTS_PER_PORT) {
+				request_status(queried[port]);
+			} else {
+				queried[port] = joints;
+				pending--;
+			}
+		}
+	}
+
+	// wylaczenie terminu
+	memset(&deadline, 0, sizeof(deadline));
+	timerfd_settime(deadline_fd, 0, &deadline, NULL);
+}
+
 } // namespace bird_hand
 } // namespace edp
 } // namespace mrrocpp
@@ -15,6 +15,36 @@ namespace mrrocpp {
 namespace edp {
 namespace bird_hand {
 
+//! number of serial ports of the hand
+const unsigned int PORTS_NR = 8;
+
+//! deadline of the batched status exchange with all the joints
+const long STATUS_DEADLINE_NS = 100000000;
+
+/*!
+ * \brief command of a single joint for the batched transfer
+ */
+struct joint_command
+{
+	//! SET_CMD1, SET_CMD2 or SET_CMD3; 0 if the joint gets no command
+	uint8_t code;
+	int16_t t;
+	int16_t b;
+	int16_t Fd;
+	int32_t rd;
+};
+
+/*!
+ * \brief status of a single joint from the batched transfer
+ */
+struct joint_status
+{
+	uint8_t status;
+	int32_t position;
+	int16_t current;
+	int16_t torque;
+};
+
 /*!
  * \brief class of EDP bird hand gripper hardware interface.
  *
@@ -107,13 +137,40 @@ public:
 	 */
 	void synchronize(uint8_t id, uint16_t step);
 
+	/*!
+	 * \brief method set commands for all joints.
+	 *
+	 * Frames of the joints sharing a port are sent back-to-back with a single write,
+	 * without waiting for the other ports.
+	 */
+	void setCMDs(const joint_command * cmd, unsigned int joints);
+
+	/*!
+	 * \brief method get status of all joints.
+	 *
+	 * Status requests are pending on all ports at once; the next joint of a port is queried
+	 * as soon as the answer of the previous one is complete, so the joints sharing a bus never answer together.
+	 * The whole exchange is bounded by STATUS_DEADLINE_NS.
+	 */
+	void getStatuses(joint_status * status, unsigned int joints);
+
 protected:
 private:
 
 	void write_read(int fd, char* buf, unsigned int w_len, unsigned int r_len);
 
-	int fd[8];
-	struct termios oldtio[8];
+	/*!
+	 * \brief send the status request of a joint, without waiting for the answer.
+	 */
+	void request_status(uint8_t id);
+
+	int fd[PORTS_NR];
+	struct termios oldtio[PORTS_NR];
+
+	//! epoll descriptor waiting for the answers on all ports and for the deadline
+	int epoll_fd;
+	//! timer descriptor signalling the deadline of the batched exchange
+	int deadline_fd;
 
 	char buf[30];
 
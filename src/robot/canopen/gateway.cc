@@ -5,6 +5,8 @@
  *      Author: ptroja
  */
 
+#include <cstring>
+
 #include "gateway.h"
 
 namespace mrrocpp {
@@ -142,6 +144,88 @@ WORD gateway::CalcFieldCRC(const WORD *pDataArray, WORD numberOfWords)
 	return CRC;
 }
 
+WORD gateway::TPDOCobID(uint8_t nodeId, unsigned int pdo)
+{
+	return 0x180 + 0x100 * (pdo - 1) + nodeId;
+}
+
+WORD gateway::RPDOCobID(uint8_t nodeId, unsigned int pdo)
+{
+	return 0x200 + 0x100 * (pdo - 1) + nodeId;
+}
+
+void gateway::SendSYNC()
+{
+	const BYTE data[8] = { 0 };
+
+	SendCANFrame(SYNC_COB_ID, 0, data);
+}
+
+void gateway::SendRPDO(uint8_t nodeId, unsigned int pdo, WORD Length, const BYTE Data[8])
+{
+	try {
+		SendCANFrame(RPDOCobID(nodeId, pdo), Length, Data);
+	} catch (boost::exception & e) {
+		e << canId(nodeId);
+		throw;
+	}
+}
+
+bool gateway::supportsProcessImage() const
+{
+	return false;
+}
+
+void gateway::registerTPDO(uint8_t nodeId, unsigned int pdo)
+{
+	pdo_buffer_t & buffer = process_image[TPDOCobID(nodeId, pdo)];
+
+	buffer.length = 0;
+	buffer.updated = false;
+}
+
+bool gateway::storeTPDO(WORD cobId, WORD length, const BYTE * data)
+{
+	std::map <WORD, pdo_buffer_t>::iterator it = process_image.find(cobId);
+
+	if (it == process_image.end()) {
+		return false;
+	}
+
+	pdo_buffer_t & buffer = it->second;
+
+	buffer.length = (length > 8) ? 8 : length;
+	memcpy(buffer.data, data, buffer.length);
+
+	if (buffer.updated) {
+		return false;
+	}
+
+	buffer.updated = true;
+
+	return true;
+}
+
+void gateway::SyncProcessImage()
+{
+	BOOST_THROW_EXCEPTION(fe_canopen_error() << reason("cyclic process image not supported by the gateway"));
+}
+
+const gateway::pdo_buffer_t & gateway::getTPDO(uint8_t nodeId, unsigned int pdo) const
+{
+	std::map <WORD, pdo_buffer_t>::const_iterator it = process_image.find(TPDOCobID(nodeId, pdo));
+
+	if (it == process_image.end()) {
+		BOOST_THROW_EXCEPTION(fe_canopen_error() << reason("TPDO not registered in the process image") << canId(nodeId));
+	}
+
+	if (!it->second.updated) {
+		BOOST_THROW_EXCEPTION(fe_canopen_error() << reason("TPDO not received in the last SYNC cycle") << canId(nodeId));
+	}
+
+	return it->second;
+}
+
 void gateway::setDebugLevel(int level)
 {
 	debug = level;
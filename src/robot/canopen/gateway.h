@@ -8,6 +8,7 @@
 
 #include <stdint.h>  /* int types with given size */
 #include <string>
+#include <map>
 
 #include <boost/type_traits/is_same.hpp>
 #include <boost/throw_exception.hpp>
@@ -41,7 +42,33 @@ private:
 	 */
 	virtual unsigned int ReadObject(WORD *ans, unsigned int ans_len, uint8_t nodeId, WORD index, BYTE subindex) = 0;
 
+public:
+	//! Process data received with a TPDO
+	typedef struct _pdo_buffer
+	{
+		//! CAN Frame Data
+		BYTE data[8];
+
+		//! CAN Frame Data Length Code (DLC)
+		WORD length;
+
+		//! Flag set if the frame was received in the current SYNC cycle
+		bool updated;
+	} pdo_buffer_t;
+
 protected:
+	//! Process image: last TPDO frames of the registered nodes, indexed by the COB-ID
+	std::map <WORD, pdo_buffer_t> process_image;
+
+	/*! \brief Store the frame in the process image
+	 *
+	 * @param cobId CAN Frame 11-bit Identifier
+	 * @param length CAN Frame Data Length Code (DLC)
+	 * @param data CAN Frame Data
+	 * @return true if the frame is a registered TPDO, which was not received yet in the current SYNC cycle
+	 */
+	bool storeTPDO(WORD cobId, WORD length, const BYTE * data);
+
 	//! Flag indicating connection status
 	bool device_opened;
 
@@ -183,6 +210,58 @@ public:
 	 */
 	virtual void SendCANFrame(WORD Identifier, WORD Length, const BYTE Data[8]) = 0;
 
+	//! \brief COB-ID of the SYNC object
+	static const WORD SYNC_COB_ID = 0x080;
+
+	/*! \brief COB-ID of the TPDO (default CANopen allocation)
+	 *
+	 * @param nodeId CAN node ID
+	 * @param pdo number of the PDO (1..4)
+	 */
+	static WORD TPDOCobID(uint8_t nodeId, unsigned int pdo);
+
+	/*! \brief COB-ID of the RPDO (default CANopen allocation)
+	 *
+	 * @param nodeId CAN node ID
+	 * @param pdo number of the PDO (1..4)
+	 */
+	static WORD RPDOCobID(uint8_t nodeId, unsigned int pdo);
+
+	//! Send the SYNC object to the CAN bus
+	void SendSYNC();
+
+	/*! \brief Send the RPDO to the CAN bus
+	 *
+	 * @param nodeId CAN node ID
+	 * @param pdo number of the PDO (1..4)
+	 * @param Length CAN Frame Data Length Code (DLC)
+	 * @param Data CAN Frame Data
+	 */
+	void SendRPDO(uint8_t nodeId, unsigned int pdo, WORD Length, const BYTE Data[8]);
+
+	//! Check if the gateway receives PDOs, required by the cyclic process image
+	virtual bool supportsProcessImage() const;
+
+	/*! \brief Add the TPDO to the process image
+	 *
+	 * @param nodeId CAN node ID
+	 * @param pdo number of the PDO (1..4)
+	 */
+	void registerTPDO(uint8_t nodeId, unsigned int pdo);
+
+	/*! \brief Send the SYNC object and wait for all the TPDOs of the process image
+	 *
+	 * Synchronous PDOs of all the nodes are exchanged in a single bus cycle.
+	 */
+	virtual void SyncProcessImage();
+
+	/*! \brief Get the TPDO received in the last SYNC cycle
+	 *
+	 * @param nodeId CAN node ID
+	 * @param pdo number of the PDO (1..4)
+	 */
+	const pdo_buffer_t & getTPDO(uint8_t nodeId, unsigned int pdo) const;
+
 	//! Open device
 	virtual void open() = 0;
 
@@ -26,7 +26,8 @@ namespace canopen {
 
 gateway_socketcan::gateway_socketcan(const std::string & _iface) :
 	iface(_iface), sock(-1),
-	sdo_timeout(boost::posix_time::milliseconds(500))
+	sdo_timeout(boost::posix_time::milliseconds(500)),
+	sync_timeout(boost::posix_time::milliseconds(20))
 {
 	if(iface.length() >= IFNAMSIZ) {
 		BOOST_THROW_EXCEPTION(fe_canopen_error() << reason("name of CAN device too long"));
@@ -75,17 +76,19 @@ void gateway_socketcan::close()
 	device_opened = false;
 }
 
-canid_t gateway_socketcan::readFromWire(struct can_frame & frame)
+canid_t gateway_socketcan::readFromWire(struct can_frame & frame, const boost::system_time & deadline)
 {
 	// Setup for read timeout
 	fd_set rfds;
 	FD_ZERO(&rfds);
 	FD_SET(sock, &rfds);
 
-	// 500ms timeout
+	// Wait no longer than until the deadline of the whole transaction
+	const boost::int64_t remaining = (deadline - boost::get_system_time()).total_microseconds();
+
 	struct timeval tv;
-	tv.tv_sec = 0;
-	tv.tv_usec = 500000;
+	tv.tv_sec = (remaining > 0) ? (remaining / 1000000) : 0;
+	tv.tv_usec = (remaining > 0) ? (remaining % 1000000) : 0;
 
 	// Wait for data with timeout
 	int ret = select(sock+1, &rfds, NULL, NULL, &tv);
@@ -160,6 +163,9 @@ void gateway_socketcan::writeToWire(const struct can_frame & frame)
 
 void gateway_socketcan::handleCanOpenMgmt(const struct can_frame & frame)
 {
+	// keep the process data received while waiting for the SDO reply
+	storeTPDO(frame.can_id, frame.can_dlc, frame.data);
+
 	// TODO: handle general CanOpen management messages
 }
 
@@ -184,7 +190,7 @@ unsigned int gateway_socketcan::ReadObject(WORD *ans, unsigned int ans_len, uint
 	const boost::system_time timeout = boost::get_system_time() + sdo_timeout;
 
 	// wait for reply
-	while(readFromWire(frame) != (0x580 + nodeId)) {
+	while(readFromWire(frame, timeout) != (0x580 + nodeId)) {
 		handleCanOpenMgmt(frame);
 
 		// Check for timeout
@@ -312,7 +318,7 @@ void gateway_socketcan::WriteObject(uint8_t nodeId, WORD index, BYTE subindex, u
 		const boost::system_time timeout = boost::get_system_time() + sdo_timeout;
 
 		// wait for reply
-		while(readFromWire(frame) != (0x580 + nodeId)) {
+		while(readFromWire(frame, timeout) != (0x580 + nodeId)) {
 			handleCanOpenMgmt(frame);
 
 			// Check for timeout
@@ -383,7 +389,7 @@ void gateway_socketcan::InitiateSementedWrite(uint8_t nodeId, WORD index, BYTE s
 		const boost::system_time timeout = boost::get_system_time() + sdo_timeout;
 
 		// wait for reply
-		while(readFromWire(frame) != (0x580 + nodeId)) {
+		while(readFromWire(frame, timeout) != (0x580 + nodeId)) {
 			handleCanOpenMgmt(frame);
 
 			// Check for timeout
@@ -467,7 +473,7 @@ void gateway_socketcan::SegmentedWrite(uint8_t nodeId, BYTE * ptr, std::size_t l
 		const boost::system_time timeout = boost::get_system_time() + sdo_timeout;
 
 		// wait for reply
-		while(readFromWire(frame) != (0x580 + nodeId)) {
+		while(readFromWire(frame, timeout) != (0x580 + nodeId)) {
 			handleCanOpenMgmt(frame);
 
 			// Check for timeout
@@ -543,6 +549,42 @@ void gateway_socketcan::SendCANFrame(WORD Identifier, WORD Length, const BYTE Da
 	writeToWire(frame);
 }
 
+bool gateway_socketcan::supportsProcessImage() const
+{
+	return true;
+}
+
+void gateway_socketcan::SyncProcessImage()
+{
+	// Start a new cycle
+	for (std::map <WORD, pdo_buffer_t>::iterator it = process_image.begin(); it != process_image.end(); ++it) {
+		it->second.updated = false;
+	}
+
+	std::size_t pending = process_image.size();
+
+	SendSYNC();
+
+	// Setup timeout timer
+	const boost::system_time timeout = boost::get_system_time() + sync_timeout;
+
+	// wait for the TPDOs of all the registered nodes
+	while (pending) {
+		struct can_frame frame;
+
+		const canid_t id = readFromWire(frame, timeout);
+
+		if (storeTPDO(id, frame.can_dlc, frame.data)) {
+			--pending;
+		}
+
+		// Check for timeout
+		if (pending && boost::get_system_time() > timeout) {
+			BOOST_THROW_EXCEPTION(fe_canopen_error() << reason("Timeout while waiting for process data"));
+		}
+	}
+}
+
 BYTE gateway_socketcan::getCanID()
 {
 	return 0;
@@ -34,8 +34,13 @@ private:
 	//! write CAN data frame to the network interface
 	void writeToWire(const struct can_frame & frame);
 
-	//! read CAN data frame from the network interface
-	canid_t readFromWire(struct can_frame & frame);
+	/*! \brief read CAN data frame from the network interface
+	 *
+	 * @param frame buffer for the received frame
+	 * @param deadline absolute time after which the read fails with timeout
+	 * @return CAN-ID of the received frame
+	 */
+	canid_t readFromWire(struct can_frame & frame, const boost::system_time & deadline);
 
 	//! handle the CanOpen protocol management messages
 	void handleCanOpenMgmt(const struct can_frame & frame);
@@ -46,6 +51,9 @@ private:
 	//! Timeout for SDO protocol reply
 	const boost::posix_time::time_duration sdo_timeout;
 
+	//! Timeout for the TPDOs replied to the SYNC
+	const boost::posix_time::time_duration sync_timeout;
+
 public:
 	/*! \brief Read Object from the CANopen device, firmware definition 6.3.1.1
 	 *
@@ -90,6 +98,12 @@ public:
 	//! Send CAN frame the the CAN bus
 	void SendCANFrame(WORD Identifier, WORD Length, const BYTE Data[8]);
 
+	//! SocketCAN receives all the frames from the bus, including the PDOs
+	bool supportsProcessImage() const;
+
+	//! Send the SYNC object and wait for all the TPDOs of the process image
+	void SyncProcessImage();
+
 	/*! \brief create new USB CANopen object
 	 *
 	 * @param iface SocketCAN interface to use (i.e. "can0")
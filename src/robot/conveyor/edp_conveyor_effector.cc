@@ -53,6 +53,9 @@ void effector::master_order(common::MT_ORDER nm_task, int nm_tryb)
 effector::effector(common::shell &_shell) :
 		motor_driven_effector(_shell, lib::conveyor::ROBOT_NAME, instruction, reply)
 {
+	// servo_buffer tworzy symulowany interfejs sprzetowy
+	enable_hardware_simulation();
+
 	//  Stworzenie listy dostepnych kinematyk.
 	number_of_servos = lib::conveyor::NUM_OF_SERVOS;
 
@@ -222,10 +222,8 @@ uint8_t NL_regulator_1_conv::compute_set_value(void)
 			break;
 	}
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[0] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[0] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[0] = (float) set_value_new;
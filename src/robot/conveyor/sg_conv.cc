@@ -14,6 +14,7 @@
 #include "robot/conveyor/edp_conveyor_effector.h"
 // Klasa hardware_interface.
 #include "robot/hi_moxa/hi_moxa.h"
+#include "robot/hi_sim/hi_sim.h"
 // Klasa servo_buffer.
 #include "robot/conveyor/sg_conv.h"
 #include "robot/conveyor/regulator_conv.h"
@@ -42,8 +43,11 @@ void servo_buffer::load_hardware_interface(void)
 
 	const std::vector <std::string> ports_vector(mrrocpp::lib::conveyor::ports_strings, mrrocpp::lib::conveyor::ports_strings
 			+ mrrocpp::lib::conveyor::LAST_MOXA_PORT_NUM + 1);
-	hi =
-			new hi_moxa::HI_moxa(master, mrrocpp::lib::conveyor::LAST_MOXA_PORT_NUM, ports_vector, mrrocpp::lib::conveyor::MAX_INCREMENT);
+	if (master.hardware_simulation) {
+		hi = new hi_sim::HI_sim(master, mrrocpp::lib::conveyor::LAST_MOXA_PORT_NUM, axe_inc_per_revolution, synchro_step_coarse);
+	} else {
+		hi = new hi_moxa::HI_moxa(master, mrrocpp::lib::conveyor::LAST_MOXA_PORT_NUM, ports_vector, mrrocpp::lib::conveyor::MAX_INCREMENT);
+	}
 	hi->init();
 
 	// conveyor uruchamia sie jako zsynchronizowany - ustawic parametr na karcie sterownika
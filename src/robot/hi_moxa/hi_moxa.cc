@@ -13,7 +13,12 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
 
 #include "base/lib/periodic_timer.h"
 #include "robot/hi_moxa/hi_moxa.h"
@@ -23,16 +28,43 @@ namespace mrrocpp {
 namespace edp {
 namespace hi_moxa {
 
+namespace {
+
+//! Identifier of the deadline timer in the epoll events; the ports are identified by the drive number
+const uint32_t DEADLINE_EVENT = MOXA_SERVOS_NR;
+
+//! Nanoseconds elapsed between two readings of CLOCK_MONOTONIC
+uint64_t elapsed_ns(const struct timespec & from, const struct timespec & to)
+{
+	return (uint64_t) (to.tv_sec - from.tv_sec) * 1000000000ULL + to.tv_nsec - from.tv_nsec;
+}
+
+} // namespace
+
 HI_moxa::HI_moxa(common::motor_driven_effector &_master, int last_drive_n, std::vector <std::string> ports, const double* max_increments) :
 		common::HardwareInterface(_master),
 		last_drive_number(last_drive_n),
 		port_names(ports),
 		ridiculous_increment(max_increments),
-		ptimer(COMMCYCLE_TIME_NS / 1000000)
+		ptimer(COMMCYCLE_TIME_NS / 1000000),
+		epoll_fd(-1),
+		deadline_fd(-1),
+		receive_attempts(0),
+		error_msg_power_stage(0),
+		error_msg_hardware_panic(0),
+		error_msg_overcurrent(0),
+		status_disp_cnt(0)
 {
 #ifdef T_INFO_FUNC
 	std::cout << "[func] Hi, Moxa!" << std::endl;
 #endif
+	for (std::size_t i = 0; i < MOXA_SERVOS_NR; i++) {
+		fd[i] = -1;
+		bytes_received[i] = READ_BYTES;
+		last_synchro_state[i] = 0;
+		synchro_switch_filter[i] = 0;
+		memset(&comm_stats[i], 0, sizeof(comm_stats[i]));
+	}
 }
 
 HI_moxa::~HI_moxa()
@@ -41,11 +73,30 @@ HI_moxa::~HI_moxa()
 	std::cout << "[func] Bye, Moxa!" << std::endl;
 #endif
 	for (unsigned int i = 0; i <= last_drive_number; i++) {
+		if (comm_stats[i].replies > 0) {
+			std::cout << "[info] drive " << i << "(" << port_names[i].c_str() << "): answers = "
+					<< comm_stats[i].replies << ", timeouts = " << comm_stats[i].timeouts << ", answer time [us] min = "
+					<< comm_stats[i].reply_time_min / 1000 << ", avg = "
+					<< comm_stats[i].reply_time_sum / comm_stats[i].replies / 1000 << ", max = "
+					<< comm_stats[i].reply_time_max / 1000 << std::endl;
+		}
 		if (fd[i] > 0) {
 			tcsetattr(fd[i], TCSANOW, &oldtio[i]);
 			close(fd[i]);
 		}
 	}
+	if (shared_clock && shared_clock->telemetry().wakeups > 0) {
+		const lib::servo_clock_participant & phase = shared_clock->telemetry();
+		std::cout << "[info] servo clock phase error [us]: avg = "
+				<< phase.phase_error_sum / (int64_t) phase.wakeups / 1000 << ", max = " << phase.phase_error_max / 1000
+				<< ", missed ticks = " << phase.missed_ticks << std::endl;
+	}
+	if (deadline_fd >= 0) {
+		close(deadline_fd);
+	}
+	if (epoll_fd >= 0) {
+		close(epoll_fd);
+	}
 }
 
 void HI_moxa::init()
@@ -73,6 +124,14 @@ void HI_moxa::init()
 	}
 	hardware_panic = false;
 
+	// wspolna podstawa czasu z innymi EDP na tym samym wezle, np. przy scislej wspolpracy dwoch robotow
+	if (master.config.exists(lib::SERVO_CLOCK)) {
+		shared_clock.reset(new lib::servo_clock(master.config.value <std::string> (lib::SERVO_CLOCK), master.robot_name, COMMCYCLE_TIME_NS));
+		std::cout << "[info] " << master.robot_name << " locked to servo clock \""
+				<< master.config.value <std::string> (lib::SERVO_CLOCK) << "\""
+				<< (shared_clock->is_master() ? " (master)" : "") << std::endl;
+	}
+
 	// informacja o stanie robota
 	master.controller_state_edp_buf.is_power_on = true;
 	master.controller_state_edp_buf.robot_in_fault_state = false;
@@ -88,6 +147,21 @@ void HI_moxa::init()
 		// domyslnie robot nie jest zsynchronizowany
 		master.controller_state_edp_buf.is_synchronised = false;
 
+		// odpowiedzi napedow i termin ich nadejscia obslugiwane sa jednym epoll
+		epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		deadline_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		if (epoll_fd < 0 || deadline_fd < 0) {
+			throw(std::runtime_error("unable to create epoll descriptors !!!"));
+		}
+
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u32 = DEADLINE_EVENT;
+		if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, deadline_fd, &ev) < 0) {
+			throw(std::runtime_error("unable to register deadline timer !!!"));
+		}
+
 		fd_max = 0;
 		for (unsigned int i = 0; i <= last_drive_number; i++) {
 			std::cout << "[info] opening port : " << port_names[i].c_str();
@@ -123,6 +197,14 @@ void HI_moxa::init()
 			tcflush(fd[i], TCIFLUSH);
 			tcsetattr(fd[i], TCSANOW, &newtio);
 
+			if (fd[i] >= 0) {
+				ev.events = EPOLLIN;
+				ev.data.u32 = i;
+				if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd[i], &ev) < 0) {
+					throw(std::runtime_error("unable to register port in epoll !!!"));
+				}
+			}
+
 			// start driver in MANUAL mode
 			set_parameter(i, hi_moxa::PARAM_DRIVER_MODE, hi_moxa::PARAM_DRIVER_MODE_MANUAL);
 			set_parameter(i, hi_moxa::PARAM_DRIVER_MODE, hi_moxa::PARAM_DRIVER_MODE_MANUAL);
@@ -194,67 +276,133 @@ long int HI_moxa::get_position(int drive_number)
 	return ret;
 }
 
+void HI_moxa::write_commands(void)
+{
+	char frame[WRITE_BYTES + 2];
+
+	for (std::size_t drive_number = 0; drive_number <= last_drive_number; drive_number++) {
+		// spozniona odpowiedz z poprzedniego cyklu rozsynchronizowalaby ramki
+		if (bytes_received[drive_number] < READ_BYTES) {
+			tcflush(fd[drive_number], TCIFLUSH);
+		}
+		// ramka razem z dopelnieniem wysylana jednym wywolaniem
+		memcpy(frame, servo_data[drive_number].buf, WRITE_BYTES);
+		frame[WRITE_BYTES] = ' ';
+		frame[WRITE_BYTES + 1] = ' ';
+		write(fd[drive_number], frame, sizeof(frame));
+	}
+}
+
+bool HI_moxa::read_replies(void)
+{
+	struct timespec start, now;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	struct itimerspec deadline;
+	memset(&deadline, 0, sizeof(deadline));
+	deadline.it_value.tv_sec = start.tv_sec + (start.tv_nsec + REPLY_DEADLINE_NS) / 1000000000L;
+	deadline.it_value.tv_nsec = (start.tv_nsec + REPLY_DEADLINE_NS) % 1000000000L;
+	timerfd_settime(deadline_fd, TFD_TIMER_ABSTIME, &deadline, NULL);
+
+	std::size_t pending = 0;
+	for (std::size_t drive_number = 0; drive_number <= last_drive_number; drive_number++) {
+		bytes_received[drive_number] = 0;
+		if (fd[drive_number] >= 0) {
+			pending++;
+		}
+	}
+
+	struct epoll_event events[MOXA_SERVOS_NR + 1];
+	bool deadline_passed = false;
+
+	while (pending > 0 && !deadline_passed) {
+		int nfds = epoll_wait(epoll_fd, events, MOXA_SERVOS_NR + 1, -1);
+		if (nfds < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error("HI_moxa: epoll_wait() failed");
+		}
+
+		for (int i = 0; i < nfds; i++) {
+			const uint32_t drive_number = events[i].data.u32;
+
+			if (drive_number == DEADLINE_EVENT) {
+				deadline_passed = true;
+				continue;
+			}
+
+			if (bytes_received[drive_number] >= READ_BYTES) {
+				// nadmiarowe bajty po kompletnej odpowiedzi
+				char discard[SERVO_ST_BUF_LEN];
+				read(fd[drive_number], discard, sizeof(discard));
+				continue;
+			}
+
+			ssize_t bytes_read =
+					read(fd[drive_number], (char*) (&(servo_data[drive_number].drive_status))
+							+ bytes_received[drive_number], READ_BYTES - bytes_received[drive_number]);
+			if (bytes_read <= 0) {
+				continue;
+			}
+
+			bytes_received[drive_number] += bytes_read;
+			if (bytes_received[drive_number] == READ_BYTES) {
+				pending--;
+
+				clock_gettime(CLOCK_MONOTONIC, &now);
+				const uint64_t reply_time = elapsed_ns(start, now);
+				drive_comm_stats & stats = comm_stats[drive_number];
+				stats.reply_time_last = reply_time;
+				if (stats.replies == 0 || reply_time < stats.reply_time_min) {
+					stats.reply_time_min = reply_time;
+				}
+				if (reply_time > stats.reply_time_max) {
+					stats.reply_time_max = reply_time;
+				}
+				stats.reply_time_sum += reply_time;
+				stats.replies++;
+				stats.consecutive_timeouts = 0;
+			}
+		}
+	}
+
+	if (deadline_passed) {
+		uint64_t expirations;
+		read(deadline_fd, &expirations, sizeof(expirations));
+	} else {
+		// wszystkie odpowiedzi przed terminem, timer zatrzymany
+		memset(&deadline, 0, sizeof(deadline));
+		timerfd_settime(deadline_fd, 0, &deadline, NULL);
+	}
+
+	for (std::size_t drive_number = 0; drive_number <= last_drive_number; drive_number++) {
+		if (bytes_received[drive_number] < READ_BYTES) {
+			comm_stats[drive_number].timeouts++;
+			comm_stats[drive_number].consecutive_timeouts++;
+		}
+	}
+
+	return (pending == 0);
+}
+
 uint64_t HI_moxa::read_write_hardware(void)
 {
-	static int64_t receive_attempts = 0;
-	// UNUSED: static int64_t receive_timeouts = 0;
-	static int error_msg_power_stage = 0;
-	static int error_msg_hardware_panic = 0;
-	static int error_msg_overcurrent = 0;
-	static int last_synchro_state[] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-	static int comm_timeouts[] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-	static int synchro_switch_filter[] = { 0, 0, 0, 0, 0, 0, 0, 0 };
 	const int synchro_switch_filter_th = 2;
 	bool robot_synchronized = true;
 	bool power_fault;
 	bool hardware_read_ok = true;
 	bool all_hardware_read = true;
-	std::size_t bytes_received[MOXA_SERVOS_NR];
-	// UNUSED:  fd_set rfds;
 	uint64_t ret = 0;
 	uint8_t drive_number;
-	static int status_disp_cnt = 0;
 
 	// test mode
 	if (master.robot_test_mode) {
-		ptimer.sleep();
+		wait_for_next_cycle();
 
 		return ret;
 	} // end test mode
 
-	/* YOYKA
-	 if (hardware_panic) {
-
-	 if (error_msg_hardware_panic < 10) {
-	 for (drive_number = 0; drive_number <= last_drive_number; drive_number++)
-	 set_parameter(drive_number, PARAM_DRIVER_MODE, PARAM_DRIVER_MODE_ERROR);
-	 }
-
-	 if (error_msg_hardware_panic == 0) {
-	 master.msg->message(lib::FATAL_ERROR, "Hardware panic");
-	 std::cout << "[error] hardware panic" << std::endl;
-
-	 }
-	 error_msg_hardware_panic++;
-	 ptimer.sleep();
-	 return ret;
-	 }
-	 */
-	/* OLD
-	 if (hardware_panic) {
-	 for (drive_number = 0; drive_number <= last_drive_number; drive_number++)
-	 set_parameter(drive_number, PARAM_DRIVER_MODE, PARAM_DRIVER_MODE_ERROR);
-
-	 if (error_msg_hardware_panic == 0) {
-	 master.msg->message(lib::FATAL_ERROR, "Hardware panic");
-	 std::cout << "[error] hardware panic" << std::endl;
-	 error_msg_hardware_panic++;
-	 }
-	 ptimer.sleep();
-	 return ret;
-	 }
-	 */
-
 	// If Hardware Panic, send PARAM_DRIVER_MODE_ERROR to motor drivers
 	if (hardware_panic) {
 		for (drive_number = 0; drive_number <= last_drive_number; drive_number++) {
@@ -266,54 +414,27 @@ uint64_t HI_moxa::read_write_hardware(void)
 			std::cout << "[error] hardware panic" << std::endl;
 			error_msg_hardware_panic++;
 		}
-		//	ptimer.sleep();
-		//	return ret;
 	} else {
-		for (drive_number = 0; drive_number <= last_drive_number; drive_number++) {
-			//	write(fd[drive_number], "  ", 2);
-			write(fd[drive_number], servo_data[drive_number].buf, WRITE_BYTES);
-			write(fd[drive_number], "  ", 2);
-			bytes_received[drive_number] = 0;
-		}
+		write_commands();
 	}
 
 	receive_attempts++;
 
-	struct timespec delay;
-	delay.tv_nsec = 500000;
-	delay.tv_sec = 0;
+	all_hardware_read = read_replies();
 
-	nanosleep(&delay, NULL);
-
-	// Tu kiedys byl SELECT
-
-	// If Hardware Panic, read answers received from motors drivers, wait till the end of comm cycle and return.
+	// If Hardware Panic, answers received from motors drivers are dropped, wait till the end of comm cycle and return.
 	if (hardware_panic) {
-		for (drive_number = 0; drive_number <= last_drive_number; drive_number++) {
-			bytes_received[drive_number] =
-					read(fd[drive_number], (char*) (&(servo_data[drive_number].drive_status)), READ_BYTES);
-		}
-		ptimer.sleep();
+		wait_for_next_cycle();
 		return ret;
 	}
 
-	all_hardware_read = true;
-	for (drive_number = 0; drive_number <= last_drive_number; drive_number++) {
-		bytes_received[drive_number] =
-				read(fd[drive_number], (char*) (&(servo_data[drive_number].drive_status)), READ_BYTES);
-		if (bytes_received[drive_number] < READ_BYTES) {
-			comm_timeouts[drive_number]++;
-			if (all_hardware_read) {
-				all_hardware_read = false;
-				std::cout << "[error] timeout in " << (int) receive_attempts << " communication cycle on drives";
+	if (!all_hardware_read) {
+		std::cout << "[error] timeout in " << (int) receive_attempts << " communication cycle on drives";
+		for (drive_number = 0; drive_number <= last_drive_number; drive_number++) {
+			if (bytes_received[drive_number] < READ_BYTES) {
+				std::cout << " " << (int) drive_number << "(" << port_names[drive_number].c_str() << ")";
 			}
-			std::cout << " " << (int) drive_number << "(" << port_names[drive_number].c_str() << ")";
 		}
-	}
-	if (all_hardware_read) {
-		for (drive_number = 0; drive_number <= last_drive_number; drive_number++)
-			comm_timeouts[drive_number] = 0;
-	} else {
 		std::cout << std::endl;
 		hardware_read_ok = false;
 	}
@@ -382,7 +503,7 @@ uint64_t HI_moxa::read_write_hardware(void)
 		}
 
 		// Wykrywanie sekwencji timeoutow komunikacji
-		if (comm_timeouts[drive_number] >= MAX_COMM_TIMEOUTS) {
+		if (comm_stats[drive_number].consecutive_timeouts >= MAX_COMM_TIMEOUTS) {
 			hardware_panic = true;
 			std::stringstream temp_message;
 			temp_message << "[error] multiple communication timeouts on drive " << (int) drive_number << "("
@@ -425,6 +546,19 @@ uint64_t HI_moxa::read_write_hardware(void)
 	}
 
 	if (status_disp_cnt++ == STATUS_DISP_T) {
+#ifdef T_INFO_CALC
+		std::cout << "[info] answer time [us]:";
+		for (drive_number = 0; drive_number <= last_drive_number; drive_number++) {
+			std::cout << " " << comm_stats[drive_number].reply_time_last / 1000 << "/"
+					<< comm_stats[drive_number].reply_time_max / 1000;
+		}
+		std::cout << std::endl;
+		if (shared_clock) {
+			const lib::servo_clock_participant & phase = shared_clock->telemetry();
+			std::cout << "[info] servo clock phase error [us]: " << phase.phase_error_last / 1000 << "/"
+					<< phase.phase_error_max / 1000 << ", missed ticks = " << phase.missed_ticks << std::endl;
+		}
+#endif
 		// UNUSED: const int disp_drv_no = 0;
 		//		std::cout << "[info]";
 		//		std::cout << " sw1_sw2_swSynchr = " << (int) servo_data[disp_drv_no].drive_status.sw1 << "," << (int) servo_data[disp_drv_no].drive_status.sw2 << "," << (int) servo_data[disp_drv_no].drive_status.swSynchr;
@@ -445,11 +579,20 @@ uint64_t HI_moxa::read_write_hardware(void)
 		status_disp_cnt = 0;
 	}
 
-	ptimer.sleep();
+	wait_for_next_cycle();
 
 	return ret;
 }
 
+void HI_moxa::wait_for_next_cycle(void)
+{
+	if (shared_clock) {
+		shared_clock->sleep();
+	} else {
+		ptimer.sleep();
+	}
+}
+
 int HI_moxa::set_parameter(int drive_number, const int parameter, uint32_t new_value)
 {
 	char tx_buf[SERVO_ST_BUF_LEN];
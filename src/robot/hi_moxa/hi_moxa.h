@@ -13,6 +13,8 @@
 #include <vector>
 #include <stdint.h>
 
+#include <boost/scoped_ptr.hpp>
+
 // // // // // // // //
 // TERMINAL INFO
 //#define T_INFO_FUNC
@@ -21,6 +23,7 @@
 #define STATUS_DISP_T 100
 
 #include "base/lib/periodic_timer.h"
+#include "base/lib/servo_clock.h"
 #include "base/edp/HardwareInterface.h"
 #include "robot/hi_moxa/hi_moxa_combuf.h"
 
@@ -41,6 +44,25 @@ const int FIRST_HARDWARE_READS_WITH_ZERO_INCREMENT = 4;
 const int VOLTAGE = 48.0;
 
 const unsigned long COMMCYCLE_TIME_NS = 2000000;
+/// deadline for the answers of the drives, counted from the end of the writes
+const unsigned long REPLY_DEADLINE_NS = 500000;
+
+/*!
+ * @brief communication statistics of a single drive
+ */
+struct drive_comm_stats
+{
+	/// number of complete answers
+	uint64_t replies;
+	/// number of cycles without a complete answer
+	uint64_t timeouts;
+	/// number of consecutive cycles without a complete answer
+	int consecutive_timeouts;
+	/// answer time of the last, the fastest and the slowest answer (ns)
+	uint64_t reply_time_last, reply_time_min, reply_time_max;
+	/// sum of the answer times, for the average (ns)
+	uint64_t reply_time_sum;
+};
 
 /*!
  * @brief hardware interface class
@@ -101,7 +123,7 @@ public:
 	/**
 	 * @brief do communication cycle
 	 * sends data in communication buffer to motor controllers,
-	 * waits 500us for answers from controllers,
+	 * collects answers from controllers as they arrive, at most REPLY_DEADLINE_NS,
 	 * writes received data to communication buffer.
 	 */
 	virtual uint64_t read_write_hardware(void);
@@ -174,6 +196,46 @@ private:
 
 	/// periodic timer used for generating read_write_hardware time base
 	lib::periodic_timer ptimer;
+	/// time base shared with the co-located EDPs, used instead of ptimer if configured
+	boost::scoped_ptr <lib::servo_clock> shared_clock;
+
+	/// epoll descriptor waiting for the answers on all ports and for the deadline
+	int epoll_fd;
+	/// timer descriptor signalling the deadline of the answers
+	int deadline_fd;
+	/// number of bytes of the answer received in the current cycle
+	std::size_t bytes_received[MOXA_SERVOS_NR];
+	/// communication statistics of the drives
+	drive_comm_stats comm_stats[MOXA_SERVOS_NR];
+
+	/// number of the communication cycle
+	int64_t receive_attempts;
+	/// error messages already reported
+	int error_msg_power_stage, error_msg_hardware_panic, error_msg_overcurrent;
+	/// synchronization state of the drives in the previous cycle
+	int last_synchro_state[MOXA_SERVOS_NR];
+	/// number of consecutive cycles with the synchronization switch on
+	int synchro_switch_filter[MOXA_SERVOS_NR];
+	/// cycles since the last status display
+	int status_disp_cnt;
+
+	/**
+	 * @brief send the communication buffers to all drives, one write per port
+	 * the input of the ports which did not answer in the previous cycle is flushed first
+	 */
+	void write_commands(void);
+	/**
+	 * @brief collect the answers of the drives
+	 * waits for readiness of the ports until all answers are complete or REPLY_DEADLINE_NS passes,
+	 * updates bytes_received and comm_stats
+	 * @return true if all drives answered
+	 */
+	bool read_replies(void);
+	/**
+	 * @brief wait for the beginning of the next communication cycle
+	 * of the shared servo clock, if configured, or of the local periodic timer
+	 */
+	void wait_for_next_cycle(void);
 };
 // endof: class hardware_interface
 
@@ -0,0 +1,316 @@
+/*
+ * hi_sim.cc
+ *
+ *  Simulated motors, gearboxes and encoders in place of the motor controllers.
+ */
+
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+#include <sstream>
+#include <iostream>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include "robot/hi_sim/hi_sim.h"
+#include "robot/hi_moxa/hi_moxa_combuf.h"
+#include "base/edp/servo_gr.h"
+#include "base/edp/edp_e_motor_driven.h"
+
+namespace mrrocpp {
+namespace edp {
+namespace hi_sim {
+
+namespace {
+
+//! Number of the encoder revolution containing a given count, rounded towards minus infinity
+long int revolution_of(long int count, long int period)
+{
+	return (count >= 0) ? count / period : -((-count - 1) / period) - 1;
+}
+
+} // namespace
+
+HI_sim::HI_sim(common::motor_driven_effector &_master, int last_drive_n, const double* inc_per_revolution, const double* synchro_step_coarse) :
+		common::HardwareInterface(_master), last_drive_number(last_drive_n)
+{
+	if (last_drive_number >= SIM_SERVOS_NR) {
+		throw std::runtime_error("HI_sim: too many drives");
+	}
+
+	for (std::size_t i = 0; i <= last_drive_number; i++) {
+		memset(&model[i], 0, sizeof(model[i]));
+		model[i].inc_per_revolution = inc_per_revolution[i];
+		synchro_direction[i] = (synchro_step_coarse[i] < 0) ? -1.0 : 1.0;
+	}
+}
+
+void HI_sim::read_model_parameter(const std::string & key, double default_value, std::vector <double> & values) const
+{
+	values.assign(last_drive_number + 1, default_value);
+
+	if (!master.config.exists(key)) {
+		return;
+	}
+
+	std::string text_value = master.config.value <std::string>(key);
+	boost::algorithm::trim(text_value);
+
+	if (text_value.empty() || text_value[0] != '[') {
+		// jedna wartosc dla wszystkich napedow
+		values.assign(last_drive_number + 1, master.config.value <double>(key));
+		return;
+	}
+
+	boost::algorithm::trim_if(text_value, boost::algorithm::is_any_of("[]"));
+	std::istringstream stream(text_value);
+	for (std::size_t i = 0; i <= last_drive_number; i++) {
+		if (!(stream >> values[i])) {
+			throw std::runtime_error("HI_sim: too few values of parameter \"" + key + "\"");
+		}
+	}
+}
+
+void HI_sim::init()
+{
+	if (!master.sim_clock) {
+		throw std::runtime_error("HI_sim: no virtual time base");
+	}
+
+	// domyslne parametry: silnik ok. 100W z przekladnia 1:100
+	std::vector <double> resistance, inductance, torque_constant, motor_inertia, load_inertia, gear_ratio,
+			viscous_friction, coulomb_friction, synchro_switch;
+
+	read_model_parameter("sim_resistance", 1.0, resistance);
+	read_model_parameter("sim_inductance", 0.0005, inductance);
+	read_model_parameter("sim_torque_constant", 0.05, torque_constant);
+	read_model_parameter("sim_motor_inertia", 2.0e-5, motor_inertia);
+	read_model_parameter("sim_load_inertia", 0.2, load_inertia);
+	read_model_parameter("sim_gear_ratio", 100.0, gear_ratio);
+	read_model_parameter("sim_viscous_friction", 2.0e-5, viscous_friction);
+	read_model_parameter("sim_coulomb_friction", 0.01, coulomb_friction);
+	read_model_parameter("sim_synchro_switch", 0.25, synchro_switch);
+
+	for (std::size_t i = 0; i <= last_drive_number; i++) {
+		model[i].resistance = resistance[i];
+		model[i].inductance = inductance[i];
+		model[i].torque_constant = torque_constant[i];
+		model[i].motor_inertia = motor_inertia[i];
+		model[i].load_inertia = load_inertia[i];
+		model[i].gear_ratio = gear_ratio[i];
+		model[i].viscous_friction = viscous_friction[i];
+		model[i].coulomb_friction = coulomb_friction[i];
+		model[i].max_current = 10.0;
+		// wylacznik synchronizacji po stronie, w ktora odbywa sie ruch synchronizacji
+		model[i].synchro_switch = synchro_direction[i] * fabs(synchro_switch[i]);
+
+		if (model[i].resistance <= 0 || model[i].inductance <= 0 || model[i].motor_inertia + model[i].load_inertia
+				<= 0 || model[i].gear_ratio <= 0) {
+			throw std::runtime_error("HI_sim: invalid model parameters");
+		}
+
+		memset(&state[i], 0, sizeof(state[i]));
+	}
+
+	hardware_panic = false;
+
+	// informacja o stanie robota, jak po wlaczeniu sterownikow
+	master.controller_state_edp_buf.is_synchronised = false;
+	master.controller_state_edp_buf.is_power_on = true;
+	master.controller_state_edp_buf.robot_in_fault_state = false;
+
+	std::cout << "[info] " << master.robot_name << " hardware simulation, speed = ";
+	if (master.sim_clock->get_speed() == 0) {
+		std::cout << "unthrottled" << std::endl;
+	} else {
+		std::cout << master.sim_clock->get_speed() << "x real time" << std::endl;
+	}
+
+	reset_counters();
+}
+
+void HI_sim::insert_set_value(int drive_number, double set_value)
+{
+	state[drive_number].set_value = set_value;
+}
+
+int HI_sim::get_current(int drive_number)
+{
+	return (int) (state[drive_number].current * 1000.0);
+}
+
+float HI_sim::get_voltage(int drive_number)
+{
+	return VOLTAGE;
+}
+
+double HI_sim::get_increment(int drive_number)
+{
+	return (double) (state[drive_number].count - state[drive_number].previous_count);
+}
+
+long int HI_sim::get_position(int drive_number)
+{
+	return state[drive_number].count - state[drive_number].position_offset;
+}
+
+void HI_sim::simulate_drive(std::size_t drive_number)
+{
+	const drive_model & m = model[drive_number];
+	drive_state & s = state[drive_number];
+
+	const double h = COMMCYCLE_TIME_NS * 1.0e-9 / MODEL_SUBSTEPS;
+	const double inertia = m.motor_inertia + m.load_inertia / (m.gear_ratio * m.gear_ratio);
+	const double counts_per_radian = m.inc_per_revolution / (2 * M_PI);
+	const long int index_period = (long int) floor(m.inc_per_revolution + 0.5);
+
+	// po awarii sterowniki wylaczaja stopnie mocy
+	double set_value = hardware_panic ? 0.0 : s.set_value;
+	if (set_value > MAX_SET_VALUE) {
+		set_value = MAX_SET_VALUE;
+	} else if (set_value < -MAX_SET_VALUE) {
+		set_value = -MAX_SET_VALUE;
+	}
+	const double voltage = set_value / MAX_SET_VALUE * VOLTAGE;
+
+	for (int k = 0; k < MODEL_SUBSTEPS; k++) {
+		// obwod twornika, schemat niejawny stabilny dla dowolnej stalej czasowej
+		s.current = (s.current + h / m.inductance * (voltage - m.torque_constant * s.velocity)) / (1.0 + h
+				* m.resistance / m.inductance);
+		if (s.current > m.max_current) {
+			s.current = m.max_current;
+		} else if (s.current < -m.max_current) {
+			s.current = -m.max_current;
+		}
+
+		const double motor_torque = m.torque_constant * s.current;
+
+		// tarcie statyczne trzyma nieruchomy wal
+		if (s.velocity == 0 && fabs(motor_torque) <= m.coulomb_friction) {
+			continue;
+		}
+
+		const double direction = (s.velocity != 0) ? ((s.velocity > 0) ? 1.0 : -1.0) : ((motor_torque > 0) ? 1.0 : -1.0);
+		double velocity = (s.velocity + h / inertia * (motor_torque - m.coulomb_friction * direction)) / (1.0 + h
+				* m.viscous_friction / inertia);
+		// tarcie moze zatrzymac wal, ale nie zmienia kierunku ruchu
+		if (velocity * direction < 0) {
+			velocity = 0;
+		}
+		s.velocity = velocity;
+		s.angle += h * velocity;
+
+		const long int count = (long int) floor(s.angle * counts_per_radian);
+
+		// impuls zera enkodera raz na obrot walu silnika
+		if (s.synchro_requested && !in_synchro_area(drive_number) && index_period > 0) {
+			if (revolution_of(s.count, index_period) != revolution_of(count, index_period)) {
+				s.synchro_zero = true;
+				s.synchronized = true;
+			}
+		}
+
+		s.count = count;
+	}
+}
+
+uint64_t HI_sim::read_write_hardware(void)
+{
+	uint64_t ret = 0;
+	bool robot_synchronized = true;
+
+	for (std::size_t drive_number = 0; drive_number <= last_drive_number; drive_number++) {
+		drive_state & s = state[drive_number];
+
+		s.synchro_zero = false;
+		s.previous_count = s.count;
+
+		simulate_drive(drive_number);
+
+		if (in_synchro_area(drive_number)) {
+			ret |= (uint64_t) (common::SYNCHRO_SWITCH_ON << (5 * (drive_number))); // Zadzialal wylacznik synchronizacji
+		}
+		if (s.synchro_zero) {
+			ret |= (uint64_t) (common::SYNCHRO_ZERO << (5 * (drive_number))); // Impuls zera rezolwera
+		}
+		if (!s.synchronized) {
+			robot_synchronized = false;
+		}
+	}
+
+	master.controller_state_edp_buf.is_synchronised = robot_synchronized;
+
+	// koniec cyklu komunikacji w czasie wirtualnym
+	master.sim_clock->advance(COMMCYCLE_TIME_NS);
+
+	return ret;
+}
+
+int HI_sim::set_parameter(int drive_number, const int parameter, uint32_t new_value)
+{
+	switch (parameter)
+	{
+		case hi_moxa::PARAM_MAXCURRENT:
+			// ograniczenie pradu w mA
+			model[drive_number].max_current = new_value / 1000.0;
+			break;
+		case hi_moxa::PARAM_SYNCHRONIZED:
+			state[drive_number].synchronized = (new_value != 0);
+			break;
+		default:
+			// pozostale parametry dotycza regulatorow sterownika, ktorych model nie obejmuje
+			break;
+	}
+	return 0;
+}
+
+void HI_sim::reset_counters(void)
+{
+	for (std::size_t i = 0; i <= last_drive_number; i++) {
+		reset_position(i);
+	}
+}
+
+void HI_sim::start_synchro(int drive_number)
+{
+	state[drive_number].synchro_requested = true;
+}
+
+void HI_sim::finish_synchro(int drive_number)
+{
+	state[drive_number].synchro_requested = false;
+}
+
+bool HI_sim::in_synchro_area(int drive_number)
+{
+	const drive_model & m = model[drive_number];
+	const double switch_count = m.synchro_switch * m.inc_per_revolution;
+
+	return ((state[drive_number].count - switch_count) * synchro_direction[drive_number] >= 0);
+}
+
+bool HI_sim::robot_synchronized()
+{
+	for (std::size_t i = 0; i <= last_drive_number; i++) {
+		if (!state[i].synchronized) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool HI_sim::is_impulse_zero(int drive_number)
+{
+	return state[drive_number].synchro_zero;
+}
+
+void HI_sim::reset_position(int drive_number)
+{
+	state[drive_number].position_offset = state[drive_number].count;
+	state[drive_number].previous_count = state[drive_number].count;
+}
+
+} // namespace hi_sim
+} // namespace edp
+} // namespace mrrocpp
@@ -0,0 +1,203 @@
+/*
+ * hi_sim.h
+ *
+ *  Simulated motors, gearboxes and encoders in place of the motor controllers.
+ */
+
+#ifndef __HI_SIM_H
+#define __HI_SIM_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "base/edp/HardwareInterface.h"
+
+namespace mrrocpp {
+namespace edp {
+namespace common {
+class motor_driven_effector;
+}
+namespace hi_sim {
+
+const std::size_t SIM_SERVOS_NR = 8;
+
+/// period of the simulated communication cycle, the same as of the motor controllers
+const unsigned long COMMCYCLE_TIME_NS = 2000000;
+/// number of integration steps of the motor model per communication cycle
+const int MODEL_SUBSTEPS = 20;
+
+/// supply voltage of the power stages
+const double VOLTAGE = 48.0;
+/// set value corresponding to the full supply voltage
+const double MAX_SET_VALUE = 255.0;
+
+/*!
+ * @brief parameters of a simulated drive: DC motor, gearbox and incremental encoder
+ * all values refer to the motor shaft, the load inertia is reduced by the gear ratio
+ */
+struct drive_model
+{
+	/// armature resistance [Ohm]
+	double resistance;
+	/// armature inductance [H]
+	double inductance;
+	/// torque constant [Nm/A], equal to the back-EMF constant [Vs/rad]
+	double torque_constant;
+	/// inertia of the rotor [kgm^2]
+	double motor_inertia;
+	/// inertia of the load on the output shaft of the gearbox [kgm^2]
+	double load_inertia;
+	/// ratio of the gearbox (motor revolutions per output revolution)
+	double gear_ratio;
+	/// viscous friction [Nms/rad]
+	double viscous_friction;
+	/// Coulomb friction [Nm]
+	double coulomb_friction;
+	/// current limit of the power stage [A]
+	double max_current;
+	/// encoder increments per motor revolution
+	double inc_per_revolution;
+	/// position of the edge of the synchronization switch (motor revolutions from the start, signed)
+	double synchro_switch;
+};
+
+/*!
+ * @brief state of a simulated drive
+ */
+struct drive_state
+{
+	/// set value of the power stage
+	double set_value;
+	/// armature current [A]
+	double current;
+	/// motor velocity [rad/s]
+	double velocity;
+	/// motor angle from the start [rad]
+	double angle;
+	/// encoder count at the last reset of the position
+	long int position_offset;
+	/// encoder count in the current and in the previous cycle
+	long int count, previous_count;
+	/// 'synchro zero' search requested
+	bool synchro_requested;
+	/// 'synchro zero' found in the current cycle
+	bool synchro_zero;
+	/// drive synchronized
+	bool synchronized;
+};
+
+/*!
+ * @brief hardware interface simulating the drives of a servo_buffer driven robot
+ *
+ * Every cycle integrates the motor models over the communication period
+ * and advances the virtual time base of the effector, so the servo loop,
+ * and the threads paced by the virtual time, run at a configured multiple of the real time
+ * or as fast as possible. Only the latter is repeatable: the servo loop then stops
+ * between the commands instead of stepping idle (see servo_buffer::wait_for_command_if_idle()).
+ *
+ * @ingroup edp
+ */
+class HI_sim : public common::HardwareInterface
+{
+
+public:
+	/**
+	 * @brief constructor
+	 * @param &_master				master effector
+	 * @param last_drive_n			(number of drives)-1
+	 * @param inc_per_revolution	tab of encoder increments per motor revolution
+	 * @param synchro_step_coarse	tab of synchronization steps, their signs give the side of the synchronization switches
+	 */
+	HI_sim(common::motor_driven_effector &_master, int last_drive_n, const double* inc_per_revolution, const double* synchro_step_coarse);
+	/**
+	 * @brief initialization of hardware interface
+	 * reads the parameters of the models from the configuration
+	 */
+	virtual void init();
+	/**
+	 * @brief set the pwm of the drive for the next cycle
+	 */
+	virtual void insert_set_value(int drive_number, double set_value);
+	/**
+	 * @brief motor current [mA]
+	 */
+	virtual int get_current(int drive_number);
+	/**
+	 * @brief supply voltage of the drive
+	 */
+	virtual float get_voltage(int drive_number);
+	/**
+	 * @brief encoder increment in the last cycle
+	 */
+	virtual double get_increment(int drive_number);
+	/**
+	 * @brief encoder position
+	 */
+	virtual long int get_position(int drive_number);
+	/**
+	 * @brief do communication cycle
+	 * integrates the models over the cycle, advances the virtual time
+	 */
+	virtual uint64_t read_write_hardware(void);
+	/**
+	 * @brief set parameter of the drive, only the current limit is simulated
+	 */
+	virtual int set_parameter(int drive_number, const int parameter, uint32_t new_value);
+	/**
+	 * @brief reset all motor positions and position increments
+	 */
+	virtual void reset_counters(void);
+	/**
+	 * @brief start looking for the 'synchro zero' signal
+	 */
+	virtual void start_synchro(int drive_number);
+	/**
+	 * @brief finish synchronization procedure
+	 */
+	virtual void finish_synchro(int drive_number);
+	/**
+	 * @brief 'in synchro area' flag
+	 */
+	virtual bool in_synchro_area(int drive_number);
+	/**
+	 * @brief 'all drives synchronized' flag
+	 */
+	virtual bool robot_synchronized();
+	/**
+	 * @brief 'is impulse zero' flag
+	 */
+	virtual bool is_impulse_zero(int drive_number);
+	/**
+	 * @brief reset motor position
+	 */
+	virtual void reset_position(int drive_number);
+
+private:
+	/// (number of drives)-1
+	const std::size_t last_drive_number;
+	/// parameters of the drives
+	drive_model model[SIM_SERVOS_NR];
+	/// state of the drives
+	drive_state state[SIM_SERVOS_NR];
+	/// signs of the synchronization moves
+	double synchro_direction[SIM_SERVOS_NR];
+
+	/**
+	 * @brief per-drive configuration value: a scalar for all drives or [v0 v1 ...]
+	 * @param key				configuration key
+	 * @param default_value	value used if the key does not exist
+	 * @param values			place for the values of the drives
+	 */
+	void read_model_parameter(const std::string & key, double default_value, std::vector <double> & values) const;
+	/**
+	 * @brief integrate the model of a drive over a communication cycle
+	 */
+	void simulate_drive(std::size_t drive_number);
+};
+
+} // namespace hi_sim
+} // namespace edp
+} // namespace mrrocpp
+
+#endif // __HI_SIM_H
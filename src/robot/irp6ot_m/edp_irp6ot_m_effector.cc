@@ -70,6 +70,9 @@ void effector::create_threads()
 effector::effector(common::shell &_shell) :
 	manip_effector(_shell, lib::irp6ot_m::ROBOT_NAME, instruction, reply)
 {
+	// servo_buffer tworzy symulowany interfejs sprzetowy
+	enable_hardware_simulation();
+
 	number_of_servos = lib::irp6ot_m::NUM_OF_SERVOS;
 
 	//  Stworzenie listy dostepnych kinematyk.
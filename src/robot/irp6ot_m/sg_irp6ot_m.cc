@@ -20,6 +20,7 @@
 // Klasa hardware_interface.
 //#include "robot/irp6p_m/hi_irp6p_m.h"
 #include "robot/hi_moxa/hi_moxa.h"
+#include "robot/hi_sim/hi_sim.h"
 // Klasa servo_buffer.
 #include "robot/irp6ot_m/sg_irp6ot_m.h"
 #include "robot/irp6ot_m/regulator_irp6ot_m.h"
@@ -59,8 +60,11 @@ void servo_buffer::load_hardware_interface(void)
 {
 	const std::vector <std::string> ports_vector(mrrocpp::lib::irp6ot_m::ports_strings, mrrocpp::lib::irp6ot_m::ports_strings
 			+ mrrocpp::lib::irp6ot_m::LAST_MOXA_PORT_NUM + 1);
-	hi =
-			new hi_moxa::HI_moxa(master, mrrocpp::lib::irp6ot_m::LAST_MOXA_PORT_NUM, ports_vector, mrrocpp::lib::irp6ot_m::MAX_INCREMENT);
+	if (master.hardware_simulation) {
+		hi = new hi_sim::HI_sim(master, mrrocpp::lib::irp6ot_m::LAST_MOXA_PORT_NUM, axe_inc_per_revolution, synchro_step_coarse);
+	} else {
+		hi = new hi_moxa::HI_moxa(master, mrrocpp::lib::irp6ot_m::LAST_MOXA_PORT_NUM, ports_vector, mrrocpp::lib::irp6ot_m::MAX_INCREMENT);
+	}
 	hi->init();
 
 	hi->set_parameter(0, hi_moxa::PARAM_MAXCURRENT, mrrocpp::lib::irp6ot_m::MAX_CURRENT_0);
@@ -40,6 +40,9 @@ effector::effector(common::shell &_shell) :
 		motor_driven_effector(_shell, lib::irp6ot_tfg::ROBOT_NAME, instruction, reply)
 {
 
+	// servo_buffer tworzy symulowany interfejs sprzetowy
+	enable_hardware_simulation();
+
 	number_of_servos = lib::irp6ot_tfg::NUM_OF_SERVOS;
 
 	//  Stworzenie listy dostepnych kinematyk.
@@ -360,10 +360,8 @@ uint8_t NL_regulator_8_irp6ot::compute_set_value(void)
 	 */
 
 	//   if (set_value_new!=0.0) printf ("aa: %f\n", set_value_new);
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[0] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[0] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[0] = (float) set_value_new;
@@ -79,6 +79,9 @@ effector::effector(common::shell &_shell) :
 		manip_effector(_shell, lib::irp6p_m::ROBOT_NAME, instruction, reply)
 {
 
+	// servo_buffer tworzy symulowany interfejs sprzetowy
+	enable_hardware_simulation();
+
 	number_of_servos = lib::irp6p_m::NUM_OF_SERVOS;
 	//  Stworzenie listy dostepnych kinematyk.
 	create_kinematic_models_for_given_robot();
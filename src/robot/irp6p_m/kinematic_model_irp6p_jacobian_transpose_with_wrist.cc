@@ -28,10 +28,11 @@ model_jacobian_transpose_with_wrist::model_jacobian_transpose_with_wrist(int _nu
 
 }
 
-void model_jacobian_transpose_with_wrist::inverse_kinematics_transform(lib::JointArray & local_desired_joints, lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame)
+void model_jacobian_transpose_with_wrist::inverse_kinematics_transform(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame)
 {
 	const double K = 0.1; //Zadane wzmocnienie - od (0) do (1), w modelu transponowanym zalecane ponizej jedynki
 	const double E = 0.00001; //Max, wartosc uchybu dla ktorego rozwiazanie zaakceptowane
+	const unsigned int MAX_ITERATIONS = 1000; //Ograniczenie liczby iteracji (czas obliczen w kroku EDP)
 
 	lib::Homog_matrix local_current_end_effector_frame; //Ramka odpowiadajaca aktualnej pozycji
 	lib::Xyz_Angle_Axis_vector desired_distance_new; //odleglosc do pokonania
@@ -57,7 +58,7 @@ void model_jacobian_transpose_with_wrist::inverse_kinematics_transform(lib::Join
 	//Wzmocnienie
 	desired_distance_new *= K;
 
-	while (fabs(Max) > E) {
+	for (unsigned int iteration = 0; (fabs(Max) > E) && (iteration < MAX_ITERATIONS); ++iteration) {
 
 		//Wzory na jakobian dla Irp-6 o 6 stopniach swobody
 		jacobian_new.irp6_6dof_equations(current_joints);
@@ -68,11 +69,11 @@ void model_jacobian_transpose_with_wrist::inverse_kinematics_transform(lib::Join
 		//Wyliczenie przyrostu zmiennych przegubowych
 		delta_q = jacobian_new * desired_distance_new;
 		current_joints += delta_q;
-		current_joints.to_table(&local_current_joints[0]);
+		current_joints.to_table(&local_desired_joints[0]);
 
 		//wyliczenie prostego zadania kinematyki dla nowo wyliczonej konfiguracji
 		attached_tool_computations = false;
-		i2e_transform(local_current_joints, local_current_end_effector_frame);
+		i2e_transform(local_desired_joints, local_current_end_effector_frame);
 		attached_tool_computations = true;
 
 		//Wyliczenie uchybu pozycji dla zadanej tymczasowej i porzadanej ramki
@@ -82,9 +83,7 @@ void model_jacobian_transpose_with_wrist::inverse_kinematics_transform(lib::Join
 		desired_distance_new *= K;
 	}
 
-	for (int i = 0; i <= 5; i++) {
-		local_desired_joints[i] = local_current_joints[i];
-	}
+	current_joints.to_table(&local_desired_joints[0]);
 
 	// Sprawdzenie ograniczen na wspolrzedne wewnetrzne.
 	check_joints(local_desired_joints);
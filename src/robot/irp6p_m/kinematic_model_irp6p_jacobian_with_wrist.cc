@@ -9,6 +9,8 @@
  * @ingroup KINEMATICS IRP6P_KINEMATICS irp6p_m
  */
 
+#include <algorithm>
+
 #include "robot/irp6p_m/kinematic_model_irp6p_jacobian_with_wrist.h"
 
 namespace mrrocpp {
@@ -16,7 +18,8 @@ namespace kinematics {
 namespace irp6p {
 
 model_jacobian_with_wrist::model_jacobian_with_wrist (int _number_of_servos):
-	model_with_wrist(_number_of_servos)
+	model_with_wrist(_number_of_servos),
+	previous_solution_valid(false)
 {
   // Ustawienie etykiety modelu kinematycznego.
   set_kinematic_model_label("Switching to kinematic based on jacobian matrix");
@@ -26,67 +29,142 @@ model_jacobian_with_wrist::model_jacobian_with_wrist (int _number_of_servos):
   // Wykonywac przeliczenia zwiazane z narzedziem.
   attached_tool_computations = true;
 
+  last_report.iterations = 0;
+  last_report.residual = 0;
+  last_report.damping = 0;
+  last_report.converged = true;
+  last_report.warm_started = false;
 }
 
 
-void model_jacobian_with_wrist::inverse_kinematics_transform(lib::JointArray & local_desired_joints, lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame)
+double model_jacobian_with_wrist::position_error(const lib::Xyz_Angle_Axis_vector & q, lib::JointArray & joints, const lib::Homog_matrix & desired_frame, lib::Xyz_Angle_Axis_vector & distance)
 {
+  lib::Homog_matrix current_frame;
 
-  double K=1; 			//Zadane wzmocnienie
-  double E=0.00001;		//Uchyb dla ktorego rozwiazanie zaakceptowane
-  double Max;			//pomocnbicza zmienna - max element wektora
-
-  lib::Homog_matrix local_current_end_effector_frame;	//Ramka odpowiadajaca aktualnej pozycji
-  lib::Xyz_Angle_Axis_vector desired_distance_new;				//odleglosc do pokonania
-  lib::Xyz_Angle_Axis_vector delta_q;									//przyrost zmieenych przegubowych na jedna iteracje
-  lib::Xyz_Angle_Axis_vector current_joints(local_current_joints);							//wartosci aktualnych zmiennych przegubowych reprezentowane jako wektor
-  lib::Jacobian_matrix  jacobian_new;					//jakobian
+  q.to_table(&joints[0]);
 
+  //wyliczenie prostego zadania kinematyki bez narzedzia
   attached_tool_computations = false;
-
-  //wyliczenie prostego zadania kinematyki dla aktualnej konfiguracji
-  i2e_transform(local_current_joints, local_current_end_effector_frame);
+  i2e_transform(joints, current_frame);
   attached_tool_computations = true;
-  desired_distance_new.position_distance(local_current_end_effector_frame, local_desired_end_effector_frame);
 
- // printf("jacobian inverse\n");
+  //Wyliczenie uchybu pozycji dla zadanej tymczasowej i porzadanej ramki
+  distance.position_distance(current_frame, desired_frame);
 
-   //Wyliczenie max elementu uchybu
-   Max=desired_distance_new.max_element();
-
-   //Wzmocnienie
-   desired_distance_new *= K;
-
-while(fabs(Max)>E){
-
-	//Wzory na jakobian dla Irp-6 o 6 stopniach swobody
-     jacobian_new.irp6_6dof_equations(current_joints);
+  return distance.max_element();
+}
 
-	//Wyliczenie przyrostu zmiennych przegubowych
-     delta_q= jacobian_new.jacobian_inverse_gauss(desired_distance_new);
-	current_joints += delta_q;
-	current_joints.to_table(&local_current_joints[0]);
 
-    //wyliczenie prostego zadania kinematyki dla nowo wyliczonej konfiguracji
-	attached_tool_computations = false;
-	i2e_transform(local_current_joints, local_current_end_effector_frame);
-	attached_tool_computations = true;
+void model_jacobian_with_wrist::inverse_kinematics_transform(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame)
+{
+  const double E = 0.00001;		//Uchyb dla ktorego rozwiazanie zaakceptowane
+  const double LAMBDA_INITIAL = 0.001;	//Poczatkowy wspolczynnik tlumienia
+  const double LAMBDA_MIN = 1e-6;
+  const double LAMBDA_MAX = 1.0;
 
-	//Wyliczenie uchybu pozycji dla zadanej tymczasowej i porzadanej ramki
-	desired_distance_new.position_distance(local_current_end_effector_frame, local_desired_end_effector_frame);
+  lib::Xyz_Angle_Axis_vector desired_distance_new;				//odleglosc do pokonania
+  lib::Xyz_Angle_Axis_vector trial_distance;
+  lib::Xyz_Angle_Axis_vector delta_q;									//przyrost zmieenych przegubowych na jedna iteracje
+  lib::Xyz_Angle_Axis_vector current_joints(local_current_joints);							//wartosci aktualnych zmiennych przegubowych reprezentowane jako wektor
+  const lib::Xyz_Angle_Axis_vector seed_joints(current_joints);
+  lib::Jacobian_matrix  jacobian_new;					//jakobian
 
-	Max=desired_distance_new.max_element();
-	desired_distance_new *= K;
-}
+  double Max = position_error(current_joints, local_desired_joints, local_desired_end_effector_frame, desired_distance_new);
+
+  // Start z ekstrapolowanego rozwiazania z poprzedniego makrokroku,
+  // o ile ruch jest jego kontynuacja i daje mniejszy uchyb.
+  last_report.warm_started = false;
+  bool continuation = previous_solution_valid && lib::Xyz_Angle_Axis_vector(current_joints - previous_solution).max_element() < E;
+  if (continuation && Max > E) {
+	lib::Xyz_Angle_Axis_vector predicted_joints(previous_solution + previous_increment);
+	double predicted_max = position_error(predicted_joints, local_desired_joints, local_desired_end_effector_frame, trial_distance);
+	if (predicted_max < Max) {
+		current_joints = predicted_joints;
+		desired_distance_new = trial_distance;
+		Max = predicted_max;
+		last_report.warm_started = true;
+	}
+  }
+
+  double lambda = LAMBDA_INITIAL;
+  unsigned int iteration = 0;
+
+  while ((Max > E) && (iteration < MAX_ITERATIONS)) {
+	iteration++;
 
-  for (int i=0; i<=5; i++){
-		local_desired_joints[i]=local_current_joints[i];}
+	//Wzory na jakobian dla Irp-6 o 6 stopniach swobody
+	jacobian_new.irp6_6dof_equations(current_joints);
+
+	//Wyliczenie tlumionego przyrostu zmiennych przegubowych
+	delta_q = jacobian_new.damped_least_squares(desired_distance_new, lambda);
+
+	lib::Xyz_Angle_Axis_vector trial_joints(current_joints + delta_q);
+	double trial_max = position_error(trial_joints, local_desired_joints, local_desired_end_effector_frame, trial_distance);
+
+	if (trial_max < Max) {
+		// Krok przyjety - zmniejszenie tlumienia
+		current_joints = trial_joints;
+		desired_distance_new = trial_distance;
+		Max = trial_max;
+		lambda = std::max(lambda * 0.1, LAMBDA_MIN);
+	} else {
+		// Krok odrzucony (np. w poblizu osobliwosci) - zwiekszenie tlumienia
+		lambda = std::min(lambda * 10.0, LAMBDA_MAX);
+	}
+  }
+
+  current_joints.to_table(&local_desired_joints[0]);
+
+  last_report.iterations = iteration;
+  last_report.residual = Max;
+  last_report.damping = lambda;
+  last_report.converged = (Max <= E);
+
+  // Zapamietanie rozwiazania dla nastepnego makrokroku.
+  previous_increment = continuation ? lib::Xyz_Angle_Axis_vector(current_joints - seed_joints) : lib::Xyz_Angle_Axis_vector(0, 0, 0, 0, 0, 0);
+  previous_solution = current_joints;
+  previous_solution_valid = true;
 
   // Sprawdzenie ograniczen na wspolrzedne wewnetrzne.
  check_joints (local_desired_joints);
 
 } //: inverse_kinematics_transform()
 
+void model_jacobian_with_wrist::inverse_kinematics_transform_batch(joint_batch_t & desired_joints_, const lib::JointArray & current_joints_, const frame_batch_t & desired_frames_)
+{
+  desired_joints_.resize(desired_frames_.rows(), number_of_servos);
+
+  lib::Homog_matrix frame;
+  lib::JointArray joints(number_of_servos);
+  lib::JointArray joints_old = current_joints_;
+
+  ik_report batch_report = last_report;
+  batch_report.iterations = 0;
+  batch_report.residual = 0;
+  batch_report.converged = true;
+
+  for (int i = 0; i < desired_frames_.rows(); ++i) {
+	get_batch_frame(desired_frames_, i, frame);
+	// Wywolanie bez dynamicznego wiazania - kolejne rozwiazanie startuje z poprzedniego.
+	model_jacobian_with_wrist::inverse_kinematics_transform(joints, joints_old, frame);
+	desired_joints_.row(i) = joints.transpose();
+	joints_old = joints;
+
+	batch_report.iterations += last_report.iterations;
+	batch_report.residual = std::max(batch_report.residual, last_report.residual);
+	batch_report.converged = batch_report.converged && last_report.converged;
+	batch_report.damping = last_report.damping;
+	batch_report.warm_started = last_report.warm_started;
+  }
+
+  last_report = batch_report;
+}
+
+const model_jacobian_with_wrist::ik_report & model_jacobian_with_wrist::get_last_report() const
+{
+  return last_report;
+}
+
 } // namespace irp6p
 } // namespace kinematic
 } // namespace mrrocpp
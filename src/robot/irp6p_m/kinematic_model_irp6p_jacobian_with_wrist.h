@@ -29,6 +29,55 @@ namespace irp6p {
  */
 class model_jacobian_with_wrist : public model_with_wrist
 {
+public:
+	/**
+	 * @brief Report of the last inverse kinematics computation.
+	 */
+	struct ik_report
+	{
+		//! Number of performed iterations.
+		unsigned int iterations;
+
+		//! Max element of the remaining end-effector position error.
+		double residual;
+
+		//! Damping factor used in the last iteration.
+		double damping;
+
+		//! Solution reached the required accuracy within the iteration budget.
+		bool converged;
+
+		//! Iterations were seeded with the extrapolated previous solution.
+		bool warm_started;
+	};
+
+	//! Iteration budget of a single inverse kinematics computation.
+	static const unsigned int MAX_ITERATIONS = 30;
+
+private:
+	//! Last computed report.
+	ik_report last_report;
+
+	//! Solution from the previous macro-step.
+	lib::Xyz_Angle_Axis_vector previous_solution;
+
+	//! Joint increment between two last macro-steps.
+	lib::Xyz_Angle_Axis_vector previous_increment;
+
+	//! Previous solution is valid for warm start.
+	bool previous_solution_valid;
+
+	/**
+	 * @brief Computes the end-effector position error for given joints.
+	 *
+	 * @param[in] q joint values.
+	 * @param[out] joints joint values exported to the array.
+	 * @param[in] desired_frame Given end-effector frame.
+	 * @param[out] distance position error.
+	 * @return max element of the position error.
+	 */
+	double
+			position_error(const lib::Xyz_Angle_Axis_vector & q, lib::JointArray & joints, const lib::Homog_matrix & desired_frame, lib::Xyz_Angle_Axis_vector & distance);
 
 public:
 	/**
@@ -40,13 +89,38 @@ public:
 	/**
 	 * @brief Solves inverse kinematics utilizing jacobian. The new, 6th DOF is active.
 	 *
+	 * Damped least-squares (Levenberg-Marquardt) iterations, bounded by MAX_ITERATIONS.
+	 * The iterations start from the current joints or, if it gives smaller error,
+	 * from the previous solution extrapolated with the previous macro-step increment.
+	 * If the accuracy is not reached the best found configuration is returned.
+	 *
 	 * @param[out] local_desired_joints Computed join values (q0, q1, ...).
 	 * @param[in] local_current_joints Current (in fact previous) internal values.
 	 * @param[in] local_desired_end_effector_frame Given end-effector frame.
 	 */
 	virtual void
-			inverse_kinematics_transform(lib::JointArray & local_desired_joints, lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame);
+			inverse_kinematics_transform(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame);
+
+	/**
+	 * @brief Solves inverse kinematics for a sequence of frames.
+	 *
+	 * Every frame is warm-started with the solution for the previous frame extrapolated
+	 * with the increment between two previous solutions. The report sums iterations of all frames
+	 * and holds the worst residual.
+	 *
+	 * @param[out] desired_joints_ Computed joint values (one row per frame).
+	 * @param[in] current_joints_ Current (in fact previous) internal values.
+	 * @param[in] desired_frames_ Given end-effector frames.
+	 */
+	virtual void
+			inverse_kinematics_transform_batch(joint_batch_t & desired_joints_, const lib::JointArray & current_joints_, const frame_batch_t & desired_frames_);
+
+	/**
+	 * @brief Returns the report of the last inverse kinematics computation.
+	 */
+	const ik_report & get_last_report() const;
 
+	EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };//: kinematic_model_irp6p_jacobian_with_wrist
 
 } // namespace irp6p
@@ -296,10 +296,8 @@ uint8_t NL_regulator_2_irp6p::compute_set_value(void)
 			break;
 	}
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[0] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[0] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[0] = (float) set_value_new;
@@ -511,10 +509,8 @@ uint8_t NL_regulator_3_irp6p::compute_set_value(void)
 			break;
 	}
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[1] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[1] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[1] = (float) set_value_new;
@@ -727,10 +723,8 @@ uint8_t NL_regulator_4_irp6p::compute_set_value(void)
 			break;
 	}
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[2] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[2] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[2] = (float) set_value_new;
@@ -937,10 +931,8 @@ uint8_t NL_regulator_5_irp6p::compute_set_value(void)
 			break;
 	}
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[3] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[3] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[3] = (float) set_value_new;
@@ -1160,10 +1152,8 @@ uint8_t NL_regulator_6_irp6p::compute_set_value(void)
 	if (set_value_new < -MAX_PWM)
 		set_value_new = -MAX_PWM;
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[4] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[4] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[4] = (float) set_value_new;
@@ -1387,10 +1377,8 @@ uint8_t NL_regulator_7_irp6p::compute_set_value(void)
 
 	// if (set_value_new!=0.0) printf ("aa: %f\n", set_value_new);
 
-	// scope-locked reader data update
+	// reader data update (servo thread)
 	{
-		boost::mutex::scoped_lock lock(master.rb_obj->reader_mutex);
-
 		master.rb_obj->step_data.desired_inc[5] = (float) step_new_pulse; // pozycja osi 0
 		master.rb_obj->step_data.current_inc[5] = (short int) position_increment_new;
 		master.rb_obj->step_data.pwm[5] = (float) set_value_new;
@@ -16,6 +16,7 @@
 #include "robot/irp6p_tfg/edp_irp6p_tfg_effector.h"
 // Klasa hardware_interface.
 #include "robot/hi_moxa/hi_moxa.h"
+#include "robot/hi_sim/hi_sim.h"
 // Klasa servo_buffer.
 #include "robot/irp6p_tfg/sg_irp6p_tfg.h"
 #include "robot/irp6p_tfg/regulator_irp6p_tfg.h"
@@ -48,8 +49,11 @@ void servo_buffer::load_hardware_interface(void)
 
 	const std::vector <std::string> ports_vector(mrrocpp::lib::irp6p_tfg::ports_strings, mrrocpp::lib::irp6p_tfg::ports_strings
 			+ mrrocpp::lib::irp6p_tfg::LAST_MOXA_PORT_NUM + 1);
-	hi =
-			new hi_moxa::HI_moxa(master, mrrocpp::lib::irp6p_tfg::LAST_MOXA_PORT_NUM, ports_vector, mrrocpp::lib::irp6p_tfg::MAX_INCREMENT);
+	if (master.hardware_simulation) {
+		hi = new hi_sim::HI_sim(master, mrrocpp::lib::irp6p_tfg::LAST_MOXA_PORT_NUM, axe_inc_per_revolution, synchro_step_coarse);
+	} else {
+		hi = new hi_moxa::HI_moxa(master, mrrocpp::lib::irp6p_tfg::LAST_MOXA_PORT_NUM, ports_vector, mrrocpp::lib::irp6p_tfg::MAX_INCREMENT);
+	}
 	hi->init();
 
 	//Ustawienie zwlocznego ograniczenia pradowego - dlugotrwale przekroczenie ustawionej wartosci
@@ -101,7 +101,7 @@ const unsigned epos::SECONDS_PER_MINUTE = 60;
 /************************************************************/
 
 epos::epos(gateway & _device, uint8_t _nodeId, const std::string & _deviceName) :
-		device(_device), nodeId(_nodeId), deviceName(_deviceName)
+		device(_device), nodeId(_nodeId), deviceName(_deviceName), processData(false)
 {
 	// Read the cached parameters
 	OpMode = getActualOperationMode();
@@ -1431,6 +1431,106 @@ void epos::setTargetPosition(INTEGER32 val)
 	WriteObjectValue(0x607a, 0x00, val);
 }
 
+/* PDO mapping entry: object index, subindex and length in bits; firmware description 7.3 */
+#define PDO_MAPPING(index, subindex, bits) (((DWORD) (index) << 16) | ((DWORD) (subindex) << 8) | (bits))
+
+/* synchronous PDO, transmitted/applied at every SYNC */
+#define PDO_TRANSMISSION_SYNCHRONOUS	1
+
+/* COB-ID bit marking the PDO as not valid; CiA 301 */
+#define PDO_COBID_INVALID	0x80000000UL
+
+void epos::configurePDO(WORD communicationIndex, WORD mappingIndex, WORD cobId, const DWORD * mapping, unsigned int entries)
+{
+	// the PDO is disabled for the time of the reconfiguration
+	WriteObjectValue(communicationIndex, 0x01, (UNSIGNED32) (cobId | PDO_COBID_INVALID));
+	WriteObjectValue(communicationIndex, 0x02, (UNSIGNED8) PDO_TRANSMISSION_SYNCHRONOUS);
+
+	// the mapping is changed only with the number of mapped objects set to zero
+	WriteObjectValue(mappingIndex, 0x00, (UNSIGNED8) 0);
+	for (unsigned int i = 0; i < entries; ++i) {
+		WriteObjectValue(mappingIndex, (BYTE) (i + 1), (UNSIGNED32) mapping[i]);
+	}
+	WriteObjectValue(mappingIndex, 0x00, (UNSIGNED8) entries);
+
+	WriteObjectValue(communicationIndex, 0x01, (UNSIGNED32) cobId);
+}
+
+bool epos::setupProcessData()
+{
+	if (!device.supportsProcessImage()) {
+		return false;
+	}
+
+	// PDO mapping can be changed only in the pre-operational state
+	device.SendNMTService(nodeId, gateway::Enter_Pre_Operational);
+
+	const DWORD tpdo1[] = { PDO_MAPPING(0x6041, 0x00, 16), PDO_MAPPING(0x6064, 0x00, 32) };
+	const DWORD tpdo2[] = { PDO_MAPPING(0x606C, 0x00, 32), PDO_MAPPING(0x6078, 0x00, 16) };
+	const DWORD rpdo1[] = { PDO_MAPPING(0x6040, 0x00, 16), PDO_MAPPING(0x607A, 0x00, 32) };
+
+	configurePDO(0x1800, 0x1A00, gateway::TPDOCobID(nodeId, 1), tpdo1, 2);
+	configurePDO(0x1801, 0x1A01, gateway::TPDOCobID(nodeId, 2), tpdo2, 2);
+	configurePDO(0x1400, 0x1600, gateway::RPDOCobID(nodeId, 1), rpdo1, 2);
+
+	device.SendNMTService(nodeId, gateway::Start_Remote_Node);
+	remote = isRemoteOperationEnabled(getStatusWord());
+
+	device.registerTPDO(nodeId, 1);
+	device.registerTPDO(nodeId, 2);
+
+	processData = true;
+
+	return true;
+}
+
+bool epos::isProcessDataEnabled() const
+{
+	return processData;
+}
+
+epos::process_data_t epos::getProcessData()
+{
+	process_data_t pd;
+
+	if (processData) {
+		// PDO data is transmitted in little-endian byte order
+		const BYTE * tpdo1 = device.getTPDO(nodeId, 1).data;
+		const BYTE * tpdo2 = device.getTPDO(nodeId, 2).data;
+
+		pd.statusword = (UNSIGNED16) (tpdo1[0] | (tpdo1[1] << 8));
+		pd.position = (INTEGER32) ((DWORD) tpdo1[2] | ((DWORD) tpdo1[3] << 8) | ((DWORD) tpdo1[4] << 16) | ((DWORD) tpdo1[5] << 24));
+		pd.velocity = (INTEGER32) ((DWORD) tpdo2[0] | ((DWORD) tpdo2[1] << 8) | ((DWORD) tpdo2[2] << 16) | ((DWORD) tpdo2[3] << 24));
+		pd.current = (INTEGER16) (tpdo2[4] | (tpdo2[5] << 8));
+	} else {
+		pd.statusword = getStatusWord();
+		pd.position = getActualPosition();
+		pd.velocity = getActualVelocity();
+		pd.current = getActualCurrent();
+	}
+
+	return pd;
+}
+
+void epos::setProcessData(UNSIGNED16 controlword, INTEGER32 targetPosition)
+{
+	if (processData) {
+		BYTE rpdo1[8] = { 0 };
+
+		rpdo1[0] = (BYTE) (controlword & 0xFF);
+		rpdo1[1] = (BYTE) (controlword >> 8);
+		rpdo1[2] = (BYTE) (targetPosition & 0xFF);
+		rpdo1[3] = (BYTE) ((targetPosition >> 8) & 0xFF);
+		rpdo1[4] = (BYTE) ((targetPosition >> 16) & 0xFF);
+		rpdo1[5] = (BYTE) ((targetPosition >> 24) & 0xFF);
+
+		device.SendRPDO(nodeId, 1, 6, rpdo1);
+	} else {
+		setTargetPosition(targetPosition);
+		setControlword(controlword);
+	}
+}
+
 /* read manufacturer device name string firmware */
 //std::string epos::getCanDeviceName()
 //{
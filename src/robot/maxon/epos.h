@@ -129,6 +129,16 @@ private:
 	 * @return result of comparison */
 	static bool bitcmp(canopen::WORD a, canopen::WORD b);
 
+	/*! \brief configure the PDO
+	 *
+	 * @param communicationIndex index of the PDO communication parameter object
+	 * @param mappingIndex index of the PDO mapping parameter object
+	 * @param cobId COB-ID of the PDO
+	 * @param mapping mapped objects: index, subindex and length in bits, packed as in the mapping object
+	 * @param entries number of mapped objects
+	 */
+	void configurePDO(canopen::WORD communicationIndex, canopen::WORD mappingIndex, canopen::WORD cobId, const canopen::DWORD * mapping, unsigned int entries);
+
 	//! Object to access the device
 	canopen::gateway & device;
 
@@ -144,6 +154,9 @@ private:
 	//! name of the axis for debug informations
 	const std::string deviceName;
 
+	//! process data is exchanged with the PDOs
+	bool processData;
+
 public:
 	/*!
 	 * \brief All high-level methods throws this exception in case of error.
@@ -709,6 +722,46 @@ public:
 
 	//! @}
 
+	//! \ingroup libEPOS
+	//! \defgroup epos_pdo Cyclic Process Data
+	//! @{
+
+	//! \brief Process data exchanged with the synchronous PDOs
+	typedef struct _process_data_t {
+		UNSIGNED16 statusword;	//! statusword
+		INTEGER32 position;		//! actual position
+		INTEGER32 velocity;		//! actual velocity
+		INTEGER16 current;		//! actual current
+	} process_data_t;
+
+	/*! \brief Map the process data to the synchronous PDOs and register them in the gateway process image
+	 *
+	 * TPDO1: statusword and actual position, TPDO2: actual velocity and actual current,
+	 * RPDO1: controlword and target position. The device is left in the NMT operational state.
+	 *
+	 * @return false if the gateway does not receive PDOs; the device is not reconfigured then
+	 */
+	bool setupProcessData();
+
+	//! \brief Check if the process data is exchanged with the PDOs
+	bool isProcessDataEnabled() const;
+
+	/*! \brief read the process data
+	 *
+	 * Taken from the gateway process image of the last SYNC cycle if the PDOs are configured,
+	 * read with SDO otherwise.
+	 */
+	process_data_t getProcessData();
+
+	/*! \brief write the controlword and the target position
+	 *
+	 * Sent with the RPDO1 and applied by the device at the next SYNC if the PDOs are configured,
+	 * written with SDO otherwise.
+	 */
+	void setProcessData(UNSIGNED16 controlword, INTEGER32 targetPosition);
+
+	//! @}
+
 	//! \brief Get message of the error code
 	/*static*/ const char * ErrorCodeMessage(UNSIGNED32 code);
 
@@ -37,6 +37,9 @@ effector::effector(common::shell &_shell) :
 	motor_driven_effector(_shell, lib::sarkofag::ROBOT_NAME, instruction, reply)
 {
 
+	// servo_buffer tworzy symulowany interfejs sprzetowy
+	enable_hardware_simulation();
+
 	number_of_servos = lib::sarkofag::NUM_OF_SERVOS;
 
 	//  Stworzenie listy dostepnych kinematyk.
@@ -38,7 +38,7 @@ void effector::master_order(common::MT_ORDER nm_task, int nm_tryb)
 // Konstruktor.
 effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
 		motor_driven_effector(_shell, l_robot_name, instruction, reply),
-		homing_velocity(0), homing_offset(0)
+		cyclic_process_data(false), process_data_valid(false), homing_velocity(0), homing_offset(0)
 {
 	DEBUG_METHOD;
 
@@ -64,9 +64,32 @@ effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
 
 		// Create epos objects according to CAN ID-mapping.
 		epos_node = (boost::shared_ptr <maxon::epos>) new maxon::epos(*gateway, 7, "head");
+
+		// Exchange the process data with the synchronous PDOs.
+		if (config.exists_and_true("cyclic_process_data")) {
+			cyclic_process_data = epos_node->setupProcessData();
+			if (!cyclic_process_data) {
+				msg->message("CAN gateway does not support PDOs, process data will be read with SDO");
+			}
+		}
 	}
 }
 
+int32_t effector::actual_position()
+{
+	return (process_data_valid) ? process_data.position : epos_node->getActualPosition();
+}
+
+int16_t effector::actual_current()
+{
+	return (process_data_valid) ? process_data.current : epos_node->getActualCurrent();
+}
+
+bool effector::target_reached()
+{
+	return (process_data_valid) ? maxon::epos::isTargetReached(process_data.statusword) : epos_node->isTargetReached();
+}
+
 effector::~effector()
 {
 	// Disable servo for the motor.
@@ -129,10 +152,22 @@ void effector::check_controller_state()
 
 	maxon::UNSIGNED16 statusWord = 0x0000;
 
+	// Read the process data in a single SYNC cycle.
+	process_data_valid = false;
+	if (cyclic_process_data) {
+		try {
+			gateway->SyncProcessImage();
+			process_data = epos_node->getProcessData();
+			process_data_valid = true;
+		} catch (...) {
+			// The axis did not reply, read the statusword with SDO.
+		}
+	}
+
 	try {
 		// Get current epos statusword.
 
-		statusWord = epos_node->getStatusWord();
+		statusWord = (process_data_valid) ? process_data.statusword : epos_node->getStatusWord();
 
 		maxon::epos::actual_state_t state = epos_node->status2state(statusWord);
 
@@ -481,11 +516,11 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					DEBUG_COMMAND("MOTOR");
 					if (!robot_test_mode) {
 						// Update current position.
-						current_motor_pos[0] = epos_node->getActualPosition();
+						current_motor_pos[0] = actual_position();
 						// Copy values to buffer.
 						reply.shead.epos_controller.position = current_motor_pos[0];
-						reply.shead.epos_controller.current = epos_node->getActualCurrent();
-						reply.shead.epos_controller.motion_in_progress = !epos_node->isTargetReached();
+						reply.shead.epos_controller.current = actual_current();
+						reply.shead.epos_controller.motion_in_progress = !target_reached();
 					} else {
 						// Copy values to buffer.
 						reply.shead.epos_controller.position = current_motor_pos[0];
@@ -497,10 +532,10 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					DEBUG_COMMAND("JOINT");
 					if (!robot_test_mode) {
 						// Update current position.
-						current_motor_pos[0] = epos_node->getActualPosition();
+						current_motor_pos[0] = actual_position();
 						// Copy values to buffer.
-						reply.shead.epos_controller.current = epos_node->getActualCurrent();
-						reply.shead.epos_controller.motion_in_progress = !epos_node->isTargetReached();
+						reply.shead.epos_controller.current = actual_current();
+						reply.shead.epos_controller.motion_in_progress = !target_reached();
 					} else {
 						// Copy values to buffer.
 						reply.shead.epos_controller.current = 0;
@@ -36,6 +36,24 @@ protected:
 	//! Digitial_input axis
 	boost::shared_ptr <maxon::epos> epos_node;
 
+	//! Process data of the axis is exchanged with the synchronous PDOs ("cyclic_process_data" in the configuration).
+	bool cyclic_process_data;
+
+	//! Process data read in the last SYNC cycle is valid.
+	bool process_data_valid;
+
+	//! Process data of the axis read in the last SYNC cycle.
+	maxon::epos::process_data_t process_data;
+
+	//! Actual position of the axis, taken from the last SYNC cycle if possible.
+	int32_t actual_position();
+
+	//! Actual current of the axis, taken from the last SYNC cycle if possible.
+	int16_t actual_current();
+
+	//! Checks whether the axis reached its target, using the last SYNC cycle if possible.
+	bool target_reached();
+
 	//! Default axis velocity [rpm]
 	static const uint32_t Vdefault;
 
@@ -40,7 +40,7 @@ const uint32_t effector::Adefault[lib::smb::NUM_OF_SERVOS] = { 500UL, 1000UL };
 const uint32_t effector::Ddefault[lib::smb::NUM_OF_SERVOS] = { 500UL, 1000UL };
 
 effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
-		motor_driven_effector(_shell, l_robot_name, instruction, reply), cleaning_active(false)
+		motor_driven_effector(_shell, l_robot_name, instruction, reply), cyclic_process_data(false), process_data_valid(false), cleaning_active(false)
 {
 	DEBUG_METHOD;
 
@@ -74,6 +74,9 @@ effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
 		axes[0] = &(*legs_rotation_node);
 		axes[1] = &(*pkm_rotation_node);
 
+		// Exchange the process data with the synchronous PDOs.
+		setup_process_data();
+
 		// Create festo node.
 		cpv10 = (boost::shared_ptr <festo::cpv>) new festo::cpv(*gateway, FESTO_ADRESS);
 
@@ -81,6 +84,40 @@ effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
 
 }
 
+void effector::setup_process_data()
+{
+	DEBUG_METHOD;
+
+	if (robot_test_mode || !config.exists_and_true("cyclic_process_data")) {
+		return;
+	}
+
+	cyclic_process_data = true;
+
+	BOOST_FOREACH(maxon::epos * node, axes) {
+		if (!node->setupProcessData()) {
+			msg->message("CAN gateway does not support PDOs, process data will be read with SDO");
+			cyclic_process_data = false;
+			break;
+		}
+	}
+}
+
+int32_t effector::actual_position(size_t axis)
+{
+	return (process_data_valid) ? process_data[axis].position : axes[axis]->getActualPosition();
+}
+
+int16_t effector::actual_current(size_t axis)
+{
+	return (process_data_valid) ? process_data[axis].current : axes[axis]->getActualCurrent();
+}
+
+bool effector::target_reached(size_t axis)
+{
+	return (process_data_valid) ? maxon::epos::isTargetReached(process_data[axis].statusword) : axes[axis]->isTargetReached();
+}
+
 void effector::master_order(common::MT_ORDER nm_task, int nm_tryb)
 {
 	DEBUG_METHOD;
@@ -190,12 +227,27 @@ void effector::check_controller_state()
 	unsigned int powerOn = 0;
 	unsigned int enabled = 0;
 
+	// Read the process data of all axes in a single SYNC cycle.
+	process_data_valid = false;
+	if (cyclic_process_data) {
+		try {
+			gateway->SyncProcessImage();
+			for (size_t i = 0; i < axes.size(); ++i) {
+				process_data[i] = axes[i]->getProcessData();
+			}
+			process_data_valid = true;
+		} catch (...) {
+			// Some of the axes did not reply, check them one by one.
+		}
+	}
+
 	// Check axes.
 	for (size_t i = 0; i < axes.size(); ++i) {
 		try {
 			cout << string("Axis ") << axes[i]->getDeviceName() << endl;
 			// Get current EPOS state.
-			maxon::epos::actual_state_t state = axes[i]->getState();
+			maxon::epos::actual_state_t state =
+					(process_data_valid) ? maxon::epos::status2state(process_data[i].statusword) : axes[i]->getState();
 			if (state != maxon::epos::OPERATION_ENABLE) {
 				// Print state.
 				axes[i]->printState();
@@ -238,7 +290,8 @@ void effector::check_controller_state()
 		controller_state_edp_buf.robot_in_fault_state = (enabled < 1);
 	} else {
 		// Robot is synchronized if only one axis - the one controlling the PKM rotation - is referenced.
-		controller_state_edp_buf.is_synchronised = pkm_rotation_node->isReferenced();
+		controller_state_edp_buf.is_synchronised =
+				(process_data_valid) ? maxon::epos::isReferenced(process_data[1].statusword) : pkm_rotation_node->isReferenced();
 		// Check fault state.
 		controller_state_edp_buf.robot_in_fault_state = (enabled != axes.size());
 	}
@@ -621,15 +674,15 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					for (size_t i = 0; i < number_of_servos; ++i) {
 						if (!robot_test_mode) {
 							// Update current position.
-							current_motor_pos[i] = axes[i]->getActualPosition();
+							current_motor_pos[i] = actual_position(i);
 							// In case of legs rotation node...
 							if (i == 0)
 								// ... compute relative position.
 								current_motor_pos[i] -= legs_relative_zero_position;
 							// Copy values to buffer.
 							reply.smb.epos_controller[i].position = current_motor_pos[i];
-							reply.smb.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.smb.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							reply.smb.epos_controller[i].current = actual_current(i);
+							reply.smb.epos_controller[i].motion_in_progress = !target_reached(i);
 						} else {
 							// Copy values to buffer.
 							reply.smb.epos_controller[i].position = current_motor_pos[i];
@@ -644,14 +697,14 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					for (size_t i = 0; i < axes.size(); ++i) {
 						if (!robot_test_mode) {
 							// Update current position.
-							current_motor_pos[i] = axes[i]->getActualPosition();
+							current_motor_pos[i] = actual_position(i);
 							// In case of legs rotation node...
 							if (i == 0)
 								// ... compute relative position.
 								current_motor_pos[i] -= legs_relative_zero_position;
 							// Copy values to buffer.
-							reply.smb.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.smb.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							reply.smb.epos_controller[i].current = actual_current(i);
+							reply.smb.epos_controller[i].motion_in_progress = !target_reached(i);
 						} else {
 							// Copy values to buffer.
 							reply.smb.epos_controller[i].current = 0;
@@ -674,14 +727,14 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					for (size_t i = 0; i < axes.size(); ++i) {
 						if (!robot_test_mode) {
 							// Update current position.
-							current_motor_pos[i] = axes[i]->getActualPosition();
+							current_motor_pos[i] = actual_position(i);
 							// In case of legs rotation node...
 							if (i == 0)
 								// ... compute relative position.
 								current_motor_pos[i] -= legs_relative_zero_position;
 							// Copy values to buffer.
-							reply.smb.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.smb.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							reply.smb.epos_controller[i].current = actual_current(i);
+							reply.smb.epos_controller[i].motion_in_progress = !target_reached(i);
 						} else {
 							// Copy values to buffer.
 							reply.smb.epos_controller[i].current = 0;
@@ -54,7 +54,7 @@ using namespace std;
 const uint32_t effector::limit_extension = 1000;
 
 effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
-		manip_effector(_shell, l_robot_name, instruction, reply)
+		manip_effector(_shell, l_robot_name, instruction, reply), cyclic_process_data(false), process_data_valid(false)
 {
 	DEBUG_METHOD;
 
@@ -122,6 +122,40 @@ effector::effector(common::shell &_shell, lib::robot_name_t l_robot_name) :
 	}
 }
 
+void effector::setup_process_data()
+{
+	DEBUG_METHOD;
+
+	if (robot_test_mode || !config.exists_and_true("cyclic_process_data")) {
+		return;
+	}
+
+	cyclic_process_data = true;
+
+	BOOST_FOREACH(boost::shared_ptr<maxon::epos> node, axes) {
+		if (!node->setupProcessData()) {
+			msg->message("CAN gateway does not support PDOs, process data will be read with SDO");
+			cyclic_process_data = false;
+			break;
+		}
+	}
+}
+
+int32_t effector::actual_position(size_t axis)
+{
+	return (process_data_valid) ? process_data[axis].position : axes[axis]->getActualPosition();
+}
+
+int16_t effector::actual_current(size_t axis)
+{
+	return (process_data_valid) ? process_data[axis].current : axes[axis]->getActualCurrent();
+}
+
+bool effector::target_reached(size_t axis)
+{
+	return (process_data_valid) ? maxon::epos::isTargetReached(process_data[axis].statusword) : axes[axis]->isTargetReached();
+}
+
 effector::~effector()
 {
 	DEBUG_METHOD;
@@ -264,11 +298,25 @@ void effector::check_controller_state()
 
 	boost::array <canopen::WORD, lib::spkm::NUM_OF_SERVOS> cachedStatusWords;
 
+	// Read the process data of all axes in a single SYNC cycle.
+	process_data_valid = false;
+	if (cyclic_process_data) {
+		try {
+			gateway->SyncProcessImage();
+			for (size_t i = 0; i < axes.size(); ++i) {
+				process_data[i] = axes[i]->getProcessData();
+			}
+			process_data_valid = true;
+		} catch (...) {
+			// Some of the axes did not reply, check them one by one.
+		}
+	}
+
 	// Check axes.
 	for (size_t i = 0; i < axes.size(); ++i) {
 		try {
 			// Get current status.
-			cachedStatusWords[i] = axes[i]->getStatusWord();
+			cachedStatusWords[i] = (process_data_valid) ? process_data[i].statusword : axes[i]->getStatusWord();
 			// Get current epos state.
 			maxon::epos::actual_state_t state = maxon::epos::status2state(cachedStatusWords[i]);
 
@@ -1450,10 +1498,10 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 							reply.spkm.epos_controller[i].current = 0;
 							reply.spkm.epos_controller[i].motion_in_progress = false;
 						} else {
-							current_motor_pos[i] = axes[i]->getActualPosition();
+							current_motor_pos[i] = actual_position(i);
 							reply.spkm.epos_controller[i].position = current_motor_pos[i];
-							reply.spkm.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.spkm.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							reply.spkm.epos_controller[i].current = actual_current(i);
+							reply.spkm.epos_controller[i].motion_in_progress = !target_reached(i);
 						}
 					}
 					break;
@@ -1462,9 +1510,9 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					// Read actual values from the hardware.
 					if (!robot_test_mode) {
 						for (size_t i = 0; i < axes.size(); ++i) {
-							current_motor_pos[i] = axes[i]->getActualPosition();
-							reply.spkm.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.spkm.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							current_motor_pos[i] = actual_position(i);
+							reply.spkm.epos_controller[i].current = actual_current(i);
+							reply.spkm.epos_controller[i].motion_in_progress = !target_reached(i);
 						}
 					}
 
@@ -1495,8 +1543,8 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					// Return additional informations regarding current and motion.
 					if (!robot_test_mode) {
 						for (size_t i = 0; i < axes.size(); ++i) {
-							reply.spkm.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.spkm.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							reply.spkm.epos_controller[i].current = actual_current(i);
+							reply.spkm.epos_controller[i].motion_in_progress = !target_reached(i);
 						}
 					}
 					break;
@@ -1529,8 +1577,8 @@ void effector::get_arm_position(bool read_hardware, lib::c_buffer &instruction_)
 					// Return additional informations regarding current and motion.
 					if (!robot_test_mode) {
 						for (size_t i = 0; i < axes.size(); ++i) {
-							reply.spkm.epos_controller[i].current = axes[i]->getActualCurrent();
-							reply.spkm.epos_controller[i].motion_in_progress = !axes[i]->isTargetReached();
+							reply.spkm.epos_controller[i].current = actual_current(i);
+							reply.spkm.epos_controller[i].motion_in_progress = !target_reached(i);
 						}
 					}
 					break;
@@ -96,6 +96,27 @@ protected:
 	//! Handler for the asynchronous execution of the interpolated profile motion
 	maxon::ipm_executor <lib::spkm::NUM_OF_MOTION_SEGMENTS, lib::spkm::NUM_OF_SERVOS> ipm_handler;
 
+	//! Process data of the axes is exchanged with the synchronous PDOs ("cyclic_process_data" in the configuration).
+	bool cyclic_process_data;
+
+	//! Process data read in the last SYNC cycle is valid.
+	bool process_data_valid;
+
+	//! Process data of the axes read in the last SYNC cycle.
+	boost::array <maxon::epos::process_data_t, mrrocpp::lib::spkm::NUM_OF_SERVOS> process_data;
+
+	//! Configures the PDOs of the axes if the cyclic process data is enabled.
+	void setup_process_data();
+
+	//! Actual position of the axis, taken from the last SYNC cycle if possible.
+	int32_t actual_position(size_t axis);
+
+	//! Actual current of the axis, taken from the last SYNC cycle if possible.
+	int16_t actual_current(size_t axis);
+
+	//! Checks whether the axis reached its target, using the last SYNC cycle if possible.
+	bool target_reached(size_t axis);
+
 public:
 	/*!
 	 * @brief Constructor.
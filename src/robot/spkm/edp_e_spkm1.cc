@@ -31,6 +31,9 @@ effector::effector(common::shell &_shell) :
 		axes[4] = axis2;
 		axes[5] = axis3;
 
+		// Exchange the process data with the synchronous PDOs.
+		setup_process_data();
+
 		// Setup the axis array for the IPM handler
 		{
 			boost::unique_lock <boost::mutex> lock(ipm_handler.mtx);
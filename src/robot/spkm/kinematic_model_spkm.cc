@@ -186,6 +186,52 @@ void kinematic_model_spkm::inverse_kinematics_transform(lib::JointArray & local_
 
     // Compute the required O_S_T - pose of the spherical wrist middle (S) in global reference frame (O).
 	Homog4d  O_S_T_desired = O_W_T_desired * params.W_S_T;
+
+	inverse_kinematics_from_wrist_pose(local_desired_joints, local_current_joints, O_S_T_desired);
+}
+
+void kinematic_model_spkm::inverse_kinematics_transform_batch(joint_batch_t & desired_joints_, const lib::JointArray & current_joints_, const frame_batch_t & desired_frames_)
+{
+	const int n_frames = desired_frames_.rows();
+
+	// Compute the required O_S_T = O_W_T * W_S_T for all frames at once - column (4*r + c) of the batch
+	// is the (r,c) element of all frames, thus every product element is a combination of whole columns.
+	frame_batch_t O_S_T_batch(n_frames, 12);
+	for (int r = 0; r < 3; ++r) {
+		for (int c = 0; c < 4; ++c) {
+			O_S_T_batch.col(4 * r + c) = desired_frames_.col(4 * r) * params.W_S_T(0, c) + desired_frames_.col(4 * r + 1)
+					* params.W_S_T(1, c) + desired_frames_.col(4 * r + 2) * params.W_S_T(2, c);
+			if (c == 3) {
+				O_S_T_batch.col(4 * r + 3) += desired_frames_.col(4 * r + 3);
+			}
+		}
+	}
+
+	desired_joints_.resize(n_frames, 6);
+
+	Homog4d O_S_T_desired;
+	O_S_T_desired(3, 0) = 0;
+	O_S_T_desired(3, 1) = 0;
+	O_S_T_desired(3, 2) = 0;
+	O_S_T_desired(3, 3) = 1;
+	lib::JointArray joints(6);
+	lib::JointArray joints_old = current_joints_;
+
+	for (int i = 0; i < n_frames; ++i) {
+		for (int r = 0; r < 3; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				O_S_T_desired(r, c) = O_S_T_batch(i, 4 * r + c);
+			}
+		}
+		inverse_kinematics_from_wrist_pose(joints, joints_old, O_S_T_desired);
+		desired_joints_.row(i) = joints.transpose();
+		// Spherical wrist solution for the next frame is chosen in relation to this one.
+		joints_old = joints;
+	}
+}
+
+void kinematic_model_spkm::inverse_kinematics_from_wrist_pose(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const Homog4d & O_S_T_desired)
+{
 #if(DEBUG_KINEMATICS)
 	std::cout <<"Desired pose of the wrist center:\n" << O_S_T_desired<<std::endl;
 #endif
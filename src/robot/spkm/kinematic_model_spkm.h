@@ -103,6 +103,27 @@ public:
 	 */
 	void inverse_kinematics_transform(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const lib::Homog_matrix& local_desired_end_effector_frame);
 
+	/*!
+	 * @brief Solves inverse kinematics for a sequence of frames.
+	 *
+	 * Poses of the spherical wrist middle are computed for all frames in one pass,
+	 * the SW solution for every frame is chosen in relation to the previous one.
+	 *
+	 * @param[out] desired_joints_ Computed joint values (one row per frame).
+	 * @param[in] current_joints_ Current (in fact previously desired) joint values.
+	 * @param[in] desired_frames_ Given end-effector frames.
+	 */
+	void inverse_kinematics_transform_batch(joint_batch_t & desired_joints_, const lib::JointArray & current_joints_, const frame_batch_t & desired_frames_);
+
+	/*!
+	 * @brief Solves inverse kinematics for the given pose of the spherical wrist middle.
+	 *
+	 * @param[out] local_desired_joints Computed join values.
+	 * @param[in] local_current_joints Current (in fact previously desired) joint values.
+	 * @param[in] O_S_T_desired Desired pose of the spherical wrist middle (S) in the global reference frame (O).
+	 */
+	void inverse_kinematics_from_wrist_pose(lib::JointArray & local_desired_joints, const lib::JointArray & local_current_joints, const Homog4d & O_S_T_desired);
+
 	/*!
 	 * @brief Computes platform pose on the base of given _O_S_T.
 	 *
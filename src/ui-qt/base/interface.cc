@@ -13,7 +13,6 @@
 #include <string>
 #include <iostream>
 
-#include <boost/regex.hpp>
 #include <boost/foreach.hpp>
 
 #include <QtGui/QApplication>
@@ -123,20 +122,28 @@ void Interface::start_on_timer()
 
 void Interface::html_it(const std::string &_input, std::string &_output)
 {
-	try {
-		// Wyrażenie regularne reprezentujące pierwsze dwie kolumny (druga może być pusta)
-		boost::regex pattern("(<)|(>)|( )|(&)");
-		// Format stringu odpowiadający podmienianemu dopasowaniu.
-		std::string fmt("(?1&lt;)(?2&gt;)(?3&#160;)(?4&amp;)");
+	_output.clear();
+	_output.reserve(_input.size() + _input.size() / 2);
 
-		std::ostringstream t(std::ios::out | std::ios::binary);
-		std::ostream_iterator <char> oi(t);
-		boost::regex_merge(oi, _input.begin(), _input.end(), pattern, fmt, boost::match_default | boost::format_all);
-
-		_output = t.str();
-
-	} catch (std::exception &ex) {
-		std::cout << "blad" << ex.what() << std::endl;
+	for (std::string::const_iterator it = _input.begin(); it != _input.end(); ++it) {
+		switch (*it)
+		{
+			case '<':
+				_output += "&lt;";
+				break;
+			case '>':
+				_output += "&gt;";
+				break;
+			case ' ':
+				_output += "&#160;";
+				break;
+			case '&':
+				_output += "&amp;";
+				break;
+			default:
+				_output += *it;
+				break;
+		}
 	}
 }
 
@@ -163,6 +170,9 @@ void Interface::timer_slot()
 
 		std::string html_line;
 
+		// wszystkie linie z jednego cyklu sa dopisywane do okna naraz
+		std::string html_block;
+
 		lib::sr_package_t sr_msg;
 		int iterator = sr_buffer::UI_SR_BUFFER_LENGHT;
 
@@ -269,6 +279,12 @@ void Interface::timer_slot()
 
 			std::string text(sr_msg.description);
 
+			if (sr_msg.repeated > 1) {
+				char repeated_buffer[32];
+				snprintf(repeated_buffer, sizeof(repeated_buffer), " (x%u)", (unsigned int) sr_msg.repeated);
+				text += repeated_buffer;
+			}
+
 			boost::char_separator <char> sep("\n");
 			boost::tokenizer <boost::char_separator <char> > tokens(text, sep);
 
@@ -296,12 +312,19 @@ void Interface::timer_slot()
 						}
 						strcat(current_line, t.c_str());
 
-						mw->get_ui()->textEdit_sr->append(QString::fromStdString(html_line));
+						if (!html_block.empty()) {
+							html_block += "<br>";
+						}
+						html_block += html_line;
 
-						(*log_file_outfile) << current_line << std::endl;
+						(*log_file_outfile) << current_line << '\n';
 					}
 		}
 
+		if (!html_block.empty()) {
+			mw->get_ui()->textEdit_sr->append(QString::fromStdString(html_block));
+		}
+
 		(*log_file_outfile).flush();
 
 	}
@@ -48,7 +48,7 @@ bool busy_flag::is_busy() const
 }
 
 function_execution_buffer::function_execution_buffer(Interface& _interface) :
-		interface(_interface), has_command(false)
+		interface(_interface), has_command(false), idle_running(false)
 {
 }
 
@@ -65,19 +65,76 @@ void function_execution_buffer::command(command_function_t _com_fun)
 	return;
 }
 
+void function_execution_buffer::idle_command(command_function_t _idle_fun, const boost::posix_time::time_duration & _idle_period)
+{
+	boost::unique_lock <boost::mutex> lock(mtx);
+
+	idle_fun = _idle_fun;
+	idle_period = _idle_period;
+
+	cond.notify_one();
+}
+
+void function_execution_buffer::finish_idle_command()
+{
+	boost::unique_lock <boost::mutex> lock(mtx);
+
+	idle_running = false;
+
+	idle_cond.notify_all();
+}
+
+void function_execution_buffer::clear_idle_command()
+{
+	boost::unique_lock <boost::mutex> lock(mtx);
+
+	idle_fun.clear();
+
+	while (idle_running) {
+		idle_cond.wait(lock);
+	}
+}
+
 int function_execution_buffer::wait_and_execute()
 {
 	command_function_t popped_command;
+	bool idle = false;
 
 	{
 		boost::unique_lock <boost::mutex> lock(mtx);
 
+		// funkcja wykonywana w tle moze zostac usunieta w czasie oczekiwania
 		while (!has_command) {
-			cond.wait(lock);
+			if (idle_fun.empty()) {
+				cond.wait(lock);
+			} else if (!cond.timed_wait(lock, idle_period) && !idle_fun.empty()) {
+				idle = true;
+				break;
+			}
+		}
+
+		if (idle) {
+			popped_command = idle_fun;
+			idle_running = true;
+		} else {
+			has_command = false;
+			popped_command = com_fun;
+		}
+	}
+
+	// czynnosci wykonywane w tle nie zmieniaja stanu interfejsu na zajety
+	if (idle) {
+		int ret = 0;
+
+		try {
+			ret = popped_command();
+		} catch (...) {
+			finish_idle_command();
+			throw;
 		}
 
-		has_command = false;
-		popped_command = com_fun;
+		finish_idle_command();
+		return ret;
 	}
 
 	busy_flagger flagger(interface.communication_flag);
@@ -12,6 +12,7 @@
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include <stdexcept>
 #include <iostream>
@@ -150,6 +151,14 @@ public:
 	Interface& interface;
 	int wait_and_execute();
 	void command(command_function_t _com_fun);
+
+	//! set function executed periodically when there is no command to execute
+	void idle_command(command_function_t _idle_fun, const boost::posix_time::time_duration & _idle_period);
+
+	//! remove the idle function and wait until its execution in progress, if any, is finished
+	//! @note must not be called from the idle function itself
+	void clear_idle_command();
+
 	function_execution_buffer(Interface& _interface);
 private:
 	boost::condition_variable cond; //! active command condition
@@ -158,6 +167,15 @@ private:
 	bool has_command; //! flag indicating active command to execute
 
 	command_function_t com_fun; //! command functor
+
+	command_function_t idle_fun; //! idle functor, empty if not set
+	boost::posix_time::time_duration idle_period; //! period of idle functor execution
+
+	bool idle_running; //! flag indicating the idle functor is being executed
+	boost::condition_variable idle_cond; //! end of the idle functor execution
+
+	//! mark the end of the idle functor execution
+	void finish_idle_command();
 };
 
 class feb_thread : public boost::noncopyable
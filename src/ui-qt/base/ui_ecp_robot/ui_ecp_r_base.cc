@@ -61,8 +61,17 @@ void EcpRobot::execute_motion(void)
 {
 	// Zlecenie wykonania ruchu przez robota jest to polecenie dla EDP
 
+	communication_lock lock(communication_mutex);
+
 	ui_robot.interface.set_ui_state_notification(UI_N_COMMUNICATION);
 
+	transmit();
+}
+
+void EcpRobot::transmit(void)
+{
+	communication_lock lock(communication_mutex);
+
 	// TODO: in QNX/Photon exceptions are handled at the main loop
 	// in GTK exceptions triggered signals cannot be handled in main loop
 
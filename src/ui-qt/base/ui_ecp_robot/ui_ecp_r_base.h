@@ -9,6 +9,9 @@
 
 #include "base/ecp/ecp_robot.h"
 
+#include <boost/noncopyable.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+
 namespace mrrocpp {
 namespace ui {
 namespace common {
@@ -23,13 +26,77 @@ public:
 
 	ecp::common::robot::common_buffers_ecp_robot *ecp;
 
+	//! Serializes the communication with EDP of the UI thread and the robot thread
+	struct communication_mutex_t : private boost::noncopyable
+	{
+		boost::recursive_mutex mutex;
+
+		//! Commands waiting for the communication, the background poll gives way to them
+		volatile unsigned int commands_waiting;
+
+		communication_mutex_t() :
+				commands_waiting(0)
+		{
+		}
+	} communication_mutex;
+
+	//! Lock of the communication for the whole command-reply exchange
+	class communication_lock : private boost::noncopyable
+	{
+		communication_mutex_t & m;
+
+	public:
+		communication_lock(communication_mutex_t & _m) :
+				m(_m)
+		{
+			__sync_fetch_and_add(&m.commands_waiting, 1);
+			m.mutex.lock();
+			__sync_fetch_and_sub(&m.commands_waiting, 1);
+		}
+
+		~communication_lock()
+		{
+			m.mutex.unlock();
+		}
+	};
+
+	//! Lock of the communication for the background poll; not taken while a command waits or runs
+	class poll_lock : private boost::noncopyable
+	{
+		communication_mutex_t & m;
+
+		bool locked;
+
+	public:
+		poll_lock(communication_mutex_t & _m) :
+				m(_m), locked(!m.commands_waiting && m.mutex.try_lock())
+		{
+		}
+
+		~poll_lock()
+		{
+			if (locked) {
+				m.mutex.unlock();
+			}
+		}
+
+		bool owns_lock() const
+		{
+			return locked;
+		}
+	};
+
 	EcpRobot(common::UiRobot& _ui_robot); // Konstruktor
 
 	// by Y - do odczytu stanu poczatkowego robota
 	void get_controller_state(lib::controller_state_t & robot_controller_initial_state_l);
 
+	//! Command for EDP, shown in the UI state
 	virtual void execute_motion(void);
 
+	//! Command-reply exchange with EDP without the UI notification, used directly by the background poll
+	virtual void transmit(void);
+
 	virtual ~EcpRobot();
 
 };
@@ -27,11 +27,11 @@ public:
 	boost::shared_ptr <ECP_ROBOT_T> the_robot;
 
 	// Zlecenie wykonania ruchu przez robota jest to polecenie dla EDP
-	virtual void execute_motion(void)
+	virtual void transmit(void)
 	{
-		//printf("EcpRobotDataPort::execute_motion by pthread_t = %lu\n", pthread_self());
+		//printf("EcpRobotDataPort::transmit by pthread_t = %lu\n", pthread_self());
 
-		ui_robot.interface.set_ui_state_notification(UI_N_COMMUNICATION);
+		communication_lock lock(communication_mutex);
 
 		the_robot->is_new_data = false;
 		the_robot->is_new_request = false;
@@ -36,12 +36,16 @@ namespace common {
 
 void UiRobot::delete_ui_ecp_robot()
 {
-	delete ui_ecp_robot;
+	// odczyt stanu w tle nie moze korzystac z usuwanego obiektu;
+	// wywolanie z watku eb nie czeka, bo wtedy odczyt nie jest w toku
+	eb.clear_idle_command();
 
+	delete ui_ecp_robot;
+	ui_ecp_robot = NULL;
 }
 
 UiRobot::UiRobot(Interface& _interface, lib::robot_name_t _robot_name, int _number_of_servos) :
-		interface(_interface), tid(NULL), eb(_interface), robot_name(_robot_name), number_of_servos(_number_of_servos)
+		ui_ecp_robot(NULL), interface(_interface), tid(NULL), eb(_interface), robot_name(_robot_name), number_of_servos(_number_of_servos)
 {
 	//activation_string = _activation_string;
 	state.edp.section_name = interface.config->get_edp_section(robot_name);
@@ -50,6 +54,7 @@ UiRobot::UiRobot(Interface& _interface, lib::robot_name_t _robot_name, int _numb
 	state.edp.last_state = UI_EDP_STATE_NOT_KNOWN; // edp nieokreslone
 	state.ecp.trigger_fd = lib::invalid_fd;
 	state.edp.is_synchronised = false; // edp nieaktywne
+
 	msg =
 			(boost::shared_ptr <lib::sr_ecp>) new lib::sr_ecp(lib::ECP, "ui_" + robot_name, interface.network_sr_attach_point);
 
@@ -69,12 +74,26 @@ UiRobot::~UiRobot()
 
 void UiRobot::create_thread()
 {
+	state_refresh_interval =
+			interface.config->exists("state_refresh_interval", lib::UI_SECTION) ?
+					interface.config->value <int>("state_refresh_interval", lib::UI_SECTION) :
+					interface.position_refresh_interval;
+
+	// odczyt stanu w tle, zatrzymywany przy usuwaniu ui_ecp_robot
+	eb.idle_command(boost::bind(&ui::common::UiRobot::poll_state, this), boost::posix_time::milliseconds(state_refresh_interval));
+
 	//	assert(tid == NULL);
 	if (!tid) {
 		tid = new feb_thread(eb);
 	}
 }
 
+int UiRobot::poll_state()
+{
+	// robot nie udostepnia stanu czytanego w tle
+	return 0;
+}
+
 void UiRobot::setup_menubar()
 {
 	Ui::MenuBar *menuBar = interface.get_main_window()->getMenuBar();
@@ -255,16 +274,10 @@ void UiRobot::abort_thread()
 
 void UiRobot::connect_to_reader()
 {
-	short tmp = 0;
-	// kilka sekund  (~1) na otworzenie urzadzenia
-
-	while ((state.edp.reader_fd = messip::port_connect(state.edp.network_reader_attach_point)) == lib::invalid_fd) {
-		if ((tmp++) < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-		} else {
-			perror("blad odwolania do READER");
-			break;
-		}
+	// oczekiwanie na kanal READER, zarzadca messip powiadamia o jego utworzeniu
+	if ((state.edp.reader_fd = messip::port_connect_wait(state.edp.network_reader_attach_point, lib::CONNECT_TIMEOUT))
+			== lib::invalid_fd) {
+		perror("blad odwolania do READER");
 	}
 }
 
@@ -311,27 +324,11 @@ void UiRobot::pulse_reader_execute(int code, int value)
 
 void UiRobot::connect_to_ecp_pulse_chanell()
 {
-	short tmp = 0;
-	// kilka sekund  (~1) na otworzenie urzadzenia
-	// zabezpieczenie przed zawieszeniem poprzez wyslanie sygnalu z opoznieniem
-
-	while ((state.ecp.trigger_fd = messip::port_connect(state.ecp.network_trigger_attach_point)) == NULL
-
-	) {
-		if (errno == EINTR
-		)
-			break;
-		if ((tmp++) < lib::CONNECT_RETRY) {
-			boost::this_thread::sleep(lib::CONNECT_DELAY);
-		} else {
-			perror("blad odwolania do ECP_TRIGGER");
-		}
+	// oczekiwanie na kanal ECP_TRIGGER, zarzadca messip powiadamia o jego utworzeniu
+	if ((state.ecp.trigger_fd = messip::port_connect_wait(state.ecp.network_trigger_attach_point, lib::CONNECT_TIMEOUT))
+			== NULL) {
+		perror("blad odwolania do ECP_TRIGGER");
 	}
-
-	/*
-	 // odwolanie alarmu
-	 ualarm((useconds_t)(0), 0);
-	 */
 }
 
 void UiRobot::pulse_ecp_execute(int code, int value)
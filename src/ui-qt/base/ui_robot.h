@@ -153,6 +153,18 @@ public:
 
 	void create_thread();
 	void abort_thread();
+
+	/**
+	 * @brief Period of the background reading of the robot state [ms]
+	 * state_refresh_interval in the [ui] section, defaults to the position refresh interval
+	 */
+	int state_refresh_interval;
+
+	/**
+	 * @brief Reads the state requested by the widgets
+	 * Executed periodically by the robot thread when it has no other command to execute.
+	 */
+	virtual int poll_state();
 	void pulse_reader_execute(int code, int value);
 
 	bool pulse_reader_start_exec_pulse(void);
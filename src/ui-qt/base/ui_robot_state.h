@@ -0,0 +1,131 @@
+// -------------------------------------------------------------------------
+//                            ui_robot_state.h
+// Stan robota odczytywany w tle i udostepniany widgetom
+//
+// Ostatnia modyfikacja: 2012
+// -------------------------------------------------------------------------
+
+#ifndef __UI_ROBOT_STATE_H
+#define __UI_ROBOT_STATE_H
+
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace mrrocpp {
+namespace ui {
+namespace common {
+
+/*!
+ * Subscription of the robot state.
+ *
+ * The state consists of parts, each identified by a single bit. Widgets
+ * request the parts they display and read the last published copy; they
+ * never wait for the EDP. The state is read periodically by the robot thread,
+ * which fills the back buffer and swaps it with the front one. The mutex is
+ * held only for the swap and for the copy of the front buffer.
+ *
+ * @tparam T type of the state
+ */
+template <typename T>
+class robot_state_subscription : private boost::noncopyable
+{
+public:
+	//! Maximal number of the parts of the state
+	static const unsigned int MAX_PARTS = 8;
+
+private:
+	//! Front and back buffer
+	T buffers[2];
+
+	//! Index of the front buffer, modified only by the reading thread
+	int front;
+
+	//! Parts requested by the widgets since the last read
+	volatile unsigned int requested;
+
+	//! Number of the publications
+	unsigned int published;
+
+	//! Number of the last publication of each part, 0 if the part was never read
+	unsigned int part_sequence[MAX_PARTS];
+
+	//! Guards the swap of the buffers
+	mutable boost::mutex swap_mutex;
+
+	//! Index of the part given as a single bit
+	static unsigned int index(unsigned int part)
+	{
+		unsigned int i = 0;
+		while ((part >>= 1) && (i < MAX_PARTS - 1)) {
+			++i;
+		}
+		return i;
+	}
+
+public:
+	robot_state_subscription() :
+			buffers(), front(0), requested(0), published(0)
+	{
+		for (unsigned int i = 0; i < MAX_PARTS; ++i) {
+			part_sequence[i] = 0;
+		}
+	}
+
+	//! Request the parts of the state; called by the widgets
+	void request(unsigned int parts)
+	{
+		__sync_fetch_and_or(&requested, parts);
+	}
+
+	//! Take and clear the requested parts; called by the reading thread
+	unsigned int take_requests()
+	{
+		return __sync_fetch_and_and(&requested, 0);
+	}
+
+	//! Buffer for the new state, initialized with the last published one; called by the reading thread
+	T & back()
+	{
+		buffers[1 - front] = buffers[front];
+		return buffers[1 - front];
+	}
+
+	//! Publish the parts of the state filled in back(); called by the reading thread
+	void publish(unsigned int parts)
+	{
+		boost::mutex::scoped_lock lock(swap_mutex);
+		front = 1 - front;
+		++published;
+		for (unsigned int i = 0; i < MAX_PARTS; ++i) {
+			if (parts & (1u << i)) {
+				part_sequence[i] = published;
+			}
+		}
+	}
+
+	//! Number of the last publication of the part, 0 if the part was never read
+	unsigned int sequence(unsigned int part) const
+	{
+		boost::mutex::scoped_lock lock(swap_mutex);
+		return part_sequence[index(part)];
+	}
+
+	/*!
+	 * Copy of the last published state.
+	 * @param snapshot copy of the state
+	 * @param part part of the state the caller is interested in
+	 * @return number of the last publication of the part, 0 if the part was never read
+	 */
+	unsigned int get(T & snapshot, unsigned int part) const
+	{
+		boost::mutex::scoped_lock lock(swap_mutex);
+		snapshot = buffers[front];
+		return part_sequence[index(part)];
+	}
+};
+
+}
+} //namespace ui
+} //namespace mrrocpp
+
+#endif
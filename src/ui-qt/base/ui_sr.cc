@@ -61,10 +61,10 @@ void sr_buffer::operator()()
 	thread_started.command();
 
 	while (true) {
-		lib::sr_package_t sr_msg;
+		lib::sr_batch_t sr_batch;
 
 		int32_t type, subtype;
-		int rcvid = messip::port_receive(ch, type, subtype, sr_msg);
+		int rcvid = messip::port_receive(ch, type, subtype, sr_batch);
 		//	printf("SR received: %d\n", licznik);
 
 		if (rcvid != MESSIP_MSG_NOREPLY) {
@@ -72,14 +72,7 @@ void sr_buffer::operator()()
 			continue;
 		}
 
-		if (strlen(sr_msg.process_name) > 1) // by Y jesli ten string jest pusty to znaczy ze przyszedl smiec
-				{
-			//	flushall();
-
-			put_one_msg(sr_msg);
-		} else {
-			printf("SR(%s:%d) unexpected message\n", __FILE__, __LINE__);
-		}
+		put_batch(sr_batch);
 	}
 }
 
@@ -105,6 +98,22 @@ void sr_buffer::put_one_msg(const lib::sr_package_t& new_msg)
 	return;
 }
 
+void sr_buffer::put_batch(const lib::sr_batch_t& new_batch)
+{
+	boost::mutex::scoped_lock lock(mtx);
+
+	for (uint32_t i = 0; i < new_batch.count; ++i) {
+		const lib::sr_package_t & sr_msg = new_batch.packages[i];
+
+		if (strlen(sr_msg.process_name) > 1) // by Y jesli ten string jest pusty to znaczy ze przyszedl smiec
+				{
+			cb.push_back(sr_msg);
+		} else {
+			printf("SR(%s:%d) unexpected message\n", __FILE__, __LINE__);
+		}
+	}
+}
+
 void sr_buffer::get_one_msg(lib::sr_package_t& new_msg)
 {
 	boost::mutex::scoped_lock lock(mtx);
@@ -42,6 +42,7 @@ public:
 	void operator()();
 
 	void put_one_msg(const lib::sr_package_t& new_msg); // podniesienie semafora
+	void put_batch(const lib::sr_batch_t& new_batch); // wszystkie komunikaty z paczki naraz
 	void get_one_msg(lib::sr_package_t& new_msg); // podniesienie semafora
 	void inter_get_one_msg(lib::sr_package_t& new_msg); // podniesienie semafora
 
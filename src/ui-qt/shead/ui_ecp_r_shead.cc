@@ -20,6 +20,8 @@ EcpRobot::EcpRobot(common::UiRobot& _ui_robot) :
 
 void EcpRobot::move_motors(const double final_position[lib::shead::NUM_OF_SERVOS])
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_motor_command_data_port.data.motion_variant = lib::epos::NON_SYNC_TRAPEZOIDAL;
 
 	for (int i = 0; i < lib::shead::NUM_OF_SERVOS; ++i) {
@@ -33,6 +35,8 @@ void EcpRobot::move_motors(const double final_position[lib::shead::NUM_OF_SERVOS
 
 void EcpRobot::move_joints(const double final_position[lib::shead::NUM_OF_SERVOS])
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_joint_command_data_port.data.motion_variant = lib::epos::NON_SYNC_TRAPEZOIDAL;
 
 	for (int i = 0; i < lib::shead::NUM_OF_SERVOS; ++i) {
@@ -45,6 +49,8 @@ void EcpRobot::move_joints(const double final_position[lib::shead::NUM_OF_SERVOS
 
 void EcpRobot::clear_fault()
 {
+	communication_lock lock(communication_mutex);
+
 
 	the_robot->epos_clear_fault_data_port.set();
 
@@ -53,6 +59,8 @@ void EcpRobot::clear_fault()
 
 void EcpRobot::stop_motors()
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_brake_command_data_port.set();
 
 	execute_motion();
@@ -53,6 +53,59 @@ int UiRobot::synchronise_int()
 
 }
 
+int UiRobot::poll_state()
+{
+	const unsigned int parts = polled_state.take_requests();
+
+	// common::UiRobot::ui_ecp_robot jest zerowany przy usuwaniu robota
+	if (!parts || !is_edp_loaded() || !state.edp.is_synchronised || !common::UiRobot::ui_ecp_robot) {
+		return 0;
+	}
+
+	try {
+		// polecenie uzytkownika ma pierwszenstwo, odczyt zostanie ponowiony w nastepnym cyklu
+		EcpRobot::poll_lock lock(ui_ecp_robot->communication_mutex);
+		if (!lock.owns_lock()) {
+			polled_state.request(parts);
+			return 0;
+		}
+
+		if (parts & STATE_MOTORS) {
+			ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.set_request();
+		}
+		if (parts & STATE_JOINTS) {
+			ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.set_request();
+		}
+		if (parts & STATE_HEAD) {
+			ui_ecp_robot->the_robot->shead_reply_data_request_port.set_request();
+		}
+
+		// odczyt w tle nie zmienia stanu komunikacji pokazywanego w UI
+		ui_ecp_robot->transmit();
+
+		polled_state_t & next = polled_state.back();
+
+		if (parts & STATE_MOTORS) {
+			ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.get();
+			next.motors = ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.data;
+		}
+		if (parts & STATE_JOINTS) {
+			ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.get();
+			next.joints = ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.data;
+		}
+		if (parts & STATE_HEAD) {
+			ui_ecp_robot->the_robot->shead_reply_data_request_port.get();
+			next.head = ui_ecp_robot->the_robot->shead_reply_data_request_port.data;
+		}
+
+		polled_state.publish(parts);
+
+	} // end try
+	CATCH_SECTION_IN_ROBOT
+
+	return 1;
+}
+
 int UiRobot::execute_clear_fault()
 {
 	try {
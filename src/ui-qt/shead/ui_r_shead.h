@@ -12,10 +12,12 @@
 #include <QMenu>
 #include "../base/ui.h"
 #include "../base/ui_robot.h"
+#include "../base/ui_robot_state.h"
 
 #include "wgt_shead_command.h"
 
 #include "robot/shead/const_shead.h"
+#include "robot/shead/dp_shead.h"
 
 namespace Ui {
 class MenuBar;
@@ -31,6 +33,21 @@ class Interface;
 namespace shead {
 
 class EcpRobot;
+
+//! Parts of the state read in background
+enum
+{
+	STATE_MOTORS = 1, STATE_JOINTS = 2, STATE_HEAD = 4
+};
+
+//! State of the robot read in background
+struct polled_state_t
+{
+	lib::epos::epos_reply motors;
+	lib::epos::epos_reply joints;
+	lib::shead::reply head;
+};
+
 //
 //
 // KLASA UiRobot
@@ -43,6 +60,11 @@ Q_OBJECT
 
 public:
 
+	//! State of the robot displayed by the widgets
+	common::robot_state_subscription <polled_state_t> polled_state;
+
+	int poll_state();
+
 	double current_pos[lib::shead::NUM_OF_SERVOS]; // pozycja biezaca
 	double desired_pos[lib::shead::NUM_OF_SERVOS]; // pozycja zadana
 
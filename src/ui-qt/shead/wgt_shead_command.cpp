@@ -12,7 +12,7 @@
 #include "../../robot/shead/kinematic_model_shead.h"
 
 wgt_shead_command::wgt_shead_command(const QString & _widget_label, mrrocpp::ui::common::Interface& _interface, mrrocpp::ui::common::UiRobot *_robot, QWidget *parent) :
-		wgt_base(_widget_label, _interface, parent)
+		wgt_base(_widget_label, _interface, parent), read_pending(false), pending_part(0), requested_sequence(0)
 {
 	ui.setupUi(this);
 	robot = dynamic_cast <mrrocpp::ui::shead::UiRobot *>(_robot);
@@ -73,75 +73,22 @@ void wgt_shead_command::init()
 			{
 
 				synchro_depended_widgets_disable(false);
-				if (ui.radioButton_m_motor->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.set_request();
-				} else if (ui.radioButton_m_joint->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.set_request();
-				}
-
-				robot->ui_ecp_robot->the_robot->shead_reply_data_request_port.set_request();
-				robot->ui_ecp_robot->execute_motion();
-				robot->ui_ecp_robot->the_robot->shead_reply_data_request_port.get();
-
-				lib::epos::epos_reply *er;
 
+				unsigned int part = 0;
 				if (ui.radioButton_m_motor->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.get();
-					er = &robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.data;
+					part = mrrocpp::ui::shead::STATE_MOTORS;
 				} else if (ui.radioButton_m_joint->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.get();
-					er = &robot->ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.data;
-				}
-
-				lib::shead::reply &rep = robot->ui_ecp_robot->the_robot->shead_reply_data_request_port.data;
-
-				// sets soldification state
-				switch (rep.solidification_state)
-				{
-					case lib::shead::SOLIDIFICATION_STATE_ON:
-						ui.checkBox_sol_on->setChecked(true);
-						ui.checkBox_sol_off->setChecked(false);
-						ui.checkBox_sol_int->setChecked(false);
-						break;
-					case lib::shead::SOLIDIFICATION_STATE_OFF:
-						ui.checkBox_sol_on->setChecked(false);
-						ui.checkBox_sol_off->setChecked(true);
-						ui.checkBox_sol_int->setChecked(false);
-						break;
-					case lib::shead::SOLIDIFICATION_STATE_INTERMEDIATE:
-						ui.checkBox_sol_on->setChecked(false);
-						ui.checkBox_sol_off->setChecked(false);
-						ui.checkBox_sol_int->setChecked(true);
-						break;
-					default:
-						break;
+					part = mrrocpp::ui::shead::STATE_JOINTS;
 				}
 
-				// sets vacumization state
-				switch (rep.vacuum_state)
-				{
-					case lib::shead::VACUUM_STATE_ON:
-						ui.checkBox_vac_on->setChecked(true);
-						ui.checkBox_vac_off->setChecked(false);
-						ui.checkBox_vac_int->setChecked(false);
-						break;
-					case lib::shead::VACUUM_STATE_OFF:
-						ui.checkBox_vac_on->setChecked(false);
-						ui.checkBox_vac_off->setChecked(true);
-						ui.checkBox_vac_int->setChecked(false);
-						break;
-					case lib::shead::VACUUM_STATE_INTERMEDIATE:
-						ui.checkBox_vac_on->setChecked(false);
-						ui.checkBox_vac_off->setChecked(false);
-						ui.checkBox_vac_int->setChecked(true);
-						break;
-					default:
-						break;
-				}
-
-				for (int i = 0; i < lib::shead::NUM_OF_SERVOS; i++) {
-					checkBox_m_mip_Vector[i]->setChecked(er->epos_controller[i].motion_in_progress);
-					doubleSpinBox_m_current_position_Vector[i]->setValue(er->epos_controller[i].position);
+				// odczyt wykonuje watek robota, wynik wyswietla show_polled_state()
+				if (part) {
+					if (!read_pending || (pending_part != part)) {
+						requested_sequence = robot->polled_state.sequence(part);
+						pending_part = part;
+						read_pending = true;
+					}
+					robot->polled_state.request(part | mrrocpp::ui::shead::STATE_HEAD);
 				}
 
 			} else {
@@ -154,6 +101,75 @@ void wgt_shead_command::init()
 	CATCH_SECTION_UI_PTR
 }
 
+void wgt_shead_command::show_polled_state()
+{
+	if (!read_pending) {
+		return;
+	}
+
+	mrrocpp::ui::shead::polled_state_t snapshot;
+
+	if (robot->polled_state.get(snapshot, pending_part) == requested_sequence) {
+		return;
+	}
+
+	read_pending = false;
+
+	const lib::shead::reply &rep = snapshot.head;
+
+	// sets soldification state
+	switch (rep.solidification_state)
+	{
+		case lib::shead::SOLIDIFICATION_STATE_ON:
+			ui.checkBox_sol_on->setChecked(true);
+			ui.checkBox_sol_off->setChecked(false);
+			ui.checkBox_sol_int->setChecked(false);
+			break;
+		case lib::shead::SOLIDIFICATION_STATE_OFF:
+			ui.checkBox_sol_on->setChecked(false);
+			ui.checkBox_sol_off->setChecked(true);
+			ui.checkBox_sol_int->setChecked(false);
+			break;
+		case lib::shead::SOLIDIFICATION_STATE_INTERMEDIATE:
+			ui.checkBox_sol_on->setChecked(false);
+			ui.checkBox_sol_off->setChecked(false);
+			ui.checkBox_sol_int->setChecked(true);
+			break;
+		default:
+			break;
+	}
+
+	// sets vacumization state
+	switch (rep.vacuum_state)
+	{
+		case lib::shead::VACUUM_STATE_ON:
+			ui.checkBox_vac_on->setChecked(true);
+			ui.checkBox_vac_off->setChecked(false);
+			ui.checkBox_vac_int->setChecked(false);
+			break;
+		case lib::shead::VACUUM_STATE_OFF:
+			ui.checkBox_vac_on->setChecked(false);
+			ui.checkBox_vac_off->setChecked(true);
+			ui.checkBox_vac_int->setChecked(false);
+			break;
+		case lib::shead::VACUUM_STATE_INTERMEDIATE:
+			ui.checkBox_vac_on->setChecked(false);
+			ui.checkBox_vac_off->setChecked(false);
+			ui.checkBox_vac_int->setChecked(true);
+			break;
+		default:
+			break;
+	}
+
+	const lib::epos::epos_reply &er =
+			(pending_part == mrrocpp::ui::shead::STATE_MOTORS) ? snapshot.motors : snapshot.joints;
+
+	for (int i = 0; i < lib::shead::NUM_OF_SERVOS; i++) {
+		checkBox_m_mip_Vector[i]->setChecked(er.epos_controller[i].motion_in_progress);
+		doubleSpinBox_m_current_position_Vector[i]->setValue(er.epos_controller[i].position);
+	}
+}
+
 void wgt_shead_command::synchro_depended_widgets_disable(bool _set_disabled)
 {
 	ui.pushButton_m_execute->setDisabled(_set_disabled);
@@ -167,6 +183,8 @@ void wgt_shead_command::synchro_depended_widgets_disable(bool _set_disabled)
 
 void wgt_shead_command::timer_slot()
 {
+	show_polled_state();
+
 	if ((dwgt->isVisible()) && (ui.checkBox_cyclic_read->isChecked())) {
 		init();
 	}
@@ -236,8 +254,12 @@ void wgt_shead_command::on_pushButton_sol_execute_clicked()
 			sa = lib::shead::SOLIDIFICATION_OFF;
 		}
 
-		robot->ui_ecp_robot->the_robot->solidification_data_port.set();
-		robot->ui_ecp_robot->execute_motion();
+		{
+			mrrocpp::ui::shead::EcpRobot::communication_lock lock(robot->ui_ecp_robot->communication_mutex);
+
+			robot->ui_ecp_robot->the_robot->solidification_data_port.set();
+			robot->ui_ecp_robot->execute_motion();
+		}
 
 		init();
 
@@ -260,8 +282,12 @@ void wgt_shead_command::on_pushButton_vac_execute_clicked()
 			va = lib::shead::VACUUM_OFF;
 		}
 
-		robot->ui_ecp_robot->the_robot->vacuum_activation_data_port.set();
-		robot->ui_ecp_robot->execute_motion();
+		{
+			mrrocpp::ui::shead::EcpRobot::communication_lock lock(robot->ui_ecp_robot->communication_mutex);
+
+			robot->ui_ecp_robot->the_robot->vacuum_activation_data_port.set();
+			robot->ui_ecp_robot->execute_motion();
+		}
 
 		init();
 
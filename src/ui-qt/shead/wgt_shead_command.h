@@ -48,6 +48,18 @@ private:
 
 	void init();
 
+	//! Displays the state read by the robot thread
+	void show_polled_state();
+
+	//! The requested state was not displayed yet
+	bool read_pending;
+
+	//! Part of the state to display
+	unsigned int pending_part;
+
+	//! Number of the state publication at the time of the request
+	unsigned int requested_sequence;
+
 	void synchro_depended_widgets_disable(bool _set_disabled);
 
 	void get_desired_position();
@@ -18,6 +18,8 @@ EcpRobot::EcpRobot(common::UiRobot& _ui_robot) :
 
 void EcpRobot::move_motors(const double final_position[lib::smb::NUM_OF_SERVOS])
 {
+	communication_lock lock(communication_mutex);
+
 	for (int i = 0; i < lib::smb::NUM_OF_SERVOS; ++i) {
 		the_robot->epos_motor_command_data_port.data.desired_position[i] = final_position[i];
 	}
@@ -29,6 +31,8 @@ void EcpRobot::move_motors(const double final_position[lib::smb::NUM_OF_SERVOS])
 
 void EcpRobot::move_joints(const double final_position[lib::smb::NUM_OF_SERVOS])
 {
+	communication_lock lock(communication_mutex);
+
 	for (int i = 0; i < lib::smb::NUM_OF_SERVOS; ++i) {
 		the_robot->epos_joint_command_data_port.data.desired_position[i] = final_position[i];
 	}
@@ -39,6 +43,8 @@ void EcpRobot::move_joints(const double final_position[lib::smb::NUM_OF_SERVOS])
 
 void EcpRobot::move_external(const double final_position[6], const double _estimated_time)
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_external_command_data_port.data.estimated_time = _estimated_time;
 
 	the_robot->epos_external_command_data_port.data.base_vs_bench_rotation = final_position[0];
@@ -51,6 +57,8 @@ void EcpRobot::move_external(const double final_position[6], const double _estim
 
 void EcpRobot::clear_fault()
 {
+	communication_lock lock(communication_mutex);
+
 	//the_robot->epos_clear_fault_data_port.data = true;
 
 	the_robot->epos_clear_fault_data_port.set();
@@ -60,6 +68,8 @@ void EcpRobot::clear_fault()
 
 void EcpRobot::stop_motors()
 {
+	communication_lock lock(communication_mutex);
+
 	//the_robot->epos_brake_command_data_port.data = true;
 
 	the_robot->epos_brake_command_data_port.set();
@@ -12,10 +12,12 @@
 #include <QMenu>
 #include "../base/ui.h"
 #include "../base/ui_robot.h"
+#include "../base/ui_robot_state.h"
 
 #include "wgt_smb_command.h"
 
 #include "robot/smb/const_smb.h"
+#include "robot/smb/dp_smb.h"
 
 namespace Ui {
 class MenuBar;
@@ -31,6 +33,22 @@ class Interface;
 namespace smb {
 
 class EcpRobot;
+
+//! Parts of the state read in background
+enum
+{
+	STATE_MOTORS = 1, STATE_JOINTS = 2, STATE_EXTERNAL = 4, STATE_LEGS = 8
+};
+
+//! State of the robot read in background
+struct polled_state_t
+{
+	lib::epos::epos_reply motors;
+	lib::epos::epos_reply joints;
+	lib::smb::smb_ext_epos_reply external;
+	lib::smb::multi_leg_reply_td legs;
+};
+
 //
 //
 // KLASA UiRobot
@@ -43,6 +61,11 @@ Q_OBJECT
 
 public:
 
+	//! State of the robot displayed by the widgets
+	common::robot_state_subscription <polled_state_t> polled_state;
+
+	int poll_state();
+
 	double current_pos[lib::smb::NUM_OF_SERVOS]; // pozycja biezaca
 	double desired_pos[lib::smb::NUM_OF_SERVOS]; // pozycja zadana
 
@@ -8,7 +8,7 @@
 #include "../base/ui_robot.h"
 
 wgt_smb_command::wgt_smb_command(const QString & _widget_label, mrrocpp::ui::common::Interface& _interface, mrrocpp::ui::common::UiRobot *_robot, QWidget *parent) :
-		wgt_base(_widget_label, _interface, parent)
+		wgt_base(_widget_label, _interface, parent), read_pending(false), pending_part(0), requested_sequence(0)
 {
 	ui.setupUi(this);
 	robot = dynamic_cast <mrrocpp::ui::smb::UiRobot *>(_robot);
@@ -125,57 +125,24 @@ void wgt_smb_command::init()
 			if (robot->state.edp.is_synchronised) // Czy robot jest zsynchronizowany?
 			{
 				synchro_depended_widgets_disable(false);
-				if (ui.radioButton_m_motor->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.set_request();
-				} else if (ui.radioButton_m_joint->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.set_request();
-				} else if (ui.radioButton_m_ext->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.set_request();
-				}
-				robot->ui_ecp_robot->the_robot->smb_multi_leg_reply_data_request_port.set_request();
-				robot->ui_ecp_robot->execute_motion();
-				robot->ui_ecp_robot->the_robot->smb_multi_leg_reply_data_request_port.get();
-				lib::epos::epos_reply *er;
-				lib::smb::smb_ext_epos_reply *ser;
 
+				unsigned int part = 0;
 				if (ui.radioButton_m_motor->isChecked()) {
-
-					robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.get();
-					er = &robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.data;
+					part = mrrocpp::ui::smb::STATE_MOTORS;
 				} else if (ui.radioButton_m_joint->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.get();
-					er = &robot->ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.data;
+					part = mrrocpp::ui::smb::STATE_JOINTS;
 				} else if (ui.radioButton_m_ext->isChecked()) {
-					robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.get();
-					ser = &robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.data;
-				}
-
-				// sets leg state
-
-				lib::smb::multi_leg_reply_td &mlr =
-						robot->ui_ecp_robot->the_robot->smb_multi_leg_reply_data_request_port.data;
-
-				for (int i = 0; i < lib::smb::LEG_CLAMP_NUMBER; i++) {
-					checkBox_fl_in_Vector[i]->setChecked(mlr.leg[i].is_in);
-					checkBox_fl_out_Vector[i]->setChecked(mlr.leg[i].is_out);
-					checkBox_fl_attached_Vector[i]->setChecked(mlr.leg[i].is_attached);
+					part = mrrocpp::ui::smb::STATE_EXTERNAL;
 				}
 
-				if (ui.radioButton_m_motor->isChecked()) {
-					for (int i = 0; i < lib::smb::NUM_OF_SERVOS; i++) {
-						checkBox_m_mip_Vector[i]->setChecked(er->epos_controller[i].motion_in_progress);
-						doubleSpinBox_m_current_position_Vector[i]->setValue(er->epos_controller[i].position);
-					}
-				} else if (ui.radioButton_m_joint->isChecked()) {
-					for (int i = 0; i < lib::smb::NUM_OF_SERVOS; i++) {
-						checkBox_m_mip_Vector[i]->setChecked(er->epos_controller[i].motion_in_progress);
-						doubleSpinBox_m_current_position_Vector[i]->setValue(er->epos_controller[i].position);
-					}
-				} else if (ui.radioButton_m_ext->isChecked()) {
-					for (int i = 0; i < lib::smb::NUM_OF_SERVOS; i++) {
-						checkBox_m_mip_Vector[i]->setChecked(ser->epos_controller[i].motion_in_progress);
-						doubleSpinBox_m_current_position_Vector[i]->setValue(ser->epos_controller[i].position);
+				// odczyt wykonuje watek robota, wynik wyswietla show_polled_state()
+				if (part) {
+					if (!read_pending || (pending_part != part)) {
+						requested_sequence = robot->polled_state.sequence(part);
+						pending_part = part;
+						read_pending = true;
 					}
+					robot->polled_state.request(part | mrrocpp::ui::smb::STATE_LEGS);
 				}
 
 			} else {
@@ -188,6 +155,48 @@ void wgt_smb_command::init()
 	CATCH_SECTION_UI_PTR
 }
 
+void wgt_smb_command::show_polled_state()
+{
+	if (!read_pending) {
+		return;
+	}
+
+	mrrocpp::ui::smb::polled_state_t snapshot;
+
+	if (robot->polled_state.get(snapshot, pending_part) == requested_sequence) {
+		return;
+	}
+
+	read_pending = false;
+
+	// sets leg state
+
+	const lib::smb::multi_leg_reply_td &mlr = snapshot.legs;
+
+	for (int i = 0; i < lib::smb::LEG_CLAMP_NUMBER; i++) {
+		checkBox_fl_in_Vector[i]->setChecked(mlr.leg[i].is_in);
+		checkBox_fl_out_Vector[i]->setChecked(mlr.leg[i].is_out);
+		checkBox_fl_attached_Vector[i]->setChecked(mlr.leg[i].is_attached);
+	}
+
+	if (pending_part == mrrocpp::ui::smb::STATE_MOTORS) {
+		for (int i = 0; i < lib::smb::NUM_OF_SERVOS; i++) {
+			checkBox_m_mip_Vector[i]->setChecked(snapshot.motors.epos_controller[i].motion_in_progress);
+			doubleSpinBox_m_current_position_Vector[i]->setValue(snapshot.motors.epos_controller[i].position);
+		}
+	} else if (pending_part == mrrocpp::ui::smb::STATE_JOINTS) {
+		for (int i = 0; i < lib::smb::NUM_OF_SERVOS; i++) {
+			checkBox_m_mip_Vector[i]->setChecked(snapshot.joints.epos_controller[i].motion_in_progress);
+			doubleSpinBox_m_current_position_Vector[i]->setValue(snapshot.joints.epos_controller[i].position);
+		}
+	} else if (pending_part == mrrocpp::ui::smb::STATE_EXTERNAL) {
+		for (int i = 0; i < lib::smb::NUM_OF_SERVOS; i++) {
+			checkBox_m_mip_Vector[i]->setChecked(snapshot.external.epos_controller[i].motion_in_progress);
+			doubleSpinBox_m_current_position_Vector[i]->setValue(snapshot.external.epos_controller[i].position);
+		}
+	}
+}
+
 void wgt_smb_command::synchro_depended_widgets_disable(bool _set_disabled)
 {
 	ui.pushButton_m_execute->setDisabled(_set_disabled);
@@ -201,6 +210,8 @@ void wgt_smb_command::synchro_depended_widgets_disable(bool _set_disabled)
 
 void wgt_smb_command::timer_slot()
 {
+	show_polled_state();
+
 	if ((dwgt->isVisible()) && (ui.checkBox_cyclic_read->isChecked())) {
 		init();
 	}
@@ -289,8 +300,12 @@ void wgt_smb_command::on_pushButton_fl_execute_clicked()
 			}
 
 		}
-		robot->ui_ecp_robot->the_robot->smb_festo_command_data_port.set();
-		robot->ui_ecp_robot->execute_motion();
+		{
+			mrrocpp::ui::smb::EcpRobot::communication_lock lock(robot->ui_ecp_robot->communication_mutex);
+
+			robot->ui_ecp_robot->the_robot->smb_festo_command_data_port.set();
+			robot->ui_ecp_robot->execute_motion();
+		}
 
 		init();
 
@@ -20,6 +20,8 @@ EcpRobot::EcpRobot(common::UiRobot& _ui_robot) :
 
 void EcpRobot::move_motors(const double final_position[lib::spkm::NUM_OF_SERVOS], lib::epos::EPOS_MOTION_VARIANT motion_variant)
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_motor_command_data_port.data.motion_variant = motion_variant;
 
 	for (int i = 0; i < lib::spkm::NUM_OF_SERVOS; ++i) {
@@ -33,6 +35,8 @@ void EcpRobot::move_motors(const double final_position[lib::spkm::NUM_OF_SERVOS]
 
 void EcpRobot::move_joints(const double final_position[lib::spkm::NUM_OF_SERVOS], lib::epos::EPOS_MOTION_VARIANT motion_variant)
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_joint_command_data_port.data.motion_variant = motion_variant;
 
 	for (int i = 0; i < lib::spkm::NUM_OF_SERVOS; ++i) {
@@ -45,6 +49,8 @@ void EcpRobot::move_joints(const double final_position[lib::spkm::NUM_OF_SERVOS]
 
 void EcpRobot::move_external(const double final_position[6], lib::epos::EPOS_MOTION_VARIANT motion_variant, lib::spkm::POSE_SPECIFICATION tool_variant, const double _estimated_time)
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_external_command_data_port.data.pose_specification = tool_variant;
 	the_robot->epos_external_command_data_port.data.motion_variant = motion_variant;
 	the_robot->epos_external_command_data_port.data.estimated_time = _estimated_time;
@@ -60,6 +66,8 @@ void EcpRobot::move_external(const double final_position[6], lib::epos::EPOS_MOT
 
 void EcpRobot::clear_fault()
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_clear_fault_data_port.set();
 
 	execute_motion();
@@ -67,6 +75,8 @@ void EcpRobot::clear_fault()
 
 void EcpRobot::stop_motors()
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_quickstop_command_data_port.set();
 
 	execute_motion();
@@ -75,6 +85,8 @@ void EcpRobot::stop_motors()
 
 void EcpRobot::brake_motors()
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_brake_command_data_port.set();
 
 	execute_motion();
@@ -82,6 +94,8 @@ void EcpRobot::brake_motors()
 
 void EcpRobot::disable_brake()
 {
+	communication_lock lock(communication_mutex);
+
 	the_robot->epos_disable_brake_command_data_port.set();
 
 	execute_motion();
@@ -31,7 +31,9 @@ namespace spkm {
 //
 
 UiRobot::UiRobot(common::Interface& _interface, lib::robot_name_t _robot_name) :
-		common::UiRobot(_interface, _robot_name, lib::spkm::NUM_OF_SERVOS), ui_ecp_robot(NULL)
+		common::UiRobot(_interface, _robot_name, lib::spkm::NUM_OF_SERVOS),
+		polled_pose_specification(lib::spkm::POSE_SPECIFICATION::WRIST_XYZ_EULER_ZYZ),
+		ui_ecp_robot(NULL)
 {
 //	add_wgt <wgt_spkm_inc>(WGT_SPKM_INC, "Spkm inc");
 //	add_wgt <wgt_spkm_int>(WGT_SPKM_INT, "Spkm int");
@@ -226,6 +228,61 @@ void UiRobot::move_to_preset_position(int variant)
 
 }
 
+int UiRobot::poll_state()
+{
+	const unsigned int parts = polled_state.take_requests();
+
+	// common::UiRobot::ui_ecp_robot jest zerowany przy usuwaniu robota
+	if (!parts || !is_edp_loaded() || !state.edp.is_synchronised || !common::UiRobot::ui_ecp_robot) {
+		return 0;
+	}
+
+	try {
+		// polecenie uzytkownika ma pierwszenstwo, odczyt zostanie ponowiony w nastepnym cyklu
+		EcpRobot::poll_lock lock(ui_ecp_robot->communication_mutex);
+		if (!lock.owns_lock()) {
+			polled_state.request(parts);
+			return 0;
+		}
+
+		if (parts & STATE_MOTORS) {
+			ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.set_request();
+		}
+		if (parts & STATE_JOINTS) {
+			ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.set_request();
+		}
+		if (parts & STATE_EXTERNAL) {
+			ui_ecp_robot->the_robot->epos_external_reply_data_request_port.set_data = polled_pose_specification;
+			ui_ecp_robot->the_robot->epos_external_reply_data_request_port.set_request();
+		}
+
+		// odczyt w tle nie zmienia stanu komunikacji pokazywanego w UI
+		ui_ecp_robot->transmit();
+
+		polled_state_t & next = polled_state.back();
+
+		if (parts & STATE_MOTORS) {
+			ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.get();
+			next.motors = ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.data;
+		}
+		if (parts & STATE_JOINTS) {
+			ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.get();
+			next.joints = ui_ecp_robot->the_robot->epos_joint_reply_data_request_port.data;
+		}
+		if (parts & STATE_EXTERNAL) {
+			ui_ecp_robot->the_robot->epos_external_reply_data_request_port.get();
+			next.external = ui_ecp_robot->the_robot->epos_external_reply_data_request_port.data;
+			next.external_pose_specification = ui_ecp_robot->the_robot->epos_external_reply_data_request_port.set_data;
+		}
+
+		polled_state.publish(parts);
+
+	} // end try
+	CATCH_SECTION_IN_ROBOT
+
+	return 1;
+}
+
 int UiRobot::execute_motor_motion()
 {
 	try {
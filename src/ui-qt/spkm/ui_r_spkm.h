@@ -5,7 +5,9 @@
 #include <QMenu>
 #include "../base/ui.h"
 #include "../base/ui_robot.h"
+#include "../base/ui_robot_state.h"
 #include "robot/spkm/const_spkm.h"
+#include "robot/spkm/dp_spkm.h"
 #include "robot/spkm/kinematic_parameters_spkm.h"
 
 #include "wgt_spkm_inc.h"
@@ -36,12 +38,37 @@ namespace spkm {
 
 class EcpRobot;
 
+//! Parts of the state read in background
+enum
+{
+	STATE_MOTORS = 1, STATE_JOINTS = 2, STATE_EXTERNAL = 4
+};
+
+//! State of the robot read in background
+struct polled_state_t
+{
+	lib::epos::epos_reply motors;
+	lib::epos::epos_reply joints;
+	lib::spkm::spkm_ext_epos_reply external;
+
+	//! Pose specification of the external state
+	lib::spkm::POSE_SPECIFICATION external_pose_specification;
+};
+
 class UiRobot : public common::UiRobot
 {
 	Q_OBJECT
 
 public:
 
+	//! State of the robot displayed by the widgets
+	common::robot_state_subscription <polled_state_t> polled_state;
+
+	//! Pose specification of the external state, set by the widget before the request
+	lib::spkm::POSE_SPECIFICATION polled_pose_specification;
+
+	int poll_state();
+
 	double current_pos[lib::spkm::NUM_OF_SERVOS]; // pozycja biezaca
 	double desired_pos[lib::spkm::NUM_OF_SERVOS]; // pozycja zadana
 
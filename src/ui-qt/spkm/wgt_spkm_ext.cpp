@@ -10,7 +10,7 @@
 #include "../base/ui_robot.h"
 
 wgt_spkm_ext::wgt_spkm_ext(const QString & _widget_label, mrrocpp::ui::common::Interface& _interface, mrrocpp::ui::common::UiRobot *_robot, QWidget *parent) :
-		wgt_base(_widget_label, _interface, parent), current_pose_specification(lib::spkm::POSE_SPECIFICATION::WRIST_XYZ_EULER_ZYZ)
+		wgt_base(_widget_label, _interface, parent), current_pose_specification(lib::spkm::POSE_SPECIFICATION::WRIST_XYZ_EULER_ZYZ), read_pending(false), requested_sequence(0)
 {
 	ui.setupUi(this);
 	robot = dynamic_cast <mrrocpp::ui::spkm::UiRobot *>(_robot);
@@ -45,6 +45,8 @@ wgt_spkm_ext::wgt_spkm_ext(const QString & _widget_label, mrrocpp::ui::common::I
 
 void wgt_spkm_ext::timer_slot()
 {
+	show_polled_state();
+
 	if ((dwgt->isVisible()) && (ui.checkBox_cyclic_read->isChecked())) {
 		init();
 	}
@@ -67,36 +69,14 @@ void wgt_spkm_ext::init()
 			if (robot->state.edp.is_synchronised) // Czy robot jest zsynchronizowany?
 			{
 				//ui.pushButton_execute->setDisabled(false);
-				robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.set_data =
-						current_pose_specification;
-				robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.set_request();
-				robot->ui_ecp_robot->execute_motion();
-				robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.get();
-
-				for (int i = 0; i < 6; i++) {
-					set_single_axis(i,
-					// doubleSpinBox_mcur_Vector[i],
-					radioButton_mip_Vector[i]);
-				}
-
-				lib::spkm::spkm_ext_epos_reply &ser =
-						robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.data;
-
-				/*lib::Homog_matrix tmp_frame(ser.current_frame);
-				 lib::Xyz_Angle_Axis_vector tmp_vector;
-				 double current_position[6];
-				 tmp_frame.get_xyz_angle_axis(tmp_vector);
-				 tmp_vector.to_table(current_position);
 
-				 for (int i = 0; i < 6; i++) {
-				 doubleSpinBox_cur_Vector[i]->setValue(current_position[i]);
-				 robot->desired_pos[i] = robot->current_pos[i];
-				 }*/
-
-				for (int i = 0; i < 6; i++) {
-					doubleSpinBox_cur_Vector[i]->setValue(ser.current_pose[i]);
-					robot->desired_pos[i] = robot->current_pos[i];
+				// odczyt wykonuje watek robota, wynik wyswietla show_polled_state()
+				if (!read_pending) {
+					requested_sequence = robot->polled_state.sequence(mrrocpp::ui::spkm::STATE_EXTERNAL);
+					read_pending = true;
 				}
+				robot->polled_pose_specification = current_pose_specification;
+				robot->polled_state.request(mrrocpp::ui::spkm::STATE_EXTERNAL);
 
 			} else {
 				// Wygaszanie elementow przy niezsynchronizowanym robocie
@@ -109,9 +89,42 @@ void wgt_spkm_ext::init()
 
 }
 
-void wgt_spkm_ext::set_single_axis(int axis, QAbstractButton* qab_mip)
+void wgt_spkm_ext::show_polled_state()
+{
+	if (!read_pending) {
+		return;
+	}
+
+	mrrocpp::ui::spkm::polled_state_t snapshot;
+
+	if (robot->polled_state.get(snapshot, mrrocpp::ui::spkm::STATE_EXTERNAL) == requested_sequence) {
+		return;
+	}
+
+	// pozycja odczytana dla poprzednio wybranego narzedzia
+	if (snapshot.external_pose_specification != current_pose_specification) {
+		requested_sequence = robot->polled_state.sequence(mrrocpp::ui::spkm::STATE_EXTERNAL);
+		robot->polled_pose_specification = current_pose_specification;
+		robot->polled_state.request(mrrocpp::ui::spkm::STATE_EXTERNAL);
+		return;
+	}
+
+	read_pending = false;
+
+	for (int i = 0; i < 6; i++) {
+		set_single_axis(i, snapshot.external,
+		// doubleSpinBox_mcur_Vector[i],
+		radioButton_mip_Vector[i]);
+	}
+
+	for (int i = 0; i < 6; i++) {
+		doubleSpinBox_cur_Vector[i]->setValue(snapshot.external.current_pose[i]);
+		robot->desired_pos[i] = robot->current_pos[i];
+	}
+}
+
+void wgt_spkm_ext::set_single_axis(int axis, const lib::spkm::spkm_ext_epos_reply &ser, QAbstractButton* qab_mip)
 {
-	lib::spkm::spkm_ext_epos_reply &ser = robot->ui_ecp_robot->the_robot->epos_external_reply_data_request_port.data;
 //	qdsb_mcur->setValue(er.epos_controller[axis].current);
 
 	if (ser.epos_controller[axis].motion_in_progress) {
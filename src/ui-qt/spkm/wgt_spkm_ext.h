@@ -6,8 +6,8 @@
 #include <QDockWidget>
 #include "ui_wgt_spkm_ext.h"
 #include "../base/wgt_base.h"
-#include <QTimer>
 #include "robot/spkm/dp_spkm.h"
+#include <QTimer>
 #include <boost/shared_ptr.hpp>
 
 namespace mrrocpp {
@@ -45,9 +45,18 @@ private:
 	void init();
 	void copy();
 
-	void set_single_axis(int axis,
+	void set_single_axis(int axis, const mrrocpp::lib::spkm::spkm_ext_epos_reply &ser,
 	//	QDoubleSpinBox* qdsb_mcur,
 	QAbstractButton* qab_mip);
+
+	//! Displays the state read by the robot thread
+	void show_polled_state();
+
+	//! The requested state was not displayed yet
+	bool read_pending;
+
+	//! Number of the state publication at the time of the request
+	unsigned int requested_sequence;
 	void get_desired_position();
 	void move_it();
 	boost::shared_ptr <QTimer> timer;
@@ -8,7 +8,7 @@
 #include "../base/ui_robot.h"
 
 wgt_spkm_inc::wgt_spkm_inc(const QString & _widget_label, mrrocpp::ui::common::Interface& _interface, mrrocpp::ui::common::UiRobot *_robot, QWidget *parent) :
-		wgt_base(_widget_label, _interface, parent)
+		wgt_base(_widget_label, _interface, parent), read_pending(false), requested_sequence(0)
 {
 	ui.setupUi(this);
 	robot = dynamic_cast <mrrocpp::ui::spkm::UiRobot *>(_robot);
@@ -62,6 +62,8 @@ void wgt_spkm_inc::synchro_depended_init()
 
 void wgt_spkm_inc::timer_slot()
 {
+	show_polled_state();
+
 	if ((dwgt->isVisible()) && (ui.checkBox_cyclic_read->isChecked())) {
 		init();
 	}
@@ -123,14 +125,12 @@ int wgt_spkm_inc::init()
 			{
 				synchro_depended_widgets_disable(false);
 
-				robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.set_request();
-				robot->ui_ecp_robot->execute_motion();
-				robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.get();
-
-				for (int i = 0; i < robot->number_of_servos; i++) {
-					set_single_axis(i, doubleSpinBox_mcur_Vector[i], doubleSpinBox_cur_Vector[i], radioButton_mip_Vector[i]);
-					robot->desired_pos[i] = robot->current_pos[i];
+				// odczyt wykonuje watek robota, wynik wyswietla show_polled_state()
+				if (!read_pending) {
+					requested_sequence = robot->polled_state.sequence(mrrocpp::ui::spkm::STATE_MOTORS);
+					read_pending = true;
 				}
+				robot->polled_state.request(mrrocpp::ui::spkm::STATE_MOTORS);
 
 			} else {
 				// Wygaszanie elementow przy niezsynchronizowanym robocie
@@ -144,10 +144,28 @@ int wgt_spkm_inc::init()
 	return 1;
 }
 
-void wgt_spkm_inc::set_single_axis(int axis, QDoubleSpinBox* qdsb_mcur, QDoubleSpinBox* qdsb_cur_p, QAbstractButton* qab_mip)
+void wgt_spkm_inc::show_polled_state()
 {
+	if (!read_pending) {
+		return;
+	}
+
+	mrrocpp::ui::spkm::polled_state_t snapshot;
+
+	if (robot->polled_state.get(snapshot, mrrocpp::ui::spkm::STATE_MOTORS) == requested_sequence) {
+		return;
+	}
 
-	lib::epos::epos_reply &er = robot->ui_ecp_robot->the_robot->epos_motor_reply_data_request_port.data;
+	read_pending = false;
+
+	for (int i = 0; i < robot->number_of_servos; i++) {
+		set_single_axis(i, snapshot.motors, doubleSpinBox_mcur_Vector[i], doubleSpinBox_cur_Vector[i], radioButton_mip_Vector[i]);
+		robot->desired_pos[i] = robot->current_pos[i];
+	}
+}
+
+void wgt_spkm_inc::set_single_axis(int axis, const lib::epos::epos_reply &er, QDoubleSpinBox* qdsb_mcur, QDoubleSpinBox* qdsb_cur_p, QAbstractButton* qab_mip)
+{
 	qdsb_mcur->setValue(er.epos_controller[axis].current);
 	qdsb_cur_p->setValue(er.epos_controller[axis].position);
 
@@ -6,6 +6,7 @@
 #include <QDockWidget>
 #include "ui_wgt_spkm_int.h"
 #include "../base/wgt_base.h"
+#include "robot/maxon/dp_epos.h"
 #include <QTimer>
 
 #include <boost/shared_ptr.hpp>
@@ -44,7 +45,16 @@ private:
 	void init();
 	void copy();
 
-	void set_single_axis(int axis, QDoubleSpinBox* qdsb_mcur, QDoubleSpinBox* qdsb_cur_p, QAbstractButton* qab_mip);
+	void set_single_axis(int axis, const mrrocpp::lib::epos::epos_reply &er, QDoubleSpinBox* qdsb_mcur, QDoubleSpinBox* qdsb_cur_p, QAbstractButton* qab_mip);
+
+	//! Displays the state read by the robot thread
+	void show_polled_state();
+
+	//! The requested state was not displayed yet
+	bool read_pending;
+
+	//! Number of the state publication at the time of the request
+	unsigned int requested_sequence;
 	void get_desired_position();
 	void move_it();
 